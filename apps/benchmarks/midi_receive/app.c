@@ -0,0 +1,215 @@
+// $Id$
+/*
+ * Benchmark for MIDI Receive Handler
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+
+#include <FreeRTOS.h>
+#include <portmacro.h>
+
+#include "benchmark.h"
+#include "app.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Global Variables
+/////////////////////////////////////////////////////////////////////////////
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+static u32 benchmark_cycles;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+
+/////////////////////////////////////////////////////////////////////////////
+// This hook is called after startup to initialize the application
+/////////////////////////////////////////////////////////////////////////////
+void APP_Init(void)
+{
+  // initialize all LEDs
+  MIOS32_BOARD_LED_Init(0xffffffff);
+
+  // initialize stopwatch for measuring delays
+  MIOS32_STOPWATCH_Init(100);
+
+  // initialize benchmark
+  BENCHMARK_Init(0);
+
+  // init benchmark result
+  benchmark_cycles = 0;
+
+  // print welcome message on MIOS terminal
+  MIOS32_MIDI_SendDebugMessage("\n");
+  MIOS32_MIDI_SendDebugMessage("====================\n");
+  MIOS32_MIDI_SendDebugMessage("%s\n", MIOS32_LCD_BOOT_MSG_LINE1);
+  MIOS32_MIDI_SendDebugMessage("====================\n");
+  MIOS32_MIDI_SendDebugMessage("\n");
+  MIOS32_MIDI_SendDebugMessage("Play MIDI notes to start different benchmarks\n");
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// This task is running endless in background
+/////////////////////////////////////////////////////////////////////////////
+void APP_Background(void)
+{
+  // clear LCD screen
+  MIOS32_LCD_Clear();
+
+  // print message
+  MIOS32_LCD_CursorSet(0, 0);
+  MIOS32_LCD_PrintString("see README.txt   ");
+  MIOS32_LCD_CursorSet(0, 1);
+  MIOS32_LCD_PrintString("for details     ");
+
+  // wait endless
+  while( 1 );
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// This hook is called when a MIDI package has been received
+/////////////////////////////////////////////////////////////////////////////
+void APP_MIDI_NotifyPackage(mios32_midi_port_t port, mios32_midi_package_t midi_package)
+{
+  s32 (*benchmark_start)(u32 par);
+  u32 benchmark_par = 0;
+  u32 num_loops = 100;
+  u32 num_received;
+
+  if( midi_package.type == NoteOn && midi_package.velocity > 0 ) {
+    // change debug interface (where messages are forwarded)
+    MIOS32_MIDI_DebugPortSet(port);
+
+    // determine test number (use note number, remove octave)
+    u8 test_number = midi_package.note % 12;
+
+    // select the processing method (0..2) and the package pattern (0..2)
+    benchmark_par = test_number / 3;
+    if( benchmark_par > 2 ) {
+      MIOS32_MIDI_SendDebugMessage("This note isn't mapped to a test function.\n");
+      return;
+    }
+
+    switch( test_number % 3 ) {
+      case 0:
+	MIOS32_MIDI_SendDebugMessage("Testing MIOS32_MIDI_ReceivePackage for each package (pattern %d)\n", benchmark_par);
+	benchmark_start = BENCHMARK_Start_Single;
+	break;
+
+      case 1:
+	MIOS32_MIDI_SendDebugMessage("Testing MIOS32_MIDI_ReceivePackageBlock (pattern %d)\n", benchmark_par);
+	benchmark_start = BENCHMARK_Start_Block;
+	break;
+
+      default:
+	MIOS32_MIDI_SendDebugMessage("Testing MIOS32_MIDI_ReceivePackageBlock with block callback (pattern %d)\n", benchmark_par);
+	benchmark_start = BENCHMARK_Start_BlockCallback;
+    }
+
+    // add some delay to ensure that there a no USB background traffic caused by the debug message
+    MIOS32_DELAY_Wait_uS(50000);
+
+    // reset benchmark
+    BENCHMARK_Reset(benchmark_par);
+
+    portENTER_CRITICAL(); // port specific FreeRTOS function to disable tasks (nested)
+
+    // turn on LED (e.g. for measurements with a scope)
+    MIOS32_BOARD_LED_Set(0xffffffff, 1);
+
+    // reset stopwatch
+    MIOS32_STOPWATCH_Reset();
+
+    // start benchmark
+    {
+      int i;
+
+      for(i=0; i<num_loops; ++i) {
+	benchmark_start(benchmark_par);
+	if( i == 0 )
+	  num_received = BENCHMARK_NumReceivedGet();
+      }
+    }
+
+    // capture counter value
+    benchmark_cycles = MIOS32_STOPWATCH_ValueGet();
+
+    // turn off LED
+    MIOS32_BOARD_LED_Set(0xffffffff, 0);
+
+    portEXIT_CRITICAL(); // port specific FreeRTOS function to enable tasks (nested)
+
+    // print result on MIOS terminal
+    if( benchmark_cycles == 0xffffffff )
+      MIOS32_MIDI_SendDebugMessage("Time: overrun!\n");
+    else
+      MIOS32_MIDI_SendDebugMessage("Time: %5d.%d mS for %d packages (%d forwarded per loop)\n",
+				   benchmark_cycles/(10*num_loops), benchmark_cycles%(10*num_loops),
+				   BENCHMARK_NUM_PACKAGES, num_received);
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// This hook is called before the shift register chain is scanned
+/////////////////////////////////////////////////////////////////////////////
+void APP_SRIO_ServicePrepare(void)
+{
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// This hook is called after the shift register chain has been scanned
+/////////////////////////////////////////////////////////////////////////////
+void APP_SRIO_ServiceFinish(void)
+{
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// This hook is called when a button has been toggled
+// pin_value is 1 when button released, and 0 when button pressed
+/////////////////////////////////////////////////////////////////////////////
+void APP_DIN_NotifyToggle(u32 pin, u32 pin_value)
+{
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// This hook is called when an encoder has been moved
+// incrementer is positive when encoder has been turned clockwise, else
+// it is negative
+/////////////////////////////////////////////////////////////////////////////
+void APP_ENC_NotifyChange(u32 encoder, s32 incrementer)
+{
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// This hook is called when a pot has been moved
+/////////////////////////////////////////////////////////////////////////////
+void APP_AIN_NotifyChange(u32 pin, u32 pin_value)
+{
+}
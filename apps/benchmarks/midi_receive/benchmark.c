@@ -0,0 +1,176 @@
+// $Id$
+/*
+ * Benchmark for MIDI Receive Handler
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <mios32.h>
+#include <string.h>
+#include "benchmark.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local Variables
+/////////////////////////////////////////////////////////////////////////////
+
+// the pattern is copied into the receive buffer before each run like the
+// USB callback would do, because MIOS32_MIDI_ReceivePackageBlock() clears
+// the cable numbers inside the buffer
+static mios32_midi_package_t pattern[BENCHMARK_NUM_PACKAGES];
+static mios32_midi_package_t packages[BENCHMARK_NUM_PACKAGES];
+
+// the callbacks sum up some values to ensure that they can't be optimized away
+static u32 num_received;
+static u32 checksum;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Dummy callbacks
+/////////////////////////////////////////////////////////////////////////////
+void BENCHMARK_NotifyPackage(mios32_midi_port_t port, mios32_midi_package_t midi_package)
+{
+  ++num_received;
+  checksum += midi_package.ALL + port;
+}
+
+s32 BENCHMARK_NotifyBlock(mios32_midi_port_t port, mios32_midi_package_t *p, u32 num)
+{
+  num_received += num;
+  for(; num; --num, ++p)
+    checksum += p->ALL + port;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Initialisation
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_Init(u32 mode)
+{
+  num_received = 0;
+  checksum = 0;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Fills the package buffer with a burst of channel voice messages
+// par == 0: Notes and CCs on a single cable
+// par == 1: like 0, but with a MIDI clock after each 8th package
+// par == 2: like 0, but the cable is changed after each 4th package
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_Reset(u32 par)
+{
+  int i;
+
+  for(i=0; i<BENCHMARK_NUM_PACKAGES; ++i) {
+    mios32_midi_package_t *p = &pattern[i];
+
+    p->ALL = 0;
+
+    if( par == 1 && (i % 8) == 7 ) {
+      p->type = 0x5; // single byte System Common / Realtime
+      p->evnt0 = 0xf8;
+    } else if( i & 1 ) {
+      p->type = CC;
+      p->evnt0 = 0xb0 | (i & 0xf);
+      p->evnt1 = 0x07;
+      p->evnt2 = i & 0x7f;
+    } else {
+      p->type = NoteOn;
+      p->evnt0 = 0x90 | (i & 0xf);
+      p->evnt1 = 0x3c + (i % 12);
+      p->evnt2 = 0x64;
+    }
+
+    if( par == 2 )
+      p->cable = (i / 4) & 1;
+  }
+
+  BENCHMARK_Init(0);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Previous method: each package is processed by MIOS32_MIDI_ReceivePackage
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_Start_Single(u32 par)
+{
+  int i;
+  mios32_midi_package_t *p = &packages[0];
+
+  memcpy(packages, pattern, sizeof(packages));
+  for(i=0; i<BENCHMARK_NUM_PACKAGES; ++i, ++p)
+    MIOS32_MIDI_ReceivePackage(USB0 + p->cable, *p, BENCHMARK_NotifyPackage);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Block processing with a callback for each package
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_Start_Block(u32 par)
+{
+  memcpy(packages, pattern, sizeof(packages));
+  return MIOS32_MIDI_ReceivePackageBlock(USB0, packages, BENCHMARK_NUM_PACKAGES, BENCHMARK_NotifyPackage);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Block processing with the block callback
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_Start_BlockCallback(u32 par)
+{
+  s32 status;
+
+  memcpy(packages, pattern, sizeof(packages));
+  MIOS32_MIDI_BlockCallback_Init(BENCHMARK_NotifyBlock);
+  status = MIOS32_MIDI_ReceivePackageBlock(USB0, packages, BENCHMARK_NUM_PACKAGES, BENCHMARK_NotifyPackage);
+  MIOS32_MIDI_BlockCallback_Init(NULL);
+
+  return status;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the package pattern which has been prepared by BENCHMARK_Reset()
+/////////////////////////////////////////////////////////////////////////////
+const mios32_midi_package_t *BENCHMARK_PatternGet(void)
+{
+  return pattern;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the number of packages which have been forwarded to the callbacks
+/////////////////////////////////////////////////////////////////////////////
+u32 BENCHMARK_NumReceivedGet(void)
+{
+  return num_received;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the checksum over all packages and ports which have been forwarded
+/////////////////////////////////////////////////////////////////////////////
+u32 BENCHMARK_ChecksumGet(void)
+{
+  return checksum;
+}
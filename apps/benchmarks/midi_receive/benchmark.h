@@ -0,0 +1,54 @@
+// $Id$
+/*
+ * Header file for benchmark routines
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+#ifndef _BENCHMARK_H
+#define _BENCHMARK_H
+
+/////////////////////////////////////////////////////////////////////////////
+// Global definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// number of packages which are processed per loop
+#define BENCHMARK_NUM_PACKAGES 256
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Global Types
+/////////////////////////////////////////////////////////////////////////////
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+extern s32 BENCHMARK_Init(u32 mode);
+
+extern s32 BENCHMARK_Reset(u32 par);
+extern s32 BENCHMARK_Start_Single(u32 par);
+extern s32 BENCHMARK_Start_Block(u32 par);
+extern s32 BENCHMARK_Start_BlockCallback(u32 par);
+
+extern void BENCHMARK_NotifyPackage(mios32_midi_port_t port, mios32_midi_package_t midi_package);
+extern s32 BENCHMARK_NotifyBlock(mios32_midi_port_t port, mios32_midi_package_t *p, u32 num);
+
+extern const mios32_midi_package_t *BENCHMARK_PatternGet(void);
+extern u32 BENCHMARK_NumReceivedGet(void);
+extern u32 BENCHMARK_ChecksumGet(void);
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Export global variables
+/////////////////////////////////////////////////////////////////////////////
+
+
+#endif /* _BENCHMARK_H */
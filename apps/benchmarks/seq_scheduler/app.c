@@ -69,6 +69,7 @@ void APP_Init(void)
   MIOS32_MIDI_SendDebugMessage("Settings:\n");
   MIOS32_MIDI_SendDebugMessage("#define SEQ_MIDI_OUT_MALLOC_METHOD %d\n", SEQ_MIDI_OUT_MALLOC_METHOD);
   MIOS32_MIDI_SendDebugMessage("#define SEQ_MIDI_OUT_MAX_EVENTS %d\n", SEQ_MIDI_OUT_MAX_EVENTS);
+  MIOS32_MIDI_SendDebugMessage("#define SEQ_MIDI_OUT_QUEUE_METHOD %d\n", SEQ_MIDI_OUT_QUEUE_METHOD);
   MIOS32_MIDI_SendDebugMessage("\n");
   MIOS32_MIDI_SendDebugMessage("Play any MIDI note to start the benchmark\n");
 }
@@ -162,6 +163,35 @@ void APP_MIDI_NotifyPackage(mios32_midi_port_t port, mios32_midi_package_t midi_
     else
       MIOS32_MIDI_SendDebugMessage("Time: %5d.%d mS\n", benchmark_cycles/10, benchmark_cycles%10);
 
+    // measure insertion and dispatching of randomly distributed events for different queue sizes
+    u32 num_events;
+    for(num_events=128; num_events<=SEQ_MIDI_OUT_MAX_EVENTS; num_events *= 2) {
+      u32 insert_cycles, drain_cycles;
+      s32 queued;
+
+      BENCHMARK_QueueReset();
+
+      portENTER_CRITICAL(); // port specific FreeRTOS function to disable tasks (nested)
+
+      MIOS32_STOPWATCH_Reset();
+      queued = BENCHMARK_QueueFill(num_events);
+      insert_cycles = MIOS32_STOPWATCH_ValueGet();
+
+      MIOS32_STOPWATCH_Reset();
+      BENCHMARK_QueueDrain();
+      drain_cycles = MIOS32_STOPWATCH_ValueGet();
+
+      portEXIT_CRITICAL(); // port specific FreeRTOS function to enable tasks (nested)
+
+      if( insert_cycles == 0xffffffff || drain_cycles == 0xffffffff )
+	MIOS32_MIDI_SendDebugMessage("Queue %4d events: overrun!\n", queued);
+      else
+	MIOS32_MIDI_SendDebugMessage("Queue %4d events: insert %5d.%d mS, drain %5d.%d mS\n",
+				     queued,
+				     insert_cycles/10, insert_cycles%10,
+				     drain_cycles/10, drain_cycles%10);
+    }
+
     // print status screen
     print_msg = PRINT_MSG_STATUS;
   }
@@ -26,6 +26,22 @@
 #include "mid_file.h"
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// range of ticks over which the events of the queue benchmark are distributed
+// (multiplied with the number of events)
+#define QUEUE_TICKS_PER_EVENT 4
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+static u32 queue_random_seed;
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Local prototypes
 /////////////////////////////////////////////////////////////////////////////
@@ -127,6 +143,94 @@ s32 BENCHMARK_Start(void)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// this function resets the queue benchmark
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_QueueReset(void)
+{
+  // take control over BPM generator (see BENCHMARK_Reset())
+  SEQ_BPM_ModeSet(SEQ_BPM_MODE_Master);
+  SEQ_BPM_Start();
+  SEQ_BPM_ModeSet(SEQ_BPM_MODE_Slave);
+  SEQ_BPM_TickSet(0);
+
+  // empty queue
+  SEQ_MIDI_OUT_FlushQueue();
+
+  // clear MIDI scheduler analysis variables
+  seq_midi_out_allocated = 0;
+  seq_midi_out_max_allocated = 0;
+  seq_midi_out_dropouts = 0;
+
+  // same sequence for each run
+  queue_random_seed = 0x12345678;
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// this function fills the queue with the given number of events
+// the timestamps are randomly distributed, so that each insertion has to
+// search for the appr. position
+// returns the number of queued events
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_QueueFill(u32 num_events)
+{
+  u32 tick_range = num_events * QUEUE_TICKS_PER_EVENT;
+  mios32_midi_package_t midi_package;
+
+  midi_package.type = NoteOn;
+  midi_package.event = NoteOn;
+  midi_package.velocity = 100;
+
+  int i;
+  for(i=0; i<num_events; ++i) {
+    // simple linear congruential generator
+    queue_random_seed = queue_random_seed * 1664525 + 1013904223;
+    u32 timestamp = 1 + (queue_random_seed >> 8) % tick_range;
+
+    // mix of all event types which are queued without an additional Off event
+    // (On events only in each 4th slot so that they are not rejected by the failsafe measure of SEQ_MIDI_OUT_Send())
+    seq_midi_out_event_type_t event_type;
+    switch( i % 4 ) {
+    case 0: event_type = SEQ_MIDI_OUT_OnEvent; break;
+    case 1: event_type = SEQ_MIDI_OUT_CCEvent; break;
+    case 2: event_type = (i % 16 == 2) ? SEQ_MIDI_OUT_ClkEvent : SEQ_MIDI_OUT_OffEvent; break;
+    default: event_type = SEQ_MIDI_OUT_OffEvent;
+    }
+
+    midi_package.cable = i % 16; // tag
+    midi_package.note = i % 128;
+    SEQ_MIDI_OUT_Send(0xff, midi_package, event_type, timestamp, 0);
+  }
+
+  return seq_midi_out_allocated;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// this function plays all queued events
+/////////////////////////////////////////////////////////////////////////////
+s32 BENCHMARK_QueueDrain(void)
+{
+  u32 bpm_tick = 0;
+
+  while( seq_midi_out_allocated ) {
+    // increment tick
+    ++bpm_tick;
+
+    // forward to BPM handler
+    SEQ_BPM_TickSet(bpm_tick);
+
+    // send timestamped MIDI events immediately
+    SEQ_MIDI_OUT_Handler();
+  }
+
+  return 0; // no error
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // called when a MIDI event should be played at a given tick
 /////////////////////////////////////////////////////////////////////////////
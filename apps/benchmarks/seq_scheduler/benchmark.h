@@ -33,6 +33,10 @@ extern s32 BENCHMARK_Init(u32 mode);
 extern s32 BENCHMARK_Reset(void);
 extern s32 BENCHMARK_Start(void);
 
+extern s32 BENCHMARK_QueueReset(void);
+extern s32 BENCHMARK_QueueFill(u32 num_events);
+extern s32 BENCHMARK_QueueDrain(void);
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Export global variables
@@ -27,7 +27,26 @@
 // max number of scheduled events which will allocate memory
 // each event allocates 12 bytes
 // MAX_EVENTS must be a power of two! (e.g. 64, 128, 256, 512, ...)
-#define SEQ_MIDI_OUT_MAX_EVENTS 128
+// the queue benchmark is executed for 128..SEQ_MIDI_OUT_MAX_EVENTS events
+#if defined(MIOS32_FAMILY_STM32F4xx)
+#define SEQ_MIDI_OUT_MAX_EVENTS 4096
+#define MIOS32_HEAP_SIZE 70*1024
+#else
+#define SEQ_MIDI_OUT_MAX_EVENTS 256
+#endif
+
+// queue method:
+// 0: single linked list, sorted by timestamp
+// 1: hierarchical timing wheel
+// can be selected without changing this file with:
+//   make cleanall; make C_DEFINES="-D SEQ_MIDI_OUT_QUEUE_METHOD=1"
+#ifndef SEQ_MIDI_OUT_QUEUE_METHOD
+#define SEQ_MIDI_OUT_QUEUE_METHOD 0
+#endif
+
+// the benchmark doesn't re-schedule events, and for 4096 events the
+// tag index would allocate 48k additional RAM
+#define SEQ_MIDI_OUT_TAG_INDEX 0
 
 // enable seq_midi_out_max_allocated and seq_midi_out_dropouts
 #define SEQ_MIDI_OUT_MALLOC_ANALYSIS 1
@@ -244,6 +244,7 @@ s32 PRESETS_Init(u32 mode)
 	n->dst_chn  = (cfg2 >> 8) & 0xff;
       }
     }
+    MIDI_ROUTER_NodesChanged();
   }
 
   return 0; // no error
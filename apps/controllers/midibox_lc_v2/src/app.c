@@ -160,6 +160,7 @@ void APP_Init(void)
 	n->dst_port = ncfg->dst_port;
 	n->dst_chn = ncfg->dst_chn;
   }
+  MIDI_ROUTER_NodesChanged();
 
   // init terminal
   TERMINAL_Init(0);
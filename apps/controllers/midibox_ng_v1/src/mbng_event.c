@@ -129,6 +129,32 @@ static u16 event_pool_maps_begin;
 static u16 event_pool_num_items;
 static u16 event_pool_num_maps;
 
+// search index: pool offsets of all items, sorted by id resp. hw_id (and pool order for identical ids)
+// the ids are read from the pool items, so that each index only costs 2 bytes per item
+// a pool item takes at least 32 bytes, so this is the max. number of items which could be stored
+#ifndef MBNG_EVENT_POOL_INDEX_MAX_ITEMS
+#define MBNG_EVENT_POOL_INDEX_MAX_ITEMS (MBNG_EVENT_POOL_MAX_SIZE / 32)
+#endif
+static u16 AHB_SECTION event_pool_id_index[MBNG_EVENT_POOL_INDEX_MAX_ITEMS];
+static u16 AHB_SECTION event_pool_hw_id_index[MBNG_EVENT_POOL_INDEX_MAX_ITEMS];
+static u8 event_pool_index_valid;
+
+// MIDI receive dispatch table: pool offsets of all items which can receive MIDI events,
+// bucketed by the status byte (first stream byte) and sorted by the key byte within a bucket
+// (data1 of Note/PolyPressure/CC events, RX_KEY_ANY for items which have to be checked on any data1,
+// RX_KEY_NRPN for NRPN items, which are additionally sorted by the NRPN address)
+// and pool order for identical keys
+#define MBNG_EVENT_RX_KEY_ANY   0x80
+#define MBNG_EVENT_RX_KEY_NRPN  0x81
+#define MBNG_EVENT_RX_KEY_NONE  0xff // item doesn't receive MIDI events
+static u16 AHB_SECTION event_pool_rx_offset[MBNG_EVENT_POOL_INDEX_MAX_ITEMS];
+static u8 AHB_SECTION event_pool_rx_key[MBNG_EVENT_POOL_INDEX_MAX_ITEMS];
+static u16 event_pool_rx_bucket_begin[128+1]; // for status 0x80..0xff
+
+// continue_ix of indexed searches: flag + position in index
+// (a linear search stores the item number in the upper half, which never reaches this flag)
+#define MBNG_EVENT_POOL_INDEX_CONTINUE_FLAG 0x80000000
+
 // last active event
 mbng_event_item_id_t last_event_item_id;
 
@@ -185,6 +211,13 @@ static u8 lc_meters[LC_METERS_NUM_PORTS][LC_METERS_NUM_ITEMS];
 static s32 MBNG_EVENT_ItemCopy2User(mbng_event_pool_item_t* pool_item, mbng_event_item_t *item);
 static s32 MBNG_EVENT_ItemCopy2Pool(mbng_event_item_t *item, mbng_event_pool_item_t* pool_item);
 
+static s32 MBNG_EVENT_PoolIndexBuild(void);
+static u8 MBNG_EVENT_RxKeyGet(mbng_event_pool_item_t *pool_item);
+static u16 MBNG_EVENT_RxNrpnAddressGet(mbng_event_pool_item_t *pool_item);
+static u32 MBNG_EVENT_RxLowerBound(u32 begin, u32 end, u8 key, u32 nrpn_address);
+static s32 MBNG_EVENT_MIDI_NotifyPoolItem(mbng_event_pool_item_t *pool_item, u32 port_mask, mios32_midi_package_t midi_package, u16 nrpn_address, u16 nrpn_value, u8 nrpn_msb_only);
+static s32 MBNG_EVENT_ItemSearchIndexed(u8 by_hw_id, mbng_event_item_id_t id, mbng_event_item_id_t id_end_range, mbng_event_item_t *item, u32 *continue_ix);
+
 static s32 MBNG_EVENT_LCMeters_Update(void);
 static s32 MBNG_EVENT_LCMeters_Set(u8 port_ix, u8 lc_meter_value);
 static s32 MBNG_EVENT_LCMeters_Tick(void);
@@ -370,6 +403,7 @@ s32 MBNG_EVENT_PoolClear(void)
   event_pool_maps_begin = 0;
   event_pool_num_items = 0;
   event_pool_num_maps = 0;
+  event_pool_index_valid = 0;
 
   last_event_item_id = 0;
 
@@ -406,10 +440,250 @@ s32 MBNG_EVENT_PoolUpdate(void)
     pool_ptr += pool_item->len;
   }
 
+  // build search index
+  MBNG_EVENT_PoolIndexBuild();
+
   return 0; // no error
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! Help function: returns the id or hw_id of the pool item at the given offset
+/////////////////////////////////////////////////////////////////////////////
+static inline u16 MBNG_EVENT_PoolIndexKey(u8 by_hw_id, u16 pool_offset)
+{
+  mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[pool_offset];
+  return by_hw_id ? pool_item->hw_id : pool_item->id;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Help function: returns the first index position with a key >= the given key
+/////////////////////////////////////////////////////////////////////////////
+static u32 MBNG_EVENT_PoolIndexLowerBound(u8 by_hw_id, u32 key, u32 num_entries)
+{
+  u16 *index = by_hw_id ? event_pool_hw_id_index : event_pool_id_index;
+  u32 lo = 0;
+  u32 hi = num_entries;
+
+  while( lo < hi ) {
+    u32 mid = (lo + hi) / 2;
+    if( MBNG_EVENT_PoolIndexKey(by_hw_id, index[mid]) < key )
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Builds the id and hw_id search index of the event pool\n
+//! Called from \ref MBNG_EVENT_PoolUpdate after a new file has been loaded
+//! \returns -1 if the pool contains too many items, searches will be done
+//! linear in this case
+/////////////////////////////////////////////////////////////////////////////
+static s32 MBNG_EVENT_PoolIndexBuild(void)
+{
+  event_pool_index_valid = 0;
+
+  if( event_pool_num_items > MBNG_EVENT_POOL_INDEX_MAX_ITEMS )
+    return -1; // too many items
+
+  // binary insertion in pool order, so that items with the same id keep their order
+  // (ids are normally already sorted in .NGC files, so that entries rarely have to be moved)
+  u16 pool_offset = 0;
+  u32 i;
+  for(i=0; i<event_pool_num_items; ++i) {
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[pool_offset];
+
+    u8 by_hw_id;
+    for(by_hw_id=0; by_hw_id<2; ++by_hw_id) {
+      u16 *index = by_hw_id ? event_pool_hw_id_index : event_pool_id_index;
+      u16 key = by_hw_id ? pool_item->hw_id : pool_item->id;
+      u32 pos = MBNG_EVENT_PoolIndexLowerBound(by_hw_id, (u32)key + 1, i); // behind all entries with the same key
+      if( pos < i )
+	memmove(&index[pos+1], &index[pos], (i-pos)*sizeof(u16));
+      index[pos] = pool_offset;
+    }
+
+    pool_offset += pool_item->len;
+  }
+
+  // MIDI receive dispatch table
+  // count items per status byte bucket, and determine the bucket begins
+  u32 bucket;
+  for(bucket=0; bucket<=128; ++bucket)
+    event_pool_rx_bucket_begin[bucket] = 0;
+
+  pool_offset = 0;
+  for(i=0; i<event_pool_num_items; ++i) {
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[pool_offset];
+    if( MBNG_EVENT_RxKeyGet(pool_item) != MBNG_EVENT_RX_KEY_NONE )
+      ++event_pool_rx_bucket_begin[(pool_item->data_begin & 0x7f) + 1];
+    pool_offset += pool_item->len;
+  }
+
+  for(bucket=1; bucket<=128; ++bucket)
+    event_pool_rx_bucket_begin[bucket] += event_pool_rx_bucket_begin[bucket-1];
+
+  // place items in pool order into their bucket
+  // bucket_begin[bucket+1] is used as fill pointer meanwhile: it starts at the begin of the bucket and ends at the begin of the next bucket
+  for(bucket=128; bucket>=1; --bucket)
+    event_pool_rx_bucket_begin[bucket] = event_pool_rx_bucket_begin[bucket-1];
+
+  pool_offset = 0;
+  for(i=0; i<event_pool_num_items; ++i) {
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[pool_offset];
+    u8 key = MBNG_EVENT_RxKeyGet(pool_item);
+
+    if( key != MBNG_EVENT_RX_KEY_NONE ) {
+      u32 pos = event_pool_rx_bucket_begin[(pool_item->data_begin & 0x7f) + 1]++;
+      event_pool_rx_offset[pos] = pool_offset;
+      event_pool_rx_key[pos] = key;
+    }
+
+    pool_offset += pool_item->len;
+  }
+
+  // sort each bucket by key (and NRPN address) - insertion sort keeps the pool order of identical keys
+  for(bucket=0; bucket<128; ++bucket) {
+    u32 begin = event_pool_rx_bucket_begin[bucket];
+    u32 end = event_pool_rx_bucket_begin[bucket+1];
+    u32 j;
+    for(j=begin+1; j<end; ++j) {
+      u16 offset = event_pool_rx_offset[j];
+      u8 key = event_pool_rx_key[j];
+      u32 pos; // behind all entries with the same key (and NRPN address)
+      if( key == MBNG_EVENT_RX_KEY_NRPN ) {
+	u16 address = MBNG_EVENT_RxNrpnAddressGet((mbng_event_pool_item_t *)&event_pool[offset]);
+	pos = MBNG_EVENT_RxLowerBound(begin, j, key, (u32)address + 1);
+      } else {
+	pos = MBNG_EVENT_RxLowerBound(begin, j, key + 1, 0);
+      }
+
+      if( pos < j ) {
+	memmove(&event_pool_rx_offset[pos+1], &event_pool_rx_offset[pos], (j-pos)*sizeof(u16));
+	memmove(&event_pool_rx_key[pos+1], &event_pool_rx_key[pos], (j-pos)*sizeof(u8));
+	event_pool_rx_offset[pos] = offset;
+	event_pool_rx_key[pos] = key;
+      }
+    }
+  }
+
+  event_pool_index_valid = 1;
+
+  return 0; // no error
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Help function: returns the key of an item in the MIDI receive dispatch table
+//! \returns MBNG_EVENT_RX_KEY_NONE if the item doesn't receive MIDI events
+/////////////////////////////////////////////////////////////////////////////
+static u8 MBNG_EVENT_RxKeyGet(mbng_event_pool_item_t *pool_item)
+{
+  if( !pool_item->len_stream || pool_item->data_begin < 0x80 )
+    return MBNG_EVENT_RX_KEY_NONE;
+
+  u8 *stream = &pool_item->data_begin;
+  mbng_event_type_t event_type = ((mbng_event_flags_t)pool_item->flags).type;
+  if( event_type <= MBNG_EVENT_TYPE_CC ) {
+    // button/led matrices are also notified on the following keys
+    if( pool_item->flags.use_any_key_or_cc || pool_item->len_stream < 2 ||
+	(pool_item->hw_id & 0xf000) == MBNG_EVENT_CONTROLLER_BUTTON_MATRIX ||
+	(pool_item->hw_id & 0xf000) == MBNG_EVENT_CONTROLLER_LED_MATRIX )
+      return MBNG_EVENT_RX_KEY_ANY;
+    return stream[1] & 0x7f;
+  } else if( event_type <= MBNG_EVENT_TYPE_PITCHBEND ) {
+    return MBNG_EVENT_RX_KEY_ANY;
+  } else if( event_type == MBNG_EVENT_TYPE_NRPN ) {
+    return MBNG_EVENT_RX_KEY_NRPN;
+  } else if( event_type >= MBNG_EVENT_TYPE_CLOCK && event_type <= MBNG_EVENT_TYPE_CONT ) {
+    return MBNG_EVENT_RX_KEY_ANY;
+  }
+
+  return MBNG_EVENT_RX_KEY_NONE;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Help function: returns the expected NRPN address of a NRPN item
+/////////////////////////////////////////////////////////////////////////////
+static u16 MBNG_EVENT_RxNrpnAddressGet(mbng_event_pool_item_t *pool_item)
+{
+  u8 *stream = &pool_item->data_begin;
+  return stream[1] | ((u16)stream[2] << 7); // same like in MBNG_EVENT_MIDI_NotifyPoolItem()
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Help function: returns the first position in a MIDI receive dispatch table bucket
+//! with a key (and NRPN address) >= the given values
+/////////////////////////////////////////////////////////////////////////////
+static u32 MBNG_EVENT_RxLowerBound(u32 begin, u32 end, u8 key, u32 nrpn_address)
+{
+  while( begin < end ) {
+    u32 mid = (begin + end) / 2;
+    u8 mid_key = event_pool_rx_key[mid];
+    u8 less = mid_key < key;
+
+    if( mid_key == key && key == MBNG_EVENT_RX_KEY_NRPN ) {
+      mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[event_pool_rx_offset[mid]];
+      less = MBNG_EVENT_RxNrpnAddressGet(pool_item) < nrpn_address;
+    }
+
+    if( less )
+      begin = mid + 1;
+    else
+      end = mid;
+  }
+
+  return begin;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Help function: search an item with the id or hw_id index
+//! Items with the same id are returned in pool order, id ranges are returned
+//! in the order of the ids.
+//! \returns 0 and copies item into *item if found
+//! \returns -1 if item not found
+/////////////////////////////////////////////////////////////////////////////
+static s32 MBNG_EVENT_ItemSearchIndexed(u8 by_hw_id, mbng_event_item_id_t id, mbng_event_item_id_t id_end_range, mbng_event_item_t *item, u32 *continue_ix)
+{
+  u16 *index = by_hw_id ? event_pool_hw_id_index : event_pool_id_index;
+  u16 id_end = id_end_range ? id_end_range : id;
+  u32 pos;
+
+  if( *continue_ix ) {
+    pos = *continue_ix & ~MBNG_EVENT_POOL_INDEX_CONTINUE_FLAG;
+  } else {
+    pos = MBNG_EVENT_PoolIndexLowerBound(by_hw_id, id, event_pool_num_items);
+  }
+
+  for(; pos<event_pool_num_items; ++pos) {
+    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[index[pos]];
+    u16 key = by_hw_id ? pool_item->hw_id : pool_item->id;
+
+    if( key < id || key > id_end )
+      break; // no further matching item
+
+    if( by_hw_id && !pool_item->flags.active )
+      continue; // only active items are returned on hw_id searches
+
+    MBNG_EVENT_ItemCopy2User(pool_item, item);
+
+    // pass next index position in continue_ix for continued search
+    // skip this if no further item with matching id exists
+    u32 next_pos = pos + 1;
+    if( next_pos >= event_pool_num_items || MBNG_EVENT_PoolIndexKey(by_hw_id, index[next_pos]) > id_end )
+      *continue_ix = 0;
+    else
+      *continue_ix = MBNG_EVENT_POOL_INDEX_CONTINUE_FLAG | next_pos;
+
+    return 0; // item found
+  }
+
+  return -1; // not found
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Sends the event pool to debug terminal
 /////////////////////////////////////////////////////////////////////////////
@@ -1427,6 +1701,10 @@ s32 MBNG_EVENT_ItemAdd(mbng_event_item_t *item)
   ++event_pool_num_items;
   event_pool_maps_begin += pool_item_len;
 
+  // index will be rebuilt by MBNG_EVENT_PoolUpdate() (after a file has been loaded)
+  // or MBNG_EVENT_PoolIndexBuild() (after MIDI learn)
+  event_pool_index_valid = 0;
+
   return 0; // no error
 }
 
@@ -1443,6 +1721,10 @@ s32 MBNG_EVENT_ItemModify(mbng_event_item_t *item)
     if( pool_item->id == item->id ) {
       u32 label_len = item->label ? (strlen(item->label)+1) : 0;
       u32 pool_item_len = MBNG_EVENT_ItemCalcPoolItemLen(item);
+      u16 prev_hw_id = pool_item->hw_id;
+      u8 prev_rx_status = pool_item->len_stream ? pool_item->data_begin : 0;
+      u8 prev_rx_key = MBNG_EVENT_RxKeyGet(pool_item);
+      u16 prev_rx_nrpn_address = MBNG_EVENT_RxNrpnAddressGet(pool_item);
 
       if( pool_item_len > 255 )
 	return -2; // too much data
@@ -1480,11 +1762,35 @@ s32 MBNG_EVENT_ItemModify(mbng_event_item_t *item)
 	// change event pool size and move map pointer
 	event_pool_size += len_diff;
 	event_pool_maps_begin += len_diff;
+
+	// move the index entries of all following items (their order doesn't change)
+	if( event_pool_index_valid ) {
+	  u16 pool_offset = (u32)pool_item - (u32)event_pool;
+	  u32 j;
+	  for(j=0; j<event_pool_num_items; ++j) {
+	    if( event_pool_id_index[j] > pool_offset )
+	      event_pool_id_index[j] += len_diff;
+	    if( event_pool_hw_id_index[j] > pool_offset )
+	      event_pool_hw_id_index[j] += len_diff;
+	  }
+	  for(j=0; j<event_pool_rx_bucket_begin[128]; ++j) {
+	    if( event_pool_rx_offset[j] > pool_offset )
+	      event_pool_rx_offset[j] += len_diff;
+	  }
+	}
       } else {
 	// no size change - copy new item directly into pool
 	MBNG_EVENT_ItemCopy2Pool(item, pool_item);
       }
 
+      // hw_id index and MIDI receive dispatch table have to be sorted again if the hw_id or the MIDI event has been changed
+      if( event_pool_index_valid &&
+	  (pool_item->hw_id != prev_hw_id ||
+	   (pool_item->len_stream ? pool_item->data_begin : 0) != prev_rx_status ||
+	   MBNG_EVENT_RxKeyGet(pool_item) != prev_rx_key ||
+	   MBNG_EVENT_RxNrpnAddressGet(pool_item) != prev_rx_nrpn_address) )
+	MBNG_EVENT_PoolIndexBuild();
+
       return 0; // operation was successfull
     }
     pool_ptr += pool_item->len;
@@ -1500,6 +1806,12 @@ s32 MBNG_EVENT_ItemModify(mbng_event_item_t *item)
 /////////////////////////////////////////////////////////////////////////////
 s32 MBNG_EVENT_ItemSearchById(mbng_event_item_id_t id, mbng_event_item_id_t id_end_range, mbng_event_item_t *item, u32 *continue_ix)
 {
+  if( event_pool_index_valid )
+    return MBNG_EVENT_ItemSearchIndexed(0, id, id_end_range, item, continue_ix);
+
+  if( *continue_ix & MBNG_EVENT_POOL_INDEX_CONTINUE_FLAG )
+    return -1; // index has been invalidated during an indexed search
+
   u8 *pool_ptr = (u8 *)&event_pool[0];
   u32 i = 0;
 
@@ -1542,6 +1854,12 @@ s32 MBNG_EVENT_ItemSearchById(mbng_event_item_id_t id, mbng_event_item_id_t id_e
 /////////////////////////////////////////////////////////////////////////////
 s32 MBNG_EVENT_ItemSearchByHwId(mbng_event_item_id_t hw_id, mbng_event_item_id_t hw_id_end_range, mbng_event_item_t *item, u32 *continue_ix)
 {
+  if( event_pool_index_valid )
+    return MBNG_EVENT_ItemSearchIndexed(1, hw_id, hw_id_end_range, item, continue_ix);
+
+  if( *continue_ix & MBNG_EVENT_POOL_INDEX_CONTINUE_FLAG )
+    return -1; // index has been invalidated during an indexed search
+
   u8 *pool_ptr = (u8 *)&event_pool[0];
   u32 i = 0;
 
@@ -2354,6 +2672,10 @@ s32 MBNG_EVENT_MidiLearnIt(mbng_event_item_id_t hw_id)
       MBNG_EVENT_MidiLearnModeSet(0); // disable learn mode
       return -3; // out of memory...
     }
+
+    // the index has been invalidated by MBNG_EVENT_ItemAdd()
+    MBNG_EVENT_PoolIndexBuild();
+
     if( debug_verbose_level >= DEBUG_VERBOSE_LEVEL_INFO ) {
       DEBUG_MSG("[MIDI_LEARN] item id=%s:%d has been created.\n", MBNG_EVENT_ItemControllerStrGet(id), id & 0xfff);
     }
@@ -4664,107 +4986,165 @@ s32 MBNG_EVENT_MIDI_NotifyPackage(mios32_midi_port_t port, mios32_midi_package_t
   }
 
   // search in pool for matching events
-  u8 evnt0 = midi_package.evnt0;
-  u8 evnt1 = midi_package.evnt1;
-  u8 *pool_ptr = (u8 *)&event_pool[0];
-  u32 i;
-  for(i=0; i<event_pool_num_items; ++i) {
-    mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)pool_ptr;
-    if( pool_item->data_begin == evnt0 && pool_item->len_stream ) { // timing critical
-      // first byte is matching - now we've a bit more time for checking
-      
-      if( (pool_item->hw_id & 0xf000) == MBNG_EVENT_CONTROLLER_SENDER ) { // a sender doesn't receive
-	pool_ptr += pool_item->len;
-	continue;
+  if( event_pool_index_valid ) {
+    // with the MIDI receive dispatch table
+    if( midi_package.evnt0 < 0x80 )
+      return 0; // no status byte
+
+    u32 bucket = midi_package.evnt0 & 0x7f;
+    u32 begin = event_pool_rx_bucket_begin[bucket];
+    u32 end = event_pool_rx_bucket_begin[bucket+1];
+
+    // up to three ranges have to be notified: matching key, any key and matching NRPN address
+    u32 range_pos[3];
+    u32 range_end[3];
+
+    if( midi_package.evnt1 < 0x80 ) {
+      range_pos[0] = MBNG_EVENT_RxLowerBound(begin, end, midi_package.evnt1, 0);
+      range_end[0] = MBNG_EVENT_RxLowerBound(range_pos[0], end, midi_package.evnt1 + 1, 0);
+    } else {
+      range_pos[0] = range_end[0] = begin;
+    }
+
+    range_pos[1] = MBNG_EVENT_RxLowerBound(begin, end, MBNG_EVENT_RX_KEY_ANY, 0);
+    range_end[1] = MBNG_EVENT_RxLowerBound(range_pos[1], end, MBNG_EVENT_RX_KEY_ANY + 1, 0);
+
+    if( nrpn_address != 0xffff ) {
+      range_pos[2] = MBNG_EVENT_RxLowerBound(range_end[1], end, MBNG_EVENT_RX_KEY_NRPN, nrpn_address);
+      range_end[2] = MBNG_EVENT_RxLowerBound(range_pos[2], end, MBNG_EVENT_RX_KEY_NRPN, (u32)nrpn_address + 1);
+    } else {
+      range_pos[2] = range_end[2] = begin;
+    }
+
+    // notify items in pool order
+    while( 1 ) {
+      int next_range = -1;
+      u16 next_offset = 0xffff;
+      int range;
+      for(range=0; range<3; ++range) {
+	if( range_pos[range] < range_end[range] && event_pool_rx_offset[range_pos[range]] <= next_offset ) {
+	  next_offset = event_pool_rx_offset[range_pos[range]];
+	  next_range = range;
+	}
       }
 
-      if( !(pool_item->enabled_ports & port_mask) ) { // port not enabled
-	pool_ptr += pool_item->len;
-	continue;
+      if( next_range < 0 )
+	break; // all items notified
+
+      ++range_pos[next_range];
+      mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)&event_pool[next_offset];
+      MBNG_EVENT_MIDI_NotifyPoolItem(pool_item, port_mask, midi_package, nrpn_address, nrpn_value, nrpn_msb_only);
+    }
+  } else {
+    // linear search
+    u8 evnt0 = midi_package.evnt0;
+    u8 *pool_ptr = (u8 *)&event_pool[0];
+    u32 i;
+    for(i=0; i<event_pool_num_items; ++i) {
+      mbng_event_pool_item_t *pool_item = (mbng_event_pool_item_t *)pool_ptr;
+      if( pool_item->data_begin == evnt0 && pool_item->len_stream ) { // timing critical
+	MBNG_EVENT_MIDI_NotifyPoolItem(pool_item, port_mask, midi_package, nrpn_address, nrpn_value, nrpn_msb_only);
       }
+      pool_ptr += pool_item->len;
+    }
+  }
 
-      mbng_event_type_t event_type = ((mbng_event_flags_t)pool_item->flags).type;
-      if( event_type <= MBNG_EVENT_TYPE_CC ) {
-	u8 *stream = &pool_item->data_begin;
-	if( pool_item->flags.use_any_key_or_cc || stream[1] == evnt1 ) { // || pool_item->secondary_value >= 128 || evnt1 == pool_item->secondary_value ) {
-	  mbng_event_item_t item;
-	  MBNG_EVENT_ItemCopy2User(pool_item, &item);
-	  if( item.flags.use_key_or_cc ) {
-	    item.secondary_value = midi_package.value;
-	    MBNG_EVENT_ItemReceive(&item, midi_package.evnt1, 1, 1);
-	  } else {
-	    item.secondary_value = midi_package.evnt1;
-	    MBNG_EVENT_ItemReceive(&item, midi_package.value, 1, 1);
-	  }
-	} else {
-	  // EXTRA for button/led matrices
-	  int matrix = (pool_item->hw_id & 0x0fff) - 1;
-	  int num_pins = -1;
-
-	  switch( pool_item->hw_id & 0xf000 ) {
-	  case MBNG_EVENT_CONTROLLER_BUTTON_MATRIX: {
-	    if( matrix >= 0 && matrix < MBNG_PATCH_NUM_MATRIX_DIN ) {
-	      mbng_patch_matrix_din_entry_t *m = (mbng_patch_matrix_din_entry_t *)&mbng_patch_matrix_din[matrix];
-
-	      if( m->sr_din1 ) {
-		u8 row_size = m->sr_din2 ? 16 : 8;
-		num_pins = row_size * row_size;
-	      }
-	    }
-	  } break;
-	  case MBNG_EVENT_CONTROLLER_LED_MATRIX: {
-	    if( matrix >= 0 && matrix < MBNG_PATCH_NUM_MATRIX_DOUT ) {
-	      mbng_patch_matrix_dout_entry_t *m = (mbng_patch_matrix_dout_entry_t *)&mbng_patch_matrix_dout[matrix];
-
-	      if( m->sr_dout_r1 && !pool_item->flags.led_matrix_pattern ) {
-		u8 row_size = m->sr_dout_r2 ? 16 : 8; // we assume that the same condition is valid for dout_g2 and dout_b2
-		num_pins = row_size * row_size;
-	      }
-	    }
-	  } break;
+  return 0; // no error
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Help function: notifies a pool item about a received MIDI event
+//! The first stream byte has already been matched with the status byte
+/////////////////////////////////////////////////////////////////////////////
+static s32 MBNG_EVENT_MIDI_NotifyPoolItem(mbng_event_pool_item_t *pool_item, u32 port_mask, mios32_midi_package_t midi_package, u16 nrpn_address, u16 nrpn_value, u8 nrpn_msb_only)
+{
+  u8 evnt1 = midi_package.evnt1;
+
+  if( (pool_item->hw_id & 0xf000) == MBNG_EVENT_CONTROLLER_SENDER ) // a sender doesn't receive
+    return 0;
+
+  if( !(pool_item->enabled_ports & port_mask) ) // port not enabled
+    return 0;
+
+  mbng_event_type_t event_type = ((mbng_event_flags_t)pool_item->flags).type;
+  if( event_type <= MBNG_EVENT_TYPE_CC ) {
+    u8 *stream = &pool_item->data_begin;
+    if( pool_item->flags.use_any_key_or_cc || stream[1] == evnt1 ) { // || pool_item->secondary_value >= 128 || evnt1 == pool_item->secondary_value ) {
+      mbng_event_item_t item;
+      MBNG_EVENT_ItemCopy2User(pool_item, &item);
+      if( item.flags.use_key_or_cc ) {
+	item.secondary_value = midi_package.value;
+	MBNG_EVENT_ItemReceive(&item, midi_package.evnt1, 1, 1);
+      } else {
+	item.secondary_value = midi_package.evnt1;
+	MBNG_EVENT_ItemReceive(&item, midi_package.value, 1, 1);
+      }
+    } else {
+      // EXTRA for button/led matrices
+      int matrix = (pool_item->hw_id & 0x0fff) - 1;
+      int num_pins = -1;
+
+      switch( pool_item->hw_id & 0xf000 ) {
+      case MBNG_EVENT_CONTROLLER_BUTTON_MATRIX: {
+	if( matrix >= 0 && matrix < MBNG_PATCH_NUM_MATRIX_DIN ) {
+	  mbng_patch_matrix_din_entry_t *m = (mbng_patch_matrix_din_entry_t *)&mbng_patch_matrix_din[matrix];
+
+	  if( m->sr_din1 ) {
+	    u8 row_size = m->sr_din2 ? 16 : 8;
+	    num_pins = row_size * row_size;
 	  }
+	}
+      } break;
+      case MBNG_EVENT_CONTROLLER_LED_MATRIX: {
+	if( matrix >= 0 && matrix < MBNG_PATCH_NUM_MATRIX_DOUT ) {
+	  mbng_patch_matrix_dout_entry_t *m = (mbng_patch_matrix_dout_entry_t *)&mbng_patch_matrix_dout[matrix];
 
-	  if( num_pins >= 0 ) {
-	    int first_evnt1 = stream[1];
-	    if( evnt1 >= first_evnt1 && evnt1 < (first_evnt1 + num_pins) ) {
-	      mbng_event_item_t item;
-	      MBNG_EVENT_ItemCopy2User(pool_item, &item);
-	      item.matrix_pin = evnt1 - first_evnt1;
-	      MBNG_EVENT_ItemReceive(&item, midi_package.value, 1, 1);
-	    }
+	  if( m->sr_dout_r1 && !pool_item->flags.led_matrix_pattern ) {
+	    u8 row_size = m->sr_dout_r2 ? 16 : 8; // we assume that the same condition is valid for dout_g2 and dout_b2
+	    num_pins = row_size * row_size;
 	  }
 	}
-      } else if( event_type <= MBNG_EVENT_TYPE_AFTERTOUCH ) {
-	mbng_event_item_t item;
-	MBNG_EVENT_ItemCopy2User(pool_item, &item);
-	MBNG_EVENT_ItemReceive(&item, evnt1, 1, 1);
-      } else if( event_type == MBNG_EVENT_TYPE_PITCHBEND ) {
-	mbng_event_item_t item;
-	MBNG_EVENT_ItemCopy2User(pool_item, &item);
-	MBNG_EVENT_ItemReceive(&item, evnt1 | ((u16)midi_package.value << 7), 1, 1);
-      } else if( event_type == MBNG_EVENT_TYPE_NRPN ) {
-	u8 *stream = &pool_item->data_begin;
-	u16 expected_address = stream[1] | ((u16)stream[2] << 7);
-	mbng_event_nrpn_format_t nrpn_format = stream[3];
-	if( nrpn_address == expected_address &&
-	    (!nrpn_msb_only || nrpn_format == MBNG_EVENT_NRPN_FORMAT_MSB_ONLY) ) {
+      } break;
+      }
+
+      if( num_pins >= 0 ) {
+	int first_evnt1 = stream[1];
+	if( evnt1 >= first_evnt1 && evnt1 < (first_evnt1 + num_pins) ) {
 	  mbng_event_item_t item;
 	  MBNG_EVENT_ItemCopy2User(pool_item, &item);
-
-	  if( nrpn_format == MBNG_EVENT_NRPN_FORMAT_MSB_ONLY )
-	    MBNG_EVENT_ItemReceive(&item, nrpn_value / 128, 1, 1);
-	  else
-	    MBNG_EVENT_ItemReceive(&item, nrpn_value, 1, 1);
+	  item.matrix_pin = evnt1 - first_evnt1;
+	  MBNG_EVENT_ItemReceive(&item, midi_package.value, 1, 1);
 	}
-      } else if( event_type >= MBNG_EVENT_TYPE_CLOCK && event_type <= MBNG_EVENT_TYPE_CONT ) {
-	mbng_event_item_t item;
-	MBNG_EVENT_ItemCopy2User(pool_item, &item);
-	MBNG_EVENT_ItemReceive(&item, 0, 1, 1);
-      } else {
-	// no additional event types yet...
       }
     }
-    pool_ptr += pool_item->len;
+  } else if( event_type <= MBNG_EVENT_TYPE_AFTERTOUCH ) {
+    mbng_event_item_t item;
+    MBNG_EVENT_ItemCopy2User(pool_item, &item);
+    MBNG_EVENT_ItemReceive(&item, evnt1, 1, 1);
+  } else if( event_type == MBNG_EVENT_TYPE_PITCHBEND ) {
+    mbng_event_item_t item;
+    MBNG_EVENT_ItemCopy2User(pool_item, &item);
+    MBNG_EVENT_ItemReceive(&item, evnt1 | ((u16)midi_package.value << 7), 1, 1);
+  } else if( event_type == MBNG_EVENT_TYPE_NRPN ) {
+    u8 *stream = &pool_item->data_begin;
+    u16 expected_address = stream[1] | ((u16)stream[2] << 7);
+    mbng_event_nrpn_format_t nrpn_format = stream[3];
+    if( nrpn_address == expected_address &&
+	(!nrpn_msb_only || nrpn_format == MBNG_EVENT_NRPN_FORMAT_MSB_ONLY) ) {
+      mbng_event_item_t item;
+      MBNG_EVENT_ItemCopy2User(pool_item, &item);
+
+      if( nrpn_format == MBNG_EVENT_NRPN_FORMAT_MSB_ONLY )
+	MBNG_EVENT_ItemReceive(&item, nrpn_value / 128, 1, 1);
+      else
+	MBNG_EVENT_ItemReceive(&item, nrpn_value, 1, 1);
+    }
+  } else if( event_type >= MBNG_EVENT_TYPE_CLOCK && event_type <= MBNG_EVENT_TYPE_CONT ) {
+    mbng_event_item_t item;
+    MBNG_EVENT_ItemCopy2User(pool_item, &item);
+    MBNG_EVENT_ItemReceive(&item, 0, 1, 1);
+  } else {
+    // no additional event types yet...
   }
 
   return 0; // no error
@@ -192,6 +192,15 @@ extern void APP_MUTEX_MIDIIN_Give(void);
 #define UIP_TASK_MUTEX_MIDIIN_TAKE  { APP_MUTEX_MIDIIN_Take(); }
 #define UIP_TASK_MUTEX_MIDIIN_GIVE  { APP_MUTEX_MIDIIN_Give(); }
 
+// output rings for the MIDI router and SEQ_MIDI_OUT: packages are queued without
+// taking the MIDI OUT mutex, and forwarded in bursts (16 packages per port, ~2k RAM)
+// only for STM32F4, the RAM of LPC17 is used by the event pool
+#if defined(MIOS32_FAMILY_STM32F4xx)
+#define MIOS32_MIDI_OUT_RING_SIZE 16
+#define MIOS32_MIDI_OUT_RING_MUTEX_TAKE { APP_MUTEX_MIDIOUT_Take(); }
+#define MIOS32_MIDI_OUT_RING_MUTEX_GIVE { APP_MUTEX_MIDIOUT_Give(); }
+#endif
+
 // Mutex for J16 access
 extern void APP_J16SemaphoreTake(void);
 extern void APP_J16SemaphoreGive(void);
@@ -466,6 +466,10 @@ s32 TERMINAL_ParseLine(char *input, void *_output_function)
       } else {
 	u8 got_first_event_item = 0;
 	MBNG_FILE_C_Parser(0, brkt, &got_first_event_item);
+	if( got_first_event_item ) {
+	  // post-processing step like after loading a file
+	  MBNG_EVENT_PoolUpdate();
+	}
 	out("Executed command.");
       }
     } else if( strcmp(parameter, "save") == 0 ) {
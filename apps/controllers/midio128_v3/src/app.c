@@ -151,6 +151,9 @@ void APP_Init(void)
   // install SysEx callback
   MIOS32_MIDI_SysExCallback_Init(APP_SYSEX_Parser);
 
+  // install callback for runs of received channel voice messages
+  MIOS32_MIDI_BlockCallback_Init(APP_MIDI_NotifyBlock);
+
   // install MIDI Rx/Tx callback functions
   MIOS32_MIDI_DirectRxCallback_Init(&NOTIFY_MIDI_Rx);
   MIOS32_MIDI_DirectTxCallback_Init(&NOTIFY_MIDI_Tx);
@@ -260,6 +263,37 @@ void APP_MIDI_NotifyPackage(mios32_midi_port_t port, mios32_midi_package_t midi_
   MIDIMON_Receive(port, midi_package, filter_sysex_message);
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// This hook is called with a run of channel voice messages which have been
+// received on the same port (installed via MIOS32_MIDI_BlockCallback_Init)
+/////////////////////////////////////////////////////////////////////////////
+s32 APP_MIDI_NotifyBlock(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 num)
+{
+  u32 i;
+
+  // -> MIDI Router (searches the routes of the port only once)
+  MIDI_ROUTER_ReceiveBlock(port, packages, num);
+
+  u8 filter_sysex_message = (port == USB0) || (port == UART0);
+  for(i=0; i<num; ++i) {
+    mios32_midi_package_t midi_package = packages[i];
+
+    // -> DOUT
+    MIDIO_DOUT_MIDI_NotifyPackage(port, midi_package);
+
+    // -> MIDI Port Handler (used for MIDI monitor function)
+    MIDI_PORT_NotifyMIDIRx(port, midi_package);
+
+    // -> MIDI file recorder
+    MID_FILE_Receive(port, midi_package);
+
+    // forward to MIDI Monitor
+    MIDIMON_Receive(port, midi_package, filter_sysex_message);
+  }
+
+  return 0; // no error
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // This function parses an incoming sysex stream for MIOS32 commands
 /////////////////////////////////////////////////////////////////////////////
@@ -34,6 +34,7 @@ extern void APP_Background(void);
 extern void APP_Tick(void);
 extern void APP_MIDI_Tick(void);
 extern void APP_MIDI_NotifyPackage(mios32_midi_port_t port, mios32_midi_package_t midi_package);
+extern s32 APP_MIDI_NotifyBlock(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 num);
 extern s32 APP_SYSEX_Parser(mios32_midi_port_t port, u8 midi_in);
 extern void APP_SRIO_ServicePrepare(void);
 extern void APP_SRIO_ServiceFinish(void);
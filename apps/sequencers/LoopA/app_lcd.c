@@ -21,6 +21,7 @@
 #include <mios32.h>
 
 #include "app_lcd.h"
+#include "screen.h"
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -363,6 +364,8 @@ s32 APP_LCD_Init(u32 mode)
   // Set_Partial_Display(0x01,0x00,0x00);// Disable Partial Display
   Set_Display_On();
 
+  // the display RAM content is unknown after the initialisation
+  screenForceFullRefresh();
 
   return (display_available & (1 << mios32_lcd_device)) ? 0 : -1; // return -1 if display not available
 }
@@ -413,6 +416,37 @@ s32 APP_LCD_Data(u8 data)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Sends a block of data bytes to LCD
+// Chip select and DC are only set once for the whole block. A transport
+// with DMA support could send the block here without the CPU.
+// IN: <len> data bytes in <data>
+// OUT: returns < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 APP_LCD_DataBlock(u8 *data, u32 len)
+{
+  u8 cs=0;
+
+  // chip select and DC
+#if APP_LCD_USE_J10_FOR_CS
+  MIOS32_BOARD_J10_Set(~(1 << cs));
+#else
+  MIOS32_BOARD_J15_DataSet(~(1 << cs));
+#endif
+  MIOS32_BOARD_J15_RS_Set(1); // RS pin used to control DC
+
+  // send data
+  u32 i;
+  for(i=0; i<len; ++i)
+    MIOS32_BOARD_J15_SerDataShift(data[i]);
+
+  // increment graphical cursor
+  mios32_lcd_x += len;
+
+  return 0; // no error
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Sends command byte to LCD
 // IN: command byte in <cmd>
@@ -460,6 +494,9 @@ s32 APP_LCD_Clear(void)
     }
   }
 
+  // the screen buffer has to be sent completely with the next frame
+  screenForceFullRefresh();
+
   return 0;
 }
 
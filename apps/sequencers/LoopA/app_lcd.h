@@ -49,6 +49,7 @@
 // hooks to MIOS32_LCD
 extern s32 APP_LCD_Init(u32 mode);
 extern s32 APP_LCD_Data(u8 data);
+extern s32 APP_LCD_DataBlock(u8 *data, u32 len);
 extern s32 APP_LCD_Cmd(u8 cmd);
 extern s32 APP_LCD_Clear(void);
 extern s32 APP_LCD_CursorSet(u16 column, u16 line);
@@ -93,6 +93,40 @@ s8 liveTransposeRequested_ = 0;       // If != active liveTranspose_, perform a
 u16 clipActiveNote_[TRACKS][SCENES];  // currently active edited note number, when in noteroll editor
 s8 valueEncoderAccel_ = 0;            // 1: value encoder pushed (while turning) -> accellerate data inputs
 
+// --- Clip playback index (not on disk) ---
+// Notes of the active scene clip of each track, sorted by their transformed (stretched, scrolled, quantized) start tick,
+// so that loopaSeqTick() only has to touch the notes that are due instead of transforming all clip notes on every tick
+#if MAXNOTES > 256
+# error "ClipIndex stores clip note numbers with 8 bit"
+#endif
+
+typedef struct
+{
+   u8 valid;                          // 0: rebuild requested (see invalidateClipIndex())
+   u8 scene;                          // clip parameters the index has been built with - if one of them changes, the index is rebuilt
+   u16 steps;
+   u32 quantize;
+   s8 swing;
+   s16 scroll;
+   u8 stretch;
+   u16 notesSize;
+
+   u16 size;                          // number of index entries (notes outside of the stretched clip length are not indexed)
+   u16 cursor;                        // next entry to be played
+   u32 cursorTick;                    // clip time at which the cursor is valid, otherwise it will be re-seeked
+   u16 tick[MAXNOTES];                // transformed start tick (clips are limited to 1024 steps, so 16 bit are sufficient)
+   u8 note[MAXNOTES];                 // clip note number
+} ClipIndex;
+
+// two indices per track: the index of the active scene and a spare index, which is prepared for the requested scene
+// before a synced scene change (see prepareClipIndex()), so that the scene change only has to swap them
+static ClipIndex clipIndex_[TRACKS][2];
+static u8 clipIndexActive_[TRACKS];   // index of the active scene: clipIndex_[track][clipIndexActive_[track]]
+
+// notes of the active scene clips whose start tick has been changed or which have been recorded (see updateClipIndexNote()),
+// their index entries are moved by the sequencer task before the next tick is played
+static u32 clipIndexNotesChanged_[TRACKS][MAXNOTES / 32];
+
 // =================================================================================================
 
 
@@ -176,46 +210,390 @@ u32 quantize(u32 tick, u32 quantizeMeasure, s8 swingPercent, u32 clipLengthInTic
 
 
 /**
- * Transform (stretch, scroll, probabilities/random) and then quantize/apply swing to a note in a clip
+ * Help function: transform (stretch, scroll) and then quantize/apply swing to a note in a clip of the given scene
+ * @return transformed tick or -1, if the note is not within the clip length after stretching
  *
  */
-s32 quantizeTransform(u8 clip, u16 noteNumber)
+static s32 transformSceneNoteTick(u8 clip, u8 scene, u16 noteNumber)
 {
    // Idea: scroll first, and modulo-map to trackstart/end boundaries
    //       scale afterwards
    //       apply track len afterwards
    //       drop notes with ticks < 0 and ticks > tracklen
 
-   s32 tick = clipNotes_[clip][activeScene_][noteNumber].tick;
-   s16 quantizeMeasure = clipFxQuantize_[clip][activeScene_];
-   s32 clipLengthInTicks = getClipLengthInTicks(clip);
+   s32 tick = clipNotes_[clip][scene][noteNumber].tick;
+   s16 quantizeMeasure = clipFxQuantize_[clip][scene];
+   s32 clipLengthInTicks = stepToTick(clipSteps_[clip][scene]);
 
    // stretch
-   tick *= clipStretch_[clip][activeScene_];
+   tick *= clipStretch_[clip][scene];
    tick = tick >> 4U; // divide by 16 (stretch base)
 
    // only consider notes, that are within the clip length after stretching
    if (tick >= clipLengthInTicks)
       return -1;
 
-   // if clip fx probabilities/randomization is on, only consider notes that pass the random test
+   // scroll
+   tick += clipScroll_[clip][scene] * TICKS_PER_STEP;
+
+   while (tick < 0)
+      tick += clipLengthInTicks;
+
+   tick %= clipLengthInTicks;
+
+   return quantize(tick, quantizeMeasure, clipFxSwing_[clip][scene], clipLengthInTicks);
+}
+// -------------------------------------------------------------------------------------------------
+
+
+/**
+ * Transform (stretch, scroll) and then quantize/apply swing to a note in a clip, without the probability test
+ * @return transformed tick or -1, if the note is not within the clip length after stretching
+ *
+ */
+s32 transformNoteTick(u8 clip, u16 noteNumber)
+{
+   return transformSceneNoteTick(clip, activeScene_, noteNumber);
+}
+// -------------------------------------------------------------------------------------------------
+
+
+/**
+ * Clip fx probabilities/randomization: check, if a note should be dropped
+ * @return 1, if the note does not pass the random test
+ *
+ */
+u8 isNoteDropped(u8 clip, u16 noteNumber)
+{
    s8 randomMinimum = clipFxProbability_[clip][activeScene_];
    if (randomMinimum)
    {
       srand(((millisecondsSinceStartup_ >> 5U) << 8U) + noteNumber);  // Newly rerandomize every ~ 32ms
       if ((rand() % 100) < randomMinimum)
-         return -1;
+         return 1;
    }
 
-   // scroll
-   tick += clipScroll_[clip][activeScene_] * TICKS_PER_STEP;
+   return 0;
+}
+// -------------------------------------------------------------------------------------------------
 
-   while (tick < 0)
-      tick += clipLengthInTicks;
 
-   tick %= clipLengthInTicks;
+/**
+ * Transform (stretch, scroll, probabilities/random) and then quantize/apply swing to a note in a clip
+ *
+ */
+s32 quantizeTransform(u8 clip, u16 noteNumber)
+{
+   s32 tick = transformNoteTick(clip, noteNumber);
+
+   // if clip fx probabilities/randomization is on, only consider notes that pass the random test
+   if (tick < 0 || isNoteDropped(clip, noteNumber))
+      return -1;
+
+   return tick;
+}
+// -------------------------------------------------------------------------------------------------
+
 
-   return quantize(tick, quantizeMeasure, clipFxSwing_[clip][activeScene_], clipLengthInTicks);
+/**
+ * Request a rebuild of the playback index of a clip (track), has to be called after all notes of the clip have been
+ * replaced (session load, clip clear/freeze/paste)
+ * (changes of clip steps, quantization, swing, scroll, stretch and the active scene are detected automatically)
+ *
+ */
+void invalidateClipIndex(u8 clip)
+{
+   clipIndex_[clip][0].valid = 0;
+   clipIndex_[clip][1].valid = 0;
+}
+// -------------------------------------------------------------------------------------------------
+
+
+/**
+ * Update the playback index entry of a single note of the active scene clip, has to be called after the start tick of
+ * the note has been changed, or after the note has been recorded (also if the number of clip notes has been increased)
+ * The entry is moved by the sequencer task before the next tick is played, so this can be called from any task
+ *
+ */
+void updateClipIndexNote(u8 clip, u16 noteNumber)
+{
+   if (noteNumber < MAXNOTES)
+   {
+      MIOS32_IRQ_Disable();
+      clipIndexNotesChanged_[clip][noteNumber >> 5U] |= 1UL << (noteNumber & 31U);
+      MIOS32_IRQ_Enable();
+   }
+}
+// -------------------------------------------------------------------------------------------------
+
+
+/**
+ * Help function: check, if an index has been built with the current parameters of a scene clip
+ * (the number of clip notes is checked separately, as recorded notes are added incrementally)
+ *
+ */
+static u8 isClipIndexUpToDate(ClipIndex *ci, u8 clip, u8 scene)
+{
+   return ci->valid &&
+          ci->scene == scene &&
+          ci->steps == clipSteps_[clip][scene] &&
+          ci->quantize == clipFxQuantize_[clip][scene] &&
+          ci->swing == clipFxSwing_[clip][scene] &&
+          ci->scroll == clipScroll_[clip][scene] &&
+          ci->stretch == clipStretch_[clip][scene];
+}
+// -------------------------------------------------------------------------------------------------
+
+
+/**
+ * Help function: build an index for all notes of a scene clip
+ *
+ */
+static void buildClipIndex(ClipIndex *ci, u8 clip, u8 scene)
+{
+   // mark valid first, so that an invalidation while rebuilding (e.g. clip clear/paste from the UI) is not lost
+   ci->valid = 1;
+   ci->scene = scene;
+   ci->steps = clipSteps_[clip][scene];
+   ci->quantize = clipFxQuantize_[clip][scene];
+   ci->swing = clipFxSwing_[clip][scene];
+   ci->scroll = clipScroll_[clip][scene];
+   ci->stretch = clipStretch_[clip][scene];
+   ci->notesSize = clipNotesSize_[clip][scene];
+
+   // insertion sort by transformed tick - stable, so that notes starting at the same tick are still played in clip note order
+   u16 size = 0;
+   u16 i;
+   for (i = 0; i < ci->notesSize && i < MAXNOTES; i++)
+   {
+      s32 tick = transformSceneNoteTick(clip, scene, i);
+
+      if (tick >= 0)
+      {
+         u16 pos = size;
+         while (pos > 0 && ci->tick[pos - 1] > tick)
+         {
+            ci->tick[pos] = ci->tick[pos - 1];
+            ci->note[pos] = ci->note[pos - 1];
+            pos--;
+         }
+
+         ci->tick[pos] = tick;
+         ci->note[pos] = i;
+         size++;
+      }
+   }
+
+   ci->size = size;
+   ci->cursorTick = 0xFFFFFFFF; // force re-seek
+}
+// -------------------------------------------------------------------------------------------------
+
+
+/**
+ * Help function: remove the entry of a clip note from an index (if it is indexed)
+ *
+ */
+static void removeClipIndexNote(ClipIndex *ci, u16 noteNumber)
+{
+   u16 pos;
+   for (pos = 0; pos < ci->size; pos++)
+   {
+      if (ci->note[pos] == noteNumber)
+      {
+         // keep the cursor on the same entry
+         if (pos < ci->cursor)
+            ci->cursor--;
+
+         ci->size--;
+         for (; pos < ci->size; pos++)
+         {
+            ci->tick[pos] = ci->tick[pos + 1];
+            ci->note[pos] = ci->note[pos + 1];
+         }
+         return;
+      }
+   }
+}
+// -------------------------------------------------------------------------------------------------
+
+
+/**
+ * Help function: insert the entry of a clip note into an index, behind the notes with the same start tick and a lower
+ * clip note number (in the same order like buildClipIndex() sorts them)
+ *
+ */
+static void insertClipIndexNote(ClipIndex *ci, u8 clip, u16 noteNumber)
+{
+   s32 tick = transformSceneNoteTick(clip, ci->scene, noteNumber);
+   if (tick < 0)
+      return; // not within the clip length after stretching
+
+   u16 lo = 0;
+   u16 hi = ci->size;
+   while (lo < hi)
+   {
+      u16 mid = (lo + hi) >> 1U;
+      if (ci->tick[mid] < tick || (ci->tick[mid] == tick && ci->note[mid] < noteNumber))
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+
+   u16 pos;
+   for (pos = ci->size; pos > lo; pos--)
+   {
+      ci->tick[pos] = ci->tick[pos - 1];
+      ci->note[pos] = ci->note[pos - 1];
+   }
+
+   ci->tick[lo] = tick;
+   ci->note[lo] = noteNumber;
+   ci->size++;
+
+   // the cursor points to the first entry at/after cursorTick
+   if (tick < ci->cursorTick)
+      ci->cursor++;
+}
+// -------------------------------------------------------------------------------------------------
+
+
+/**
+ * Bring the playback index of a clip (track) up to date:
+ * - moves the entries of notes which have been changed with updateClipIndexNote()
+ * - switches to the spare index on a scene change, if it has been prepared by prepareClipIndex()
+ * - rebuilds the index otherwise (after invalidateClipIndex() and clip parameter changes)
+ *
+ */
+static void updateClipIndex(u8 clip)
+{
+   ClipIndex *ci = &clipIndex_[clip][clipIndexActive_[clip]];
+   ClipIndex *spare = &clipIndex_[clip][clipIndexActive_[clip] ^ 1];
+   u16 notesSize = clipNotesSize_[clip][activeScene_];
+   u32 changed[MAXNOTES / 32];
+   u32 anyChanged = 0;
+   u16 i;
+
+   // take over the changed notes
+   MIOS32_IRQ_Disable();
+   for (i = 0; i < MAXNOTES / 32; i++)
+   {
+      changed[i] = clipIndexNotesChanged_[clip][i];
+      clipIndexNotesChanged_[clip][i] = 0;
+      anyChanged |= changed[i];
+   }
+   MIOS32_IRQ_Enable();
+
+   if (!isClipIndexUpToDate(ci, clip, activeScene_))
+   {
+      if (!anyChanged && isClipIndexUpToDate(spare, clip, activeScene_) && spare->notesSize == notesSize)
+      {
+         // scene change: use the prepared index
+         clipIndexActive_[clip] ^= 1;
+         spare->cursorTick = 0xFFFFFFFF; // force re-seek
+         return;
+      }
+
+      // changed notes can't be assigned to a scene anymore
+      if (anyChanged)
+         spare->valid = 0;
+
+      buildClipIndex(ci, clip, activeScene_);
+   }
+   else if (anyChanged || ci->notesSize != notesSize)
+   {
+      u8 rebuild = notesSize < ci->notesSize;
+
+      // recorded notes are added incrementally - they have been marked with updateClipIndexNote() as well
+      for (i = ci->notesSize; i < notesSize && !rebuild; i++)
+         rebuild = !(changed[i >> 5U] & (1UL << (i & 31U)));
+
+      if (rebuild)
+      {
+         buildClipIndex(ci, clip, activeScene_);
+      }
+      else
+      {
+         for (i = 0; i < notesSize; i++)
+         {
+            if (changed[i >> 5U] & (1UL << (i & 31U)))
+            {
+               if (i < ci->notesSize)
+                  removeClipIndexNote(ci, i);
+               insertClipIndexNote(ci, clip, i);
+            }
+         }
+
+         ci->notesSize = notesSize;
+      }
+   }
+
+   // the spare index of the same scene is outdated now
+   if (spare->scene == activeScene_)
+      spare->valid = 0;
+}
+// -------------------------------------------------------------------------------------------------
+
+
+/**
+ * Prepare the spare playback indices for a synced scene change, so that the indices don't have to be rebuilt when
+ * the scene is changed. Only one index is built per call, to spread the load over the ticks before the scene change
+ *
+ */
+static void prepareClipIndex(u8 scene)
+{
+   u8 clip;
+   for (clip = 0; clip < TRACKS; clip++)
+   {
+      ClipIndex *spare = &clipIndex_[clip][clipIndexActive_[clip] ^ 1];
+
+      if (!isClipIndexUpToDate(spare, clip, scene) || spare->notesSize != clipNotesSize_[clip][scene])
+      {
+         buildClipIndex(spare, clip, scene);
+         return;
+      }
+   }
+}
+// -------------------------------------------------------------------------------------------------
+
+
+/**
+ * Get the clip note numbers starting at the given clip time, the cursor is moved behind these notes
+ * @return number of notes, pointer to the first clip note number in *notes
+ *
+ */
+static u16 getClipIndexNotesAt(u8 clip, u32 clipNoteTime, const u8 **notes)
+{
+   updateClipIndex(clip);
+
+   ClipIndex *ci = &clipIndex_[clip][clipIndexActive_[clip]];
+
+   if (ci->cursorTick != clipNoteTime)
+   {
+      // clip time jumped (wrap around, beatloop, song position...) -> binary search for the first note at/after clipNoteTime
+      u16 lo = 0;
+      u16 hi = ci->size;
+      while (lo < hi)
+      {
+         u16 mid = (lo + hi) >> 1U;
+         if (ci->tick[mid] < clipNoteTime)
+            lo = mid + 1;
+         else
+            hi = mid;
+      }
+      ci->cursor = lo;
+   }
+
+   u16 first = ci->cursor;
+   u16 end = first;
+   while (end < ci->size && ci->tick[end] == clipNoteTime)
+      end++;
+
+   *notes = &ci->note[first];
+   ci->cursor = end;
+   ci->cursorTick = clipNoteTime + 1;
+
+   return end - first;
 }
 // -------------------------------------------------------------------------------------------------
 
@@ -297,6 +675,9 @@ void performSyncedSceneChanges()
    {
       u8 sceneChangeInTicks = stepsPerMeasure_ - (tickToStep(tick_) % stepsPerMeasure_);
 
+      // build the playback indices of the target scene before the scene change
+      prepareClipIndex(sceneChangeRequested_);
+
       // flash indicate target scene (after synced scene switch)
       if (tick_ % 16 < 8)
       {
@@ -563,6 +944,10 @@ void loadSession(u16 sessionNumber)
 
    MUTEX_SDCARD_GIVE;
 
+   u8 track;
+   for (track = 0; track < TRACKS; track++)
+      invalidateClipIndex(track);
+
    setActiveScene(activeScene_);
    screenSetClipSelected(activeTrack_);
    updateLiveLEDs();
@@ -770,13 +1155,17 @@ s32 loopaSeqTick(u32 bpmTick)
          if (!trackMute_[track])
          {
             u32 clipNoteTime = boundTickToClipSteps(bpmTick, track);
-            u16 i;
+            const u8 *notes;
+            u16 num = getClipIndexNotesAt(track, clipNoteTime, &notes);
+            u16 n;
 
-            for (i = 0; i < clipNotesSize_[track][activeScene_]; i++) // i: clip notes iterator
+            for (n = 0; n < num; n++) // n: clip index iterator
             {
+               u16 i = notes[n]; // i: clip note number
+
                if (clipNotes_[track][activeScene_][i].length > 0) // not still being held/recorded!
                {
-                  if (quantizeTransform(track, i) == clipNoteTime)
+                  if (!isNoteDropped(track, i))
                   {
                      // If cursor erase is activated on the active track, set velocity of this note to zero, erase it, don't play it
                      if (cursorEraseActive_ && track == activeTrack_)
@@ -824,13 +1213,17 @@ s32 loopaSeqTick(u32 bpmTick)
             if (cursorEraseActive_)
             {
                u32 clipNoteTime = boundTickToClipSteps(bpmTick, track);
-               u16 i;
+               const u8 *notes;
+               u16 num = getClipIndexNotesAt(track, clipNoteTime, &notes);
+               u16 n;
 
-               for (i = 0; i < clipNotesSize_[track][activeScene_]; i++) // i: clip notes iterator
+               for (n = 0; n < num; n++) // n: clip index iterator
                {
+                  u16 i = notes[n]; // i: clip note number
+
                   if (clipNotes_[track][activeScene_][i].length > 0) // not still being held/recorded!
                   {
-                     if (quantizeTransform(track, i) == clipNoteTime)
+                     if (!isNoteDropped(track, i))
                      {
                         clipNotes_[track][activeScene_][i].velocity = 0;
                      }
@@ -1092,6 +1485,7 @@ void loopaRecord(mios32_midi_port_t port, mios32_midi_package_t midi_package)
                // screenFormattedFlashMessage("Note %d on - ptr %d", midi_package.note, clipNoteNumber);
                if (!reusedDeletedNote)
                   clipNotesSize_[activeTrack_][activeScene_]++;
+               updateClipIndexNote(activeTrack_, clipNoteNumber);
             }
             else if (midi_package.type == NoteOff || (midi_package.type == NoteOn && midi_package.velocity == 0))
             {
@@ -1223,6 +1617,8 @@ void footswitchReleased(u8 footswitchNumber)
             cursorEraseActive_ = 0;
             break;
 
+         default:
+            break;
       }
    }
 }
@@ -126,9 +126,21 @@ u32 boundTickToClipSteps(u32 tick, u8 clip);
 // Quantize a tick time event
 u32 quantize(u32 tick, u32 quantizeMeasure, s8 swingPercent, u32 clipLengthInTicks);
 
+// Transform (stretch, scroll) and then quantize/apply swing a note in a clip, without the probability test
+s32 transformNoteTick(u8 clip, u16 noteNumber);
+
+// Clip fx probabilities/randomization: check, if a note should be dropped
+u8 isNoteDropped(u8 clip, u16 noteNumber);
+
 // Transform (stretch, scroll, probabilities/random) and then quantize/apply swing a note in a clip
 s32 quantizeTransform(u8 clip, u16 noteNumber);
 
+// Request a rebuild of the playback index of a clip after all notes have been replaced
+void invalidateClipIndex(u8 clip);
+
+// Update the playback index entry of a note after its start tick has been changed or after it has been recorded
+void updateClipIndexNote(u8 clip, u16 noteNumber);
+
 // Get the clip length in ticks
 u32 getClipLengthInTicks(u8 clip);
 
@@ -20,6 +20,9 @@
 // --- globals ---
 
 u8 screen[64][128];             // Screen buffer [y][x]
+u8 screenSent_[64][128];        // Screen buffer contents as last sent to the display [y][x]
+u8 screenSentValid_ = 0;        // if set to 0, the next frame will be sent completely, not only the changed parts
+u8 screenRowOut_[128];          // Row pixel data to be sent (after inversion/beat flash)
 
 u8 screenShowLoopaLogo_;
 u8 screenShowShift_ = 0;
@@ -312,6 +315,8 @@ void printPageIcon()
       case PAGE_LIVEFX:
          c = KEYICON_LIVEFX;
          break;
+      default:
+         break;
    }
 
    unsigned x;
@@ -841,6 +846,8 @@ void displayHelp(void)
          printFormattedString(0, 36, "You can use the SELECT encoder to scroll");
          printFormattedString(0, 48, "and select the configuration entry.");
          break;
+      default:
+         break;
    }
 }
 // ----------------------------------------------------------------------------------------
@@ -1727,6 +1734,41 @@ int isScreensaverActive()
 // ----------------------------------------------------------------------------------------
 
 
+/**
+ * Send a column window of the current row output to the display
+ * (columns of 4 pixels each, 0-63)
+ *
+ */
+#define SCREEN_WINDOW_OVERHEAD 7 // bytes needed to set up a new window (0x15 + 2 bytes, 0x75 + 2 bytes, 0x5c)
+static void screenPushWindow(u8 row, u8 startCol, u8 endCol)
+{
+   APP_LCD_Cmd(0x15);
+   APP_LCD_Data(0x1c + startCol);
+   APP_LCD_Data(0x1c + endCol);
+
+   APP_LCD_Cmd(0x75);
+   APP_LCD_Data(row);
+   APP_LCD_Data(row);
+
+   APP_LCD_Cmd(0x5c);
+
+   APP_LCD_DataBlock(&screenRowOut_[startCol * 2], (endCol - startCol + 1) * 2);
+}
+// ----------------------------------------------------------------------------------------
+
+
+/**
+ * Send the complete screen buffer with the next frame, not only the changed parts
+ * (e.g. after the display RAM has been written by someone else)
+ *
+ */
+void screenForceFullRefresh()
+{
+   screenSentValid_ = 0;
+}
+// ----------------------------------------------------------------------------------------
+
+
 /**
  * Display the current screen buffer (once per frame, called in app.c scheduler)
  *
@@ -1916,6 +1958,8 @@ void display()
          case PAGE_LIVEFX:
             displayPageLiveFX();
             break;
+         default:
+            break;
       }
 
       // Render page icon in upper right corner
@@ -1947,17 +1991,10 @@ void display()
       screenshotRequested_ = 0;
    }
 
-   // Push screen buffer to screen
+   // Push screen buffer to screen, only the parts that changed since the last frame
+   u8 windowsSent = 0;
    for (j = 0; j < 64; j++)
    {
-      APP_LCD_Cmd(0x15);
-      APP_LCD_Data(0+0x1c);
-
-      APP_LCD_Cmd(0x75);
-      APP_LCD_Data(j);
-
-      APP_LCD_Cmd(0x5c);
-
       u8 bgcol = 0;
       for (i = 0; i < 128; i++)
       {
@@ -1976,12 +2013,65 @@ void display()
          }
 
          if (flash && out == 0)
-            APP_LCD_Data(flash); // normally raise dark level slightly, but more intensively after 16 16th notes during flash
-         else
-            APP_LCD_Data(out);
+            out = flash; // normally raise dark level slightly, but more intensively after 16 16th notes during flash
 
+         screenRowOut_[i] = out;
          screen[j][i] = bgcol; // clear written pixels
       }
+
+      if (!screenSentValid_)
+      {
+         screenPushWindow(j, 0, 63);
+         windowsSent = 1;
+      }
+      else
+      {
+         // Compare in display columns (4 pixels, 2 bytes), changes that are closer together than the
+         // overhead of a new window are sent in the same window
+         s8 start = -1;
+         s8 last = -1;
+         u8 col;
+         for (col = 0; col < 64; col++)
+         {
+            u8 *out = &screenRowOut_[col * 2];
+            u8 *sent = &screenSent_[j][col * 2];
+
+            if (out[0] != sent[0] || out[1] != sent[1])
+            {
+               if (start >= 0 && (col - last - 1) * 2 >= SCREEN_WINDOW_OVERHEAD)
+               {
+                  screenPushWindow(j, start, last);
+                  start = -1;
+               }
+
+               if (start < 0)
+                  start = col;
+               last = col;
+            }
+         }
+
+         if (start >= 0)
+         {
+            screenPushWindow(j, start, last);
+            windowsSent = 1;
+         }
+      }
+
+      memcpy(screenSent_[j], screenRowOut_, 128);
+   }
+
+   screenSentValid_ = 1;
+
+   // Restore the full screen window, APP_LCD_Clear() and testScreen() only set the start addresses
+   if (windowsSent)
+   {
+      APP_LCD_Cmd(0x15);
+      APP_LCD_Data(0x1c);
+      APP_LCD_Data(0x5b);
+
+      APP_LCD_Cmd(0x75);
+      APP_LCD_Data(0x00);
+      APP_LCD_Data(0x3f);
    }
 
    if (flash)
@@ -2088,6 +2178,8 @@ void testScreen()
      }
   }
 
+  screenForceFullRefresh();
+
   while(1);
 }
 // -------------------------------------------------------------------------------------------
@@ -51,6 +51,9 @@ int isScreensaverActive();
 // Display the current screen buffer
 void display();
 
+// Send the complete screen buffer with the next frame, not only the changed parts
+void screenForceFullRefresh();
+
 //Save the screen as a screenshot file on the SD card
 void saveScreenshot();
 
@@ -265,11 +265,16 @@ void writeSetup()
    // write user instruments config
    {
       u8 i;
+      char name[9];
       for (i = 0; i < SETUP_NUM_USERINSTRUMENTS; i++)
       {
+         // max. 8 characters, see readSetup()
+         memcpy(name, userInstruments_[i].name, 8);
+         name[8] = 0;
+
          sprintf(line_buffer_, "INSTRUMENT %d %s %s %d\n",
                  i,
-                 userInstruments_[i].name,
+                 name,
                  MIDI_PORT_OutNameGet(MIDI_PORT_InIxGet(userInstruments_[i].port)),
                  userInstruments_[i].channel
          );
@@ -296,11 +301,11 @@ void writeSetup()
    }
 
    // write MIDI IN MCLK ports config
-   sprintf(line_buffer_, "MIDI_IN_MClock_Ports 0x%08x\n", (u32) midi_router_mclk_in);
+   sprintf(line_buffer_, "MIDI_IN_MClock_Ports 0x%08x\n", (unsigned) midi_router_mclk_in);
    FILE_WriteBuffer((u8 *)line_buffer_, strlen(line_buffer_));
 
    // write MIDI OUT mclk ports config
-   sprintf(line_buffer_, "MIDI_OUT_MClock_Ports 0x%08x\n", (u32) midi_router_mclk_out);
+   sprintf(line_buffer_, "MIDI_OUT_MClock_Ports 0x%08x\n", (unsigned) midi_router_mclk_out);
    FILE_WriteBuffer((u8 *)line_buffer_, strlen(line_buffer_));
 
    // write last used session number
@@ -316,23 +321,23 @@ void writeSetup()
    FILE_WriteBuffer((u8 *)line_buffer_, strlen(line_buffer_));
 
    // write metronome port
-   sprintf(line_buffer_, "SETUP_Metronome_Port %d\n", (u32) gcMetronomePort_);
+   sprintf(line_buffer_, "SETUP_Metronome_Port %d\n", (int) gcMetronomePort_);
    FILE_WriteBuffer((u8 *)line_buffer_, strlen(line_buffer_));
 
    // write metronome channel
-   sprintf(line_buffer_, "SETUP_Metronome_Channel %d\n", (u32) gcMetronomeChannel_);
+   sprintf(line_buffer_, "SETUP_Metronome_Channel %d\n", (int) gcMetronomeChannel_);
    FILE_WriteBuffer((u8 *)line_buffer_, strlen(line_buffer_));
 
    // write metronome measure note
-   sprintf(line_buffer_, "SETUP_Metronome_NoteM %d\n", (u32) gcMetronomeNoteM_);
+   sprintf(line_buffer_, "SETUP_Metronome_NoteM %d\n", (int) gcMetronomeNoteM_);
    FILE_WriteBuffer((u8 *)line_buffer_, strlen(line_buffer_));
 
    // write metronome beat note
-   sprintf(line_buffer_, "SETUP_Metronome_NoteB %d\n", (u32) gcMetronomeNoteB_);
+   sprintf(line_buffer_, "SETUP_Metronome_NoteB %d\n", (int) gcMetronomeNoteB_);
    FILE_WriteBuffer((u8 *)line_buffer_, strlen(line_buffer_));
 
    // write screensaver-after-minutes
-   sprintf(line_buffer_, "SETUP_Screensaver_Minutes %d\n", (u32) gcScreensaverAfterMinutes_);
+   sprintf(line_buffer_, "SETUP_Screensaver_Minutes %d\n", (int) gcScreensaverAfterMinutes_);
    FILE_WriteBuffer((u8 *)line_buffer_, strlen(line_buffer_));
 
    // write font type
@@ -486,6 +491,7 @@ void readSetup()
                         n->src_chn = (u8) values[2];
                         n->dst_port = (u8) values[3];
                         n->dst_chn = (u8) values[4];
+                        MIDI_ROUTER_NodesChanged();
                      }
                   }
                }
@@ -400,6 +400,8 @@ void updateSwitchLEDs()
          case PAGE_TRACK:
             led_delete = LED_RED;
             break;
+         default:
+            break;
       }
    }
    else if (screenIsInShift())
@@ -863,6 +865,7 @@ void clipZoom()
 void clipClear()
 {
    clipNotesSize_[activeTrack_][activeScene_] = 0;
+   invalidateClipIndex(activeTrack_);
 
    u8 i;
    for (i=0; i<128; i++)
@@ -925,6 +928,7 @@ void clipFreeze()
 
    optimizedAmount = clipNotesSize_[activeTrack_][activeScene_] - optimizedNotes;
    clipNotesSize_[activeTrack_][activeScene_] = optimizedNotes;
+   invalidateClipIndex(activeTrack_);
 
    screenFormattedFlashMessage("%d notes optimized", optimizedAmount);
 }
@@ -1536,6 +1540,7 @@ void loopaButtonPressed(s32 pin)
                clipStretch_[activeTrack_][activeScene_] = copiedClipStretch_;
                memcpy(clipNotes_[activeTrack_][activeScene_], copiedClipNotes_, sizeof(copiedClipNotes_));
                clipNotesSize_[activeTrack_][activeScene_] = copiedClipNotesSize_;
+               invalidateClipIndex(activeTrack_);
                screenFormattedFlashMessage("pasted clip from buffer");
             }
             else
@@ -1596,6 +1601,8 @@ void loopaButtonPressed(s32 pin)
                case PAGE_LIVEFX:
                   liveFxQuantize();
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -1637,6 +1644,8 @@ void loopaButtonPressed(s32 pin)
                case PAGE_LIVEFX:
                   liveFxSwing();
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -1683,6 +1692,8 @@ void loopaButtonPressed(s32 pin)
                case PAGE_LIVEFX:
                   liveFxProbability();
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -1724,6 +1735,8 @@ void loopaButtonPressed(s32 pin)
                case PAGE_SETUP:
                   setupPar2();
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -1756,6 +1769,8 @@ void loopaButtonPressed(s32 pin)
                case PAGE_SETUP:
                   setupPar3();
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -1788,6 +1803,8 @@ void loopaButtonPressed(s32 pin)
                case PAGE_SETUP:
                   setupPar4();
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -1935,6 +1952,8 @@ void loopaButtonReleased(s32 pin)
                case PAGE_MUTE:
                   muteScreenTrackButtonReleased(0);
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -1951,6 +1970,8 @@ void loopaButtonReleased(s32 pin)
                case PAGE_MUTE:
                   muteScreenTrackButtonReleased(1);
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -1967,6 +1988,8 @@ void loopaButtonReleased(s32 pin)
                case PAGE_MUTE:
                   muteScreenTrackButtonReleased(2);
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -1983,6 +2006,8 @@ void loopaButtonReleased(s32 pin)
                case PAGE_MUTE:
                   muteScreenTrackButtonReleased(3);
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -1999,6 +2024,8 @@ void loopaButtonReleased(s32 pin)
                case PAGE_MUTE:
                   muteScreenTrackButtonReleased(4);
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -2015,6 +2042,8 @@ void loopaButtonReleased(s32 pin)
                case PAGE_MUTE:
                   muteScreenTrackButtonReleased(5);
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -2097,6 +2126,8 @@ void loopaEncoderTurned(s32 encoder, s32 incrementer)
                case COMMAND_NOTE_POSITION:
                   incrementer *= TICKS_PER_STEP;
                   break;
+               default:
+                  break;
             }
          }
       }
@@ -2267,6 +2298,7 @@ void loopaEncoderTurned(s32 encoder, s32 incrementer)
                newTick = (newTick / TICKS_PER_STEP) * TICKS_PER_STEP;
 
                clipNotes_[activeTrack_][activeScene_][activeNote].tick = (u16) newTick;
+               updateClipIndexNote(activeTrack_, activeNote);
             }
          } else if (command_ == COMMAND_NOTE_KEY)
          {
@@ -2379,6 +2411,7 @@ void loopaEncoderTurned(s32 encoder, s32 incrementer)
                newPortIndex = (s8) (MIDI_PORT_InNumGet() - 5);
 
             n->src_port = MIDI_PORT_InPortGet((u8) newPortIndex);
+            MIDI_ROUTER_NodesChanged();
             configChangesToBeWritten_ = 1;
          } else if (command_ == COMMAND_ROUTE_IN_CHANNEL)
          {
@@ -2389,6 +2422,7 @@ void loopaEncoderTurned(s32 encoder, s32 incrementer)
             newChannel = (s8) (newChannel > 17 ? 17 : newChannel);
 
             n->src_chn = (u8) newChannel;
+            MIDI_ROUTER_NodesChanged();
             configChangesToBeWritten_ = 1;
          } else if (command_ == COMMAND_ROUTE_OUT_PORT)
          {
@@ -2401,6 +2435,7 @@ void loopaEncoderTurned(s32 encoder, s32 incrementer)
                newPortIndex = (s8) (MIDI_PORT_OutNumGet() - 5);
 
             n->dst_port = MIDI_PORT_OutPortGet((u8) newPortIndex);
+            MIDI_ROUTER_NodesChanged();
             configChangesToBeWritten_ = 1;
          } else if (command_ == COMMAND_ROUTE_OUT_CHANNEL)
          {
@@ -2411,6 +2446,7 @@ void loopaEncoderTurned(s32 encoder, s32 incrementer)
             newChannel = (s8) (newChannel > 17 ? 17 : newChannel);
 
             n->dst_chn = (u8) newChannel;
+            MIDI_ROUTER_NodesChanged();
             configChangesToBeWritten_ = 1;
          } else if (command_ == COMMAND_SETUP_SELECT) // Setup page - left encoder changes active/selected setup item
          {
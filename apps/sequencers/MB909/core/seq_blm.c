@@ -32,6 +32,7 @@
 #include "seq_midi_in.h"
 #include "seq_record.h"
 #include "osc_server.h"
+#include "osc_client.h"
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -2351,6 +2352,8 @@ static s32 BLM_SendPackets(mios32_midi_package_t *packets, u8 num_packets)
     for(i=0; i<num_packets; ++i)
       end_ptr = MIOS32_OSC_PutInt(end_ptr, packets[i].ALL);
 
+    // send collected OSC client messages before (if bundled)
+    OSC_CLIENT_Flush(seq_blm_port & 0x0f);
     OSC_SERVER_SendPacket(seq_blm_port & 0x0f, packet, (u32)(end_ptr-packet));
   } else {
     int i;
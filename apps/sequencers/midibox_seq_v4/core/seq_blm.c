@@ -358,6 +358,17 @@ static s32 SEQ_BLM_LED_UpdateGridMode(void)
     }
   }
 
+  ///////////////////////////////////////////////////////////////////////////
+  // cursor: played step (or selected step) in rotated view, otherwise selected instrument
+  ///////////////////////////////////////////////////////////////////////////
+  if( BLM_SCALAR_MASTER_RotateViewGet(0) ) {
+    int cursor_step = sequencer_running ? seq_core_trk[visible_track].step : ui_selected_step;
+    if( (cursor_step / 16) == ui_selected_step_view )
+      BLM_SCALAR_MASTER_CursorRowSet(0, cursor_step % 16);
+  } else if( event_mode == SEQ_EVENT_MODE_Drum ) {
+    BLM_SCALAR_MASTER_CursorRowSet(0, ui_selected_instrument - BLM_SCALAR_MASTER_RowOffsetGet(0));
+  }
+
 
   ///////////////////////////////////////////////////////////////////////////
   // extra LEDs
@@ -587,6 +598,11 @@ static s32 SEQ_BLM_LED_UpdateTrackMode(void)
     else if( num_rows <= 8 )
       row_offset = 8*(ui_selected_group >> 1);
     BLM_SCALAR_MASTER_RowOffsetSet(0, row_offset);
+
+    // cursor: selected track
+    u8 visible_track = SEQ_UI_VisibleTrackGet();
+    if( visible_track >= row_offset )
+      BLM_SCALAR_MASTER_CursorRowSet(0, visible_track - row_offset);
   }
 
   ///////////////////////////////////////////////////////////////////////////
@@ -1284,6 +1300,9 @@ s32 SEQ_BLM_LED_Update(void)
   // row offset is used if BLM supports less than 16 rows
   BLM_SCALAR_MASTER_RowOffsetSet(0, 0);
 
+  // rows near to the cursor are sent first if the BLM bandwidth is limited
+  BLM_SCALAR_MASTER_CursorRowSet(0, 0);
+
   // (always present)
   {
     blm_scalar_master_leds_extracolumn_shift_green = 0x0000;
@@ -485,6 +485,7 @@ s32 SEQ_CC_LinkUpdate(u8 track)
         case SEQ_PAR_Type_Nth2: tcc->link_par_layer_nth2 = layer; break;
         case SEQ_PAR_Type_Root: tcc->link_par_layer_root = layer; break;
         case SEQ_PAR_Type_Scale: tcc->link_par_layer_scale = layer; break;
+        default: break; // no link
       }
     }
   }
@@ -65,6 +65,13 @@
 // value is visible in INFO->System page (-> press exit button, go to last item)
 #define STOPWATCH_PERFORMANCE_MEASURING 1
 
+// max. number of ticks which are replayed by SEQ_CORE_SeekReplay() within a
+// single SEQ_CORE_Handler() call on song position changes. The remaining
+// ticks are replayed with the next calls, meanwhile the tracks stay muted.
+#ifndef SEQ_CORE_SEEK_REPLAY_TICKS_PER_CALL
+#define SEQ_CORE_SEEK_REPLAY_TICKS_PER_CALL 64
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Local prototypes
@@ -72,6 +79,10 @@
 
 static s32 SEQ_CORE_ResetTrkPos(u8 track, seq_core_trk_t *t, seq_cc_trk_t *tcc);
 static s32 SEQ_CORE_NextStep(seq_core_trk_t *t, seq_cc_trk_t *tcc, u8 no_progression, u8 reverse);
+static s32 SEQ_CORE_PatternSwitchCheck(u32 bpm_tick);
+static s32 SEQ_CORE_SeekReplay(void);
+static s32 SEQ_CORE_SeekAnalyticPossible(void);
+static s32 SEQ_CORE_SeekAnalytic(u32 bpm_tick_target);
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -129,6 +140,10 @@ u8 seq_core_glb_loop_steps;
 static u32 bpm_tick_prefetch_req;
 static u32 bpm_tick_prefetched;
 
+static u8  seek_replay_active;
+static u32 seek_replay_tick;
+static u32 seek_replay_target;
+
 static float seq_core_bpm_target;
 static float seq_core_bpm_sweep_inc;
 
@@ -412,6 +427,10 @@ s32 SEQ_CORE_ScheduleEvent(u8 track, seq_core_trk_t *t, seq_cc_trk_t *tcc, mios3
 /////////////////////////////////////////////////////////////////////////////
 s32 SEQ_CORE_Handler(void)
 {
+  // continue the replay of a song position change (see SEQ_CORE_Seek())
+  if( seek_replay_active )
+    SEQ_CORE_SeekReplay();
+
   // handle requests
 
   u8 num_loops = 0;
@@ -473,22 +492,10 @@ s32 SEQ_CORE_Handler(void)
       // update delays
       SEQ_MIDI_PORT_ClkDelayUpdateAll();
 
-      // new position
+      // fast forward to new song position
       u32 new_tick = new_song_pos * (SEQ_BPM_PPQN_Get() / 4);
-      SEQ_CORE_Reset(new_tick);
-      SEQ_SONG_Reset(new_tick);
+      SEQ_CORE_Seek(new_tick);
 
-#if 0
-      // fast forward to new song position
-      if( new_tick ) {
-	u32 bpm_tick;
-	for(bpm_tick=0; bpm_tick<=new_tick; bpm_tick+=24) {
-	  SEQ_BPM_TickSet(bpm_tick);
-	  SEQ_CORE_Tick(bpm_tick, -1, 1); // mute all non-loopback tracks
-	}
-	SEQ_BPM_TickSet(new_tick);
-      }
-#endif
       SEQ_MIDPLY_SongPos(new_song_pos, 1);
     }
 
@@ -497,6 +504,13 @@ s32 SEQ_CORE_Handler(void)
       // check all requests again after execution of this part
       again = 1;
 
+      // the song position change hasn't been replayed completely yet:
+      // this tick will be replayed with muted tracks as well
+      if( seek_replay_active ) {
+	seek_replay_target = bpm_tick + 1;
+	continue;
+      }
+
       // it's possible to forward the sequencer on pattern changes
       // in this case bpm_tick_prefetch_req is > bpm_tick
       // in all other cases, we only generate a single tick (realtime play)
@@ -544,36 +558,7 @@ s32 SEQ_CORE_Handler(void)
 
 	// load new pattern/song step if reference step reached measure
 	// (this code is outside SEQ_CORE_Tick() to save stack space!)
-	u8 pre_ticks = SEQ_BPM_TicksFor_mS(seq_core_pattern_switch_margin_ms); // pattern switch depends on tempo and preconfigured margin
-	if( pre_ticks >= 95 )
-	  pre_ticks = 95;
-	if( (bpm_tick % 96) == (96-pre_ticks) ) {
-	  if( SEQ_SONG_ActiveGet() ) {
-	    // to handle the case as described under http://midibox.org/forums/topic/19774-question-about-expected-behaviour-in-song-mode/
-	    // seq_core_steps_per_measure was lower than seq_core_steps_per_pattern
-	    u32 song_switch_step = (seq_core_steps_per_measure < seq_core_steps_per_pattern) ? seq_core_steps_per_measure : seq_core_steps_per_pattern;
-	    if( ( seq_song_guide_track && seq_song_guide_track <= SEQ_CORE_NUM_TRACKS &&
-		  seq_core_state.ref_step_song == seq_cc_trk[seq_song_guide_track-1].length) ||
-		(!seq_song_guide_track && seq_core_state.ref_step_song == song_switch_step) ) {
-	      
-	      if( seq_song_guide_track ) {
-		// request synch-to-measure for all tracks
-		SEQ_CORE_ManualSynchToMeasure(0xffff);
-		
-		// corner case: we will load new tracks and the length of the guide track could change
-		// in order to ensure that the reference step jumps back to 0, we've to force this here:
-		seq_core_state.FORCE_REF_STEP_RESET = 1;
-	      }
-	      
-	      SEQ_SONG_NextPos();
-	    }
-	  } else {
-	    if( seq_core_options.SYNCHED_PATTERN_CHANGE &&
-		seq_core_state.ref_step_pattern == seq_core_steps_per_pattern ) {
-	      SEQ_PATTERN_Handler();
-	    }
-	  }
-	}
+	SEQ_CORE_PatternSwitchCheck(bpm_tick);
       }
     }
   } while( again && num_loops < 10 );
@@ -582,6 +567,424 @@ s32 SEQ_CORE_Handler(void)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Loads new pattern/song step if reference step reached measure
+// Called from SEQ_CORE_Handler() and SEQ_CORE_Seek() after each tick
+/////////////////////////////////////////////////////////////////////////////
+static s32 SEQ_CORE_PatternSwitchCheck(u32 bpm_tick)
+{
+  u8 pre_ticks = SEQ_BPM_TicksFor_mS(seq_core_pattern_switch_margin_ms); // pattern switch depends on tempo and preconfigured margin
+  if( pre_ticks >= 95 )
+    pre_ticks = 95;
+  if( (bpm_tick % 96) == (96-pre_ticks) ) {
+    if( SEQ_SONG_ActiveGet() ) {
+      // to handle the case as described under http://midibox.org/forums/topic/19774-question-about-expected-behaviour-in-song-mode/
+      // seq_core_steps_per_measure was lower than seq_core_steps_per_pattern
+      u32 song_switch_step = (seq_core_steps_per_measure < seq_core_steps_per_pattern) ? seq_core_steps_per_measure : seq_core_steps_per_pattern;
+      if( ( seq_song_guide_track && seq_song_guide_track <= SEQ_CORE_NUM_TRACKS &&
+	    seq_core_state.ref_step_song == seq_cc_trk[seq_song_guide_track-1].length) ||
+	  (!seq_song_guide_track && seq_core_state.ref_step_song == song_switch_step) ) {
+
+	if( seq_song_guide_track ) {
+	  // request synch-to-measure for all tracks
+	  SEQ_CORE_ManualSynchToMeasure(0xffff);
+
+	  // corner case: we will load new tracks and the length of the guide track could change
+	  // in order to ensure that the reference step jumps back to 0, we've to force this here:
+	  seq_core_state.FORCE_REF_STEP_RESET = 1;
+	}
+
+	SEQ_SONG_NextPos();
+      }
+    } else {
+      if( seq_core_options.SYNCHED_PATTERN_CHANGE &&
+	  seq_core_state.ref_step_pattern == seq_core_steps_per_pattern ) {
+	SEQ_PATTERN_Handler();
+      }
+    }
+  }
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Seeks to the given bpm_tick (used on Song Position changes)
+//
+// Afterwards the step positions (incl. clock dividers, direction modes and
+// synch-to-measure), loopback tracks, transposer and arpeggiator, LFOs and
+// the song position are in the same state like after a continuous playback
+// from the beginning of the song.
+//
+// If possible, the track positions are calculated directly from the target
+// tick (SEQ_CORE_SeekAnalytic). This takes the same time for each song
+// position. Otherwise the song is replayed with muted non-loopback tracks
+// (SEQ_CORE_SeekReplay). The replay is spread over several SEQ_CORE_Handler()
+// calls, incoming clocks are replayed muted as well until it has caught up.
+//
+// The given tick itself isn't played, it will be processed by
+// SEQ_CORE_Handler() with the next MIDI clock.
+//
+// Returns 1 if the replay will be continued by SEQ_CORE_Handler()
+/////////////////////////////////////////////////////////////////////////////
+s32 SEQ_CORE_Seek(u32 bpm_tick_target)
+{
+  // start from the beginning
+  SEQ_SONG_Reset(0);
+  SEQ_CORE_Reset(0);
+
+  // continue with the target tick
+  SEQ_BPM_TickSet(bpm_tick_target);
+  bpm_tick_prefetch_req = 0;
+  bpm_tick_prefetched = bpm_tick_target ? (bpm_tick_target - 1) : 0;
+
+  if( bpm_tick_target && SEQ_CORE_SeekAnalyticPossible() ) {
+    seek_replay_active = 0;
+    SEQ_CORE_SeekAnalytic(bpm_tick_target);
+    return 0;
+  }
+
+  seek_replay_active = 1;
+  seek_replay_tick = 0;
+  seek_replay_target = bpm_tick_target;
+  return SEQ_CORE_SeekReplay();
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Seeks by playing all tracks from the beginning of the song with muted
+// non-loopback tracks.
+//
+// SEQ_CORE_Tick() is only executed for ticks at which the track state can
+// change: reference steps, step events of each track (timestamp_next_step),
+// step trigger requests and song/pattern switch points.
+// The LFOs are forwarded over the remaining ticks with SEQ_LFO_HandleTrkTicks()
+//
+// Replays max. SEQ_CORE_SEEK_REPLAY_TICKS_PER_CALL ticks from seek_replay_tick
+// up to (but not including) seek_replay_target.
+// Returns 1 if the replay has to be continued, 0 if the target is reached.
+/////////////////////////////////////////////////////////////////////////////
+static s32 SEQ_CORE_SeekReplay(void)
+{
+  u32 bpm_tick = seek_replay_tick;
+  u32 bpm_tick_target = seek_replay_target;
+  int num_ticks = 0;
+  while( bpm_tick < bpm_tick_target ) {
+    if( ++num_ticks > SEQ_CORE_SEEK_REPLAY_TICKS_PER_CALL ) {
+      seek_replay_tick = bpm_tick;
+      return 1; // continue with next SEQ_CORE_Handler() call
+    }
+
+    SEQ_CORE_Tick(bpm_tick, -1, 1); // mute all non-loopback tracks
+    SEQ_CORE_PatternSwitchCheck(bpm_tick);
+
+    // determine the next tick which has to be processed
+    // reference step:
+    u32 next_tick = bpm_tick - (bpm_tick % 96) + 96;
+
+    // pattern/song switch point:
+    u8 pre_ticks = SEQ_BPM_TicksFor_mS(seq_core_pattern_switch_margin_ms);
+    if( pre_ticks >= 95 )
+      pre_ticks = 95;
+    if( pre_ticks ) {
+      u32 switch_tick = bpm_tick - (bpm_tick % 96) + (96-pre_ticks);
+      if( switch_tick <= bpm_tick )
+	switch_tick += 96;
+      if( switch_tick < next_tick )
+	next_tick = switch_tick;
+    }
+
+    // next step of each track:
+    u8 track;
+    seq_core_trk_t *t = &seq_core_trk[0];
+    seq_cc_trk_t *tcc = &seq_cc_trk[0];
+    for(track=0; track<SEQ_CORE_NUM_TRACKS; ++track, ++t, ++tcc) {
+      u32 step_tick;
+
+      if( t->state.FIRST_CLK || t->state.TRIGGER_NEXT_STEP_REQ ) {
+	step_tick = bpm_tick + 1;
+      } else if( tcc->trkmode_flags.STEP_TRG ) {
+	continue; // only a step trigger request can play the next step
+      } else {
+	step_tick = (t->timestamp_next_step > bpm_tick) ? t->timestamp_next_step : (bpm_tick + 1);
+      }
+
+      if( step_tick < next_tick )
+	next_tick = step_tick;
+    }
+
+    if( next_tick > bpm_tick_target )
+      next_tick = bpm_tick_target;
+
+    // forward LFOs over the skipped ticks
+    u32 skipped_ticks = next_tick - bpm_tick - 1;
+    if( skipped_ticks ) {
+      for(track=0; track<SEQ_CORE_NUM_TRACKS; ++track)
+	SEQ_LFO_HandleTrkTicks(track, bpm_tick + 1, skipped_ticks);
+    }
+
+    bpm_tick = next_tick;
+  }
+
+  // target reached: continue with the next clock
+  seek_replay_active = 0;
+  seek_replay_tick = bpm_tick;
+  bpm_tick_prefetch_req = 0;
+  bpm_tick_prefetched = bpm_tick_target ? (bpm_tick_target - 1) : 0;
+
+  return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns 1 if the state at the target tick can be calculated by
+// SEQ_CORE_SeekAnalytic(), 0 if the song has to be replayed, because:
+// - song mode: patterns are changed at song steps
+// - a synched pattern change is pending
+// - global loop mode
+// - loopback tracks: transposer/arpeggiator state depends on played notes
+// - arpeggiator and step trigger mode: step progression depends on notes
+// - random directions, skip triggers and groove delays
+// - jump back, replay, repeat and skip progression parameters
+/////////////////////////////////////////////////////////////////////////////
+static s32 SEQ_CORE_SeekAnalyticPossible(void)
+{
+  if( SEQ_SONG_ActiveGet() || seq_core_state.LOOP )
+    return 0;
+
+  if( seq_core_options.SYNCHED_PATTERN_CHANGE ) {
+    u8 group;
+    for(group=0; group<SEQ_CORE_NUM_GROUPS; ++group)
+      if( seq_pattern_req[group].REQ )
+	return 0;
+  }
+
+  u8 track;
+  seq_cc_trk_t *tcc = &seq_cc_trk[0];
+  for(track=0; track<SEQ_CORE_NUM_TRACKS; ++track, ++tcc) {
+    if( tcc->playmode != SEQ_CORE_TRKMODE_Off && (tcc->midi_port & 0xf0) == 0xf0 )
+      return 0;
+
+    if( tcc->playmode == SEQ_CORE_TRKMODE_Arpeggiator ||
+	tcc->trkmode_flags.STEP_TRG ||
+	tcc->clkdiv.MANUAL ||
+	tcc->groove_style.style )
+      return 0;
+
+    switch( tcc->dir_mode ) {
+    case SEQ_CORE_TRKDIR_Forward:
+    case SEQ_CORE_TRKDIR_Backward:
+    case SEQ_CORE_TRKDIR_PingPong:
+    case SEQ_CORE_TRKDIR_Pendulum:
+      break;
+    default:
+      return 0;
+    }
+
+    if( tcc->steps_jump_back || tcc->steps_replay || tcc->steps_repeat || tcc->steps_skip )
+      return 0;
+
+    if( tcc->loop > tcc->length )
+      return 0;
+
+    int step;
+    for(step=0; step<=tcc->length; ++step)
+      if( SEQ_TRG_SkipGet(track, step, 0) )
+	return 0;
+  }
+
+  return 1;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Helpers for SEQ_CORE_SeekAnalytic()
+// The step position of a track is given by the number of played steps.
+// Without progression parameters, the position and direction run into a
+// cycle of max. 2*(length+1) steps, which is determined once per track,
+// so that any number of steps can be reduced to less than one cycle.
+/////////////////////////////////////////////////////////////////////////////
+typedef struct {
+  u32 cycle_start; // number of steps before the cycle begins
+  u32 cycle_steps; // steps per cycle
+  u32 cycle_bars;  // bar increments per cycle
+} seq_core_seek_cycle_t;
+
+static u8 SEQ_CORE_SeekSamePos(seq_core_trk_t *a, seq_core_trk_t *b)
+{
+  return a->step == b->step && a->state.BACKWARD == b->state.BACKWARD;
+}
+
+static void SEQ_CORE_SeekCycle(seq_core_trk_t *t, seq_cc_trk_t *tcc, seq_core_seek_cycle_t *cycle)
+{
+  seq_core_trk_t tortoise = *t;
+  seq_core_trk_t hare = *t;
+  u32 power = 1;
+  u32 i;
+
+  // cycle length (Brent)
+  cycle->cycle_steps = 1;
+  SEQ_CORE_NextStep(&hare, tcc, 1, 0); // 1, 0=no progression, not reverse
+  while( !SEQ_CORE_SeekSamePos(&tortoise, &hare) ) {
+    if( power == cycle->cycle_steps ) {
+      tortoise = hare;
+      power <<= 1;
+      cycle->cycle_steps = 0;
+    }
+    SEQ_CORE_NextStep(&hare, tcc, 1, 0);
+    ++cycle->cycle_steps;
+  }
+
+  // steps before the cycle
+  tortoise = *t;
+  hare = *t;
+  for(i=0; i<cycle->cycle_steps; ++i)
+    SEQ_CORE_NextStep(&hare, tcc, 1, 0);
+  cycle->cycle_start = 0;
+  while( !SEQ_CORE_SeekSamePos(&tortoise, &hare) ) {
+    SEQ_CORE_NextStep(&tortoise, tcc, 1, 0);
+    SEQ_CORE_NextStep(&hare, tcc, 1, 0);
+    ++cycle->cycle_start;
+  }
+
+  // bars per cycle
+  cycle->cycle_bars = hare.bar - tortoise.bar;
+}
+
+// returns the track position after num_steps steps in *pos
+static void SEQ_CORE_SeekPos(seq_core_trk_t *t, seq_cc_trk_t *tcc, seq_core_seek_cycle_t *cycle, u32 num_steps, seq_core_trk_t *pos)
+{
+  *pos = *t;
+
+  if( num_steps > cycle->cycle_start ) {
+    u32 cycles = (num_steps - cycle->cycle_start) / cycle->cycle_steps;
+    num_steps -= cycles * cycle->cycle_steps;
+    pos->bar += cycles * cycle->cycle_bars;
+  }
+
+  while( num_steps-- )
+    SEQ_CORE_NextStep(pos, tcc, 1, 0);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Seeks by calculating the state of all tracks at the target tick
+// The tracks must have been reset with SEQ_CORE_Reset(0) before.
+// Gives the same result like SEQ_CORE_SeekReplay() if
+// SEQ_CORE_SeekAnalyticPossible() returns 1
+/////////////////////////////////////////////////////////////////////////////
+static s32 SEQ_CORE_SeekAnalytic(u32 bpm_tick_target)
+{
+  // the last played tick
+  u32 bpm_tick = bpm_tick_target - 1;
+
+  // tick 0 requests synch to measure: delayed mutes/unmutes are taken over,
+  // and the slave clock mute is released
+  seq_core_trk_muted |= (seq_core_trk_synched_mute & ~seq_core_trk_muted);
+  seq_core_trk_synched_mute = 0;
+  seq_core_trk_muted &= ~(seq_core_trk_synched_unmute & seq_core_trk_muted);
+  seq_core_trk_synched_unmute = 0;
+
+  u8 is_master = SEQ_BPM_IsMaster();
+  u16 synch_all_tracks = 0;
+  if( is_master || seq_core_slaveclk_mute == SEQ_CORE_SLAVECLK_MUTE_OffOnNextMeasure ) {
+    seq_core_slaveclk_mute = SEQ_CORE_SLAVECLK_MUTE_Off;
+    if( !is_master ) {
+      ui_seq_pause = 0;
+      synch_all_tracks = 0xffff; // like SEQ_CORE_ManualSynchToMeasure(0xffff) at tick 0
+    }
+  }
+
+  // reference steps
+  u32 ref_steps = bpm_tick / 96; // number of increments after tick 0
+  seq_core_state.FIRST_CLK = 0;
+  seq_core_state.ref_step = (u16)(ref_steps % ((u32)seq_core_steps_per_measure+1));
+  seq_core_state.ref_step_pattern = (u16)(ref_steps % ((u32)seq_core_steps_per_pattern+1));
+  if( seq_song_guide_track ) {
+    seq_core_state.ref_step_song = (u16)(ref_steps % ((u32)seq_cc_trk[seq_song_guide_track-1].length+1));
+  } else {
+    seq_core_state.ref_step_song = seq_core_state.ref_step;
+  }
+
+  // synch to measure resets tracks at each measure
+  u32 measure_ticks = ((u32)seq_core_steps_per_measure+1) * 96;
+
+  u8 track;
+  seq_core_trk_t *t = &seq_core_trk[0];
+  seq_cc_trk_t *tcc = &seq_cc_trk[0];
+  for(track=0; track<SEQ_CORE_NUM_TRACKS; ++track, ++t, ++tcc) {
+    // reset requests and synch to measure are handled at tick 0
+    if( seq_core_state.reset_trkpos_req & (1 << track) )
+      ++t->bar;
+
+    u8 synch_at_start = tcc->clkdiv.SYNCH_TO_MEASURE || (synch_all_tracks & (1 << track));
+    if( synch_at_start )
+      ++t->bar;
+
+    u16 step_length = ((tcc->clkdiv.value+1) * (tcc->clkdiv.TRIPLETS ? 4 : 6));
+    seq_core_seek_cycle_t cycle;
+    seq_core_trk_t pos;
+    SEQ_CORE_SeekCycle(t, tcc, &cycle);
+
+    // tick of the last track reset
+    // each complete measure starts from the same position, and increments the bar on the next reset
+    u32 reset_tick = 0;
+    if( tcc->clkdiv.SYNCH_TO_MEASURE ) {
+      u32 num_measures = bpm_tick / measure_ticks;
+      if( num_measures ) {
+	SEQ_CORE_SeekPos(t, tcc, &cycle, (measure_ticks-1) / step_length, &pos);
+	t->bar += num_measures * (pos.bar - t->bar + 1);
+	reset_tick = num_measures * measure_ticks;
+      }
+    }
+
+    // steps played since the reset, the first one doesn't progress
+    u32 num_steps = (bpm_tick - reset_tick) / step_length + 1;
+
+    t->step_length = step_length;
+    t->timestamp_next_step_ref = reset_tick + num_steps * step_length;
+    t->timestamp_next_step = t->timestamp_next_step_ref; // no groove
+    t->state.FIRST_CLK = 0;
+    t->state.POS_RESET = 0;
+
+    // step position
+    // the progression counters only save the position (no jump back/replay/repeat/skip)
+    u32 num_progressions = num_steps - 1;
+    u32 fwd_period = (u32)tcc->steps_forward + 1;
+    u32 last_saved = num_progressions - (num_progressions % fwd_period);
+    if( last_saved ) {
+      SEQ_CORE_SeekPos(t, tcc, &cycle, last_saved, &pos);
+      t->step_saved = pos.step;
+    }
+    SEQ_CORE_SeekPos(t, tcc, &cycle, num_progressions, &pos);
+    t->step = pos.step;
+    t->state.BACKWARD = pos.state.BACKWARD;
+    t->bar = pos.bar;
+    t->arp_pos = pos.arp_pos;
+
+    t->step_fwd_ctr = num_progressions % fwd_period;
+    t->step_interval_ctr = num_progressions % ((u32)tcc->steps_rs_interval + 1);
+
+    if( t->play_section > 0 )
+      t->step += t->play_section * ((int)tcc->length+1);
+
+    // LFO: reset together with the track (after it has been handled at this tick)
+    if( synch_at_start ) {
+      SEQ_LFO_ResetTrk(track);
+      SEQ_LFO_HandleTrkTicks(track, reset_tick + 1, bpm_tick - reset_tick);
+    } else {
+      SEQ_LFO_HandleTrkTicks(track, 0, bpm_tick + 1);
+    }
+  }
+  seq_core_state.reset_trkpos_req = 0;
+
+  // inform UI about new steps
+  seq_core_step_update_req = 1;
+
+  return 0; // no error
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // This function plays all "off" events
 // Should be called on sequencer reset/restart/pause to avoid hanging notes
@@ -615,6 +1018,9 @@ s32 SEQ_CORE_Reset(u32 bpm_start)
   ui_seq_pause = 0;
   seq_core_state.FIRST_CLK = 1;
 
+  // cancel an ongoing song position change
+  seek_replay_active = 0;
+
   // reset latched PB/CC values
   SEQ_LAYER_ResetLatchedValues();
 
@@ -870,12 +1276,16 @@ s32 SEQ_CORE_Tick(u32 bpm_tick, s8 export_track, u8 mute_nonloopback_tracks)
 #else
       u8 track_record_enabled = (seq_record_state.ENABLED && (seq_record_state.ARMED_TRACKS & (1 << track)) != 0) ? 1 : 0;
 #endif
+      // no recording while fast forwarding
+      if( mute_nonloopback_tracks )
+	track_record_enabled = 0;
 
       // handle LFO effect
       SEQ_LFO_HandleTrk(track, bpm_tick);
 
       // send LFO CC (if enabled and not muted)
-      if( !(seq_core_trk_muted & (1 << track)) && !seq_core_slaveclk_mute && !t->lfo_cc_muted_from_midi ) {
+      if( !(seq_core_trk_muted & (1 << track)) && !seq_core_slaveclk_mute && !t->lfo_cc_muted_from_midi &&
+	  !(round && mute_nonloopback_tracks) ) {
 	mios32_midi_package_t p;
 	if( SEQ_LFO_FastCC_Event(track, bpm_tick, &p, 0) > 0 ) {
 	  if( loopback_port )
@@ -1054,7 +1464,7 @@ s32 SEQ_CORE_Tick(u32 bpm_tick, s8 export_track, u8 mute_nonloopback_tracks)
 
 	  // forward to live function (for repeats)
 	  // if it returns 1, the step won't be played
-	  if( SEQ_LIVE_NewStep(track, prev_step, t->step, bpm_tick) == 1 )
+	  if( !mute_nonloopback_tracks && SEQ_LIVE_NewStep(track, prev_step, t->step, bpm_tick) == 1 )
 	    mute_this_step = 1;
 
 	  // inform UI about a new step (UI will clear this variable)
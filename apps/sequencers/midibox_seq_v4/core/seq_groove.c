@@ -352,7 +352,7 @@ s32 SEQ_GROOVE_Clear(u8 groove)
   s32 groove_template = groove - SEQ_GROOVE_NUM_PRESETS; // negative if not a custom template
 
   memcpy(&seq_groove_templates[groove_template], &seq_groove_presets[0], sizeof(seq_groove_entry_t));
-  sprintf(seq_groove_templates[groove_template].name, "Custom #%d   ", groove_template+1);
+  sprintf(seq_groove_templates[groove_template].name, "Custom #%d   ", (int)groove_template+1);
   seq_groove_templates[groove_template].name[12] = 0; // terminator
   seq_groove_templates[groove_template].num_steps = 2; // for fast success
     
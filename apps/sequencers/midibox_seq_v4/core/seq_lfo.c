@@ -111,6 +111,59 @@ s32 SEQ_LFO_HandleTrk(u8 track, u32 bpm_tick)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Handles the LFO of a given track for num_ticks ticks, starting at bpm_tick
+// Same result like calling SEQ_LFO_HandleTrk() for each tick, but the
+// waveform position is incremented at once between the steps, and whole
+// LFO periods are skipped (used by SEQ_CORE_Seek)
+/////////////////////////////////////////////////////////////////////////////
+s32 SEQ_LFO_HandleTrkTicks(u8 track, u32 bpm_tick, u32 num_ticks)
+{
+  seq_cc_trk_t *tcc = &seq_cc_trk[track];
+  seq_lfo_t *lfo = &seq_lfo[track];
+
+  while( num_ticks ) {
+    // the first tick could increment the step counter or reset the LFO
+    SEQ_LFO_HandleTrk(track, bpm_tick);
+
+    if( lfo->step_ctr == 65535 && tcc->lfo_enable_flags.ONE_SHOT )
+      break; // oneshot LFO halted
+
+    if( (bpm_tick % 96) == 0 && lfo->step_ctr == 0 ) {
+      // LFO has been reset: it will be in the same state again after lfo_steps_rst+1 steps
+      u32 period_ticks = ((u32)tcc->lfo_steps_rst+1) * 96;
+      u32 skipped_ticks = ((num_ticks-1) / period_ticks) * period_ticks;
+      bpm_tick += skipped_ticks;
+      num_ticks -= skipped_ticks;
+    }
+
+    ++bpm_tick;
+    --num_ticks;
+
+    // remaining ticks until next step
+    u32 ticks = (bpm_tick % 96) ? (96 - (bpm_tick % 96)) : 0;
+    if( ticks > num_ticks )
+      ticks = num_ticks;
+
+    if( ticks ) {
+      if( lfo->step_ctr <= tcc->lfo_steps_rst ) {
+	u32 lfo_ticks = (u32)(tcc->lfo_steps+1) * 96; // @384 ppqn (reference bpm_tick resolution)
+	u32 inc = 65536 / lfo_ticks;
+	lfo->pos += inc * ticks;
+      } else if( !tcc->lfo_enable_flags.ONE_SHOT || lfo->step_ctr != 65535 ) {
+	continue; // LFO will be reset with the next tick
+      }
+      // else: oneshot LFO halted, nothing to do
+
+      bpm_tick += ticks;
+      num_ticks -= ticks;
+    }
+  }
+
+  return 0; // no error
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // modifies a MIDI event depending on LFO settings
 /////////////////////////////////////////////////////////////////////////////
@@ -73,6 +73,7 @@ extern s32 SEQ_LFO_Init(u32 mode);
 
 extern s32 SEQ_LFO_ResetTrk(u8 track);
 extern s32 SEQ_LFO_HandleTrk(u8 track, u32 bpm_tick);
+extern s32 SEQ_LFO_HandleTrkTicks(u8 track, u32 bpm_tick, u32 num_ticks);
 extern s32 SEQ_LFO_Event(u8 track, seq_layer_evnt_t *e);
 extern s32 SEQ_LFO_FastCC_Event(u8 track, u32 bpm_tick, mios32_midi_package_t *p, u8 ignore_waveform);
 
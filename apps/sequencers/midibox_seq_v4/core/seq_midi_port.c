@@ -549,7 +549,7 @@ char *SEQ_MIDI_PORT_InPortToName(mios32_midi_port_t port, char str_buffer[5])
   int port_ix;
   for(port_ix=0; port_ix<NUM_IN_PORTS; ++port_ix) {
     if( in_ports[port_ix].port == port ) {
-      strncpy(str_buffer, in_ports[port_ix].name, 5);
+      memcpy(str_buffer, in_ports[port_ix].name, 5);
       return str_buffer;
     }
   }
@@ -562,7 +562,7 @@ char *SEQ_MIDI_PORT_OutPortToName(mios32_midi_port_t port, char str_buffer[5])
   int port_ix;
   for(port_ix=0; port_ix<NUM_OUT_PORTS; ++port_ix) {
     if( out_ports[port_ix].port == port ) {
-      strncpy(str_buffer, out_ports[port_ix].name, 5);
+      memcpy(str_buffer, out_ports[port_ix].name, 5);
       return str_buffer;
     }
   }
@@ -575,7 +575,7 @@ char *SEQ_MIDI_PORT_ClkPortToName(mios32_midi_port_t port, char str_buffer[5])
   int port_ix;
   for(port_ix=0; port_ix<NUM_CLK_PORTS; ++port_ix) {
     if( clk_ports[port_ix].port == port ) {
-      strncpy(str_buffer, clk_ports[port_ix].name, 5);
+      memcpy(str_buffer, clk_ports[port_ix].name, 5);
       return str_buffer;
     }
   }
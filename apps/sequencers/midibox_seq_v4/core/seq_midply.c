@@ -56,6 +56,7 @@
 static u32 SEQ_MIDPLY_read(void *buffer, u32 len);
 static s32 SEQ_MIDPLY_eof(void);
 static s32 SEQ_MIDPLY_seek(u32 pos);
+static u32 SEQ_MIDPLY_read_block(u32 pos, void *buffer, u32 len);
 
 static s32 SEQ_MIDPLY_PlayEvent(u8 track, mios32_midi_package_t midi_package, u32 tick);
 static s32 SEQ_MIDPLY_PlayMeta(u8 track, u8 meta, u32 len, u8 *buffer, u32 tick);
@@ -248,6 +249,7 @@ s32 SEQ_MIDPLY_ReadFile(char *path)
   // install callback functions
   MIOS32_IRQ_Disable();
   MID_PARSER_InstallFileCallbacks(&SEQ_MIDPLY_read, &SEQ_MIDPLY_eof, &SEQ_MIDPLY_seek);
+  MID_PARSER_InstallReadBlockCallback(&SEQ_MIDPLY_read_block);
   MID_PARSER_InstallEventCallbacks(&SEQ_MIDPLY_PlayEvent, &SEQ_MIDPLY_PlayMeta);
   MIOS32_IRQ_Enable();
 
@@ -440,9 +442,6 @@ s32 SEQ_MIDPLY_SongPos(u16 new_song_pos, u8 from_midi)
   if( !loop_range )
     SEQ_MIDPLY_PlayOffEvents();
 
-  // restart song
-  MID_PARSER_RestartSong();
-
 #if 0
   // controlled by SEQ_CORE
   // release pause
@@ -451,9 +450,17 @@ s32 SEQ_MIDPLY_SongPos(u16 new_song_pos, u8 from_midi)
 
   if( new_song_pos > 1 ) {
     // (silently) fast forward to requested position
+    // starts at the nearest checkpoint of the seek index if MID_PARSER_SEEK_INDEX_NUM > 0
     ffwd_silent_mode = 1;
-    MID_PARSER_FetchEvents(0, new_tick - 1);
+    MID_PARSER_SeekTick(new_tick - 1);
     ffwd_silent_mode = 0;
+
+    // send tempo, program changes and controllers which have been skipped
+    // (only available with MID_PARSER_SEEK_INDEX_NUM > 0)
+    MID_PARSER_ChaseEvents(new_tick - 1);
+  } else {
+    // restart song
+    MID_PARSER_RestartSong();
   }
 
   // when do we expect the next prefetch:
@@ -616,6 +623,34 @@ static s32 SEQ_MIDPLY_seek(u32 pos)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// reads <len> bytes at position <pos> of the .mid file into <buffer>
+// used by the MIDI parser to refill the read-ahead windows of the tracks
+// (only a single SD card access per window, see MID_PARSER_TRACK_BUFFER_SIZE)
+// returns number of read bytes
+/////////////////////////////////////////////////////////////////////////////
+static u32 SEQ_MIDPLY_read_block(u32 pos, void *buffer, u32 len)
+{
+  s32 status;
+
+  if( !midifile_path[0] || pos >= midifile_len )
+    return 0;
+
+  if( len > (midifile_len - pos) )
+    len = midifile_len - pos;
+
+  MUTEX_SDCARD_TAKE;
+  if( (status=FILE_ReadReOpen(&midifile_fi)) >= 0 ) {
+    if( (status=FILE_ReadSeek(pos)) >= 0 )
+      status = FILE_ReadBuffer(buffer, len);
+    FILE_ReadClose(&midifile_fi);
+  }
+  MUTEX_SDCARD_GIVE;
+
+  return (status >= 0) ? len : 0;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // called when a MIDI event should be played at a given tick
 /////////////////////////////////////////////////////////////////////////////
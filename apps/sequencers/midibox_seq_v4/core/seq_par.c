@@ -540,7 +540,7 @@ s32 SEQ_PAR_AssignedTypeStr(u8 track, u8 par_layer, u8 instrument, char *str_buf
       sprintf(str_buffer, "#%03d ", cc_number);
     }
   } else {
-    strncpy(str_buffer, SEQ_PAR_TypeStr(asg), 6);
+    strcpy(str_buffer, SEQ_PAR_TypeStr(asg)); // 5 characters + terminator
   }
   return 0; // no error
 }
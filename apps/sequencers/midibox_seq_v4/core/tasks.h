@@ -36,6 +36,12 @@
 extern "C" {
 #endif
 
+// critical sections are provided as functions by the emulation
+#ifdef MIOS32_FAMILY_EMULATION
+  extern void portENTER_CRITICAL(void);
+  extern void portEXIT_CRITICAL(void);
+#endif
+
 // this mutex should be used by all tasks which are accessing the SD Card
 #ifdef MIOS32_FAMILY_EMULATION
   extern void TASKS_SDCardSemaphoreTake(void);
@@ -81,6 +81,17 @@ extern void APP_SendDebugMessage(char *format, ...);
 # define MIOS32_HEAP_SIZE 13*1024
 #endif
 
+// read-ahead window per MIDI file track of the MIDI player (see modules/midifile/mid_parser.h)
+// reduces the SD card accesses to one per 512 bytes, but costs 16k RAM for 32 tracks -> STM32F4 only
+#ifdef MBSEQV4P
+# define MID_PARSER_TRACK_BUFFER_SIZE 512
+#endif
+
+// seek index of the MIDI player for fast song position changes (~9k RAM for 16 checkpoints)
+#ifdef MBSEQV4P
+# define MID_PARSER_SEEK_INDEX_NUM 16
+#endif
+
 // for LPC17: simplify allocation of large arrays
 #if defined(MIOS32_FAMILY_LPC17xx)
 # define AHB_SECTION __attribute__ ((section (".bss_ahb")))
@@ -139,6 +150,15 @@ extern void APP_SendDebugMessage(char *format, ...);
 // support delays
 #define SEQ_MIDI_OUT_SUPPORT_DELAY 1
 
+// timing wheel instead of sorted list (allocates 1.5k RAM for the wheel slots)
+// only together with the tag index (3k RAM for 256 events), otherwise each
+// SEQ_MIDI_OUT_ReSchedule() call of SEQ_CORE would scan all slots of the wheel
+// only for MBSEQV4P, the RAM of STM32F1 and LPC17 based cores is too tight
+#ifdef MBSEQV4P
+# define SEQ_MIDI_OUT_QUEUE_METHOD 1
+# define SEQ_MIDI_OUT_TAG_INDEX 1
+#endif
+
 
 #if defined(MIOS32_FAMILY_STM32F10x)
 // enable third UART
@@ -869,10 +869,10 @@ u8 EditState(VgmSource* vgs, VgmHead* head, u8 encoder, s32 incrementer, u8 butt
         op = 0xFF; //Allow editing octave/freq on any op if we're not fm3_special
     }
     while(1){
-        cmd = vsr->cmds[a];
+        cmd = *VGM_SourceRAM_cmdPtr(vsr, a);
         modcmd = EditCmd(cmd, encoder, incrementer, button, state, voice, op);
         if(modcmd.all != cmd.all){
-            vsr->cmds[a] = modcmd;
+            *VGM_SourceRAM_cmdPtr(vsr, a) = modcmd;
             if(modcmd.cmd == 0x50){
                 modcmd.cmd = 0;
             }else if((modcmd.cmd & 0xFE) == 0x52){
@@ -181,6 +181,7 @@ void Mode_Chan_BtnGVoice(u8 gvoice, u8 state){
             }else{
                 SyEng_ClearVoice(g, v);
                 syngenesis[g].channels[v].use = 3;
+                SyEng_VoiceUseChanged(g, v);
                 channels[selchan].trackervoice = (g << 4) | v;
                 channels[selchan].trackermode = 1;
                 FrontPanel_GenesisLEDSet(g, v, 0, 1);
@@ -211,6 +212,7 @@ void Mode_Chan_BtnSoftkey(u8 softkey, u8 state){
                         }
                         if(c == 16*MBQG_NUM_PORTS){ //there was none
                             syngenesis[g].channels[3].use = 0;
+                            SyEng_VoiceUseChanged(g, 3);
                             //Also clear trackermode from voices controlling Ch3 operator frequencies
                             for(c=0; c<16*MBQG_NUM_PORTS; ++c){
                                 if(channels[c].trackermode){
@@ -233,6 +235,7 @@ void Mode_Chan_BtnSoftkey(u8 softkey, u8 state){
                         }
                         if(c == 16*MBQG_NUM_PORTS){ //there was none
                             syngenesis[g].channels[v].use = 0;
+                            SyEng_VoiceUseChanged(g, v);
                         }
                     }
                     FrontPanel_GenesisLEDSet(g, v, 0, 0);
@@ -252,6 +255,7 @@ void Mode_Chan_BtnSoftkey(u8 softkey, u8 state){
             if(softkey == 3){
                 SyEng_ClearVoice(cursor, 3);
                 syngenesis[cursor].channels[3].use = 3;
+                SyEng_VoiceUseChanged(cursor, 3);
                 channels[selchan].trackervoice = (cursor << 4) | 3;
             }else if(softkey <= 2){
                 channels[selchan].trackervoice = (cursor << 4) | (0xC + softkey);
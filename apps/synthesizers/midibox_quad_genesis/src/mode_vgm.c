@@ -380,7 +380,7 @@ void Mode_Vgm_Background(){
             if(a < 0 || a >= vsr->numcmds){
                 FrontPanel_VGMMatrixRow(r, 0);
             }else{
-                DrawCmdLine(vsr->cmds[a], r, (a == selvgm->markstart || a == selvgm->markend));
+                DrawCmdLine(*VGM_SourceRAM_cmdPtr(vsr, a), r, (a == selvgm->markstart || a == selvgm->markend));
             }
             ++a;
         }
@@ -428,7 +428,7 @@ void Mode_Vgm_Background(){
             FrontPanel_LEDSet(FP_LED_TIME_R, 0);
             lastcmddrawn.all = 0;
         }else{
-            VgmChipWriteCmd newcmd = vsr->cmds[a];
+            VgmChipWriteCmd newcmd = *VGM_SourceRAM_cmdPtr(vsr, a);
             if(newcmd.all != lastcmddrawn.all){
                 MIOS32_IRQ_Disable();
                 if(lastcmddrawn.all != 0){
@@ -508,7 +508,7 @@ void Mode_Vgm_BtnSoftkey(u8 softkey, u8 state){
                 VgmSourceRAM* vsr = (VgmSourceRAM*)selvgm->data;
                 s32 a = head->srcaddr;
                 if(a < 0 || a >= vsr->numcmds) return;
-                vsr->cmds[a] = EditCmd(vsr->cmds[a], 0xFF, 0, FP_B_ALG, softkey, 0xFF, 0xFF);
+                *VGM_SourceRAM_cmdPtr(vsr, a) = EditCmd(*VGM_SourceRAM_cmdPtr(vsr, a), 0xFF, 0, FP_B_ALG, softkey, 0xFF, 0xFF);
             }
             break;
         case 5:
@@ -521,7 +521,7 @@ void Mode_Vgm_BtnSoftkey(u8 softkey, u8 state){
                 VgmSourceRAM* vsr = (VgmSourceRAM*)selvgm->data;
                 s32 a = head->srcaddr;
                 if(a < 0 || a >= vsr->numcmds) return;
-                vsr->cmds[a] = EditCmd(vsr->cmds[a], 0xFF, 0, FP_B_KON, (1 << softkey), 0xFF, 0xFF);
+                *VGM_SourceRAM_cmdPtr(vsr, a) = EditCmd(*VGM_SourceRAM_cmdPtr(vsr, a), 0xFF, 0, FP_B_KON, (1 << softkey), 0xFF, 0xFF);
             }
             break;
     }
@@ -559,6 +559,7 @@ void Mode_Vgm_BtnSystem(u8 button, u8 state){
                 synproginstance_t* pi = &proginstances[vgmpreviewpi];
                 pi->head->ticks = VGM_Player_GetVGMTime();
                 pi->head->playing = 1;
+                VGM_Player_Schedule(pi->head);
                 playing = 1;
             }
             return;
@@ -864,7 +865,7 @@ void Mode_Vgm_BtnEdit(u8 button, u8 state){
                 VgmSourceRAM* vsr = (VgmSourceRAM*)selvgm->data;
                 s32 a = head->srcaddr;
                 if(a < 0 || a >= vsr->numcmds) return;
-                vsr->cmds[a] = EditCmd(vsr->cmds[a], 0xFF, 0, button, state, 0xFF, 0xFF);
+                *VGM_SourceRAM_cmdPtr(vsr, a) = EditCmd(*VGM_SourceRAM_cmdPtr(vsr, a), 0xFF, 0, button, state, 0xFF, 0xFF);
             }
         }
     }
@@ -884,7 +885,7 @@ void Mode_Vgm_EncDatawheel(s32 incrementer){
             VgmSourceRAM* vsr = (VgmSourceRAM*)selvgm->data;
             s32 a = head->srcaddr;
             if(a < 0 || a >= vsr->numcmds) return;
-            vsr->cmds[a] = EditCmd(vsr->cmds[a], FP_E_DATAWHEEL, incrementer, 0xFF, 0, 0xFF, 0xFF);
+            *VGM_SourceRAM_cmdPtr(vsr, a) = EditCmd(*VGM_SourceRAM_cmdPtr(vsr, a), FP_E_DATAWHEEL, incrementer, 0xFF, 0, 0xFF, 0xFF);
         }
     }
 }
@@ -986,7 +987,7 @@ void Mode_Vgm_EncEdit(u8 encoder, s32 incrementer){
             VgmSourceRAM* vsr = (VgmSourceRAM*)selvgm->data;
             s32 a = head->srcaddr;
             if(a < 0 || a >= vsr->numcmds) return;
-            vsr->cmds[a] = EditCmd(vsr->cmds[a], encoder, incrementer, 0xFF, 0, 0xFF, 0xFF);
+            *VGM_SourceRAM_cmdPtr(vsr, a) = EditCmd(*VGM_SourceRAM_cmdPtr(vsr, a), encoder, incrementer, 0xFF, 0, 0xFF, 0xFF);
         }
     }
 }
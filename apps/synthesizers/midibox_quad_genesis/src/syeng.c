@@ -116,6 +116,7 @@ static void VoiceReset(u8 g, u8 v){
             //Start playing
             VGM_Head_Restart(head, VGM_Player_GetVGMTime());
             head->playing = 1;
+            VGM_Player_Schedule(head);
         }else{
             VGM_ResetChipVoiceAsync(g, v);
         }
@@ -143,6 +144,7 @@ static void ReleaseAllPI(synproginstance_t* pi){
             //FM voice
             v = pimap.map_voice+1;
             sg->channels[v].ALL = 0;
+            SyEng_VoiceUseChanged(g, v);
             VoiceReset(g, v);
             //See if this chip has any voice using LFO
             for(v=1; v<7; ++v) if(sg->channels[v].lfo) break;
@@ -152,15 +154,18 @@ static void ReleaseAllPI(synproginstance_t* pi){
         }else if(i == 7){
             //DAC
             sg->channels[7].ALL = 0;
+            SyEng_VoiceUseChanged(g, 7);
             VoiceReset(g, 7);
         }else if(i >= 8 && i <= 10){
             //SQ voice
             v = pimap.map_voice+8;
             sg->channels[v].ALL = 0;
+            SyEng_VoiceUseChanged(g, v);
             VoiceReset(g, v);
         }else{
             //Noise
             sg->channels[11].ALL = 0;
+            SyEng_VoiceUseChanged(g, 11);
             sg->noisefreqsq3 = 0;
             VoiceReset(g, 11);
         }
@@ -198,16 +203,18 @@ void SyEng_ClearVoice(u8 g, u8 v){
         ClearPI(&proginstances[syngenesis[g].channels[v].pi_using]);
     }
     syngenesis[g].channels[v].use = 0;
+    SyEng_VoiceUseChanged(g, v);
 }
 
 static void SetPIMappedVoicesUse(synproginstance_t* pi, u8 use){
-    u8 i, v;
+    u8 i, g, v;
     VgmHead_Channel pimap;
     syngenesis_t* sg;
     for(i=0; i<12; ++i){
         pimap = pi->mapping[i];
         if(pimap.nodata) continue;
-        sg = &syngenesis[pimap.map_chip];
+        g = pimap.map_chip;
+        sg = &syngenesis[g];
         if(i == 0){
             if(pimap.option){
                 //Only using globals for LFO
@@ -216,6 +223,7 @@ static void SetPIMappedVoicesUse(synproginstance_t* pi, u8 use){
                 //We were using OPN2 globals
                 for(v=0; v<8; ++v){
                     sg->channels[v].use = use;
+                    SyEng_VoiceUseChanged(g, v);
                 }
                 //Skip to PSG section
                 i = 7;
@@ -225,16 +233,20 @@ static void SetPIMappedVoicesUse(synproginstance_t* pi, u8 use){
             //FM voice
             v = pimap.map_voice;
             sg->channels[v+1].use = use;
+            SyEng_VoiceUseChanged(g, v+1);
         }else if(i == 7){
             //DAC
             sg->channels[7].use = use;
+            SyEng_VoiceUseChanged(g, 7);
         }else if(i >= 8 && i <= 10){
             //SQ voice
             v = pimap.map_voice;
             sg->channels[v+8].use = use;
+            SyEng_VoiceUseChanged(g, v+8);
         }else{
             //Noise
             sg->channels[11].use = use;
+            SyEng_VoiceUseChanged(g, 11);
         }
     }
 }
@@ -302,6 +314,7 @@ static void AssignVoiceToGenesis(u8 piindex, synproginstance_t* pi, u8 g, u8 vso
         map_voice = 0;
     }
     sgusage->use = 2; //pi->isstatic ? 3 : 2;
+    SyEng_VoiceUseChanged(g, vdest);
     sgusage->pi_using = piindex;
     //Map PI
     pi->mapping[vsource] = (VgmHead_Channel){.nodata = 0, .mute = 0, .map_chip = g, .map_voice = map_voice, .option = vlfo};
@@ -321,7 +334,7 @@ static void AssignVoiceToGenesis(u8 piindex, synproginstance_t* pi, u8 g, u8 vso
     }
 }
 
-static void FindBestVoice(s8* bestg, s8* bestv, u32 now, s8 forceg, u8 vstart, u8 vend, u8 sumoverv){
+static void FindBestVoiceScan(s8* bestg, s8* bestv, u32 now, s8 forceg, u8 vstart, u8 vend, u8 sumoverv){
     u16 score, totalscore, bestscore = 0x7FFF;
     u32 recency, totalrecency, maxrecency = 0;
     u8 g, v, use;
@@ -368,6 +381,75 @@ static void FindBestVoice(s8* bestg, s8* bestv, u32 now, s8 forceg, u8 vstart, u
             }
         }
     }
+}
+
+static u8 FindFreeVoice(s8* bestg, s8* bestv, s8 forceg, u8 vstart, u8 vend, u8 sumoverv){
+    //A free voice always scores lowest in FindBestVoiceScan, and all free
+    //voices have the same recency, so the first free one in scan order wins.
+    //This can be answered from the free voice bitmaps without scoring anything.
+    u8 g;
+    u8 gstart = (forceg < 0) ? 0 : forceg;
+    u8 gend = (forceg < 0) ? GENESIS_COUNT : forceg+1;
+    u16 range = ((1 << (vend+1)) - 1) & ~((1 << vstart) - 1);
+    u16 penalized = (vstart == 1 && vend == 6) ? ((1 << 3) | (1 << 6)) : 0;
+    u16 free;
+    if(sumoverv){
+        //Need the whole range free
+        for(g=gstart; g<gend; ++g){
+            if((syngenesis[g].freevoices & range) == range){
+                *bestg = g;
+                *bestv = vstart;
+                return 1;
+            }
+        }
+        return 0;
+    }
+    //Prefer unpenalized voices on any chip over penalized ones
+    for(g=gstart; g<gend; ++g){
+        free = syngenesis[g].freevoices & range & ~penalized;
+        if(free){
+            *bestg = g;
+            *bestv = __builtin_ctz(free);
+            return 1;
+        }
+    }
+    if(!penalized) return 0;
+    for(g=gstart; g<gend; ++g){
+        free = syngenesis[g].freevoices & penalized;
+        if(free){
+            *bestg = g;
+            *bestv = __builtin_ctz(free);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#if SYENG_CHECK_VOICE_INDEX
+u32 syeng_voice_index_errors;
+u8 syeng_voice_index_check = 1;
+u32 syeng_rated_voices;
+u32 syeng_rated_pis;
+#endif
+
+static void FindBestVoice(s8* bestg, s8* bestv, u32 now, s8 forceg, u8 vstart, u8 vend, u8 sumoverv){
+    if(!FindFreeVoice(bestg, bestv, forceg, vstart, vend, sumoverv)){
+        //All candidates in use, rate them to find the one to replace
+        FindBestVoiceScan(bestg, bestv, now, forceg, vstart, vend, sumoverv);
+#if SYENG_CHECK_VOICE_INDEX
+        syeng_rated_voices += ((forceg < 0) ? GENESIS_COUNT : 1) * (vend - vstart + 1);
+#endif
+    }
+#if SYENG_CHECK_VOICE_INDEX
+    if(syeng_voice_index_check){
+        s8 scang, scanv;
+        FindBestVoiceScan(&scang, &scanv, now, forceg, vstart, vend, sumoverv);
+        if(scang != *bestg || scanv != *bestv){
+            ++syeng_voice_index_errors;
+            DBG("FindBestVoice index mismatch: G%d V%d, scan G%d V%d", *bestg, *bestv, scang, scanv);
+        }
+    }
+#endif
     DBG("FindBestVoice asked forceg %d voices %d-%d sumoverv %d, result G%d V%d", forceg, vstart, vend, sumoverv, *bestg, *bestv);
 }
 
@@ -676,6 +758,9 @@ static u8 FindBestPIToReplace(u8 chn, u8 note){
             maxrecency = recency;
         }
     }
+#if SYENG_CHECK_VOICE_INDEX
+    syeng_rated_pis += MBQG_NUM_PROGINSTANCES;
+#endif
     return bestrated;
 }
 
@@ -695,6 +780,7 @@ void SyEng_Init(){
     //Initialize syngenesis
     for(i=0; i<GENESIS_COUNT; ++i){
         syngenesis[i].optionbits = 0;
+        syngenesis[i].freevoices = 0x0FFF;
         for(j=0; j<12; ++j){
             syngenesis[i].channels[j].ALL = 0;
         }
@@ -853,6 +939,7 @@ void SyEng_PlayVGMOnPI(synproginstance_t* pi, VgmSource* source, synprogram_t* p
     VGM_Head_Restart(pi->head, vgmtime);
     //DBG("PlayVGMOnPi after restart, iswait %d iswrite %d isdone %d firstoftwo %d, cmd %08X", pi->head->iswait, pi->head->iswrite, pi->head->isdone, pi->head->firstoftwo, pi->head->writecmd.all);
     pi->head->playing = startplaying;
+    VGM_Player_Schedule(pi->head);
     pi->recency = vgmtime;
 }
 
@@ -1143,7 +1230,7 @@ s32 SyEng_LoadProgram(char* filepath, synprogram_t* prog){
     return ret;
 }
 
-inline u8 TurnProgPathIntoVGMPath(char* tempbuf, char* filenamestart, u8 v){
+static inline u8 TurnProgPathIntoVGMPath(char* tempbuf, char* filenamestart, u8 v){
     u8 sl = strlen(vgmtypelabels[v]);
     memcpy(filenamestart, vgmtypelabels[v], sl);
     char* filenameend = filenamestart + sl;
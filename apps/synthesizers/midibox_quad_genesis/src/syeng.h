@@ -39,12 +39,22 @@ typedef struct {
         };
     };
     u8 dummy2;
-    u16 dummy3;
+    u16 freevoices; //Bit v set if channels[v].use == 0, see SyEng_VoiceUseChanged
     syngenesis_usage_t channels[12];
 } syngenesis_t;
 
 extern syngenesis_t syngenesis[GENESIS_COUNT];
 
+//Has to be called after every change to syngenesis[g].channels[v].use, so the
+//free voice bitmap used by the voice allocator stays up to date
+static inline void SyEng_VoiceUseChanged(u8 g, u8 v){
+    if(syngenesis[g].channels[v].use){
+        syngenesis[g].freevoices &= ~(1 << v);
+    }else{
+        syngenesis[g].freevoices |= (1 << v);
+    }
+}
+
 typedef struct {
     VgmUsageBits usage;
     VgmSource* initsource;
@@ -97,6 +107,22 @@ typedef struct {
 
 extern synchannel_t channels[16*MBQG_NUM_PORTS];
 
+//Set to 1 to compare every voice found via the free voice bitmaps with a full
+//scan of all voices; mismatches are counted in syeng_voice_index_errors.
+//The check can be switched off at runtime with syeng_voice_index_check = 0,
+//syeng_rated_voices/pis count the voices and proginstances which have been
+//rated to find one to replace
+#ifndef SYENG_CHECK_VOICE_INDEX
+#define SYENG_CHECK_VOICE_INDEX 0
+#endif
+
+#if SYENG_CHECK_VOICE_INDEX
+extern u32 syeng_voice_index_errors;
+extern u8 syeng_voice_index_check;
+extern u32 syeng_rated_voices;
+extern u32 syeng_rated_pis;
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 extern u8 voiceclearfull;
@@ -881,6 +881,7 @@ u16 MbSidSeLead::parGet(u8 par, u8 sidlr, u8 ins, bool scaleTo16bit)
             waveform.SYNC = v->voiceWaveformSync;
             waveform.RINGMOD = v->voiceWaveformRingmod;
             waveform.WAVEFORM = v->voiceWaveform;
+            value = waveform.ALL;
             if( scaleTo16bit ) value <<= 9;
         } break;
 
@@ -567,15 +567,6 @@ u8 MbSidSeMulti::knobGet(u8 knob)
 /////////////////////////////////////////////////////////////////////////////
 void MbSidSeMulti::parSet(u8 par, u16 value, u8 sidlr, u8 ins, bool scaleFrom16bit)
 {
-    u8 voiceSel;
-    u8 insSel;
-    switch( par & 3 ) {
-    case 1: insSel = sidlr; voiceSel = (sidlr&1) | ((sidlr&2)<<2); break; // selected voices
-    case 2: insSel = 0; voiceSel = 1; break; // first voice only
-    case 3: insSel = 1; voiceSel = 0x08; break; // second voice only
-    default: insSel = 3; voiceSel = 0x09; break; // both voices
-    }
-
     //MbSidVoice *v = mbSidVoice.first();
 
     if( par <= 0x07 ) {
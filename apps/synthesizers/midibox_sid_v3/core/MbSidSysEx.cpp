@@ -386,14 +386,12 @@ void MbSidSysEx::cmdParWrite(mios32_midi_port_t port, mbsid_sysex_cmd_state_t cm
 void MbSidSysEx::cmdExtra(mios32_midi_port_t port, mbsid_sysex_cmd_state_t cmd_state, u8 midi_in)
 {
     static int extra_cmd = 0;
-    static int play_instrument = 0;
 
     switch( cmd_state ) {
 
     case SYSEX_CMD_STATE_BEGIN:
         sysexState.TYPE_RECEIVED = 0;
         extra_cmd = 0;
-        play_instrument = 0;
         break;
 
     case SYSEX_CMD_STATE_CONT:
@@ -412,8 +410,7 @@ void MbSidSysEx::cmdExtra(mios32_midi_port_t port, mbsid_sysex_cmd_state_t cmd_s
                 break; // nothing else to do
 
             case 0x09: // Play current patch
-                play_instrument = midi_in;
-                break;
+                break; // the instrument isn't evaluated yet
             }
         }
         break;
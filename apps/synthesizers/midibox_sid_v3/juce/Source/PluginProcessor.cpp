@@ -99,6 +99,16 @@ MidiboxSidAudioProcessor::MidiboxSidAudioProcessor()
 
     // trigger reset
     RESID_Update(2);
+
+    // will be set to the block size of the host in prepareToPlay()
+    sidRenderMaxSamples = 512;
+
+    // start render threads (with the highest priority, JUCE v3 has no realtime audio priority)
+    for(int i=0; i<RESID_NUM_RENDER_THREADS; ++i) {
+        SidRenderThread *thread = new SidRenderThread(this, i+1);
+        sidRenderThreads.add(thread);
+        thread->startThread(10);
+    }
     
     // change pointer to physical SID registers
     u8 sid = 0;
@@ -110,6 +120,13 @@ MidiboxSidAudioProcessor::MidiboxSidAudioProcessor()
 
 MidiboxSidAudioProcessor::~MidiboxSidAudioProcessor()
 {
+    for(int i=0; i<sidRenderThreads.size(); ++i) {
+        sidRenderThreads[i]->signalThreadShouldExit();
+        sidRenderThreads[i]->startEvent.signal();
+        sidRenderThreads[i]->stopThread(1000);
+    }
+    sidRenderThreads.clear();
+
 #if SID_NUM
     for(int i=0; i<SID_NUM; ++i) {
         delete reSID[i];
@@ -277,7 +294,15 @@ void MidiboxSidAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
     reSidEnabled = 1;
     reSidSampleRate = sampleRate;
 
+    // processBlock() splits larger blocks, so that the register writes of a block
+    // always fit into the storage which is allocated here (no allocation in the audio thread)
+    if( samplesPerBlock > 0 )
+        sidRenderMaxSamples = samplesPerBlock;
+
     for(int i=0; i<SID_NUM; ++i) {
+        // at 1 kHz update frequency we get max. one register update per mS
+        sidRegWrites[i].ensureStorageAllocated((int)((sidRenderMaxSamples * MBSID_UPDATE_FRQ) / sampleRate + 2) * SID_REGS_NUM);
+
         reSID[i]->reset();
         if( !reSID[i]->set_sampling_parameters(RESID_FREQUENCY, RESID_SAMPLING_METHOD, reSidSampleRate) ) {
 #if DEBUG_VERBOSE_LEVEL >= 1
@@ -357,31 +382,41 @@ void MidiboxSidAudioProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuff
     
         // number of samples which have to be rendered
         int numSamples = buffer.getNumSamples();
-    
-        // add SID sound(s) to output(s)
-        // TK: this nested loop isn't optimal for CPU load, but we have to ensure that all SIDs are in lock-step
-        for(int i=0; i<numSamples; ++i) {
-            // update sound engine
-            mbSidUpdateCounter += (double)MBSID_UPDATE_FRQ / reSidSampleRate;
-            if( mbSidUpdateCounter >= 1.0 ) {
-                mbSidUpdateCounter -= 1.0;
+
+        // blocks which are larger than announced in prepareToPlay() are rendered in several parts
+        for(int offset=0; offset<numSamples; offset += sidRenderMaxSamples) {
+            int partSamples = numSamples - offset;
+            if( partSamples > sidRenderMaxSamples )
+                partSamples = sidRenderMaxSamples;
+
+            // update sound engine and collect the register writes with their sample offset
+            // this ensures that all SIDs are in lock-step, although they are rendered independently
+            for(int sid=0; sid<SID_NUM; ++sid)
+                sidRegWrites[sid].clearQuick();
+
+            for(int i=0; i<partSamples; ++i) {
+                mbSidUpdateCounter += (double)MBSID_UPDATE_FRQ / reSidSampleRate;
+                if( mbSidUpdateCounter >= 1.0 ) {
+                    mbSidUpdateCounter -= 1.0;
 #if RESID_PLAY_TESTTONE == 0
-                mbSidEnvironment.tick();
-                RESID_Update(0);
+                    mbSidEnvironment.tick();
+                    RESID_Update(0, i);
 #endif
+                }
             }
 
-            for(int channel = 0; channel < numChannels; ++channel) {
-                // poll for next sample
-                short sample_buf;
-                cycle_count delta_t = 1;
-                while( !reSID[channel]->clock(delta_t, &sample_buf, 1) )
-                    if( !delta_t ) // delta_t can be changed by clock()
-                        delta_t = 1;
+            // add SID sound(s) to output(s)
+            for(int sid=0; sid<SID_NUM; ++sid)
+                sidRenderDest[sid] = (sid < numChannels) ? buffer.getSampleData(sid, offset) : NULL;
+            sidRenderNumSamples = partSamples;
 
-                float currentSample = (float)sample_buf / 32768.0;
-                *buffer.getSampleData(channel, i) = currentSample;
-            }
+            for(int i=0; i<sidRenderThreads.size(); ++i)
+                sidRenderThreads[i]->startEvent.signal();
+
+            renderSids(0);
+
+            for(int i=0; i<sidRenderThreads.size(); ++i)
+                sidRenderThreads[i]->doneEvent.wait();
         }
     }
 #endif
@@ -517,7 +552,7 @@ static const u8 update_order[] = {
    // 25, 26, 27, 28, 29, 30, 31 // SwinSID registers
 };
 
-s32 MidiboxSidAudioProcessor::RESID_Update(u32 mode)
+s32 MidiboxSidAudioProcessor::RESID_Update(u32 mode, int sampleOffset)
 {
     // trigger reset?
     if( mode == 2 ) {
@@ -533,7 +568,16 @@ s32 MidiboxSidAudioProcessor::RESID_Update(u32 mode)
             u8 data;
             if( (data=sidRegs[sid].ALL[reg]) != sidRegsShadow[sid].ALL[reg] || mode >= 1 ) {
                 sidRegsShadow[sid].ALL[reg] = data;
-                reSID[sid]->write(reg, data);
+                if( sampleOffset < 0 ) {
+                    reSID[sid]->write(reg, data);
+                } else {
+                    // will be written by renderSid()
+                    SidRegWrite regWrite;
+                    regWrite.sampleOffset = sampleOffset;
+                    regWrite.reg = reg;
+                    regWrite.data = data;
+                    sidRegWrites[sid].add(regWrite);
+                }
             }
         }
     }
@@ -541,6 +585,96 @@ s32 MidiboxSidAudioProcessor::RESID_Update(u32 mode)
   return 0; // no error
 }
 
+
+/////////////////////////////////////////////////////////////////////////////
+// Renders all SIDs which are assigned to the given thread
+// (0: audio thread, >= 1: SidRenderThread)
+/////////////////////////////////////////////////////////////////////////////
+void MidiboxSidAudioProcessor::renderSids(int threadIndex)
+{
+#if SID_NUM
+    for(int sid=threadIndex; sid<SID_NUM; sid += sidRenderThreads.size() + 1)
+        renderSid(sid);
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Renders the current block of a single SID
+// The SID is clocked with a single clock() call between two register writes
+/////////////////////////////////////////////////////////////////////////////
+void MidiboxSidAudioProcessor::renderSid(int sid)
+{
+#if SID_NUM
+    SID *s = reSID[sid];
+    float *dest = sidRenderDest[sid];
+    short *sampleBuf = sidRenderBuffer[sid];
+    const int sampleBufSize = sizeof(sidRenderBuffer[sid]) / sizeof(short);
+    int numWrites = sidRegWrites[sid].size();
+    int writeIx = 0;
+    int pos = 0;
+
+    // SID not connected to an output channel: only take over register changes
+    if( dest == NULL ) {
+        for(writeIx=0; writeIx<numWrites; ++writeIx)
+            s->write(sidRegWrites[sid].getReference(writeIx).reg, sidRegWrites[sid].getReference(writeIx).data);
+        return;
+    }
+
+    while( pos < sidRenderNumSamples ) {
+        // apply all register writes at this position
+        while( writeIx < numWrites && sidRegWrites[sid].getReference(writeIx).sampleOffset <= pos ) {
+            s->write(sidRegWrites[sid].getReference(writeIx).reg, sidRegWrites[sid].getReference(writeIx).data);
+            ++writeIx;
+        }
+
+        // render until next register write
+        int endPos = (writeIx < numWrites) ? sidRegWrites[sid].getReference(writeIx).sampleOffset : sidRenderNumSamples;
+        if( endPos - pos > sampleBufSize )
+            endPos = pos + sampleBufSize;
+
+        int numSamples = endPos - pos;
+        int renderedSamples = 0;
+        while( renderedSamples < numSamples ) {
+            // clock() returns once the requested number of samples is available and the
+            // remaining cycles cover the next sample - the unused cycles are discarded
+            // therefore we pass the cycles of two additional samples
+            cycle_count delta_t = (cycle_count)((numSamples - renderedSamples + 2) * (RESID_FREQUENCY / reSidSampleRate)) + 2;
+            renderedSamples += s->clock(delta_t, &sampleBuf[renderedSamples], numSamples - renderedSamples);
+        }
+
+        for(int i=0; i<numSamples; ++i)
+            dest[pos+i] = (float)sampleBuf[i] / 32768.0;
+
+        pos = endPos;
+    }
+#endif
+}
+
+
+//==============================================================================
+SidRenderThread::SidRenderThread(MidiboxSidAudioProcessor *_processor, int _threadIndex)
+    : Thread("SID Renderer")
+    , processor(_processor)
+    , threadIndex(_threadIndex)
+{
+}
+
+void SidRenderThread::run()
+{
+    while( !threadShouldExit() ) {
+        if( !startEvent.wait(100) )
+            continue;
+
+        if( threadShouldExit() )
+            break;
+
+        processor->renderSids(threadIndex);
+        doneEvent.signal();
+    }
+}
+
+
 //==============================================================================
 // This creates new instances of the plugin..
 AudioProcessor* JUCE_CALLTYPE createPluginFilter()
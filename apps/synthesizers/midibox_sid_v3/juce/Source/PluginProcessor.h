@@ -23,6 +23,34 @@
 // if 0: emulation disabled
 #define SID_NUM 2
 
+// number of worker threads which render SIDs in parallel to the audio thread
+// if 0: all SIDs are rendered by the audio thread
+#ifndef RESID_NUM_RENDER_THREADS
+#define RESID_NUM_RENDER_THREADS (SID_NUM > 1 ? (SID_NUM-1) : 0)
+#endif
+
+class MidiboxSidAudioProcessor;
+
+//==============================================================================
+/**
+   Renders a subset of the SIDs while the audio thread renders the remaining ones
+*/
+class SidRenderThread
+    : public Thread
+{
+public:
+    SidRenderThread(MidiboxSidAudioProcessor *_processor, int _threadIndex);
+
+    void run();
+
+    WaitableEvent startEvent;
+    WaitableEvent doneEvent;
+
+private:
+    MidiboxSidAudioProcessor *processor;
+    int threadIndex;
+};
+
 
 //==============================================================================
 /**
@@ -122,7 +150,25 @@ public:
 
     sid_regs_t sidRegs[SID_NUM];
     sid_regs_t sidRegsShadow[SID_NUM];
-    s32 RESID_Update(u32 mode);
+    s32 RESID_Update(u32 mode, int sampleOffset = -1);
+
+    // register writes of the current block, they are applied at the given sample offset
+    struct SidRegWrite {
+        int sampleOffset;
+        u8 reg;
+        u8 data;
+    };
+#if SID_NUM
+    Array<SidRegWrite> sidRegWrites[SID_NUM];
+    float *sidRenderDest[SID_NUM];
+    short sidRenderBuffer[SID_NUM][256];
+#endif
+    int sidRenderNumSamples;
+    int sidRenderMaxSamples; // block size for which sidRegWrites are allocated
+    OwnedArray<SidRenderThread> sidRenderThreads;
+
+    void renderSids(int threadIndex);
+    void renderSid(int sid);
 
 private:
     //==============================================================================
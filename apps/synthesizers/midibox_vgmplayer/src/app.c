@@ -250,6 +250,7 @@ void APP_DIN_NotifyToggle(u32 pin, u32 pin_value){
                 vgmh->channel[i].map_chip = selgenesis;
             }
             vgmh->playing = 1;
+            VGM_Player_Schedule(vgmh);
         }else{
             VGM_Source_Delete(vgms);
         }
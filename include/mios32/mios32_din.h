@@ -20,11 +20,25 @@
 // Global definitions
 /////////////////////////////////////////////////////////////////////////////
 
+// scan the change flags of 4 shift registers with a single 32bit access
+// and only walk through the toggled pins
+#ifndef MIOS32_DIN_WORD_SCAN
+#define MIOS32_DIN_WORD_SCAN 1
+#endif
+
+// max. number of pin changes which are passed to a MIOS32_DIN_HandlerBatch() callback at once
+#ifndef MIOS32_DIN_BATCH_SIZE
+#define MIOS32_DIN_BATCH_SIZE 16
+#endif
 
 /////////////////////////////////////////////////////////////////////////////
 // Global Types
 /////////////////////////////////////////////////////////////////////////////
 
+typedef struct {
+  u16 pin;
+  u16 value;
+} mios32_din_change_t;
 
 /////////////////////////////////////////////////////////////////////////////
 // Prototypes
@@ -36,6 +50,7 @@ extern s32 MIOS32_DIN_PinGet(u32 pin);
 extern s32 MIOS32_DIN_SRGet(u32 sr);
 extern u8 MIOS32_DIN_SRChangedGetAndClear(u32 sr, u8 mask);
 extern s32 MIOS32_DIN_Handler(void *callback);
+extern s32 MIOS32_DIN_HandlerBatch(void *callback);
 
 
 /////////////////////////////////////////////////////////////////////////////
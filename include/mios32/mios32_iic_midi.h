@@ -204,6 +204,33 @@
 #define MIOS32_IIC_MIDI7_RI_N_PIN   18
 #endif
 
+#elif defined(MIOS32_FAMILY_EMULATION)
+// no RI_N pins available, all interfaces poll the receive status
+#ifndef MIOS32_IIC_MIDI0_ENABLED
+#define MIOS32_IIC_MIDI0_ENABLED    2
+#endif
+#ifndef MIOS32_IIC_MIDI1_ENABLED
+#define MIOS32_IIC_MIDI1_ENABLED    2
+#endif
+#ifndef MIOS32_IIC_MIDI2_ENABLED
+#define MIOS32_IIC_MIDI2_ENABLED    2
+#endif
+#ifndef MIOS32_IIC_MIDI3_ENABLED
+#define MIOS32_IIC_MIDI3_ENABLED    2
+#endif
+#ifndef MIOS32_IIC_MIDI4_ENABLED
+#define MIOS32_IIC_MIDI4_ENABLED    2
+#endif
+#ifndef MIOS32_IIC_MIDI5_ENABLED
+#define MIOS32_IIC_MIDI5_ENABLED    2
+#endif
+#ifndef MIOS32_IIC_MIDI6_ENABLED
+#define MIOS32_IIC_MIDI6_ENABLED    2
+#endif
+#ifndef MIOS32_IIC_MIDI7_ENABLED
+#define MIOS32_IIC_MIDI7_ENABLED    2
+#endif
+
 #else
 # warning "mios32_iic_midi.h not prepared for this MIOS32_FAMILY!"
 #endif
@@ -30,6 +30,76 @@
 #endif
 
 
+// size of the optional output ring of each USB, UART, IIC and SPI MIDI port (0 = disabled)
+// packages which are queued with MIOS32_MIDI_SendPackage_Queued() are forwarded
+// to the interfaces by MIOS32_MIDI_OutRing_Handler() in bursts
+// MIOS32_MIDI_SendPackage() forwards the queued packages of a port before it
+// sends a package directly, so that the order of the packages is kept
+// Each port allocates 4 bytes per package + 12 bytes
+// must be a power of two! (e.g. 16, 32, 64, ...)
+#ifndef MIOS32_MIDI_OUT_RING_SIZE
+#define MIOS32_MIDI_OUT_RING_SIZE 0
+#endif
+
+// MIOS32_MIDI_OutRing_Handler() takes this mutex while packages are forwarded
+// It has to be the same (recursive) mutex which is taken by the application
+// before MIOS32_MIDI_SendPackage() is called, e.g. in mios32_config.h:
+//   #define MIOS32_MIDI_OUT_RING_MUTEX_TAKE { APP_MUTEX_MIDIOUT_Take(); }
+//   #define MIOS32_MIDI_OUT_RING_MUTEX_GIVE { APP_MUTEX_MIDIOUT_Give(); }
+// Applications which send MIDI from a single task only can define {}
+#if MIOS32_MIDI_OUT_RING_SIZE
+# if !defined(MIOS32_MIDI_OUT_RING_MUTEX_TAKE) || !defined(MIOS32_MIDI_OUT_RING_MUTEX_GIVE)
+#  error "MIOS32_MIDI_OUT_RING_SIZE requires MIOS32_MIDI_OUT_RING_MUTEX_TAKE/GIVE (the MIDI OUT mutex)"
+# endif
+#else
+# ifndef MIOS32_MIDI_OUT_RING_MUTEX_TAKE
+#  define MIOS32_MIDI_OUT_RING_MUTEX_TAKE {}
+# endif
+# ifndef MIOS32_MIDI_OUT_RING_MUTEX_GIVE
+#  define MIOS32_MIDI_OUT_RING_MUTEX_GIVE {}
+# endif
+#endif
+
+
+// receive scheduler for UART, IIC and SPI based MIDI ports
+// 0: round robin over UART/IIC with max. 10 packages per MIOS32_MIDI_Receive_Handler() call,
+//    SPI packages are forwarded without limit
+// 1: deficit round robin over UART/IIC/SPI with weights, a budget per call and
+//    statistics, see MIOS32_MIDI_RxWeightSet() and MIOS32_MIDI_RxStatsGet()
+#ifndef MIOS32_MIDI_RX_SCHEDULER
+#define MIOS32_MIDI_RX_SCHEDULER 0
+#endif
+
+// max. number of UART, IIC and SPI packages which are forwarded by a single
+// MIOS32_MIDI_Receive_Handler() call (can be changed with MIOS32_MIDI_RxBudgetSet())
+#ifndef MIOS32_MIDI_RX_BUDGET
+#define MIOS32_MIDI_RX_BUDGET 32
+#endif
+
+// max. number of USB packages which are forwarded by a single
+// MIOS32_MIDI_Receive_Handler() call if the receive scheduler is enabled.
+// Remaining packages stay in the USB receive buffer, the host has to wait
+// until there is free space again
+#ifndef MIOS32_MIDI_RX_BUDGET_USB
+#define MIOS32_MIDI_RX_BUDGET_USB 64
+#endif
+
+// initial number of packages which are taken from a port before the next
+// port is served (can be changed with MIOS32_MIDI_RxWeightSet())
+// UARTs are preferred since their receive buffers are small
+#ifndef MIOS32_MIDI_RX_WEIGHT_UART
+#define MIOS32_MIDI_RX_WEIGHT_UART 4
+#endif
+
+#ifndef MIOS32_MIDI_RX_WEIGHT_IIC
+#define MIOS32_MIDI_RX_WEIGHT_IIC 1
+#endif
+
+#ifndef MIOS32_MIDI_RX_WEIGHT_SPI
+#define MIOS32_MIDI_RX_WEIGHT_SPI 4
+#endif
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Uses by MIOS32 SysEx parser
 /////////////////////////////////////////////////////////////////////////////
@@ -198,6 +268,21 @@ typedef enum {
 } mios32_midi_sysex_cmd_state_t;
 
 
+typedef struct {
+  u16 high_water; // max number of packages which have been stored in the ring
+  u16 queued;     // number of packages which are currently stored in the ring
+  u32 drops;      // number of packages which couldn't be queued due to a full ring
+} mios32_midi_out_ring_stats_t;
+
+
+typedef struct {
+  u32 received;   // number of packages which have been received
+  u32 starved;    // number of handler calls which ended with pending packages at this port
+  u32 overflows;  // number of bytes (UART) or packages (SPI) which have been lost due to a full receive buffer
+  u16 max_burst;  // max number of packages which have been forwarded by a single handler call
+} mios32_midi_rx_stats_t;
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Prototypes
 /////////////////////////////////////////////////////////////////////////////
@@ -213,6 +298,11 @@ extern s32 MIOS32_MIDI_RS_Reset(mios32_midi_port_t port);
 extern s32 MIOS32_MIDI_SendPackage_NonBlocking(mios32_midi_port_t port, mios32_midi_package_t package);
 extern s32 MIOS32_MIDI_SendPackage(mios32_midi_port_t port, mios32_midi_package_t package);
 
+extern s32 MIOS32_MIDI_SendPackage_Queued(mios32_midi_port_t port, mios32_midi_package_t package);
+extern s32 MIOS32_MIDI_OutRing_Handler(void);
+extern s32 MIOS32_MIDI_OutRing_StatsGet(mios32_midi_port_t port, mios32_midi_out_ring_stats_t *stats);
+extern s32 MIOS32_MIDI_OutRing_StatsReset(mios32_midi_port_t port);
+
 extern s32 MIOS32_MIDI_SendEvent(mios32_midi_port_t port, u8 evnt0, u8 evnt1, u8 evnt2);
 extern s32 MIOS32_MIDI_SendNoteOff(mios32_midi_port_t port, mios32_midi_chn_t chn, u8 note, u8 vel);
 extern s32 MIOS32_MIDI_SendNoteOn(mios32_midi_port_t port, mios32_midi_chn_t chn, u8 note, u8 vel);
@@ -244,8 +334,16 @@ extern s32 MIOS32_MIDI_SendDebugString(const char *str);
 extern s32 MIOS32_MIDI_SendDebugHexDump(const u8 *src, u32 len);
 
 extern s32 MIOS32_MIDI_ReceivePackage(mios32_midi_port_t port, mios32_midi_package_t package, void *_callback_package);
+extern s32 MIOS32_MIDI_ReceivePackageBlock(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 num, void *_callback_package);
 extern s32 MIOS32_MIDI_Receive_Handler(void *callback_event);
 
+extern s32 MIOS32_MIDI_RxWeightSet(mios32_midi_port_t port, u8 weight);
+extern s32 MIOS32_MIDI_RxWeightGet(mios32_midi_port_t port);
+extern s32 MIOS32_MIDI_RxBudgetSet(u16 budget);
+extern s32 MIOS32_MIDI_RxBudgetGet(void);
+extern s32 MIOS32_MIDI_RxStatsGet(mios32_midi_port_t port, mios32_midi_rx_stats_t *stats);
+extern s32 MIOS32_MIDI_RxStatsReset(void);
+
 extern s32 MIOS32_MIDI_Periodic_mS(void);
 
 extern s32 MIOS32_MIDI_DirectTxCallback_Init(s32 (*callback_tx)(mios32_midi_port_t port, mios32_midi_package_t package));
@@ -264,6 +362,7 @@ extern s32 MIOS32_MIDI_DeviceIDSet(u8 device_id);
 extern u8  MIOS32_MIDI_DeviceIDGet(void);
 
 extern s32 MIOS32_MIDI_SysExCallback_Init(s32 (*callback_sysex)(mios32_midi_port_t port, u8 sysex_byte));
+extern s32 MIOS32_MIDI_BlockCallback_Init(s32 (*callback_block)(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 num));
 
 extern s32 MIOS32_MIDI_DebugCommandCallback_Init(s32 (*callback_debug_command)(mios32_midi_port_t port, char c));
 extern s32 MIOS32_MIDI_FilebrowserCommandCallback_Init(s32 (*callback_filebrowser_command)(mios32_midi_port_t port, char c));
@@ -48,6 +48,13 @@ typedef struct mios32_osc_search_tree_t {
 } mios32_osc_search_tree_t;
 
 
+// search tree which has been prepared with MIOS32_OSC_CompileSearchTree()
+typedef struct {
+  const mios32_osc_search_tree_t *search_tree; // the original search tree
+  const void                     *root;        // dispatch table of the root level (located in the compile buffer)
+} mios32_osc_compiled_tree_t;
+
+
 typedef struct {
   u32 seconds;
   u32 fraction;
@@ -104,6 +111,8 @@ extern mios32_midi_package_t MIOS32_OSC_GetMIDI(u8 *buffer);
 extern u8 *MIOS32_OSC_PutMIDI(u8 *buffer, mios32_midi_package_t p);
 
 extern s32 MIOS32_OSC_ParsePacket(u8 *packet, u32 len, const mios32_osc_search_tree_t *search_tree);
+extern s32 MIOS32_OSC_CompileSearchTree(mios32_osc_compiled_tree_t *compiled_tree, const mios32_osc_search_tree_t *search_tree, u8 *buffer, u32 buffer_size);
+extern s32 MIOS32_OSC_ParsePacketCompiled(u8 *packet, u32 len, const mios32_osc_compiled_tree_t *compiled_tree);
 
 extern s32 MIOS32_OSC_SendDebugMessage(mios32_osc_args_t *osc_args, u32 method_arg);
 
@@ -80,6 +80,7 @@ extern s32 MIOS32_SPI_MIDI_Periodic_mS(void);
 extern s32 MIOS32_SPI_MIDI_PackageSend_NonBlocking(mios32_midi_package_t package);
 extern s32 MIOS32_SPI_MIDI_PackageSend(mios32_midi_package_t package);
 extern s32 MIOS32_SPI_MIDI_PackageReceive(mios32_midi_package_t *package);
+extern s32 MIOS32_SPI_MIDI_RxOverflowsGet(u8 spi_midi_port);
 
 
 /////////////////////////////////////////////////////////////////////////////
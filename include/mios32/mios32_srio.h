@@ -68,6 +68,9 @@
 // Global Types
 /////////////////////////////////////////////////////////////////////////////
 
+// 32bit access to mios32_srio_din[] and mios32_srio_din_changed[] (4 SRs per word, first SR in the lowest byte)
+// Note: u32 is 64bit wide when the emulation is compiled for a 64bit host
+typedef __UINT32_TYPE__ __attribute__((__may_alias__)) mios32_srio_word_t;
 
 /////////////////////////////////////////////////////////////////////////////
 // Prototypes
@@ -124,6 +124,7 @@ extern u32 MIOS32_UART_BaudrateGet(u8 uart);
 
 extern s32 MIOS32_UART_RxBufferFree(u8 uart);
 extern s32 MIOS32_UART_RxBufferUsed(u8 uart);
+extern s32 MIOS32_UART_RxBufferOverflowsGet(u8 uart);
 extern s32 MIOS32_UART_RxBufferGet(u8 uart);
 extern s32 MIOS32_UART_RxBufferPeek(u8 uart);
 extern s32 MIOS32_UART_RxBufferPut(u8 uart, u8 b);
@@ -67,6 +67,8 @@ extern s32 MIOS32_USB_MIDI_CheckAvailable(u8 cable);
 extern s32 MIOS32_USB_MIDI_PackageSend_NonBlocking(mios32_midi_package_t package);
 extern s32 MIOS32_USB_MIDI_PackageSend(mios32_midi_package_t package);
 extern s32 MIOS32_USB_MIDI_PackageReceive(mios32_midi_package_t *package);
+extern s32 MIOS32_USB_MIDI_PackageReceiveSpan(mios32_midi_package_t **packages);
+extern s32 MIOS32_USB_MIDI_PackageReceiveRelease(u32 num);
 
 extern s32 MIOS32_USB_MIDI_Periodic_mS(void);
 
@@ -253,6 +253,64 @@ s32 MIOS32_USB_MIDI_PackageReceive(mios32_midi_package_t *package)
   return rx_buffer_size;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+//! This function returns a pointer to the oldest received packages without
+//! copying them out of the receive buffer.<BR>
+//! Only the contiguous part of the ring buffer is returned, a wrap-around
+//! is delivered with the next call.<BR>
+//! The packages stay in the buffer until they have been released with
+//! \ref MIOS32_USB_MIDI_PackageReceiveRelease, accordingly the USB
+//! receive callback won't overwrite them in the meantime.
+//! \param[out] packages will point to the first received package
+//! \return 0 if no package in buffer
+//! \return > 0: number of contiguous packages which can be read via the pointer
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_PackageReceiveSpan(mios32_midi_package_t **packages)
+{
+  u16 tail, size;
+
+  // take a consistent snapshot - the size could be incremented by the USB callback
+  MIOS32_IRQ_Disable();
+  tail = rx_buffer_tail;
+  size = rx_buffer_size;
+  MIOS32_IRQ_Enable();
+
+  if( !size )
+    return 0;
+
+  if( size > (MIOS32_USB_MIDI_RX_BUFFER_SIZE - tail) )
+    size = MIOS32_USB_MIDI_RX_BUFFER_SIZE - tail;
+
+  *packages = (mios32_midi_package_t *)&rx_buffer[tail];
+
+  return size;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function releases packages which have been taken from the receive
+//! buffer with \ref MIOS32_USB_MIDI_PackageReceiveSpan
+//! \param[in] num number of packages which have been processed
+//! \return >= 0: number of packages which are still in the buffer
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_PackageReceiveRelease(u32 num)
+{
+  // this operation should be atomic!
+  MIOS32_IRQ_Disable();
+  if( num > rx_buffer_size ) // buffer has been cleared in the meantime
+    num = rx_buffer_size;
+  rx_buffer_tail += num;
+  if( rx_buffer_tail >= MIOS32_USB_MIDI_RX_BUFFER_SIZE )
+    rx_buffer_tail -= MIOS32_USB_MIDI_RX_BUFFER_SIZE;
+  rx_buffer_size -= num;
+  MIOS32_IRQ_Enable();
+
+  return rx_buffer_size;
+}
+
+
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -101,12 +101,16 @@ s32 MIOS32_USB_MIDI_ChangeConnectionState(u8 connected)
 
 /////////////////////////////////////////////////////////////////////////////
 //! This function returns the connection status of the USB MIDI interface
+//! \param[in] cable number
 //! \return 1: interface available
 //! \return 0: interface not available
 //! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
 /////////////////////////////////////////////////////////////////////////////
-s32 MIOS32_USB_MIDI_CheckAvailable(void)
+s32 MIOS32_USB_MIDI_CheckAvailable(u8 cable)
 {
+  if( cable >= MIOS32_USB_MIDI_NUM_PORTS )
+    return 0;
+
   return transfer_possible ? 1 : 0;
 }
 
@@ -130,7 +134,7 @@ s32 MIOS32_USB_MIDI_PackageSend_NonBlocking(mios32_midi_package_t package)
   if( tx_buffer_size >= (MIOS32_USB_MIDI_TX_BUFFER_SIZE-1) ) {
     // call USB handler, so that we are able to get the buffer free again on next execution
     // (this call simplifies polling loops!)
-    MIOS32_USB_MIDI_Handler();
+    MIOS32_USB_MIDI_TxBufferHandler();
 
     // device still available?
     // (ensures that polling loop terminates if cable has been disconnected)
@@ -210,14 +214,75 @@ s32 MIOS32_USB_MIDI_PackageReceive(mios32_midi_package_t *package)
   return rx_buffer_size;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+//! This function returns a pointer to the oldest received packages without
+//! copying them out of the receive buffer.<BR>
+//! Only the contiguous part of the ring buffer is returned, a wrap-around
+//! is delivered with the next call.<BR>
+//! The packages stay in the buffer until they have been released with
+//! \ref MIOS32_USB_MIDI_PackageReceiveRelease, accordingly the USB
+//! receive callback won't overwrite them in the meantime.
+//! \param[out] packages will point to the first received package
+//! \return 0 if no package in buffer
+//! \return > 0: number of contiguous packages which can be read via the pointer
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_PackageReceiveSpan(mios32_midi_package_t **packages)
+{
+  u16 tail, size;
+
+  // take a consistent snapshot - the size could be incremented by the USB callback
+  MIOS32_IRQ_Disable();
+  tail = rx_buffer_tail;
+  size = rx_buffer_size;
+  MIOS32_IRQ_Enable();
+
+  if( !size )
+    return 0;
+
+  if( size > (MIOS32_USB_MIDI_RX_BUFFER_SIZE - tail) )
+    size = MIOS32_USB_MIDI_RX_BUFFER_SIZE - tail;
+
+  *packages = (mios32_midi_package_t *)&rx_buffer[tail];
+
+  return size;
+}
+
 
 /////////////////////////////////////////////////////////////////////////////
-//! This handler should be called from a RTOS task to check for
+//! This function releases packages which have been taken from the receive
+//! buffer with \ref MIOS32_USB_MIDI_PackageReceiveSpan
+//! \param[in] num number of packages which have been processed
+//! \return >= 0: number of packages which are still in the buffer
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_USB_MIDI_PackageReceiveRelease(u32 num)
+{
+  // this operation should be atomic!
+  MIOS32_IRQ_Disable();
+  if( num > rx_buffer_size ) // buffer has been cleared in the meantime
+    num = rx_buffer_size;
+  rx_buffer_tail += num;
+  if( rx_buffer_tail >= MIOS32_USB_MIDI_RX_BUFFER_SIZE )
+    rx_buffer_tail -= MIOS32_USB_MIDI_RX_BUFFER_SIZE;
+  rx_buffer_size -= num;
+  MIOS32_IRQ_Enable();
+
+  return rx_buffer_size;
+}
+
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function should be called periodically each mS to check for
 //! incoming/outgoing USB packages
+//!
+//! Not for use in an application - this function is called from
+//! MIOS32_MIDI_Periodic_mS(), which is called by a task in the programming
+//! model!
 //! \return < 0 on errors
-//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
 /////////////////////////////////////////////////////////////////////////////
-s32 MIOS32_USB_MIDI_Handler(void)
+s32 MIOS32_USB_MIDI_Periodic_mS(void)
 {
   // check for received packages
   MIOS32_USB_MIDI_RxBufferHandler();
@@ -329,7 +394,7 @@ static void MIOS32_USB_MIDI_RxBufferHandler(void)
 //! Called by STM32 USB driver to check for IN streams
 //! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
 /////////////////////////////////////////////////////////////////////////////
-void MIOS32_USB_MIDI_EP1_IN_Callback(void)
+void MIOS32_USB_MIDI_EP1_IN_Callback(u8 bEP, u8 bEPStatus)
 {
   // package has been sent
   tx_buffer_busy = 0;
@@ -342,7 +407,7 @@ void MIOS32_USB_MIDI_EP1_IN_Callback(void)
 //! Called by STM32 USB driver to check for OUT streams
 //! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
 /////////////////////////////////////////////////////////////////////////////
-void MIOS32_USB_MIDI_EP1_OUT_Callback(void)
+void MIOS32_USB_MIDI_EP2_OUT_Callback(u8 bEP, u8 bEPStatus)
 {
   // put package into buffer
   rx_buffer_new_data = 1;
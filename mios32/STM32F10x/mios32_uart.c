@@ -99,6 +99,7 @@ static u8 rx_buffer[MIOS32_UART_NUM][MIOS32_UART_RX_BUFFER_SIZE];
 static volatile u8 rx_buffer_tail[MIOS32_UART_NUM];
 static volatile u8 rx_buffer_head[MIOS32_UART_NUM];
 static volatile u8 rx_buffer_size[MIOS32_UART_NUM];
+static volatile u32 rx_buffer_overflows[MIOS32_UART_NUM];
 
 static u8 tx_buffer[MIOS32_UART_NUM][MIOS32_UART_TX_BUFFER_SIZE];
 static volatile u8 tx_buffer_tail[MIOS32_UART_NUM];
@@ -470,6 +471,26 @@ s32 MIOS32_UART_RxBufferUsed(u8 uart)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! returns the number of bytes which couldn't be put into the receive buffer
+//! since startup because it was full (free running counter)
+//! \param[in] uart UART number (0..2)
+//! \return >= 0: number of lost bytes
+//! \note Applications shouldn't call these functions directly, instead please use \ref MIOS32_COM or \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_UART_RxBufferOverflowsGet(u8 uart)
+{
+#if MIOS32_UART_NUM == 0
+  return 0; // no UART available
+#else
+  if( uart >= MIOS32_UART_NUM || uart >= NUM_SUPPORTED_UARTS )
+    return 0;
+  else
+    return rx_buffer_overflows[uart];
+#endif
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! gets a byte from the receive buffer
 //! \param[in] uart UART number (0..2)
@@ -548,8 +569,10 @@ s32 MIOS32_UART_RxBufferPut(u8 uart, u8 b)
   if( uart >= MIOS32_UART_NUM || uart >= NUM_SUPPORTED_UARTS )
     return -1; // UART not available
 
-  if( rx_buffer_size[uart] >= MIOS32_UART_RX_BUFFER_SIZE )
+  if( rx_buffer_size[uart] >= MIOS32_UART_RX_BUFFER_SIZE ) {
+    ++rx_buffer_overflows[uart]; // byte will get lost if the caller doesn't retry
     return -2; // buffer full (retry)
+  }
 
   // copy received byte into receive buffer
   // this operation should be atomic!
@@ -22,6 +22,18 @@
 // this module can be optionally disabled in a local mios32_config.h file (included from mios32.h)
 #if !defined(MIOS32_DONT_USE_DIN)
 
+/////////////////////////////////////////////////////////////////////////////
+// Local prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+static u32 MIOS32_DIN_WordChangedGetAndClear(u32 word, u32 num_sr);
+static u32 MIOS32_DIN_WordGet(u32 word, u32 num_sr);
+static s32 MIOS32_DIN_ChangesScan(void (*notify)(mios32_din_change_t *changes, u32 num_changes, void *callback), void *callback);
+#if MIOS32_DIN_WORD_SCAN
+static void MIOS32_DIN_NotifyPins(mios32_din_change_t *changes, u32 num_changes, void *_callback);
+#endif
+static void MIOS32_DIN_NotifyBatch(mios32_din_change_t *changes, u32 num_changes, void *_callback);
+
 /////////////////////////////////////////////////////////////////////////////
 //! Initializes DIN driver
 //! \param[in] mode currently only mode 0 supported
@@ -128,6 +140,58 @@ u8 MIOS32_DIN_SRChangedGetAndClear(u32 sr, u8 mask)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! Returns and clears the change flags of 4 shift registers (word 0: SR 0..3,
+//! word 1: SR 4..7, ...). Unavailable SRs are masked out.
+/////////////////////////////////////////////////////////////////////////////
+static u32 MIOS32_DIN_WordChangedGetAndClear(u32 word, u32 num_sr)
+{
+  u32 changed;
+  u32 first_sr = 4*word;
+
+  if( (first_sr + 4) <= num_sr ) {
+    volatile mios32_srio_word_t *changed_word = (volatile mios32_srio_word_t *)&mios32_srio_din_changed[first_sr];
+
+    // skip idle SRs without disabling IRQs
+    if( !*changed_word )
+      return 0;
+
+    // get and clear changed flags - must be atomic!
+    MIOS32_IRQ_Disable();
+    changed = *changed_word;
+    *changed_word = 0;
+    MIOS32_IRQ_Enable();
+  } else {
+    u32 sr;
+
+    // remaining SRs of an incomplete word
+    changed = 0;
+    for(sr=first_sr; sr<num_sr; ++sr)
+      changed |= (u32)MIOS32_DIN_SRChangedGetAndClear(sr, 0xff) << (8*(sr-first_sr));
+  }
+
+  return changed;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the DIN values of 4 shift registers
+/////////////////////////////////////////////////////////////////////////////
+static u32 MIOS32_DIN_WordGet(u32 word, u32 num_sr)
+{
+  u32 first_sr = 4*word;
+
+  if( (first_sr + 4) <= num_sr )
+    return *(volatile mios32_srio_word_t *)&mios32_srio_din[first_sr];
+
+  u32 value = 0;
+  u32 sr;
+  for(sr=first_sr; sr<num_sr; ++sr)
+    value |= (u32)mios32_srio_din[sr] << (8*(sr-first_sr));
+
+  return value;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Checks for pin changes, and calls given callback function with following parameters:
 //! \code
@@ -138,9 +202,11 @@ u8 MIOS32_DIN_SRChangedGetAndClear(u32 sr, u8 mask)
 /////////////////////////////////////////////////////////////////////////////
 s32 MIOS32_DIN_Handler(void *_callback)
 {
-  s32 sr;
-  s32 sr_pin;
-  u8 changed;
+#if MIOS32_DIN_WORD_SCAN
+  // the toggled pins are collected like for MIOS32_DIN_HandlerBatch(),
+  // and passed one after another to the callback
+  return MIOS32_DIN_ChangesScan(MIOS32_DIN_NotifyPins, _callback);
+#else
   void (*callback)(u32 pin, u32 value) = _callback;
   u8 num_sr = MIOS32_SRIO_ScanNumGet();
 
@@ -156,6 +222,10 @@ s32 MIOS32_DIN_Handler(void *_callback)
   if( _callback == NULL )
     return -1;
 
+  s32 sr;
+  s32 sr_pin;
+  u8 changed;
+
   // check all shift registers for DIN pin changes
   for(sr=0; sr<num_sr; ++sr) {
     
@@ -176,10 +246,118 @@ s32 MIOS32_DIN_Handler(void *_callback)
 	MIOS32_SRIO_DebounceStart();
       }
   }
+#endif
 
   return 0;
 }
 
+
+/////////////////////////////////////////////////////////////////////////////
+//! Checks for pin changes, and calls given callback function with a list of
+//! all toggled pins (in ascending order):
+//! \code
+//!   void DIN_NotifyChanges(mios32_din_change_t *changes, u32 num_changes)
+//! \endcode
+//! If more than MIOS32_DIN_BATCH_SIZE pins have been toggled, the callback
+//! will be called multiple times.
+//! \param[in] _callback pointer to callback function
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_DIN_HandlerBatch(void *_callback)
+{
+  return MIOS32_DIN_ChangesScan(MIOS32_DIN_NotifyBatch, _callback);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Collects the toggled pins of all shift registers (in ascending order), and
+// passes them in blocks of max. MIOS32_DIN_BATCH_SIZE changes to <notify>
+// which forwards them to the application <callback>
+// Used by MIOS32_DIN_Handler() and MIOS32_DIN_HandlerBatch()
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_DIN_ChangesScan(void (*notify)(mios32_din_change_t *changes, u32 num_changes, void *callback), void *callback)
+{
+  mios32_din_change_t changes[MIOS32_DIN_BATCH_SIZE];
+  u32 num_changes = 0;
+  u8 num_sr = MIOS32_SRIO_ScanNumGet();
+  u32 word;
+
+  // no SRIOs?
+#if MIOS32_SRIO_NUM_SR == 0
+  return -1;
+#endif
+
+  if( num_sr == 0 )
+    return -1;
+
+  // no callback function?
+  if( callback == NULL )
+    return -1;
+
+  // check 4 shift registers at once for DIN pin changes
+  u32 num_words = (num_sr + 3) / 4;
+  for(word=0; word<num_words; ++word) {
+    u32 changed = MIOS32_DIN_WordChangedGetAndClear(word, num_sr);
+
+    // any pin change at these SRs?
+    if( !changed )
+      continue;
+
+    u32 value = MIOS32_DIN_WordGet(word, num_sr);
+
+    // only walk through the toggled pins
+    do {
+      u32 bit = __builtin_ctz(changed);
+      changed &= changed - 1;
+
+      changes[num_changes].pin = 32*word + bit;
+      changes[num_changes].value = (value >> bit) & 1;
+      if( ++num_changes >= MIOS32_DIN_BATCH_SIZE ) {
+	notify(changes, num_changes, callback);
+	num_changes = 0;
+      }
+    } while( changed );
+  }
+
+  if( num_changes )
+    notify(changes, num_changes, callback);
+
+  return 0;
+}
+
+
+#if MIOS32_DIN_WORD_SCAN
+/////////////////////////////////////////////////////////////////////////////
+// Forwards the collected changes pin by pin to a MIOS32_DIN_Handler() callback
+/////////////////////////////////////////////////////////////////////////////
+static void MIOS32_DIN_NotifyPins(mios32_din_change_t *changes, u32 num_changes, void *_callback)
+{
+  void (*callback)(u32 pin, u32 value) = _callback;
+
+  for(; num_changes; --num_changes, ++changes) {
+    // call the notification function
+    callback(changes->pin, changes->value);
+
+    // start debouncing (if enabled in SRIO driver)
+    MIOS32_SRIO_DebounceStart();
+  }
+}
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Forwards the collected changes to a MIOS32_DIN_HandlerBatch() callback
+/////////////////////////////////////////////////////////////////////////////
+static void MIOS32_DIN_NotifyBatch(mios32_din_change_t *changes, u32 num_changes, void *_callback)
+{
+  void (*callback)(mios32_din_change_t *changes, u32 num_changes) = _callback;
+
+  callback(changes, num_changes);
+
+  // start debouncing (if enabled in SRIO driver)
+  MIOS32_SRIO_DebounceStart();
+}
+
 //! \}
 
 #endif /* MIOS32_DONT_USE_DIN */
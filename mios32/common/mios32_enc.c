@@ -51,6 +51,21 @@ typedef union {
 } enc_state_t;
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// 4 SRs per word of mios32_srio_din_changed[]
+#define ENC_NUM_SR_WORDS ((MIOS32_SRIO_NUM_SR+3)/4)
+
+// no encoder assigned to a pin pair
+#define ENC_PIN_UNASSIGNED 0xff
+
+#if MIOS32_ENC_NUM_MAX > 255
+# error "MIOS32_ENC_NUM_MAX must be < 256"
+#endif
+
+
 /////////////////////////////////////////////////////////////////////////////
   // Local variables
   /////////////////////////////////////////////////////////////////////////////
@@ -59,6 +74,41 @@ mios32_enc_config_t enc_config[MIOS32_ENC_NUM_MAX];
 
 enc_state_t enc_state[MIOS32_ENC_NUM_MAX];
 
+// compiled transition table of each encoder: bit <state> triggers a DEC, bit <16+state> an INC
+static u32 enc_transitions[MIOS32_ENC_NUM_MAX];
+
+// the accelerator is decremented lazily: it's related to the tick of the last update
+static u16 enc_tick;
+static u16 enc_acc_tick[MIOS32_ENC_NUM_MAX];
+static u8 enc_acc_normalize_ix;
+
+// encoders which are assigned to DIN pins: [4*sr + pin_pair]
+static u8 enc_pin_lookup[4*MIOS32_SRIO_NUM_SR];
+
+// change flag masks of all assigned pins, 4 SRs per word
+static u32 enc_pin_mask[ENC_NUM_SR_WORDS];
+
+// one bit for each word of enc_pin_mask[] which contains assigned pins
+static u32 enc_active_words[(ENC_NUM_SR_WORDS+31)/32];
+
+// encoders which are controlled by the application (sr == 0)
+static u8 enc_app_list[MIOS32_ENC_NUM_MAX];
+static u8 enc_app_num;
+
+// one bit for each encoder which has been moved since the last MIOS32_ENC_Handler() call
+static u32 enc_moved[(MIOS32_ENC_NUM_MAX+31)/32];
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+static void MIOS32_ENC_ListAdd(u32 encoder);
+static void MIOS32_ENC_ListRemove(u32 encoder);
+static void MIOS32_ENC_AcceleratorUpdate(u32 encoder);
+static void MIOS32_ENC_Transition(u32 encoder);
+static u32 MIOS32_ENC_ChangedGetAndClear(u32 word, u32 mask);
+
 
 /////////////////////////////////////////////////////////////////////////////
 //! Initializes encoder driver
@@ -76,6 +126,8 @@ s32 MIOS32_ENC_Init(u32 mode)
   // clear encoder variables
   for(i=0; i<MIOS32_ENC_NUM_MAX; ++i) {
     enc_config[i].cfg.type = DISABLED; // disable encoder
+    enc_transitions[i] = 0;
+    enc_acc_tick[i] = 0;
 
     enc_state[i].state = 0xf; // all pins released
     enc_state[i].decinc = 0;
@@ -87,6 +139,20 @@ s32 MIOS32_ENC_Init(u32 mode)
     enc_state[i].predivider = 0;
   }
 
+  enc_tick = 0;
+  enc_acc_normalize_ix = 0;
+  enc_app_num = 0;
+
+  int ix;
+  for(ix=0; ix<4*MIOS32_SRIO_NUM_SR; ++ix)
+    enc_pin_lookup[ix] = ENC_PIN_UNASSIGNED;
+  for(ix=0; ix<ENC_NUM_SR_WORDS; ++ix)
+    enc_pin_mask[ix] = 0;
+  for(ix=0; ix<sizeof(enc_active_words)/sizeof(u32); ++ix)
+    enc_active_words[ix] = 0;
+  for(ix=0; ix<sizeof(enc_moved)/sizeof(u32); ++ix)
+    enc_moved[ix] = 0;
+
   return 0; // no error
 }
 
@@ -111,8 +177,16 @@ s32 MIOS32_ENC_ConfigSet(u32 encoder, mios32_enc_config_t config)
   if( encoder >= MIOS32_ENC_NUM_MAX )
     return -1; // invalid number
 
-  // take over new configuration
+  // take over new configuration and update the lists of active encoders
+  // this operation should be atomic, since MIOS32_ENC_UpdateStates() is called from the SRIO handler
+  MIOS32_IRQ_Disable();
+  if( enc_config[encoder].cfg.type != DISABLED )
+    MIOS32_ENC_AcceleratorUpdate(encoder);
+  MIOS32_ENC_ListRemove(encoder);
   enc_config[encoder] = config;
+  MIOS32_ENC_ListAdd(encoder);
+  enc_acc_tick[encoder] = enc_tick; // accelerator is frozen while the encoder is disabled
+  MIOS32_IRQ_Enable();
 
   return 0; // no error
 }
@@ -162,6 +236,8 @@ s32 MIOS32_ENC_StateSet(u32 encoder, u8 new_state)
   enc_state_t *enc_state_ptr = &enc_state[encoder];
   enc_state_ptr->last12 = enc_state_ptr->act12;
   enc_state_ptr->act12 = new_state;
+  if( enc_config[encoder].cfg.type != DISABLED && enc_config[encoder].cfg.sr != 0 )
+    enc_state_ptr->last12 = new_state; // state will be taken over from SRIO handler
   MIOS32_IRQ_Enable();
 
   return 0; // no error
@@ -186,178 +262,349 @@ s32 MIOS32_ENC_StateGet(u32 encoder)
 
 
 /////////////////////////////////////////////////////////////////////////////
-//! This function has to be called after a SRIO scan to update encoder states
-//! \return < 0 on errors
+//! Adds an encoder to the pin lookup table or to the list of application
+//! controlled encoders, and compiles its transition table
 /////////////////////////////////////////////////////////////////////////////
-s32 MIOS32_ENC_UpdateStates(void)
+static void MIOS32_ENC_ListAdd(u32 encoder)
 {
-  u8 enc;
+  mios32_enc_config_t *enc_config_ptr = &enc_config[encoder];
+  mios32_enc_type_t enc_type = enc_config_ptr->cfg.type;
 
-  // check all encoders
-  // Note: scanning of 64 encoders takes ca. 30 uS @ 72 MHz :-)
-  for(enc=0; enc<MIOS32_ENC_NUM_MAX; ++enc) {
-    mios32_enc_config_t *enc_config_ptr = &enc_config[enc];
+  if( enc_type == DISABLED ) {
+    enc_transitions[encoder] = 0;
+    return;
+  }
 
-    // skip if encoder not configured
-    if( enc_config_ptr->cfg.type == DISABLED )
-      continue;
+  // if Bit N of ENC_MODE is set, according ENC_STAT triggers Do_Inc / Do_Dec (see MIOS32_ENC_Transition())
+  enc_transitions[encoder] =
+    ((enc_type & (1 << 4)) ? (1 << 0x01) : 0) |
+    ((enc_type & (1 << 5)) ? (1 << 0x07) : 0) |
+    ((enc_type & (1 << 6)) ? (1 << 0x0e) : 0) |
+    ((enc_type & (1 << 7)) ? (1 << 0x08) : 0) |
+    ((enc_type & (1 << 0)) ? (1 << (16+0x02)) : 0) |
+    ((enc_type & (1 << 1)) ? (1 << (16+0x0b)) : 0) |
+    ((enc_type & (1 << 2)) ? (1 << (16+0x0d)) : 0) |
+    ((enc_type & (1 << 3)) ? (1 << (16+0x04)) : 0);
+
+  if( enc_config_ptr->cfg.sr == 0 ) {
+    enc_app_list[enc_app_num++] = encoder;
+  } else if( enc_config_ptr->cfg.sr <= MIOS32_SRIO_NUM_SR ) {
+    u32 ix = 4*(enc_config_ptr->cfg.sr-1) + (enc_config_ptr->cfg.pos >> 1);
+
+    // if multiple encoders are assigned to the same pins, only the first one gets the changes
+    if( enc_pin_lookup[ix] == ENC_PIN_UNASSIGNED || enc_pin_lookup[ix] > encoder )
+      enc_pin_lookup[ix] = encoder;
+
+    enc_pin_mask[ix / 16] |= 3U << (2*(ix % 16));
+    enc_active_words[ix / (16*32)] |= 1U << ((ix / 16) % 32);
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Removes an encoder from the pin lookup table or from the list of
+//! application controlled encoders
+/////////////////////////////////////////////////////////////////////////////
+static void MIOS32_ENC_ListRemove(u32 encoder)
+{
+  mios32_enc_config_t *enc_config_ptr = &enc_config[encoder];
+
+  if( enc_config_ptr->cfg.type == DISABLED )
+    return;
+
+  if( enc_config_ptr->cfg.sr == 0 ) {
+    int i;
+    for(i=0; i<enc_app_num; ++i) {
+      if( enc_app_list[i] == encoder ) {
+	for(; i<(enc_app_num-1); ++i)
+	  enc_app_list[i] = enc_app_list[i+1];
+	--enc_app_num;
+	break;
+      }
+    }
+  } else if( enc_config_ptr->cfg.sr <= MIOS32_SRIO_NUM_SR ) {
+    u32 ix = 4*(enc_config_ptr->cfg.sr-1) + (enc_config_ptr->cfg.pos >> 1);
+
+    if( enc_pin_lookup[ix] == encoder ) {
+      // search for another encoder which is assigned to the same pins
+      u32 enc;
+      enc_pin_lookup[ix] = ENC_PIN_UNASSIGNED;
+      for(enc=0; enc<MIOS32_ENC_NUM_MAX; ++enc) {
+	mios32_enc_config_t *cfg = &enc_config[enc];
+	if( enc != encoder && cfg->cfg.type != DISABLED && cfg->cfg.sr && (4*(cfg->cfg.sr-1) + (cfg->cfg.pos >> 1)) == ix ) {
+	  enc_pin_lookup[ix] = enc;
+	  break;
+	}
+      }
+
+      if( enc_pin_lookup[ix] == ENC_PIN_UNASSIGNED ) {
+	enc_pin_mask[ix / 16] &= ~(3U << (2*(ix % 16)));
+	if( !enc_pin_mask[ix / 16] )
+	  enc_active_words[ix / (16*32)] &= ~(1U << ((ix / 16) % 32));
+      }
+    }
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Applies the accelerator decrements since the last update
+/////////////////////////////////////////////////////////////////////////////
+static void MIOS32_ENC_AcceleratorUpdate(u32 encoder)
+{
+  enc_state_t *enc_state_ptr = &enc_state[encoder];
+  u16 elapsed = enc_tick - enc_acc_tick[encoder];
+
+  enc_state_ptr->accelerator = (enc_state_ptr->accelerator > elapsed) ? (enc_state_ptr->accelerator - elapsed) : 0;
+  enc_acc_tick[encoder] = enc_tick;
+}
 
-    enc_state_t *enc_state_ptr = &enc_state[enc];
 
-    // decrement accelerator until it is zero (used to determine rotation speed)
-    if( enc_state_ptr->accelerator )
-      --enc_state_ptr->accelerator;
-
-    // take over encoder state from SRIO handler if SR != 0
-    // (if SR configured with 0 we expect that the state is controlled from application, e.g. by scanning GPIOs)
-    if( enc_config_ptr->cfg.sr != 0 ) {
-      // check if encoder state has been changed, and clear changed flags, so that the changes won't be propagated to DIN handler
-      u8 sr = enc_config_ptr->cfg.sr-1;
-      u8 pos = enc_config_ptr->cfg.pos;
-      u8 pos_normalized = pos & 6; // (0, 2, 4 or 6)
-      u8 changed_mask = 3 << pos_normalized; // note: by checking mios32_srio_din_changed[sr] directly, we speed up the scanning of unmoved encoders by factor 3!
-      enc_state_ptr->last12 = enc_state_ptr->act12;
-      if( (mios32_srio_din_changed[sr] & changed_mask) && MIOS32_DIN_SRChangedGetAndClear(sr, changed_mask) ) {
+/////////////////////////////////////////////////////////////////////////////
+//! Returns and clears the masked change flags of 4 shift registers
+/////////////////////////////////////////////////////////////////////////////
+static u32 MIOS32_ENC_ChangedGetAndClear(u32 word, u32 mask)
+{
+  u32 changed;
+
+  if( (4*word + 4) <= MIOS32_SRIO_NUM_SR ) {
+    volatile mios32_srio_word_t *changed_word = (volatile mios32_srio_word_t *)&mios32_srio_din_changed[4*word];
+
+    // skip unmoved encoders without disabling IRQs
+    if( !(*changed_word & mask) )
+      return 0;
+
+    // get and clear changed flags - must be atomic!
+    MIOS32_IRQ_Disable();
+    changed = *changed_word & mask;
+    *changed_word &= ~changed;
+    MIOS32_IRQ_Enable();
+  } else {
+    u32 sr;
+
+    // remaining SRs of an incomplete word
+    changed = 0;
+    for(sr=4*word; sr<MIOS32_SRIO_NUM_SR; ++sr) {
+      u8 sr_mask = mask >> (8*(sr % 4));
+      if( mios32_srio_din_changed[sr] & sr_mask )
+	changed |= (u32)MIOS32_DIN_SRChangedGetAndClear(sr, sr_mask) << (8*(sr % 4));
+    }
+  }
+
+  return changed;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! This function has to be called after a SRIO scan to update encoder states
+//! Only encoders which are enabled, and whose pins have been toggled are
+//! processed, unmoved encoders don't consume any time.
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_ENC_UpdateStates(void)
+{
+  ++enc_tick;
+
+  // accelerators are updated when an encoder is moved
+  // refresh one encoder per tick, so that the 16bit tick difference can't overflow
+  if( enc_config[enc_acc_normalize_ix].cfg.type != DISABLED )
+    MIOS32_ENC_AcceleratorUpdate(enc_acc_normalize_ix);
+  if( ++enc_acc_normalize_ix >= MIOS32_ENC_NUM_MAX )
+    enc_acc_normalize_ix = 0;
+
+  // take over encoder states from SRIO handler
+  // only groups of 4 SRs which contain encoder pins are checked
+  u32 active_word_ix;
+  for(active_word_ix=0; active_word_ix<sizeof(enc_active_words)/sizeof(u32); ++active_word_ix) {
+    u32 active_words = enc_active_words[active_word_ix];
+
+    while( active_words ) {
+      u32 word = 32*active_word_ix + __builtin_ctz(active_words);
+      active_words &= active_words - 1;
+
+      // check if encoder states have been changed, and clear changed flags, so that the changes won't be propagated to DIN handler
+      u32 changed = MIOS32_ENC_ChangedGetAndClear(word, enc_pin_mask[word]);
+
+      while( changed ) {
+	u32 pair = __builtin_ctz(changed) / 2;
+	changed &= ~(3U << (2*pair));
+
+	u32 ix = 16*word + pair;
+	u8 enc = enc_pin_lookup[ix];
+	u8 sr = ix / 4;
+	u8 pos_normalized = 2*(ix % 4); // (0, 2, 4 or 6)
+
+	enc_state_t *enc_state_ptr = &enc_state[enc];
 	u8 state = (mios32_srio_din[sr] >> pos_normalized) & 3;
-	if( pos & 1 ) { // swap pins?
+	if( enc_config[enc].cfg.pos & 1 ) { // swap pins?
 	  state = ((state << 1) & 2) | (state >> 1);
 	}
+	enc_state_ptr->last12 = enc_state_ptr->act12;
 	enc_state_ptr->act12 = state;
+
+	// new encoder state?
+	if( enc_state_ptr->last12 != enc_state_ptr->act12 ) {
+	  MIOS32_ENC_Transition(enc);
+	  enc_state_ptr->last12 = enc_state_ptr->act12;
+	}
       }
     }
+  }
+
+  // encoders which are controlled from application, e.g. by scanning GPIOs
+  int i;
+  for(i=0; i<enc_app_num; ++i) {
+    u8 enc = enc_app_list[i];
+    enc_state_t *enc_state_ptr = &enc_state[enc];
 
     // new encoder state?
-    if( enc_state_ptr->last12 != enc_state_ptr->act12 ) {
-      mios32_enc_type_t enc_type = enc_config_ptr->cfg.type;
-      s32 predivider;
-      s32 acc;
-
-      // State Machine (own Design from 1999)
-      // changed 2000-1-5: special "analyse" state which corrects the ENC direction
-      // if encoder is rotated to fast - I should patent it ;-)
-      // changed 2009-09-14: new ENC_MODE-format, using Bits of ENC_MODE_xx to
-      // indicate edges, which trigger Do_Inc / Do_Dec
-
-      // if Bit N of ENC_MODE is set, according ENC_STAT triggers Do_Inc / Do_Dec
-      //
-      // Bit N     7   6   5   4  
-      // ENC_STAT  8   E   7   1
-      // DEC      <-  <-  <-  <-  
-      // Pin A ____|-------|_______
-      // Pin B ________|-------|___
-      // INC       ->  ->  ->  ->  
-      // ENC_STAT  2   B   D   4
-      // Bit N     0   1   2   3 
-      // This method is based on ideas from Avogra
-
-      if( (enc_state_ptr->state == 0x01 && (enc_type & (1 << 4))) ||
-	  (enc_state_ptr->state == 0x07 && (enc_type & (1 << 5))) ||
-	  (enc_state_ptr->state == 0x0e && (enc_type & (1 << 6))) ||
-	  (enc_state_ptr->state == 0x08 && (enc_type & (1 << 7))) ) {
-	// DEC
-	// plausibility check: when accelerator > 0xe0, exit if last event was a INC.
-	// if non-detented encoder: only do anything if the state has actually changed
-	if( (enc_state_ptr->decinc || enc_state_ptr->accelerator <= 0xe0) && 
-	    (enc_type != 0xff || enc_state_ptr->state != enc_state_ptr->prev_state_dec) ) {
-	  // memorize DEC
-	  enc_state_ptr->decinc = 1;
-
-	  // limit maximum increase of accelerator
-	  if( (int)enc_state_ptr->accelerator - (int)enc_state_ptr->prev_acc > 20) {
-	    enc_state_ptr->accelerator = enc_state_ptr->prev_acc + 20;
-	  }
-
-	  // branch depending on speed mode
-	  switch( enc_config_ptr->cfg.speed ) {
-	  case FAST: {
-	    // this mask leads to an improved "feeling": we've only 4 speed stages anymore, which especially means that the faster increments won't start so early
-	    // see also http://midibox.org/forums/topic/18820-optimizing-encoder-behavior-in-mbsid-firmware/?p=164539
-	    u32 speed = enc_state_ptr->accelerator & 0xc0;
-	    if( (acc=(speed >> (7-enc_config_ptr->cfg.speed_par))) == 0 )
-	      acc = 1;
-	    int new_incrementer = enc_state_ptr->incrementer - acc;
-	    if( new_incrementer < -70 ) // avoid overrun
-	      new_incrementer = -70;
-	    enc_state_ptr->incrementer = new_incrementer;
-	  } break;
-
-	  case SLOW:
-	    predivider = enc_state_ptr->predivider - (enc_config_ptr->cfg.speed_par+1);
-	    // increment on 4bit underrun
-	    if( predivider < 0 )
-	      --enc_state_ptr->incrementer;
-	    enc_state_ptr->predivider = predivider;
-	    break;
-
-	  default: // NORMAL
-	    --enc_state_ptr->incrementer;
-	    break;
-	  }
-	  // save last acceleration value
-	  enc_state_ptr->prev_acc = enc_state_ptr->accelerator;
-
-	  // set accelerator to max value (will be decremented on each tick, so that the encoder speed can be determined)
-	  enc_state_ptr->accelerator = 0xff;
-
-	  // save last state to compare whether the state changed in the next run
-	  enc_state_ptr->prev_state_dec = enc_state_ptr->state;
-	}
-      } else if( (enc_state_ptr->state == 0x02 && (enc_type & (1 << 0))) ||
-		 (enc_state_ptr->state == 0x0b && (enc_type & (1 << 1))) ||
-		 (enc_state_ptr->state == 0x0d && (enc_type & (1 << 2))) ||
-		 (enc_state_ptr->state == 0x04 && (enc_type & (1 << 3))) ) {
-	// INC
-	// plausibility check: when accelerator > 0xe0, exit if last event was a DEC
-	// if non-detented encoder: only do anything if the state has actually changed
-	if( (!enc_state_ptr->decinc || enc_state_ptr->accelerator <= 0xe0) &&
-	    (enc_type != 0xff || enc_state_ptr->state != enc_state_ptr->prev_state_inc) ) {
-	  // memorize INC
-	  enc_state_ptr->decinc = 0;
-
-	  // limit maximum increase of accelerator
-	  if( (int)enc_state_ptr->accelerator - (int)enc_state_ptr->prev_acc > 20) {
-	    enc_state_ptr->accelerator = enc_state_ptr->prev_acc + 20;
-	  }
-
-	  // branch depending on speed mode
-	  switch( enc_config_ptr->cfg.speed ) {
-	  case FAST: {
-	    // this mask leads to an improved "feeling": we've only 4 speed stages anymore, which especially means that the faster increments won't start so early
-	    // see also http://midibox.org/forums/topic/18820-optimizing-encoder-behavior-in-mbsid-firmware/?p=164539
-	    u32 speed = enc_state_ptr->accelerator & 0xc0;
-	    if( (acc=(speed >> (7-enc_config_ptr->cfg.speed_par))) == 0 )
-	      acc = 1;
-	    int new_incrementer = enc_state_ptr->incrementer + acc;
-	    if( new_incrementer > 70 ) // avoid overrun
-	      new_incrementer = 70;
-	    enc_state_ptr->incrementer = new_incrementer;
-	  } break;
-
-	  case SLOW:
-	    predivider = enc_state_ptr->predivider + (enc_config_ptr->cfg.speed_par+1);
-	    // increment on 4bit overrun
-	    if( predivider >= 16 )
-	      ++enc_state_ptr->incrementer;
-	    enc_state_ptr->predivider = predivider;
-	    break;
-
-	  default: // NORMAL
-	    ++enc_state_ptr->incrementer;
-	    break;
-	  }
-	  // save last acceleration value
-	  enc_state_ptr->prev_acc = enc_state_ptr->accelerator;
-
-	  // set accelerator to max value (will be decremented on each tick, so that the encoder speed can be determined)
-	  enc_state_ptr->accelerator = 0xff;
-
-	  //save last state to compare whether the state changed in the next run
-	  enc_state_ptr->prev_state_inc = enc_state_ptr->state;
-	}
+    if( enc_state_ptr->last12 != enc_state_ptr->act12 )
+      MIOS32_ENC_Transition(enc);
+  }
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Handles a new encoder state
+/////////////////////////////////////////////////////////////////////////////
+static void MIOS32_ENC_Transition(u32 encoder)
+{
+  mios32_enc_config_t *enc_config_ptr = &enc_config[encoder];
+  enc_state_t *enc_state_ptr = &enc_state[encoder];
+  u32 transitions = enc_transitions[encoder] >> enc_state_ptr->state;
+  mios32_enc_type_t enc_type = enc_config_ptr->cfg.type;
+  s32 predivider;
+  s32 acc;
+
+  // decrement accelerator until it is zero (used to determine rotation speed)
+  MIOS32_ENC_AcceleratorUpdate(encoder);
+
+  // State Machine (own Design from 1999)
+  // changed 2000-1-5: special "analyse" state which corrects the ENC direction
+  // if encoder is rotated to fast - I should patent it ;-)
+  // changed 2009-09-14: new ENC_MODE-format, using Bits of ENC_MODE_xx to
+  // indicate edges, which trigger Do_Inc / Do_Dec
+  // changed 2026-10-18: the edges are compiled into enc_transitions[] by MIOS32_ENC_ListAdd()
+
+  // if Bit N of ENC_MODE is set, according ENC_STAT triggers Do_Inc / Do_Dec
+  //
+  // Bit N     7   6   5   4  
+  // ENC_STAT  8   E   7   1
+  // DEC      <-  <-  <-  <-  
+  // Pin A ____|-------|_______
+  // Pin B ________|-------|___
+  // INC       ->  ->  ->  ->  
+  // ENC_STAT  2   B   D   4
+  // Bit N     0   1   2   3 
+  // This method is based on ideas from Avogra
+
+  if( transitions & (1 << 0) ) {
+    // DEC
+    // plausibility check: when accelerator > 0xe0, exit if last event was a INC.
+    // if non-detented encoder: only do anything if the state has actually changed
+    if( (enc_state_ptr->decinc || enc_state_ptr->accelerator <= 0xe0) && 
+	(enc_type != 0xff || enc_state_ptr->state != enc_state_ptr->prev_state_dec) ) {
+      // memorize DEC
+      enc_state_ptr->decinc = 1;
+
+      // limit maximum increase of accelerator
+      if( (int)enc_state_ptr->accelerator - (int)enc_state_ptr->prev_acc > 20) {
+	enc_state_ptr->accelerator = enc_state_ptr->prev_acc + 20;
       }
+
+      // branch depending on speed mode
+      switch( enc_config_ptr->cfg.speed ) {
+      case FAST: {
+	// this mask leads to an improved "feeling": we've only 4 speed stages anymore, which especially means that the faster increments won't start so early
+	// see also http://midibox.org/forums/topic/18820-optimizing-encoder-behavior-in-mbsid-firmware/?p=164539
+	u32 speed = enc_state_ptr->accelerator & 0xc0;
+	if( (acc=(speed >> (7-enc_config_ptr->cfg.speed_par))) == 0 )
+	  acc = 1;
+	int new_incrementer = enc_state_ptr->incrementer - acc;
+	if( new_incrementer < -70 ) // avoid overrun
+	  new_incrementer = -70;
+	enc_state_ptr->incrementer = new_incrementer;
+      } break;
+
+      case SLOW:
+	predivider = enc_state_ptr->predivider - (enc_config_ptr->cfg.speed_par+1);
+	// increment on 4bit underrun
+	if( predivider < 0 )
+	  --enc_state_ptr->incrementer;
+	enc_state_ptr->predivider = predivider;
+	break;
+
+      default: // NORMAL
+	--enc_state_ptr->incrementer;
+	break;
+      }
+      // save last acceleration value
+      enc_state_ptr->prev_acc = enc_state_ptr->accelerator;
+
+      // set accelerator to max value (will be decremented on each tick, so that the encoder speed can be determined)
+      enc_state_ptr->accelerator = 0xff;
+
+      // save last state to compare whether the state changed in the next run
+      enc_state_ptr->prev_state_dec = enc_state_ptr->state;
+
+      // notify MIOS32_ENC_Handler()
+      enc_moved[encoder / 32] |= 1U << (encoder % 32);
+    }
+  } else if( transitions & (1 << 16) ) {
+    // INC
+    // plausibility check: when accelerator > 0xe0, exit if last event was a DEC
+    // if non-detented encoder: only do anything if the state has actually changed
+    if( (!enc_state_ptr->decinc || enc_state_ptr->accelerator <= 0xe0) &&
+	(enc_type != 0xff || enc_state_ptr->state != enc_state_ptr->prev_state_inc) ) {
+      // memorize INC
+      enc_state_ptr->decinc = 0;
+
+      // limit maximum increase of accelerator
+      if( (int)enc_state_ptr->accelerator - (int)enc_state_ptr->prev_acc > 20) {
+	enc_state_ptr->accelerator = enc_state_ptr->prev_acc + 20;
+      }
+
+      // branch depending on speed mode
+      switch( enc_config_ptr->cfg.speed ) {
+      case FAST: {
+	// this mask leads to an improved "feeling": we've only 4 speed stages anymore, which especially means that the faster increments won't start so early
+	// see also http://midibox.org/forums/topic/18820-optimizing-encoder-behavior-in-mbsid-firmware/?p=164539
+	u32 speed = enc_state_ptr->accelerator & 0xc0;
+	if( (acc=(speed >> (7-enc_config_ptr->cfg.speed_par))) == 0 )
+	  acc = 1;
+	int new_incrementer = enc_state_ptr->incrementer + acc;
+	if( new_incrementer > 70 ) // avoid overrun
+	  new_incrementer = 70;
+	enc_state_ptr->incrementer = new_incrementer;
+      } break;
+
+      case SLOW:
+	predivider = enc_state_ptr->predivider + (enc_config_ptr->cfg.speed_par+1);
+	// increment on 4bit overrun
+	if( predivider >= 16 )
+	  ++enc_state_ptr->incrementer;
+	enc_state_ptr->predivider = predivider;
+	break;
+
+      default: // NORMAL
+	++enc_state_ptr->incrementer;
+	break;
+      }
+      // save last acceleration value
+      enc_state_ptr->prev_acc = enc_state_ptr->accelerator;
+
+      // set accelerator to max value (will be decremented on each tick, so that the encoder speed can be determined)
+      enc_state_ptr->accelerator = 0xff;
+
+      //save last state to compare whether the state changed in the next run
+      enc_state_ptr->prev_state_inc = enc_state_ptr->state;
+
+      // notify MIOS32_ENC_Handler()
+      enc_moved[encoder / 32] |= 1U << (encoder % 32);
     }
   }
-  return 0; // no error
 }
 
 
@@ -372,7 +619,7 @@ s32 MIOS32_ENC_UpdateStates(void)
 /////////////////////////////////////////////////////////////////////////////
 s32 MIOS32_ENC_Handler(void *_callback)
 {
-  u8 enc;
+  u32 word;
   s32 incrementer;
   void (*callback)(u32 pin, u32 value) = _callback;
 
@@ -380,19 +627,29 @@ s32 MIOS32_ENC_Handler(void *_callback)
   if( _callback == NULL )
     return -1;
 
-  // check all encoders
-  for(enc=0; enc<MIOS32_ENC_NUM_MAX; ++enc) {
-
+  // check all moved encoders
+  for(word=0; word<sizeof(enc_moved)/sizeof(u32); ++word) {
     // following check/modify operation must be atomic
     MIOS32_IRQ_Disable();
-    if( (incrementer = enc_state[enc].incrementer) ) {
-      enc_state[enc].incrementer = 0;
-      MIOS32_IRQ_Enable();
-
-      // call the hook
-      callback(enc, incrementer);
-    } else {
-      MIOS32_IRQ_Enable();
+    u32 moved = enc_moved[word];
+    enc_moved[word] = 0;
+    MIOS32_IRQ_Enable();
+
+    while( moved ) {
+      u32 enc = 32*word + __builtin_ctz(moved);
+      moved &= moved - 1;
+
+      // following check/modify operation must be atomic
+      MIOS32_IRQ_Disable();
+      if( (incrementer = enc_state[enc].incrementer) ) {
+	enc_state[enc].incrementer = 0;
+	MIOS32_IRQ_Enable();
+
+	// call the hook
+	callback(enc, incrementer);
+      } else {
+	MIOS32_IRQ_Enable();
+      }
     }
   }
 
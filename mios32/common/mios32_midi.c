@@ -128,6 +128,45 @@ typedef union {
 } sysex_timeout_ctr_flags_t;
 
 
+// receive functions of the UART, IIC (and SPI) based interfaces
+typedef struct {
+  mios32_midi_port_t port;
+  s32 (*receive_func)(u8 if_port, mios32_midi_package_t *package);
+} midi_intf_table_t;
+
+#if MIOS32_MIDI_RX_SCHEDULER
+// max. number of interfaces handled by the receive scheduler: 4 UARTs, 8 IICs, SPI
+#define MIOS32_MIDI_RX_INTF_MAX 13
+
+// statistics are kept for each port: the SPI interface (always the last one) serves SPIM0..SPIM7
+#define MIOS32_MIDI_RX_STATS_MAX (MIOS32_MIDI_RX_INTF_MAX + 7)
+
+typedef struct {
+  u16 deficit;   // number of packages which can still be taken in the current round
+  u8  weight;    // number of packages which are added to the deficit each round
+  u8  pending;   // set if the last receive call delivered a package
+} rx_intf_t;
+
+typedef struct {
+  u32 overflows_base; // overflow counter of the driver on last MIOS32_MIDI_RxStatsReset()
+  mios32_midi_rx_stats_t stats;
+} rx_port_stats_t;
+#endif
+
+#if MIOS32_MIDI_OUT_RING_SIZE
+// one output ring for each USB, UART, IIC and SPI port
+#define MIOS32_MIDI_OUT_RING_NUM (MIOS32_USB_MIDI_NUM_PORTS + MIOS32_UART_NUM + MIOS32_IIC_MIDI_NUM + MIOS32_SPI_MIDI_NUM_PORTS)
+
+typedef struct {
+  mios32_midi_package_t package[MIOS32_MIDI_OUT_RING_SIZE];
+  volatile u16 head; // only changed by MIOS32_MIDI_SendPackage_Queued()
+  volatile u16 tail; // only changed by MIOS32_MIDI_OutRing_Handler()
+  u16 high_water;
+  u32 drops;
+} out_ring_t;
+#endif
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Local variables
 /////////////////////////////////////////////////////////////////////////////
@@ -138,6 +177,7 @@ static mios32_midi_port_t debug_port   = MIOS32_MIDI_DEBUG_PORT;
 static s32 (*direct_rx_callback_func)(mios32_midi_port_t port, u8 midi_byte);
 static s32 (*direct_tx_callback_func)(mios32_midi_port_t port, mios32_midi_package_t package);
 static s32 (*sysex_callback_func)(mios32_midi_port_t port, u8 sysex_byte);
+static s32 (*block_callback_func)(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 num);
 static s32 (*timeout_callback_func)(mios32_midi_port_t port);
 static s32 (*debug_command_callback_func)(mios32_midi_port_t port, char c);
 static s32 (*filebrowser_command_callback_func)(mios32_midi_port_t port, char c);
@@ -165,6 +205,17 @@ static mios32_midi_port_t last_sysex_port = DEFAULT;
 static u16 sysex_timeout_ctr;
 static sysex_timeout_ctr_flags_t sysex_timeout_ctr_flags;
 
+#if MIOS32_MIDI_OUT_RING_SIZE
+static out_ring_t out_ring[MIOS32_MIDI_OUT_RING_NUM];
+#endif
+
+#if MIOS32_MIDI_RX_SCHEDULER
+static rx_intf_t rx_intf[MIOS32_MIDI_RX_INTF_MAX];
+static rx_port_stats_t rx_port_stats[MIOS32_MIDI_RX_STATS_MAX];
+static u8 rx_intf_next; // interface which is served next
+static u16 rx_budget;
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Local prototypes
@@ -180,6 +231,85 @@ static s32 MIOS32_MIDI_SYSEX_SendAck(mios32_midi_port_t port, u8 ack_code, u8 ac
 static s32 MIOS32_MIDI_SYSEX_SendAckStr(mios32_midi_port_t port, char *str);
 static s32 MIOS32_MIDI_TimeOut(mios32_midi_port_t port);
 
+static s32 MIOS32_MIDI_SendPackageToPort(mios32_midi_port_t port, mios32_midi_package_t package);
+
+#if MIOS32_MIDI_OUT_RING_SIZE
+static s32 MIOS32_MIDI_OutRingIx(mios32_midi_port_t port);
+static mios32_midi_port_t MIOS32_MIDI_OutRingPort(u32 ix);
+static s32 MIOS32_MIDI_OutRingForward(u32 ix);
+#endif
+
+#if MIOS32_MIDI_RX_SCHEDULER
+static s32 MIOS32_MIDI_RxScheduler(void *_callback_package);
+static s32 MIOS32_MIDI_RxIntfIx(mios32_midi_port_t port);
+static s32 MIOS32_MIDI_RxStatsIx(mios32_midi_port_t port);
+static mios32_midi_port_t MIOS32_MIDI_RxStatsPort(u32 ix);
+static u32 MIOS32_MIDI_RxOverflowsGet(mios32_midi_port_t port);
+#if !defined(MIOS32_DONT_USE_SPI) && !defined(MIOS32_DONT_USE_SPI_MIDI)
+static s32 MIOS32_MIDI_SPI_PackageReceive(u8 if_port, mios32_midi_package_t *package);
+#endif
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local constants
+/////////////////////////////////////////////////////////////////////////////
+
+static const midi_intf_table_t midi_intf_table[] = {
+#if !defined(MIOS32_DONT_USE_UART) && !defined(MIOS32_DONT_USE_UART_MIDI)
+#if MIOS32_UART_NUM >= 1
+  { UART0, MIOS32_UART_MIDI_PackageReceive },
+#endif
+#if MIOS32_UART_NUM >= 2
+  { UART1, MIOS32_UART_MIDI_PackageReceive },
+#endif
+#if MIOS32_UART_NUM >= 3
+  { UART2, MIOS32_UART_MIDI_PackageReceive },
+#endif
+#if MIOS32_UART_NUM >= 4
+  { UART3, MIOS32_UART_MIDI_PackageReceive },
+#endif
+#endif
+#if !defined(MIOS32_DONT_USE_IIC) && !defined(MIOS32_DONT_USE_IIC_MIDI)
+#if MIOS32_IIC_MIDI_NUM >= 1
+  { IIC0, MIOS32_IIC_MIDI_PackageReceive },
+#endif
+#if MIOS32_IIC_MIDI_NUM >= 2
+  { IIC1, MIOS32_IIC_MIDI_PackageReceive },
+#endif
+#if MIOS32_IIC_MIDI_NUM >= 3
+  { IIC2, MIOS32_IIC_MIDI_PackageReceive },
+#endif
+#if MIOS32_IIC_MIDI_NUM >= 4
+  { IIC3, MIOS32_IIC_MIDI_PackageReceive },
+#endif
+#if MIOS32_IIC_MIDI_NUM >= 5
+  { IIC4, MIOS32_IIC_MIDI_PackageReceive },
+#endif
+#if MIOS32_IIC_MIDI_NUM >= 6
+  { IIC5, MIOS32_IIC_MIDI_PackageReceive },
+#endif
+#if MIOS32_IIC_MIDI_NUM >= 7
+  { IIC6, MIOS32_IIC_MIDI_PackageReceive },
+#endif
+#if MIOS32_IIC_MIDI_NUM >= 8
+  { IIC7, MIOS32_IIC_MIDI_PackageReceive },
+#endif
+#endif
+#if MIOS32_MIDI_RX_SCHEDULER && !defined(MIOS32_DONT_USE_SPI) && !defined(MIOS32_DONT_USE_SPI_MIDI)
+  { SPIM0, MIOS32_MIDI_SPI_PackageReceive }, // SPIM0..7 are served as a single interface
+#endif
+  { 0, NULL } // end of table
+};
+
+#define MIOS32_MIDI_INTF_TABLE_NUM ((sizeof(midi_intf_table)/sizeof(midi_intf_table_t)) - 1)
+
+#if MIOS32_MIDI_RX_SCHEDULER && !defined(MIOS32_DONT_USE_SPI) && !defined(MIOS32_DONT_USE_SPI_MIDI)
+#define MIOS32_MIDI_RX_STATS_NUM (MIOS32_MIDI_INTF_TABLE_NUM + 7) // SPIM1..7 follow the SPIM0 entry
+#else
+#define MIOS32_MIDI_RX_STATS_NUM MIOS32_MIDI_INTF_TABLE_NUM
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 //! Initializes MIDI layer
@@ -202,6 +332,7 @@ s32 MIOS32_MIDI_Init(u32 mode)
   direct_rx_callback_func = NULL;
   direct_tx_callback_func = NULL;
   sysex_callback_func = NULL;
+  block_callback_func = NULL;
   timeout_callback_func = NULL;
   debug_command_callback_func = NULL;
   filebrowser_command_callback_func = NULL;
@@ -243,6 +374,43 @@ s32 MIOS32_MIDI_Init(u32 mode)
   sysex_timeout_ctr = 0;
   sysex_timeout_ctr_flags.ALL = 0;
 
+#if MIOS32_MIDI_OUT_RING_SIZE
+  // clear output rings
+  {
+    int i;
+    out_ring_t *r = &out_ring[0];
+    for(i=0; i<MIOS32_MIDI_OUT_RING_NUM; ++i, ++r) {
+      r->head = 0;
+      r->tail = 0;
+      r->high_water = 0;
+      r->drops = 0;
+    }
+  }
+#endif
+
+#if MIOS32_MIDI_RX_SCHEDULER
+  // initialize receive scheduler
+  {
+    int i;
+    rx_intf_t *intf = &rx_intf[0];
+    for(i=0; i<MIOS32_MIDI_INTF_TABLE_NUM; ++i, ++intf) {
+      switch( midi_intf_table[i].port & 0xf0 ) {
+      case UART0: intf->weight = MIOS32_MIDI_RX_WEIGHT_UART; break;
+      case IIC0:  intf->weight = MIOS32_MIDI_RX_WEIGHT_IIC; break;
+      default:    intf->weight = MIOS32_MIDI_RX_WEIGHT_SPI; break;
+      }
+      if( !intf->weight )
+	intf->weight = 1;
+      intf->deficit = 0;
+      intf->pending = 0;
+    }
+
+    rx_intf_next = 0;
+    rx_budget = MIOS32_MIDI_RX_BUDGET;
+    MIOS32_MIDI_RxStatsReset();
+  }
+#endif
+
   return -ret;
 }
 
@@ -502,6 +670,10 @@ s32 MIOS32_MIDI_SendPackage_NonBlocking(mios32_midi_port_t port, mios32_midi_pac
 //! This is a low level function - use the remaining MIOS32_MIDI_Send* functions
 //! to send specific MIDI events
 //! (blocking function)
+//!
+//! If MIOS32_MIDI_OUT_RING_SIZE is enabled, packages which are still queued
+//! in the output ring of the port are sent before the new package, so that
+//! direct sends (e.g. SysEx) can't overtake previously queued packages.
 //! \param[in] port MIDI port (DEFAULT, USB0..USB7, UART0..UART3, IIC0..IIC7, SPIM0..SPIM7)
 //! \param[in] package MIDI package
 //! \return -1 if port not available
@@ -514,6 +686,26 @@ s32 MIOS32_MIDI_SendPackage(mios32_midi_port_t port, mios32_midi_package_t packa
     port = (port == MIDI_DEBUG) ? debug_port : default_port;
   }
 
+#if MIOS32_MIDI_OUT_RING_SIZE
+  // forward queued packages of this port first
+  s32 ix = MIOS32_MIDI_OutRingIx(port);
+  if( ix >= 0 && out_ring[ix].tail != out_ring[ix].head ) {
+    MIOS32_MIDI_OUT_RING_MUTEX_TAKE;
+    MIOS32_MIDI_OutRingForward(ix);
+    MIOS32_MIDI_OUT_RING_MUTEX_GIVE;
+  }
+#endif
+
+  return MIOS32_MIDI_SendPackageToPort(port, package);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Sends a package over the given (mapped) port
+// used by MIOS32_MIDI_SendPackage() and for the packages of the output rings
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_MIDI_SendPackageToPort(mios32_midi_port_t port, mios32_midi_package_t package)
+{
   // insert subport number into package
   package.cable = port & 0xf;
 
@@ -561,6 +753,270 @@ s32 MIOS32_MIDI_SendPackage(mios32_midi_port_t port, mios32_midi_package_t packa
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! Queues a package in the output ring of the given port without blocking
+//! and without taking the MIDI OUT mutex, so that it can be called from
+//! multiple tasks at the same time.
+//! Note that the ring isn't lock-free: interrupts are disabled for the few
+//! instructions which store the package.
+//!
+//! The package will be forwarded with MIOS32_MIDI_SendPackage() by
+//! MIOS32_MIDI_OutRing_Handler(), which is called periodically from the
+//! MIDI task of the programming model.
+//!
+//! Only available if MIOS32_MIDI_OUT_RING_SIZE has been set in mios32_config.h
+//! \param[in] port MIDI port (DEFAULT, USB0..USB7, UART0..UART3, IIC0..IIC7, SPIM0..SPIM7)
+//! \param[in] package MIDI package
+//! \return -1 if the port has no output ring (or the rings are disabled)
+//!         caller should send the package with MIOS32_MIDI_SendPackage() instead
+//! \return -2 if the ring is full (the package hasn't been queued)
+//!         caller should send the package with MIOS32_MIDI_SendPackage() instead,
+//!         which forwards the queued packages of the port first
+//! \return 0 on success
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_SendPackage_Queued(mios32_midi_port_t port, mios32_midi_package_t package)
+{
+#if !MIOS32_MIDI_OUT_RING_SIZE
+  return -1; // output rings disabled
+#else
+  // if default/debug port: select mapped port
+  if( !(port & 0xf0) ) {
+    port = (port == MIDI_DEBUG) ? debug_port : default_port;
+  }
+
+  s32 ix = MIOS32_MIDI_OutRingIx(port);
+  if( ix < 0 )
+    return -1; // no output ring for this port
+
+  out_ring_t *r = &out_ring[ix];
+
+  // this operation should be atomic!
+  MIOS32_IRQ_Disable();
+  u16 queued = r->head - r->tail;
+  if( queued >= MIOS32_MIDI_OUT_RING_SIZE ) {
+    ++r->drops;
+    MIOS32_IRQ_Enable();
+    return -2; // ring full
+  }
+
+  r->package[r->head % MIOS32_MIDI_OUT_RING_SIZE] = package;
+  ++r->head;
+
+  if( ++queued > r->high_water )
+    r->high_water = queued;
+  MIOS32_IRQ_Enable();
+
+  return 0; // no error
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Forwards the packages of all output rings to the MIDI interfaces.
+//!
+//! The mutex defined with MIOS32_MIDI_OUT_RING_MUTEX_TAKE is only taken once
+//! for all pending packages.
+//!
+//! This function is called periodically by a task in the programming model.
+//! It can also be called by an application after a burst of queued packages
+//! (e.g. SEQ_MIDI_OUT_Handler() does this).
+//!
+//! \return -1 if the output rings are disabled
+//! \return >= 0: number of forwarded packages
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_OutRing_Handler(void)
+{
+#if !MIOS32_MIDI_OUT_RING_SIZE
+  return -1; // output rings disabled
+#else
+  s32 num_sent = 0;
+  u8 mutex_taken = 0;
+
+  int i;
+  out_ring_t *r = &out_ring[0];
+  for(i=0; i<MIOS32_MIDI_OUT_RING_NUM; ++i, ++r) {
+    if( r->tail == r->head )
+      continue;
+
+    if( !mutex_taken ) {
+      MIOS32_MIDI_OUT_RING_MUTEX_TAKE;
+      mutex_taken = 1;
+    }
+
+    num_sent += MIOS32_MIDI_OutRingForward(i);
+  }
+
+  if( mutex_taken ) {
+    MIOS32_MIDI_OUT_RING_MUTEX_GIVE;
+  }
+
+  return num_sent;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the statistics of the output ring of the given port
+//! \param[in] port MIDI port (DEFAULT, USB0..USB7, UART0..UART3, IIC0..IIC7, SPIM0..SPIM7)
+//! \param[out] stats high water mark, number of queued and dropped packages
+//! \return -1 if the port has no output ring (or the rings are disabled)
+//! \return 0 on success
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_OutRing_StatsGet(mios32_midi_port_t port, mios32_midi_out_ring_stats_t *stats)
+{
+#if !MIOS32_MIDI_OUT_RING_SIZE
+  return -1; // output rings disabled
+#else
+  // if default/debug port: select mapped port
+  if( !(port & 0xf0) ) {
+    port = (port == MIDI_DEBUG) ? debug_port : default_port;
+  }
+
+  s32 ix = MIOS32_MIDI_OutRingIx(port);
+  if( ix < 0 )
+    return -1; // no output ring for this port
+
+  out_ring_t *r = &out_ring[ix];
+
+  MIOS32_IRQ_Disable();
+  stats->high_water = r->high_water;
+  stats->queued = r->head - r->tail;
+  stats->drops = r->drops;
+  MIOS32_IRQ_Enable();
+
+  return 0; // no error
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Resets the high water mark and drop counter of the output ring of the given port
+//! \param[in] port MIDI port (DEFAULT, USB0..USB7, UART0..UART3, IIC0..IIC7, SPIM0..SPIM7)
+//! \return -1 if the port has no output ring (or the rings are disabled)
+//! \return 0 on success
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_OutRing_StatsReset(mios32_midi_port_t port)
+{
+#if !MIOS32_MIDI_OUT_RING_SIZE
+  return -1; // output rings disabled
+#else
+  // if default/debug port: select mapped port
+  if( !(port & 0xf0) ) {
+    port = (port == MIDI_DEBUG) ? debug_port : default_port;
+  }
+
+  s32 ix = MIOS32_MIDI_OutRingIx(port);
+  if( ix < 0 )
+    return -1; // no output ring for this port
+
+  out_ring_t *r = &out_ring[ix];
+
+  MIOS32_IRQ_Disable();
+  r->high_water = r->head - r->tail;
+  r->drops = 0;
+  MIOS32_IRQ_Enable();
+
+  return 0; // no error
+#endif
+}
+
+
+#if MIOS32_MIDI_OUT_RING_SIZE
+/////////////////////////////////////////////////////////////////////////////
+// Returns the output ring index of a given port
+// returns -1 if the port has no output ring
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_MIDI_OutRingIx(mios32_midi_port_t port)
+{
+  u8 ix = port & 0xf;
+
+  switch( port & 0xf0 ) {
+    case USB0://..15
+#if !defined(MIOS32_DONT_USE_USB) && !defined(MIOS32_DONT_USE_USB_MIDI)
+      if( ix < MIOS32_USB_MIDI_NUM_PORTS )
+	return ix;
+#endif
+      return -1;
+
+    case UART0://..15
+#if !defined(MIOS32_DONT_USE_UART) && !defined(MIOS32_DONT_USE_UART_MIDI)
+      if( ix < MIOS32_UART_NUM )
+	return MIOS32_USB_MIDI_NUM_PORTS + ix;
+#endif
+      return -1;
+
+    case IIC0://..15
+#if !defined(MIOS32_DONT_USE_IIC) && !defined(MIOS32_DONT_USE_IIC_MIDI)
+      if( ix < MIOS32_IIC_MIDI_NUM )
+	return MIOS32_USB_MIDI_NUM_PORTS + MIOS32_UART_NUM + ix;
+#endif
+      return -1;
+
+    case SPIM0://..15
+#if !defined(MIOS32_DONT_USE_SPI) && !defined(MIOS32_DONT_USE_SPI_MIDI)
+      if( ix < MIOS32_SPI_MIDI_NUM_PORTS )
+	return MIOS32_USB_MIDI_NUM_PORTS + MIOS32_UART_NUM + MIOS32_IIC_MIDI_NUM + ix;
+#endif
+      return -1;
+  }
+
+  return -1; // no output ring
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the port of a given output ring index (reverse of MIOS32_MIDI_OutRingIx())
+/////////////////////////////////////////////////////////////////////////////
+static mios32_midi_port_t MIOS32_MIDI_OutRingPort(u32 ix)
+{
+  if( ix < MIOS32_USB_MIDI_NUM_PORTS )
+    return USB0 + ix;
+  ix -= MIOS32_USB_MIDI_NUM_PORTS;
+
+  if( ix < MIOS32_UART_NUM )
+    return UART0 + ix;
+  ix -= MIOS32_UART_NUM;
+
+  if( ix < MIOS32_IIC_MIDI_NUM )
+    return IIC0 + ix;
+  ix -= MIOS32_IIC_MIDI_NUM;
+
+  return SPIM0 + ix;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Forwards the packages of the given output ring
+// has to be called while the mutex defined with MIOS32_MIDI_OUT_RING_MUTEX_TAKE is taken
+// returns the number of forwarded packages
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_MIDI_OutRingForward(u32 ix)
+{
+  out_ring_t *r = &out_ring[ix];
+
+  // read the positions while the mutex is taken, since the ring
+  // could have been forwarded by another task meanwhile
+  // packages which are queued while the ring is forwarded will be sent with the next invocation
+  u16 tail = r->tail;
+  u16 head = r->head;
+  s32 num_sent = 0;
+
+  mios32_midi_port_t port = MIOS32_MIDI_OutRingPort(ix);
+  while( tail != head ) {
+    MIOS32_IRQ_Disable();
+    mios32_midi_package_t package = r->package[tail % MIOS32_MIDI_OUT_RING_SIZE];
+    MIOS32_IRQ_Enable();
+
+    MIOS32_MIDI_SendPackageToPort(port, package);
+    r->tail = ++tail;
+    ++num_sent;
+  }
+
+  return num_sent;
+}
+#endif
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Sends a MIDI Event
 //! This function is provided for a more comfortable use model
@@ -1003,7 +1459,7 @@ s32 MIOS32_MIDI_SendDebugHexDump(const u8 *src, u32 len)
 
     // build line:
     // add source address
-    sprintf((char *)str_ptr, "%08X ", (u32)(src-src_begin));
+    sprintf((char *)str_ptr, "%08X ", (unsigned)(src-src_begin));
     str_ptr += 9;
 
     // add up to 16 bytes
@@ -1207,6 +1663,60 @@ s32 MIOS32_MIDI_ReceivePackage(mios32_midi_port_t port, mios32_midi_package_t pa
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! Processes a block of received packages.
+//!
+//! Runs of channel voice messages (package type 0x8..0xe) which have been
+//! received on the same cable are dispatched without the SysEx and timeout
+//! handling of MIOS32_MIDI_ReceivePackage(). If a block callback has been
+//! installed with MIOS32_MIDI_BlockCallback_Init(), such a run is passed
+//! as a whole, otherwise _callback_package is called for each package.<BR>
+//! All other package types are forwarded to MIOS32_MIDI_ReceivePackage()
+//! in the original order.
+//!
+//! Note that the cable number of the packages will be cleared in the given
+//! buffer (MIOS32_MIDI passes it's own port number)
+//!
+//! \param[in] port base MIDI port (e.g. USB0), the cable number of each package will be added
+//! \param[in] packages pointer to the first package
+//! \param[in] num number of packages
+//! \param[in] _callback_package typically APP_MIDI_NotifyPackage
+//! \return 0 on success
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_ReceivePackageBlock(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 num, void *_callback_package)
+{
+  void (*callback_package)(mios32_midi_port_t port, mios32_midi_package_t midi_package) = _callback_package;
+  mios32_midi_package_t *p = packages;
+  mios32_midi_package_t *end = packages + num;
+
+  while( p < end ) {
+    u8 type = p->type;
+
+    if( type >= 0x8 && type < 0xf ) {
+      // search for the end of the run: same cable, channel voice message
+      u8 cable = p->cable;
+      mios32_midi_package_t *run = p;
+      do {
+	p->cable = 0;
+	++p;
+      } while( p < end && p->cable == cable && p->type >= 0x8 && p->type < 0xf );
+
+      if( block_callback_func != NULL ) {
+	block_callback_func(port + cable, run, p - run);
+      } else if( callback_package != NULL ) {
+	for(; run < p; ++run)
+	  callback_package(port + cable, *run);
+      }
+    } else {
+      MIOS32_MIDI_ReceivePackage(port + p->cable, *p, _callback_package);
+      ++p;
+    }
+  }
+
+  return 0; // no error
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Checks for incoming MIDI messages and calls callback_package function
 //! with following parameters:
@@ -1227,65 +1737,31 @@ s32 MIOS32_MIDI_Receive_Handler(void *_callback_package)
   // handle all USB MIDI packages
 #if !defined(MIOS32_DONT_USE_USB) && !defined(MIOS32_DONT_USE_USB_MIDI)
   {
-    s32 status;
-    mios32_midi_package_t package;
-    while( (status=MIOS32_USB_MIDI_PackageReceive(&package)) >= 0 ) {
-      MIOS32_MIDI_ReceivePackage(USB0 + package.cable, package, _callback_package);
+    // packages are processed directly inside the receive buffer
+    s32 num;
+    mios32_midi_package_t *packages;
+#if MIOS32_MIDI_RX_SCHEDULER
+    // bounded, so that a continuous USB stream can't delay the UART, IIC and SPI ports
+    s32 budget = MIOS32_MIDI_RX_BUDGET_USB;
+    while( budget > 0 && (num=MIOS32_USB_MIDI_PackageReceiveSpan(&packages)) > 0 ) {
+      if( num > budget )
+	num = budget;
+      budget -= num;
+#else
+    while( (num=MIOS32_USB_MIDI_PackageReceiveSpan(&packages)) > 0 ) {
+#endif
+      MIOS32_MIDI_ReceivePackageBlock(USB0, packages, num, _callback_package);
+      MIOS32_USB_MIDI_PackageReceiveRelease(num);
     }
   }
 #endif
 
+#if MIOS32_MIDI_RX_SCHEDULER
+  // handle all UART, IIC and SPI based MIDI packages (deficit round robin)
+  MIOS32_MIDI_RxScheduler(_callback_package);
+#else
   // handle all IIC and UART based MIDI packages (round robin, max 10 packages because of possible timeouts)
   {
-    typedef struct {
-      mios32_midi_port_t port;
-      s32 (*receive_func)(u8 if_port, mios32_midi_package_t *package);
-    } midi_intf_table_t;
-
-    const midi_intf_table_t midi_intf_table[] = {
-#if !defined(MIOS32_DONT_USE_UART) && !defined(MIOS32_DONT_USE_UART_MIDI)
-#if MIOS32_UART_NUM >= 1
-      { UART0, MIOS32_UART_MIDI_PackageReceive },
-#endif
-#if MIOS32_UART_NUM >= 2
-      { UART1, MIOS32_UART_MIDI_PackageReceive },
-#endif
-#if MIOS32_UART_NUM >= 3
-      { UART2, MIOS32_UART_MIDI_PackageReceive },
-#endif
-#if MIOS32_UART_NUM >= 4
-      { UART3, MIOS32_UART_MIDI_PackageReceive },
-#endif
-#endif
-#if !defined(MIOS32_DONT_USE_IIC) && !defined(MIOS32_DONT_USE_IIC_MIDI)
-#if MIOS32_IIC_MIDI_NUM >= 1
-      { IIC0, MIOS32_IIC_MIDI_PackageReceive },
-#endif
-#if MIOS32_IIC_MIDI_NUM >= 2
-      { IIC1, MIOS32_IIC_MIDI_PackageReceive },
-#endif
-#if MIOS32_IIC_MIDI_NUM >= 3
-      { IIC2, MIOS32_IIC_MIDI_PackageReceive },
-#endif
-#if MIOS32_IIC_MIDI_NUM >= 4
-      { IIC3, MIOS32_IIC_MIDI_PackageReceive },
-#endif
-#if MIOS32_IIC_MIDI_NUM >= 5
-      { IIC4, MIOS32_IIC_MIDI_PackageReceive },
-#endif
-#if MIOS32_IIC_MIDI_NUM >= 6
-      { IIC5, MIOS32_IIC_MIDI_PackageReceive },
-#endif
-#if MIOS32_IIC_MIDI_NUM >= 7
-      { IIC6, MIOS32_IIC_MIDI_PackageReceive },
-#endif
-#if MIOS32_IIC_MIDI_NUM >= 8
-      { IIC7, MIOS32_IIC_MIDI_PackageReceive },
-#endif
-#endif
-      { 0, NULL } // end of table
-    };
-
     if( midi_intf_table[0].port != 0 ) {
       int packages_forwarded = 0;
       int packages_forwarded_this_round = 0;
@@ -1331,6 +1807,7 @@ s32 MIOS32_MIDI_Receive_Handler(void *_callback_package)
     }
   }
 #endif
+#endif
   
 
   // SysEx timeout detected by this handler?
@@ -1372,6 +1849,341 @@ s32 MIOS32_MIDI_Receive_Handler(void *_callback_package)
 }
 
 
+#if MIOS32_MIDI_RX_SCHEDULER
+/////////////////////////////////////////////////////////////////////////////
+// Deficit round robin scheduler for UART, IIC and SPI based MIDI ports
+//
+// Each interface gets <weight> packages per round. A round is interrupted
+// once <rx_budget> packages have been forwarded, and continued with the
+// remaining deficit of the current interface on the next call, so that
+// all interfaces get their share regardless of the budget.
+// An interface which doesn't deliver a package loses its deficit.
+// The scheduler stops once all interfaces have been found empty.
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_MIDI_RxScheduler(void *_callback_package)
+{
+  const int num_intf = MIOS32_MIDI_INTF_TABLE_NUM;
+  u16 burst[MIOS32_MIDI_RX_STATS_MAX];
+  int budget = rx_budget;
+  int num_idle = 0;
+  int i;
+
+  if( !num_intf )
+    return 0; // no interface
+
+  for(i=0; i<MIOS32_MIDI_RX_STATS_NUM; ++i)
+    burst[i] = 0;
+
+  while( budget > 0 && num_idle < num_intf ) {
+    int ix = rx_intf_next;
+    rx_intf_t *intf = &rx_intf[ix];
+    mios32_midi_port_t port = midi_intf_table[ix].port;
+    int num_received = 0;
+
+    // new round for this interface?
+    if( !intf->deficit )
+      intf->deficit = intf->weight;
+
+    while( intf->deficit && budget > 0 ) {
+      mios32_midi_package_t package;
+      s32 status = midi_intf_table[ix].receive_func(port & 0x0f, &package);
+
+      if( status < 0 ) {
+	if( status == -10 ) // receive timeout?
+	  MIOS32_MIDI_TimeOut(port);
+
+	// interface empty: deficit is not taken over into the next round
+	intf->deficit = 0;
+	intf->pending = 0;
+	break;
+      }
+
+      --intf->deficit;
+      --budget;
+      ++num_received;
+      intf->pending = 1;
+
+      // handle received package (SPI: the cable selects the port)
+      if( port == SPIM0 ) {
+	++burst[ix + ((package.cable < 8) ? package.cable : 0)];
+	MIOS32_MIDI_ReceivePackage(SPIM0 + package.cable, package, _callback_package);
+      } else {
+	++burst[ix];
+	MIOS32_MIDI_ReceivePackage(port, package, _callback_package);
+      }
+    }
+
+    if( num_received ) {
+      num_idle = 0;
+    } else {
+      ++num_idle;
+    }
+
+    // switch to next interface once the deficit is consumed
+    if( !intf->deficit ) {
+      if( ++rx_intf_next >= num_intf )
+	rx_intf_next = 0;
+    }
+  }
+
+  // update statistics
+  for(i=0; i<MIOS32_MIDI_RX_STATS_NUM; ++i) {
+    rx_port_stats_t *s = &rx_port_stats[i];
+    int spi = i >= num_intf || midi_intf_table[i].port == SPIM0;
+    rx_intf_t *intf = &rx_intf[spi ? (num_intf-1) : i];
+
+    s->stats.received += burst[i];
+    if( burst[i] > s->stats.max_burst )
+      s->stats.max_burst = burst[i];
+
+    // budget exhausted while the interface still delivered packages?
+    // SPI ports share a single receive buffer, only the ports which have been served in this call are counted
+    if( budget <= 0 && intf->pending && (!spi || burst[i]) )
+      ++s->stats.starved;
+  }
+
+  return 0; // no error
+}
+
+
+#if !defined(MIOS32_DONT_USE_SPI) && !defined(MIOS32_DONT_USE_SPI_MIDI)
+/////////////////////////////////////////////////////////////////////////////
+// Adapts MIOS32_SPI_MIDI_PackageReceive to the interface table
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_MIDI_SPI_PackageReceive(u8 if_port, mios32_midi_package_t *package)
+{
+  return MIOS32_SPI_MIDI_PackageReceive(package);
+}
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the receive scheduler index of a given port
+// returns -1 if the port isn't handled by the scheduler
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_MIDI_RxIntfIx(mios32_midi_port_t port)
+{
+  int ix;
+
+  // if default/debug port: select mapped port
+  if( !(port & 0xf0) ) {
+    port = (port == MIDI_DEBUG) ? debug_port : default_port;
+  }
+
+  // all SPI ports are served as a single interface
+  if( (port & 0xf0) == SPIM0 )
+    port = SPIM0;
+
+  for(ix=0; ix<MIOS32_MIDI_INTF_TABLE_NUM; ++ix)
+    if( midi_intf_table[ix].port == port )
+      return ix;
+
+  return -1; // port not handled by receive scheduler
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the statistics index of a given port
+// returns -1 if the port isn't handled by the receive scheduler
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_MIDI_RxStatsIx(mios32_midi_port_t port)
+{
+  // if default/debug port: select mapped port
+  if( !(port & 0xf0) ) {
+    port = (port == MIDI_DEBUG) ? debug_port : default_port;
+  }
+
+  s32 ix = MIOS32_MIDI_RxIntfIx(port);
+
+  // SPI: each port has it's own statistics
+  if( ix >= 0 && (port & 0xf0) == SPIM0 ) {
+    if( (port & 0x0f) >= MIOS32_SPI_MIDI_NUM_PORTS || (port & 0x0f) >= 8 )
+      return -1; // port not available
+    ix += port & 0x0f;
+  }
+
+  return ix;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the port of a given statistics index
+/////////////////////////////////////////////////////////////////////////////
+static mios32_midi_port_t MIOS32_MIDI_RxStatsPort(u32 ix)
+{
+  if( ix < MIOS32_MIDI_INTF_TABLE_NUM && midi_intf_table[ix].port != SPIM0 )
+    return midi_intf_table[ix].port;
+
+  return SPIM0 + (ix - (MIOS32_MIDI_INTF_TABLE_NUM - 1));
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the free running overflow counter of the driver
+/////////////////////////////////////////////////////////////////////////////
+static u32 MIOS32_MIDI_RxOverflowsGet(mios32_midi_port_t port)
+{
+  switch( port & 0xf0 ) {
+#if !defined(MIOS32_DONT_USE_UART) && !defined(MIOS32_DONT_USE_UART_MIDI)
+  case UART0://..15
+    return MIOS32_UART_RxBufferOverflowsGet(port & 0xf);
+#endif
+#if !defined(MIOS32_DONT_USE_SPI) && !defined(MIOS32_DONT_USE_SPI_MIDI)
+  case SPIM0://..15
+    return MIOS32_SPI_MIDI_RxOverflowsGet(port & 0xf);
+#endif
+  }
+
+  return 0; // IIC: packages are buffered by the MBHP_IIC_MIDI module
+}
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Sets the weight of an UART, IIC or SPI MIDI port for the receive scheduler.<BR>
+//! The weight specifies the number of packages which are taken from the port
+//! before the next port is served.<BR>
+//! All SPI ports (SPIM0..SPIM7) share the same weight.
+//!
+//! Only available if MIOS32_MIDI_RX_SCHEDULER is set to 1 in mios32_config.h
+//! \param[in] port MIDI port (UART0..UART3, IIC0..IIC7, SPIM0..SPIM7)
+//! \param[in] weight 1..255
+//! \return -1 if the port isn't handled by the receive scheduler
+//! \return -2 if invalid weight
+//! \return 0 on success
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_RxWeightSet(mios32_midi_port_t port, u8 weight)
+{
+#if !MIOS32_MIDI_RX_SCHEDULER
+  return -1; // receive scheduler disabled
+#else
+  s32 ix = MIOS32_MIDI_RxIntfIx(port);
+  if( ix < 0 )
+    return -1; // port not handled by receive scheduler
+
+  if( !weight )
+    return -2; // invalid weight
+
+  rx_intf[ix].weight = weight;
+
+  return 0; // no error
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the weight of an UART, IIC or SPI MIDI port for the receive scheduler
+//! \param[in] port MIDI port (UART0..UART3, IIC0..IIC7, SPIM0..SPIM7)
+//! \return -1 if the port isn't handled by the receive scheduler
+//! \return >= 1: weight
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_RxWeightGet(mios32_midi_port_t port)
+{
+#if !MIOS32_MIDI_RX_SCHEDULER
+  return -1; // receive scheduler disabled
+#else
+  s32 ix = MIOS32_MIDI_RxIntfIx(port);
+  if( ix < 0 )
+    return -1; // port not handled by receive scheduler
+
+  return rx_intf[ix].weight;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Sets the max. number of UART, IIC and SPI packages which are forwarded
+//! by a single MIOS32_MIDI_Receive_Handler() call.
+//! \param[in] budget 1..65535 (default: MIOS32_MIDI_RX_BUDGET)
+//! \return -1 if the receive scheduler is disabled
+//! \return -2 if invalid budget
+//! \return 0 on success
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_RxBudgetSet(u16 budget)
+{
+#if !MIOS32_MIDI_RX_SCHEDULER
+  return -1; // receive scheduler disabled
+#else
+  if( !budget )
+    return -2; // invalid budget
+
+  rx_budget = budget;
+
+  return 0; // no error
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the max. number of UART, IIC and SPI packages which are forwarded
+//! by a single MIOS32_MIDI_Receive_Handler() call.
+//! \return -1 if the receive scheduler is disabled
+//! \return >= 1: budget
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_RxBudgetGet(void)
+{
+#if !MIOS32_MIDI_RX_SCHEDULER
+  return -1; // receive scheduler disabled
+#else
+  return rx_budget;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the receive statistics of an UART, IIC or SPI MIDI port since the
+//! last MIOS32_MIDI_RxStatsReset() call.<BR>
+//! SPI ports (SPIM0..SPIM7) are served as a single interface, but each port
+//! has it's own statistics.
+//! \param[in] port MIDI port (UART0..UART3, IIC0..IIC7, SPIM0..SPIM7)
+//! \param[out] stats received packages, starved handler calls, lost bytes/packages
+//!             and max. number of packages forwarded by a single handler call
+//! \return -1 if the port isn't handled by the receive scheduler
+//! \return 0 on success
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_RxStatsGet(mios32_midi_port_t port, mios32_midi_rx_stats_t *stats)
+{
+#if !MIOS32_MIDI_RX_SCHEDULER
+  return -1; // receive scheduler disabled
+#else
+  s32 ix = MIOS32_MIDI_RxStatsIx(port);
+  if( ix < 0 )
+    return -1; // port not handled by receive scheduler
+
+  rx_port_stats_t *s = &rx_port_stats[ix];
+  *stats = s->stats;
+  stats->overflows = MIOS32_MIDI_RxOverflowsGet(MIOS32_MIDI_RxStatsPort(ix)) - s->overflows_base;
+
+  return 0; // no error
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Resets the receive statistics of all UART, IIC and SPI MIDI ports
+//! \return -1 if the receive scheduler is disabled
+//! \return 0 on success
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_RxStatsReset(void)
+{
+#if !MIOS32_MIDI_RX_SCHEDULER
+  return -1; // receive scheduler disabled
+#else
+  int ix;
+  rx_port_stats_t *s = &rx_port_stats[0];
+  for(ix=0; ix<MIOS32_MIDI_RX_STATS_NUM; ++ix, ++s) {
+    s->stats.received = 0;
+    s->stats.starved = 0;
+    s->stats.overflows = 0;
+    s->stats.max_burst = 0;
+    s->overflows_base = MIOS32_MIDI_RxOverflowsGet(MIOS32_MIDI_RxStatsPort(ix));
+  }
+
+  return 0; // no error
+#endif
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! This function should be called periodically each mS to handle timeout
 //! and expire counters.
@@ -1651,6 +2463,43 @@ s32 MIOS32_MIDI_SysExCallback_Init(s32 (*callback_sysex)(mios32_midi_port_t port
   return 0; // no error
 }
 
+/////////////////////////////////////////////////////////////////////////////
+//! Installs an optional block callback which is called by
+//! MIOS32_MIDI_Receive_Handler() for contiguous runs of channel voice
+//! messages (package type 0x8..0xe) which have been received on the same
+//! port.
+//!
+//! The packages are passed directly from the receive buffer of the interface
+//! (currently USB), so that the application can process a complete burst
+//! without a function call per package. The buffer is only valid during the
+//! callback.
+//!
+//! While the callback is installed, these packages won't be forwarded to
+//! APP_MIDI_NotifyPackage() anymore. All other messages (SysEx, System
+//! Common and Realtime) are still forwarded to APP_MIDI_NotifyPackage()
+//!
+//! \param[in] *callback_block pointer to callback function:<BR>
+//! \code
+//!    s32 callback_block(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 num)
+//!    {
+//!       u32 i;
+//!       for(i=0; i<num; ++i) {
+//!         // .. process packages[i]
+//!       }
+//!
+//!       return 0; // no error
+//!    }
+//! \endcode
+//! Use MIOS32_MIDI_BlockCallback_Init(NULL) to disable the callback again.
+//! \return < 0 on errors
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_BlockCallback_Init(s32 (*callback_block)(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 num))
+{
+  block_callback_func = callback_block;
+
+  return 0; // no error
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // This function parses an incoming sysex stream for MIOS32 commands
 /////////////////////////////////////////////////////////////////////////////
@@ -1798,7 +2647,7 @@ static s32 MIOS32_MIDI_SYSEX_Cmd_Query(mios32_midi_port_t port, mios32_midi_syse
 	  MIOS32_MIDI_SYSEX_SendAckStr(port, MIOS32_FAMILY_STR);
 	  break;
         case 0x04: // Chip ID
-	  sprintf(str_buffer, "%08x", MIOS32_SYS_ChipIDGet());
+	  sprintf(str_buffer, "%08x", (unsigned)MIOS32_SYS_ChipIDGet());
 	  MIOS32_MIDI_SYSEX_SendAckStr(port, (char *)str_buffer);
 	  break;
         case 0x05: // Serial Number
@@ -1808,11 +2657,11 @@ static s32 MIOS32_MIDI_SYSEX_Cmd_Query(mios32_midi_port_t port, mios32_midi_syse
 	    MIOS32_MIDI_SYSEX_SendAckStr(port, "?");
 	  break;
         case 0x06: // Flash Memory Size
-	  sprintf(str_buffer, "%d", MIOS32_SYS_FlashSizeGet());
+	  sprintf(str_buffer, "%u", (unsigned)MIOS32_SYS_FlashSizeGet());
 	  MIOS32_MIDI_SYSEX_SendAckStr(port, str_buffer);
 	  break;
         case 0x07: // RAM Memory Size
-	  sprintf(str_buffer, "%d", MIOS32_SYS_RAMSizeGet());
+	  sprintf(str_buffer, "%u", (unsigned)MIOS32_SYS_RAMSizeGet());
 	  MIOS32_MIDI_SYSEX_SendAckStr(port, str_buffer);
 	  break;
         case 0x08: // Application Name Line #1
@@ -82,6 +82,15 @@
 //! An example for a search tree construction and OSC method handling can be found
 //! under $MIOS32_PATH/apps/examples/ethernet/osc
 //!
+//! Large search trees (e.g. TouchOSC or Lemur layouts with hundreds of controls)
+//! can optionally be compiled into hashed dispatch tables with
+//! MIOS32_OSC_CompileSearchTree(). The tables are stored in a buffer provided by
+//! the application, packets are parsed with MIOS32_OSC_ParsePacketCompiled()
+//! afterwards. Address parts without wildcards are located with a hash lookup,
+//! only tree nodes which contain wildcards are compared sequentially.
+//! Incoming addresses with wildcards fall back to the sequential search.
+//! The methods are called in the same order like with MIOS32_OSC_ParsePacket().
+//!
 //!
 //! Client Part (sending OSC packets):
 //!
@@ -144,12 +153,40 @@
 #if !defined(MIOS32_DONT_USE_OSC)
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Local types
+/////////////////////////////////////////////////////////////////////////////
+
+// dispatch table of a search tree level (see MIOS32_OSC_CompileSearchTree())
+typedef struct mios32_osc_dispatch_level_t {
+  const mios32_osc_search_tree_t *nodes;       // the nodes of this level
+  const struct mios32_osc_dispatch_level_t **next; // dispatch table of the next level for each node (NULL if no link)
+  struct mios32_osc_dispatch_level_t *link;    // list of compiled levels, only used during compilation
+  u16 *hash_table;     // index+1 of the first node with the hashed address, 0 if slot is empty
+  u16 *same_address;   // index+1 of the next node with the same address, 0 if last node
+  u16 *wildcard_nodes; // indices of nodes which contain wildcards in their address
+  u16 num_nodes;
+  u16 num_wildcard_nodes;
+  u16 hash_mask;
+} mios32_osc_dispatch_level_t;
+
+// buffer management during compilation
+typedef struct {
+  u8 *buffer;
+  u32 size;
+  u32 pos;
+  mios32_osc_dispatch_level_t *levels;
+} mios32_osc_compile_t;
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Local prototypes
 /////////////////////////////////////////////////////////////////////////////
 
-static s32 MIOS32_OSC_SearchElement(u8 *buffer, u32 len, mios32_osc_args_t *osc_args, const mios32_osc_search_tree_t *search_tree);
+static s32 MIOS32_OSC_ParsePacketInternal(u8 *packet, u32 len, const mios32_osc_search_tree_t *search_tree, const mios32_osc_dispatch_level_t *level);
+static s32 MIOS32_OSC_SearchElement(u8 *buffer, u32 len, mios32_osc_args_t *osc_args, const mios32_osc_search_tree_t *search_tree, const mios32_osc_dispatch_level_t *level);
 static s32 MIOS32_OSC_SearchPath(char *path, mios32_osc_args_t *osc_args, u32 method_arg, const mios32_osc_search_tree_t *search_tree);
+static s32 MIOS32_OSC_DispatchPath(char *path, mios32_osc_args_t *osc_args, u32 method_arg, const mios32_osc_dispatch_level_t *level);
 
 static size_t my_strnlen(char *str, size_t max_len);
 
@@ -489,6 +526,32 @@ u8 *MIOS32_OSC_PutMIDI(u8 *buffer, mios32_midi_package_t p)
 //! returns -4 if MIOS32_OSC_MAX_PATH_PARTS has been exceeded
 /////////////////////////////////////////////////////////////////////////////
 s32 MIOS32_OSC_ParsePacket(u8 *packet, u32 len, const mios32_osc_search_tree_t *search_tree)
+{
+  return MIOS32_OSC_ParsePacketInternal(packet, len, search_tree, NULL);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Parses an incoming OSC packet like MIOS32_OSC_ParsePacket(), but uses
+//! the dispatch tables of a search tree which has been compiled with
+//! MIOS32_OSC_CompileSearchTree()
+//! \param[in] packet pointer to OSC packet
+//! \param[in] len length of packet
+//! \param[in] compiled_tree the compiled search tree
+//! \return same return values like MIOS32_OSC_ParsePacket()
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_OSC_ParsePacketCompiled(u8 *packet, u32 len, const mios32_osc_compiled_tree_t *compiled_tree)
+{
+  return MIOS32_OSC_ParsePacketInternal(packet, len, compiled_tree->search_tree, (const mios32_osc_dispatch_level_t *)compiled_tree->root);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Internal function:
+// parses the packet, matching addresses are searched in the dispatch tables
+// if level != NULL, otherwise directly in the search tree
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_OSC_ParsePacketInternal(u8 *packet, u32 len, const mios32_osc_search_tree_t *search_tree, const mios32_osc_dispatch_level_t *level)
 {
   // store osc arguments (and more...) into osc_args variable
   mios32_osc_args_t osc_args;
@@ -518,7 +581,7 @@ s32 MIOS32_OSC_ParsePacket(u8 *packet, u32 len, const mios32_osc_search_tree_t *
 
       // parse element if size > 0
       if( elem_size ) {
-	s32 status = MIOS32_OSC_SearchElement((u8 *)(packet+pos), elem_size, &osc_args, search_tree);
+	s32 status = MIOS32_OSC_SearchElement((u8 *)(packet+pos), elem_size, &osc_args, search_tree, level);
 	if( status < 0 )
 	  return status;
       }
@@ -532,7 +595,7 @@ s32 MIOS32_OSC_ParsePacket(u8 *packet, u32 len, const mios32_osc_search_tree_t *
     osc_args.timetag.seconds = 0;
     osc_args.timetag.fraction = 1;
 
-    s32 status = MIOS32_OSC_SearchElement(packet, len, &osc_args, search_tree);
+    s32 status = MIOS32_OSC_SearchElement(packet, len, &osc_args, search_tree, level);
     if( status < 0 )
       return status;
   }
@@ -548,7 +611,7 @@ s32 MIOS32_OSC_ParsePacket(u8 *packet, u32 len, const mios32_osc_search_tree_t *
 // returns -3 if element contains an unsupported format
 // returns -4 if MIOS32_OSC_MAX_PATH_PARTS has been exceeded
 /////////////////////////////////////////////////////////////////////////////
-static s32 MIOS32_OSC_SearchElement(u8 *buffer, u32 len, mios32_osc_args_t *osc_args, const mios32_osc_search_tree_t *search_tree)
+static s32 MIOS32_OSC_SearchElement(u8 *buffer, u32 len, mios32_osc_args_t *osc_args, const mios32_osc_search_tree_t *search_tree, const mios32_osc_dispatch_level_t *level)
 {
   // exit immediately if element is empty
   if( !len )
@@ -677,10 +740,90 @@ static s32 MIOS32_OSC_SearchElement(u8 *buffer, u32 len, mios32_osc_args_t *osc_
 
   // finally parse for elements which are matching the OSC address
   osc_args->num_path_parts = 0;
+  if( level )
+    return MIOS32_OSC_DispatchPath((char *)&path[1], osc_args, 0x00000000, level);
   return MIOS32_OSC_SearchPath((char *)&path[1], osc_args, 0x00000000, search_tree);
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Internal function:
+// compares an address part of the path with the address of a tree node
+// returns 1 on match, sep_pos contains the length of the address part
+/////////////////////////////////////////////////////////////////////////////
+static u8 MIOS32_OSC_MatchAddress(char *path, const char *address, size_t *sep_pos)
+{
+  u8 wildcard = 0;
+
+  char *str1 = path;
+  char *str2 = (char *)address;
+  *sep_pos = 0;
+
+  while( *str1 != 0 && *str1 != '/' ) {
+    if( *str1 == '*' || *str2 == '*' ) {
+      // '*' wildcard: continue to end of address part
+      while( *str1 != 0 && *str1 != '/' ) {
+	++*sep_pos;
+	++str1;
+      }
+      wildcard = 1;
+      break;
+    } else {
+      // no wildcard: check for matching characters
+      ++*sep_pos;
+      if( *str2 == 0 || (*str2 != *str1 && *str1 != '?' && *str2 != '?') )
+	return 0;
+      ++str1;
+      ++str2;
+    }
+  }
+    
+  if( !wildcard && *str2 != 0 ) // we haven't parsed the complete string
+    return 0;
+
+  return 1;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Internal function:
+// calls the method of a matching node, or continues the search in the next level
+// next_level selects the dispatch table of the next level (if NULL, the search tree will be used)
+// returns -4 if MIOS32_OSC_MAX_PATH_PARTS has been exceeded
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_OSC_MatchedNode(char *path, size_t sep_pos, mios32_osc_args_t *osc_args, u32 method_arg, const mios32_osc_search_tree_t *node, const mios32_osc_dispatch_level_t *next_level)
+{
+  // store number of path parts in local variable, since content of osc_args is changed recursively
+  // we don't want to copy the whole structure to save (a lot of...) memory
+  u8 num_path_parts = osc_args->num_path_parts;
+  // add pointer to path part
+  osc_args->path_part[num_path_parts] = (char *)node->address;
+  osc_args->num_path_parts = num_path_parts + 1;
+
+  // OR method args of current node to the args to propagate optional parameters
+  u32 combined_method_arg = method_arg | node->method_arg;
+
+  if( node->osc_method ) {
+    s32 (*osc_method)(mios32_osc_args_t *osc_args, u32 method_arg) = node->osc_method;
+    osc_method(osc_args, combined_method_arg);
+  } else if( node->next ) {
+    // continue search in next hierarchy level
+    s32 status;
+    if( next_level )
+      status = MIOS32_OSC_DispatchPath((char *)&path[sep_pos+1], osc_args, combined_method_arg, next_level);
+    else
+      status = MIOS32_OSC_SearchPath((char *)&path[sep_pos+1], osc_args, combined_method_arg, node->next);
+    if( status < 0 )
+      return status;
+  }
+
+  // restore number of path parts (which has been changed recursively)
+  osc_args->num_path_parts = num_path_parts;
+
+  return 0; // no error
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Internal function:
 // searches in search_tree for matching OSC addresses
@@ -693,70 +836,267 @@ static s32 MIOS32_OSC_SearchPath(char *path, mios32_osc_args_t *osc_args, u32 me
 
   while( search_tree->address != NULL ) {
     // compare OSC address with name of tree item
-    u8 match = 1;
-    u8 wildcard = 0;
-
-    char *str1 = path;
-    char *str2 = (char *)search_tree->address;
-    size_t sep_pos = 0;
-
-    while( *str1 != 0 && *str1 != '/' ) {
-      if( *str1 == '*' || *str2 == '*' ) {
-	// '*' wildcard: continue to end of address part
-	while( *str1 != 0 && *str1 != '/' ) {
-	  ++sep_pos;
-	  ++str1;
-	}
-	wildcard = 1;
-	break;
-      } else {
-	// no wildcard: check for matching characters
-	++sep_pos;
-	if( *str2 == 0 || (*str2 != *str1 && *str1 != '?' && *str2 != '?') ) {
-	  match = 0;
-	  break;
-	}
-	++str1;
-	++str2;
-      }
+    size_t sep_pos;
+    if( MIOS32_OSC_MatchAddress(path, search_tree->address, &sep_pos) ) {
+      s32 status = MIOS32_OSC_MatchedNode(path, sep_pos, osc_args, method_arg, search_tree, NULL);
+      if( status < 0 )
+	return status;
     }
-    
-    if( !wildcard && *str2 != 0 ) // we haven't parsed the complete string
-      match = 0;
-
-    if( match ) {
-      // store number of path parts in local variable, since content of osc_args is changed recursively
-      // we don't want to copy the whole structure to save (a lot of...) memory
-      u8 num_path_parts = osc_args->num_path_parts;
-      // add pointer to path part
-      osc_args->path_part[num_path_parts] = (char *)search_tree->address;
-      osc_args->num_path_parts = num_path_parts + 1;
-
-      // OR method args of current node to the args to propagate optional parameters
-      u32 combined_method_arg = method_arg | search_tree->method_arg;
-
-      if( search_tree->osc_method ) {
-	s32 (*osc_method)(mios32_osc_args_t *osc_args, u32 method_arg) = search_tree->osc_method;
-	osc_method(osc_args, combined_method_arg);
-      } else if( search_tree->next ) {
-
-	// continue search in next hierarchy level
-	s32 status = MIOS32_OSC_SearchPath((char *)&path[sep_pos+1], osc_args, combined_method_arg, search_tree->next);
-	if( status < 0 )
+
+    ++search_tree;
+  }
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Internal function:
+// hash function for address parts (FNV-1a), terminated by '/' or 0
+// wildcard is set if the address part contains '*' or '?'
+/////////////////////////////////////////////////////////////////////////////
+static u32 MIOS32_OSC_AddressHash(const char *address, size_t *len, u8 *wildcard)
+{
+  u32 hash = 2166136261u;
+  size_t pos;
+
+  *wildcard = 0;
+  for(pos=0; address[pos] != 0 && address[pos] != '/'; ++pos) {
+    char c = address[pos];
+    if( c == '*' || c == '?' )
+      *wildcard = 1;
+    hash = (hash ^ (u8)c) * 16777619u;
+  }
+
+  *len = pos;
+  return hash;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Internal function:
+// searches in the dispatch table of a compiled search tree level for matching OSC addresses
+// returns -4 if MIOS32_OSC_MAX_PATH_PARTS has been exceeded
+/////////////////////////////////////////////////////////////////////////////
+static s32 MIOS32_OSC_DispatchPath(char *path, mios32_osc_args_t *osc_args, u32 method_arg, const mios32_osc_dispatch_level_t *level)
+{
+  if( osc_args->num_path_parts >= MIOS32_OSC_MAX_PATH_PARTS )
+    return -4; // maximum number of path parts exceeded
+
+  size_t part_len;
+  u8 wildcard;
+  u32 hash = MIOS32_OSC_AddressHash(path, &part_len, &wildcard);
+  s32 status;
+
+  if( wildcard ) {
+    // wildcards in incoming address: compare with all nodes
+    int ix;
+    for(ix=0; ix<level->num_nodes; ++ix) {
+      size_t sep_pos;
+      if( MIOS32_OSC_MatchAddress(path, level->nodes[ix].address, &sep_pos) ) {
+	if( (status=MIOS32_OSC_MatchedNode(path, sep_pos, osc_args, method_arg, &level->nodes[ix], level->next[ix])) < 0 )
 	  return status;
       }
+    }
+    return 0; // no error
+  }
 
-      // restore number of path parts (which has been changed recursively)
-      osc_args->num_path_parts = num_path_parts;
+  // search for nodes with the same address (without wildcards)
+  u32 exact_ix = 0; // index+1
+  u32 slot = hash & level->hash_mask;
+  while( (exact_ix=level->hash_table[slot]) ) {
+    const char *address = level->nodes[exact_ix-1].address;
+    if( strncmp(address, path, part_len) == 0 && address[part_len] == 0 )
+      break;
+    slot = (slot + 1) & level->hash_mask;
+  }
+
+  // call matching nodes in the order of the search tree:
+  // merge the list of nodes with the same address and the nodes with wildcards
+  int wildcard_pos = 0;
+  while( exact_ix || wildcard_pos < level->num_wildcard_nodes ) {
+    u32 ix;
+    size_t sep_pos = part_len;
+
+    if( exact_ix && (wildcard_pos >= level->num_wildcard_nodes || (exact_ix-1) < level->wildcard_nodes[wildcard_pos]) ) {
+      ix = exact_ix - 1;
+      exact_ix = level->same_address[ix];
+    } else {
+      ix = level->wildcard_nodes[wildcard_pos++];
+      if( !MIOS32_OSC_MatchAddress(path, level->nodes[ix].address, &sep_pos) )
+	continue;
     }
 
-    ++search_tree;
+    if( (status=MIOS32_OSC_MatchedNode(path, sep_pos, osc_args, method_arg, &level->nodes[ix], level->next[ix])) < 0 )
+      return status;
   }
 
   return 0; // no error
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Internal function:
+// allocates memory in the compile buffer
+// returns NULL if the buffer is full
+/////////////////////////////////////////////////////////////////////////////
+static void *MIOS32_OSC_CompileAlloc(mios32_osc_compile_t *compile, u32 size)
+{
+  // align to pointer size
+  u32 pos = (compile->pos + sizeof(void *) - 1) & ~(u32)(sizeof(void *) - 1);
+
+  if( (pos + size) > compile->size )
+    return NULL;
+
+  compile->pos = pos + size;
+  return (void *)&compile->buffer[pos];
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Internal function:
+// creates the dispatch table for a search tree level and its next levels
+// levels which are linked from multiple nodes are only compiled once
+// returns NULL if the buffer is full
+/////////////////////////////////////////////////////////////////////////////
+static mios32_osc_dispatch_level_t *MIOS32_OSC_CompileLevel(mios32_osc_compile_t *compile, const mios32_osc_search_tree_t *nodes)
+{
+  mios32_osc_dispatch_level_t *level;
+
+  // already compiled?
+  for(level=compile->levels; level != NULL; level=level->link) {
+    if( level->nodes == nodes )
+      return level;
+  }
+
+  // count nodes
+  u32 num_nodes = 0;
+  u32 num_wildcard_nodes = 0;
+  while( nodes[num_nodes].address != NULL ) {
+    size_t len;
+    u8 wildcard;
+    MIOS32_OSC_AddressHash(nodes[num_nodes].address, &len, &wildcard);
+    if( wildcard )
+      ++num_wildcard_nodes;
+    ++num_nodes;
+  }
+
+  if( num_nodes >= 0x8000 )
+    return NULL; // too many nodes (hash_mask is 16bit)
+
+  // hash table with at least twice the number of nodes
+  u32 hash_size = 2;
+  while( hash_size < 2*(num_nodes - num_wildcard_nodes) )
+    hash_size *= 2;
+
+  if( (level=MIOS32_OSC_CompileAlloc(compile, sizeof(mios32_osc_dispatch_level_t))) == NULL ||
+      (level->next=MIOS32_OSC_CompileAlloc(compile, num_nodes * sizeof(mios32_osc_dispatch_level_t *))) == NULL ||
+      (level->hash_table=MIOS32_OSC_CompileAlloc(compile, hash_size * sizeof(u16))) == NULL ||
+      (level->same_address=MIOS32_OSC_CompileAlloc(compile, num_nodes * sizeof(u16))) == NULL ||
+      (level->wildcard_nodes=MIOS32_OSC_CompileAlloc(compile, num_wildcard_nodes * sizeof(u16))) == NULL )
+    return NULL; // buffer full
+
+  level->nodes = nodes;
+  level->num_nodes = num_nodes;
+  level->num_wildcard_nodes = 0;
+  level->hash_mask = hash_size - 1;
+  memset(level->hash_table, 0, hash_size * sizeof(u16));
+
+  // add to list before the next levels are compiled, so that recursive links are resolved
+  level->link = compile->levels;
+  compile->levels = level;
+
+  // enter nodes into hash table
+  // nodes with the same address are chained in the order of the search tree
+  int ix;
+  for(ix=0; ix<num_nodes; ++ix) {
+    size_t len;
+    u8 wildcard;
+    u32 hash = MIOS32_OSC_AddressHash(nodes[ix].address, &len, &wildcard);
+
+    level->same_address[ix] = 0;
+
+    if( wildcard ) {
+      level->wildcard_nodes[level->num_wildcard_nodes++] = ix;
+    } else {
+      u32 slot = hash & level->hash_mask;
+      u16 first_ix;
+      while( (first_ix=level->hash_table[slot]) ) {
+	if( strcmp(nodes[first_ix-1].address, nodes[ix].address) == 0 )
+	  break;
+	slot = (slot + 1) & level->hash_mask;
+      }
+
+      if( !first_ix ) {
+	level->hash_table[slot] = ix + 1;
+      } else {
+	// append to the end of the chain
+	u16 *same_address = &level->same_address[first_ix-1];
+	while( *same_address )
+	  same_address = &level->same_address[*same_address-1];
+	*same_address = ix + 1;
+      }
+    }
+  }
+
+  // compile next levels
+  for(ix=0; ix<num_nodes; ++ix) {
+    level->next[ix] = NULL;
+    if( !nodes[ix].osc_method && nodes[ix].next ) {
+      if( (level->next[ix]=MIOS32_OSC_CompileLevel(compile, nodes[ix].next)) == NULL )
+	return NULL;
+    }
+  }
+
+  return level;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Compiles a search tree into hashed dispatch tables, which speeds up
+//! MIOS32_OSC_ParsePacketCompiled() for large trees.
+//!
+//! The tables are stored into the given buffer, which has to be available as
+//! long as the compiled tree is used. The search tree itself isn't copied and
+//! shouldn't be changed after compilation.
+//!
+//! Usage Example:
+//! \code
+//!   static u8 osc_dispatch_buffer[2048];
+//!   static mios32_osc_compiled_tree_t osc_compiled_tree;
+//!
+//!   if( MIOS32_OSC_CompileSearchTree(&osc_compiled_tree, parse_root, osc_dispatch_buffer, sizeof(osc_dispatch_buffer)) < 0 ) {
+//!     // buffer too small: MIOS32_OSC_ParsePacket() has to be used instead
+//!   }
+//!
+//!   // for each received packet:
+//!   MIOS32_OSC_ParsePacketCompiled(packet, len, &osc_compiled_tree);
+//! \endcode
+//! \param[out] compiled_tree the compiled search tree
+//! \param[in] search_tree the search tree which should be compiled
+//! \param[in] buffer memory for the dispatch tables
+//! \param[in] buffer_size size of the buffer
+//! \return number of allocated bytes in buffer
+//! \return -1 if the buffer is too small
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_OSC_CompileSearchTree(mios32_osc_compiled_tree_t *compiled_tree, const mios32_osc_search_tree_t *search_tree, u8 *buffer, u32 buffer_size)
+{
+  mios32_osc_compile_t compile;
+  compile.buffer = buffer;
+  compile.size = buffer_size;
+  compile.pos = 0;
+  compile.levels = NULL;
+
+  compiled_tree->search_tree = search_tree;
+  compiled_tree->root = MIOS32_OSC_CompileLevel(&compile, search_tree);
+
+  if( compiled_tree->root == NULL )
+    return -1; // buffer too small
+
+  return compile.pos;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Sends the argument list of a method to the debug terminal.
 //!
@@ -797,15 +1137,15 @@ s32 MIOS32_OSC_SendDebugMessage(mios32_osc_args_t *osc_args, u32 method_arg)
 
   MIOS32_OSC_DEBUG_MSG("[%s] timetag %d.%d (%d args), Method Arg: 0x%08x\n", 
 		       path,
-		       osc_args->timetag.seconds,
-		       osc_args->timetag.fraction,
+		       (int)osc_args->timetag.seconds,
+		       (int)osc_args->timetag.fraction,
 		       osc_args->num_args,
-		       method_arg);
+		       (unsigned)method_arg);
 
   for(i=0; i < osc_args->num_args; ++i) {
     switch( osc_args->arg_type[i] ) {
       case 'i': // int32
-	MIOS32_OSC_DEBUG_MSG("[%s] %d: %d (int32)\n", path, i, MIOS32_OSC_GetInt(osc_args->arg_ptr[i]));
+	MIOS32_OSC_DEBUG_MSG("[%s] %d: %d (int32)\n", path, i, (int)MIOS32_OSC_GetInt(osc_args->arg_ptr[i]));
 	  break;
 
         case 'f': { // float32
@@ -821,19 +1161,19 @@ s32 MIOS32_OSC_SendDebugMessage(mios32_osc_args_t *osc_args, u32 method_arg)
 	  break;
 
         case 'b': // blob
-	  MIOS32_OSC_DEBUG_MSG("[%s] %d: blob with length %u\n", path, i, MIOS32_OSC_GetWord(osc_args->arg_ptr[i]));
+	  MIOS32_OSC_DEBUG_MSG("[%s] %d: blob with length %u\n", path, i, (unsigned)MIOS32_OSC_GetWord(osc_args->arg_ptr[i]));
 	  break;
 
         case 'h': { // int64
 	  long long value = MIOS32_OSC_GetLongLong(osc_args->arg_ptr[i]);
 	  MIOS32_OSC_DEBUG_MSG("[%s] %d: 0x%08x%08x (int64)\n", path, i, 
-				       (u32)(value >> 32), (u32)value);
+				       (unsigned)(value >> 32), (unsigned)value);
 	} break;
 
         case 't': { // timetag
 	  mios32_osc_timetag_t timetag = MIOS32_OSC_GetTimetag(osc_args->arg_ptr[i]);
 	  MIOS32_OSC_DEBUG_MSG("[%s] %d: seconds %u fraction %u\n", path, i, 
-				       timetag.seconds, timetag.fraction);
+				       (unsigned)timetag.seconds, (unsigned)timetag.fraction);
 	} break;
 
         case 'd': { // float64 (double)
@@ -848,7 +1188,7 @@ s32 MIOS32_OSC_SendDebugMessage(mios32_osc_args_t *osc_args, u32 method_arg)
 	  break;
 
         case 'r': // 32 bit RGBA color
-	  MIOS32_OSC_DEBUG_MSG("[%s] %d: %08X (RGBA color)\n", path, i, MIOS32_OSC_GetWord(osc_args->arg_ptr[i]));
+	  MIOS32_OSC_DEBUG_MSG("[%s] %d: %08X (RGBA color)\n", path, i, (unsigned)MIOS32_OSC_GetWord(osc_args->arg_ptr[i]));
 	  break;
 
         case 'm': { // MIDI message
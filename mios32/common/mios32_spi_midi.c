@@ -62,6 +62,7 @@ static u8 tx_buffer_head;
 static u8 rx_ringbuffer_tail;
 static u8 rx_ringbuffer_head;
 static u8 rx_ringbuffer_size;
+static u32 rx_ringbuffer_overflows[MIOS32_SPI_MIDI_NUM_PORTS];
 
 // indicates ongoing scan
 static volatile u8 transfer_done;
@@ -238,7 +239,7 @@ static void MIOS32_SPI_MIDI_DMA_Callback(void)
   // doesn't work - see MIOS32_SPI_MIDI_USE_MUTEX workaround in MIOS32_SPI_MIDI_Periodic_mS
 
   // transfer RX values into ringbuffer (if possible)
-  if( rx_ringbuffer_size < MIOS32_SPI_MIDI_RX_RINGBUFFER_SIZE ) {
+  {
     int i;
 
     // atomic operation to avoid conflict with other interrupts
@@ -250,6 +251,13 @@ static void MIOS32_SPI_MIDI_DMA_Callback(void)
       u32 word = *rx_buffer++;
 
       if( word != 0xffffffff && word != 0x00000000 ) {
+	if( rx_ringbuffer_size >= MIOS32_SPI_MIDI_RX_RINGBUFFER_SIZE ) {
+	  // ringbuffer full :-( - the cable number selects the port
+	  u8 cable = word >> 28;
+	  ++rx_ringbuffer_overflows[(cable < MIOS32_SPI_MIDI_NUM_PORTS) ? cable : 0];
+	  continue;
+	}
+
 	// since data has been received bytewise, we've to swap the order
 	mios32_midi_package_t p;
 	p.cin_cable = word >> 24;
@@ -262,8 +270,7 @@ static void MIOS32_SPI_MIDI_DMA_Callback(void)
 	if( ++rx_ringbuffer_head >= MIOS32_SPI_MIDI_RX_RINGBUFFER_SIZE )
 	  rx_ringbuffer_head = 0;
 
-	if( ++rx_ringbuffer_size >= MIOS32_SPI_MIDI_RX_RINGBUFFER_SIZE )
-	  break; // ringbuffer full :-( - TODO: add rx error counter
+	++rx_ringbuffer_size;
       }
     }
 
@@ -358,6 +365,23 @@ s32 MIOS32_SPI_MIDI_PackageSend(mios32_midi_package_t package)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! This function returns the number of packages of a SPI MIDI port which
+//! couldn't be put into the receive buffer since startup because it was full
+//! \param[in] spi_midi_port module number (0..7)
+//! \return >= 0: number of lost packages (free running counter)
+//! \note Applications shouldn't call this function directly, instead please use \ref MIOS32_MIDI layer functions
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_SPI_MIDI_RxOverflowsGet(u8 spi_midi_port)
+{
+#if MIOS32_SPI_MIDI_NUM_PORTS == 0
+  return 0; // SPI MIDI not activated
+#else
+  return (spi_midi_port < MIOS32_SPI_MIDI_NUM_PORTS) ? rx_ringbuffer_overflows[spi_midi_port] : 0;
+#endif
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! This function checks for a new package
 //! \param[out] package pointer to MIDI package (received package will be put into the given variable)
@@ -38,7 +38,8 @@ extern void MIOS32_SRIO_CALLBACK_BEFORE_DIN_COMPARE(void);
 volatile u8 mios32_srio_dout[MIOS32_SRIO_NUM_DOUT_PAGES][MIOS32_SRIO_NUM_SR];
 
 // DIN values of last scan
-volatile u8 mios32_srio_din[MIOS32_SRIO_NUM_SR];
+// aligned, so that the DIN and ENC handlers can check 4 SRs at once
+volatile u8 mios32_srio_din[MIOS32_SRIO_NUM_SR] __attribute__((aligned(4)));
 
 // DIN values of ongoing scan
 // Note: during SRIO scan it is required to copy new DIN values into a temporary buffer
@@ -47,7 +48,7 @@ volatile u8 mios32_srio_din[MIOS32_SRIO_NUM_SR];
 volatile u8 mios32_srio_din_buffer[MIOS32_SRIO_NUM_SR];
 
 // change notification flags
-volatile u8 mios32_srio_din_changed[MIOS32_SRIO_NUM_SR];
+volatile u8 mios32_srio_din_changed[MIOS32_SRIO_NUM_SR] __attribute__((aligned(4)));
 
 // the current DOUT page
 #if MIOS32_SRIO_NUM_DOUT_PAGES > 1
@@ -21,6 +21,7 @@
 
 #if BLM_SCALAR_MASTER_OSC_SUPPORT
 #include <osc_server.h>
+#include <osc_client.h>
 #endif
 
 #include "blm_scalar_master.h"
@@ -41,6 +42,16 @@
 
 #define SYSEX_BLM_CMD_REQUEST      0x00
 #define SYSEX_BLM_CMD_LAYOUT       0x01
+#define SYSEX_BLM_CMD_LED_BLOCK    0x02
+
+// feature flags, optionally sent by the BLM as 7th byte of the layout info
+#define SYSEX_BLM_FEATURE_LED_BLOCK 0x01
+
+// LED block flags
+#define SYSEX_BLM_LED_BLOCK_ROTATED 0x01
+
+// LED block: SysEx header, device, command, flags, first row, number of rows, F7
+#define BLM_LED_BLOCK_OVERHEAD 11
 
 // timeout after 10 seconds (timeout counter is incremented each mS)
 #define BLM_TIMEOUT_RELOAD_VALUE 10000
@@ -85,6 +96,8 @@ typedef union {
     unsigned COLUMNS_RECEIVED:1;
     unsigned ROWS_RECEIVED:1;
     unsigned COLOURS_RECEIVED:1;
+    unsigned EXTRA_CTR:2;
+    unsigned FEATURES_RECEIVED:1;
   } blm;
 
 } sysex_state_t;
@@ -124,7 +137,12 @@ static u8 blm_led_row_offset;
 static u8 blm_num_columns;
 static u8 blm_num_rows;
 static u8 blm_num_colours;
+static u8 blm_features;
 static u8 blm_force_update;
+static u8 blm_force_extra;
+static u32 blm_force_rows;
+static u8 blm_cursor_row;
+static s32 blm_tx_tokens; // in 1/1000 bytes
 
 static s32 (*blm_button_callback_func)(u8 blm, blm_scalar_master_element_t element_id, u8 button_x, u8 button_y, u8 button_depressed);
 static s32 (*blm_fader_callback_func)(u8 blm, u8 fader, u8 value);
@@ -159,6 +177,11 @@ static s32 BLM_SCALAR_MASTER_SYSEX_Cmd_Ping(mios32_midi_port_t port, sysex_cmd_s
 static s32 BLM_SCALAR_MASTER_SYSEX_SendAck(mios32_midi_port_t port, u8 ack_code, u8 ack_arg);
 
 static s32 BLM_SendPackets(mios32_midi_package_t *packets, u8 num_packets);
+static s32 BLM_SendLedBlock(u8 first_row, u8 num_rows);
+static u32 BLM_LedBlockSize(u8 num_rows);
+static u32 BLM_TxBandwidth(void);
+static u8 BLM_TxAvailable(u32 num_bytes);
+static void BLM_TxConsume(u32 num_bytes);
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -178,9 +201,14 @@ s32 BLM_SCALAR_MASTER_Init(u32 mode)
   blm_num_columns = 16;
   blm_num_rows = 16;
   blm_num_colours = 2;
+  blm_features = 0;
   blm_force_update = 0;
+  blm_force_extra = 0;
+  blm_force_rows = 0;
   blm_leds_rotate_view = 0;
   blm_led_row_offset = 0;
+  blm_cursor_row = 0;
+  blm_tx_tokens = 1000 * BLM_SCALAR_MASTER_BURST_SIZE;
 
   sysex_device_id = 0; // only device 0 supported yet
 
@@ -397,6 +425,25 @@ s32 BLM_SCALAR_MASTER_RowOffsetGet(u8 blm)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! Sets the BLM row which contains the cursor.\n
+//! If the bandwidth is limited, rows near to the cursor will be sent first.
+/////////////////////////////////////////////////////////////////////////////
+s32 BLM_SCALAR_MASTER_CursorRowSet(u8 blm, u8 row)
+{
+  blm_cursor_row = row;
+  return 0; // no error
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the BLM row which contains the cursor
+/////////////////////////////////////////////////////////////////////////////
+s32 BLM_SCALAR_MASTER_CursorRowGet(u8 blm)
+{
+  return blm_cursor_row;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Returns the number of columns as reported by the BLM during layout request
 /////////////////////////////////////////////////////////////////////////////
@@ -421,6 +468,15 @@ s32 BLM_SCALAR_MASTER_NumColoursGet(u8 blm)
   return blm_num_colours;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the feature flags as reported by the BLM during layout request\n
+//! bit 0: LED block SysEx supported
+/////////////////////////////////////////////////////////////////////////////
+s32 BLM_SCALAR_MASTER_FeaturesGet(u8 blm)
+{
+  return blm_features;
+}
+
 
 /////////////////////////////////////////////////////////////////////////////
 //! Directly sets the timeout counter, e.g. to 0 so that the BLM will be
@@ -624,6 +680,9 @@ static s32 BLM_SCALAR_MASTER_SYSEX_Cmd(mios32_midi_port_t port, sysex_cmd_state_
       BLM_SCALAR_MASTER_SYSEX_Cmd_Layout(port, cmd_state, midi_in);
       break;
 
+    case SYSEX_BLM_CMD_LED_BLOCK: // ignore to avoid loopbacks
+      break;
+
     case 0x0e: // ignore to avoid loopbacks
       break;
 
@@ -648,6 +707,7 @@ static s32 BLM_SCALAR_MASTER_SYSEX_Cmd_Layout(mios32_midi_port_t port, sysex_cmd
   switch( cmd_state ) {
 
     case SYSEX_CMD_STATE_BEGIN:
+      blm_features = 0; // older BLMs don't send this byte
       break;
 
     case SYSEX_CMD_STATE_CONT:
@@ -664,6 +724,11 @@ static s32 BLM_SCALAR_MASTER_SYSEX_Cmd_Layout(mios32_midi_port_t port, sysex_cmd
       } else if( !sysex_state.blm.COLOURS_RECEIVED ) {
 	sysex_state.blm.COLOURS_RECEIVED = 1;
 	blm_num_colours = midi_in;
+      } else if( sysex_state.blm.EXTRA_CTR < 3 ) {
+	++sysex_state.blm.EXTRA_CTR; // number of extra rows, columns and buttons
+      } else if( !sysex_state.blm.FEATURES_RECEIVED ) {
+	sysex_state.blm.FEATURES_RECEIVED = 1;
+	blm_features = midi_in;
       }
       // ignore all other bytes
       // don't sent error message to allow future extensions
@@ -809,16 +874,32 @@ s32 BLM_SCALAR_MASTER_Periodic_mS(void)
   blm_force_update = 0;
   MIOS32_IRQ_Enable();
 
+  // forced rows are cleared once they have been sent
+  if( force_update ) {
+    blm_force_rows = 0xffffffff;
+    blm_force_extra = 1;
+  }
+
+
+  ///////////////////////////////////////////////////////////////////////////
+  //! refill the token bucket of the bandwidth limiter
+  ///////////////////////////////////////////////////////////////////////////
+  blm_tx_tokens += BLM_TxBandwidth();
+  if( blm_tx_tokens > 1000 * BLM_SCALAR_MASTER_BURST_SIZE )
+    blm_tx_tokens = 1000 * BLM_SCALAR_MASTER_BURST_SIZE;
+
 
   ///////////////////////////////////////////////////////////////////////////
   //! send LED changes to BLM16x16
   ///////////////////////////////////////////////////////////////////////////
   mios32_midi_package_t packets[BLM_MAX_PACKETS];
   u8 num_packets = 0;
+  u32 num_sent_packets = 0;
 
   // help macro to handle packet buffer
 #define SEND_PACKET(p) { \
     packets[num_packets++] = p;                 \
+    ++num_sent_packets;                         \
     if( num_packets >= BLM_MAX_PACKETS ) {      \
       BLM_SendPackets(packets, num_packets);    \
       num_packets = 0;                          \
@@ -834,55 +915,116 @@ s32 BLM_SCALAR_MASTER_Periodic_mS(void)
   {
     int i;
     int num_rows = blm_leds_rotate_view ? BLM_SCALAR_MASTER_NUM_ROWS : blm_num_rows;
+    u8 row_ccs[BLM_SCALAR_MASTER_NUM_ROWS];
+    u32 cc_bytes = 0;
+    int first_row = -1;
+    int last_row = -1;
+
+    // determine the CCs which have to be sent for each row
     for(i=0; i<num_rows; ++i) {
       u8 led_row = i + blm_led_row_offset;
+      u16 diff_green = blm_scalar_master_leds_green[led_row] ^ blm_scalar_master_leds_green_sent[led_row];
+      u16 diff_red = blm_scalar_master_leds_red[led_row] ^ blm_scalar_master_leds_red_sent[led_row];
 
-      u16 pattern_green = blm_scalar_master_leds_green[led_row];
-      u16 prev_pattern_green = blm_scalar_master_leds_green_sent[led_row];
-      u16 pattern_red = blm_scalar_master_leds_red[led_row];
-      u16 prev_pattern_red = blm_scalar_master_leds_red_sent[led_row];
-
-      if( force_update || pattern_green != prev_pattern_green || pattern_red != prev_pattern_red ) {
-
-        // Note: the MIOS32 MIDI driver will take care about running status to optimize the stream
-        if( force_update || ((pattern_green ^ prev_pattern_green) & 0x00ff) ) {
-          u8 pattern8 = pattern_green;
-          p.chn = i;
-          p.cc_number = 8*blm_leds_rotate_view + ((pattern8 & 0x80) ? 17 : 16); // CC number + MSB LED
-          p.value = pattern8 & 0x7f; // remaining 7 LEDs
-
-          SEND_PACKET(p);
-        }
-
-        if( force_update || ((pattern_green ^ prev_pattern_green) & 0xff00) ) {
-          u8 pattern8 = pattern_green >> 8;
-          p.chn = i;
-          p.cc_number = 8*blm_leds_rotate_view + ((pattern8 & 0x80) ? 19 : 18); // CC number + MSB LED
-          p.value = pattern8 & 0x7f; // remaining 7 LEDs
-
-          SEND_PACKET(p);
-        }       
-
-        if( force_update || ((pattern_red ^ prev_pattern_red) & 0x00ff) ) {
-          u8 pattern8 = pattern_red;
-          p.chn = i;
-          p.cc_number = 8*blm_leds_rotate_view + ((pattern8 & 0x80) ? 33 : 32); // CC number + MSB LED
-          p.value = pattern8 & 0x7f; // remaining 7 LEDs
-
-          SEND_PACKET(p);
-        }
+      if( blm_force_rows & (1U << i) ) {
+	diff_green = 0xffff;
+	diff_red = 0xffff;
+      }
 
-        if( force_update || ((pattern_red ^ prev_pattern_red) & 0xff00) ) {
-          u8 pattern8 = pattern_red >> 8;
-          p.chn = i;
-          p.cc_number = 8*blm_leds_rotate_view + ((pattern8 & 0x80) ? 35 : 34); // CC number + MSB LED
-          p.value = pattern8 & 0x7f; // remaining 7 LEDs
+      row_ccs[i] =
+	((diff_green & 0x00ff) ? 1 : 0) |
+	((diff_green & 0xff00) ? 2 : 0) |
+	((diff_red   & 0x00ff) ? 4 : 0) |
+	((diff_red   & 0xff00) ? 8 : 0);
+
+      if( row_ccs[i] ) {
+	// Note: the MIOS32 MIDI driver will take care about running status to optimize the stream
+	// therefore each row costs one status byte and two bytes per CC
+	cc_bytes += 1 + 2*((row_ccs[i] & 1) + ((row_ccs[i] >> 1) & 1) + ((row_ccs[i] >> 2) & 1) + ((row_ccs[i] >> 3) & 1));
+	if( first_row < 0 )
+	  first_row = i;
+	last_row = i;
+      }
+    }
 
-          SEND_PACKET(p);
-        }       
+#if BLM_SCALAR_MASTER_SYSEX_BLOCKS
+    // send a LED block if supported by the BLM, and if it's smaller than the CC stream
+    u8 send_block = first_row >= 0 &&
+      blm_connection_state == BLM_SCALAR_MASTER_CONNECTION_STATE_SYSEX &&
+      (blm_features & SYSEX_BLM_FEATURE_LED_BLOCK) &&
+      BLM_LedBlockSize(last_row - first_row + 1) < cc_bytes;
+#else
+    u8 send_block = 0;
+#endif
 
-        blm_scalar_master_leds_green_sent[led_row] = pattern_green;
-        blm_scalar_master_leds_red_sent[led_row] = pattern_red;
+    if( send_block ) {
+      u32 block_bytes = BLM_LedBlockSize(last_row - first_row + 1);
+      if( BLM_TxAvailable(block_bytes) ) {
+	BLM_SendLedBlock(first_row, last_row - first_row + 1);
+	BLM_TxConsume(block_bytes);
+      }
+    } else if( first_row >= 0 ) {
+      // send rows near to the cursor first, so that they won't be delayed by the bandwidth limiter
+      int cursor_row = (blm_cursor_row < num_rows) ? blm_cursor_row : 0;
+      int distance;
+      for(distance=0; distance<num_rows; ++distance) {
+	int side;
+	for(side=0; side<2; ++side) {
+	  i = side ? (cursor_row - distance) : (cursor_row + distance);
+	  if( i < 0 || i >= num_rows || (side && !distance) || !row_ccs[i] )
+	    continue;
+
+	  u8 row_bytes = 1 + 2*((row_ccs[i] & 1) + ((row_ccs[i] >> 1) & 1) + ((row_ccs[i] >> 2) & 1) + ((row_ccs[i] >> 3) & 1));
+	  if( !BLM_TxAvailable(row_bytes) ) {
+	    distance = num_rows; // remaining rows will be sent once tokens are available again
+	    break;
+	  }
+	  BLM_TxConsume(row_bytes);
+
+	  u8 led_row = i + blm_led_row_offset;
+	  u16 pattern_green = blm_scalar_master_leds_green[led_row];
+	  u16 pattern_red = blm_scalar_master_leds_red[led_row];
+
+	  if( row_ccs[i] & 1 ) {
+	    u8 pattern8 = pattern_green;
+	    p.chn = i;
+	    p.cc_number = 8*blm_leds_rotate_view + ((pattern8 & 0x80) ? 17 : 16); // CC number + MSB LED
+	    p.value = pattern8 & 0x7f; // remaining 7 LEDs
+
+	    SEND_PACKET(p);
+	  }
+
+	  if( row_ccs[i] & 2 ) {
+	    u8 pattern8 = pattern_green >> 8;
+	    p.chn = i;
+	    p.cc_number = 8*blm_leds_rotate_view + ((pattern8 & 0x80) ? 19 : 18); // CC number + MSB LED
+	    p.value = pattern8 & 0x7f; // remaining 7 LEDs
+
+	    SEND_PACKET(p);
+	  }
+
+	  if( row_ccs[i] & 4 ) {
+	    u8 pattern8 = pattern_red;
+	    p.chn = i;
+	    p.cc_number = 8*blm_leds_rotate_view + ((pattern8 & 0x80) ? 33 : 32); // CC number + MSB LED
+	    p.value = pattern8 & 0x7f; // remaining 7 LEDs
+
+	    SEND_PACKET(p);
+	  }
+
+	  if( row_ccs[i] & 8 ) {
+	    u8 pattern8 = pattern_red >> 8;
+	    p.chn = i;
+	    p.cc_number = 8*blm_leds_rotate_view + ((pattern8 & 0x80) ? 35 : 34); // CC number + MSB LED
+	    p.value = pattern8 & 0x7f; // remaining 7 LEDs
+
+	    SEND_PACKET(p);
+	  }
+
+	  blm_scalar_master_leds_green_sent[led_row] = pattern_green;
+	  blm_scalar_master_leds_red_sent[led_row] = pattern_red;
+	  blm_force_rows &= ~(1U << i);
+	}
       }
     }
   }
@@ -891,7 +1033,10 @@ s32 BLM_SCALAR_MASTER_Periodic_mS(void)
   ///////////////////////////////////////////////////////////////////////////
   //! send LED changes to extra buttons
   ///////////////////////////////////////////////////////////////////////////
-  if( force_update || blm_scalar_master_leds_extra_green != blm_scalar_master_leds_extra_green_sent ) {
+  // only a few bytes: they are charged afterwards, so that they can't be blocked by the grid
+  num_sent_packets = 0;
+
+  if( blm_force_extra || blm_scalar_master_leds_extra_green != blm_scalar_master_leds_extra_green_sent ) {
     p.chn = Chn16;
     p.cc_number = 0x60;
     p.value = blm_scalar_master_leds_extra_green;
@@ -899,7 +1044,7 @@ s32 BLM_SCALAR_MASTER_Periodic_mS(void)
     blm_scalar_master_leds_extra_green_sent = blm_scalar_master_leds_extra_green;
   }
 
-  if( force_update || blm_scalar_master_leds_extra_red != blm_scalar_master_leds_extra_red_sent ) {
+  if( blm_force_extra || blm_scalar_master_leds_extra_red != blm_scalar_master_leds_extra_red_sent ) {
     p.chn = Chn16;
     p.cc_number = 0x68;
     p.value = blm_scalar_master_leds_extra_red;
@@ -907,7 +1052,7 @@ s32 BLM_SCALAR_MASTER_Periodic_mS(void)
     blm_scalar_master_leds_extra_red_sent = blm_scalar_master_leds_extra_red;
   }
 
-  if( force_update || blm_scalar_master_leds_extracolumn_green != blm_scalar_master_leds_extracolumn_green_sent ) {
+  if( blm_force_extra || blm_scalar_master_leds_extracolumn_green != blm_scalar_master_leds_extracolumn_green_sent ) {
     p.chn = Chn1;
     p.cc_number = (blm_scalar_master_leds_extracolumn_green & 0x0080) ? 0x41 : 0x40;
     p.value = (blm_scalar_master_leds_extracolumn_green >> 0) & 0x7f;
@@ -920,7 +1065,7 @@ s32 BLM_SCALAR_MASTER_Periodic_mS(void)
     blm_scalar_master_leds_extracolumn_green_sent = blm_scalar_master_leds_extracolumn_green;
   }
 
-  if( force_update || blm_scalar_master_leds_extracolumn_red != blm_scalar_master_leds_extracolumn_red_sent ) {
+  if( blm_force_extra || blm_scalar_master_leds_extracolumn_red != blm_scalar_master_leds_extracolumn_red_sent ) {
     p.chn = Chn1;
     p.cc_number = (blm_scalar_master_leds_extracolumn_red & 0x0080) ? 0x49 : 0x48;
     p.value = (blm_scalar_master_leds_extracolumn_red >> 0) & 0x7f;
@@ -934,7 +1079,7 @@ s32 BLM_SCALAR_MASTER_Periodic_mS(void)
   }
 
 
-  if( force_update || blm_scalar_master_leds_extracolumn_shift_green != blm_scalar_master_leds_extracolumn_shift_green_sent ) {
+  if( blm_force_extra || blm_scalar_master_leds_extracolumn_shift_green != blm_scalar_master_leds_extracolumn_shift_green_sent ) {
     p.chn = Chn1;
     p.cc_number = (blm_scalar_master_leds_extracolumn_shift_green & 0x0080) ? 0x51 : 0x50;
     p.value = (blm_scalar_master_leds_extracolumn_shift_green >> 0) & 0x7f;
@@ -947,7 +1092,7 @@ s32 BLM_SCALAR_MASTER_Periodic_mS(void)
     blm_scalar_master_leds_extracolumn_shift_green_sent = blm_scalar_master_leds_extracolumn_shift_green;
   }
 
-  if( force_update || blm_scalar_master_leds_extracolumn_shift_red != blm_scalar_master_leds_extracolumn_shift_red_sent ) {
+  if( blm_force_extra || blm_scalar_master_leds_extracolumn_shift_red != blm_scalar_master_leds_extracolumn_shift_red_sent ) {
     p.chn = Chn1;
     p.cc_number = (blm_scalar_master_leds_extracolumn_shift_red & 0x0080) ? 0x59 : 0x58;
     p.value = (blm_scalar_master_leds_extracolumn_shift_red >> 0) & 0x7f;
@@ -961,7 +1106,7 @@ s32 BLM_SCALAR_MASTER_Periodic_mS(void)
   }
 
 
-  if( force_update || blm_scalar_master_leds_extrarow_green != blm_scalar_master_leds_extrarow_green_sent ) {
+  if( blm_force_extra || blm_scalar_master_leds_extrarow_green != blm_scalar_master_leds_extrarow_green_sent ) {
     p.chn = Chn1;
     p.cc_number = (blm_scalar_master_leds_extrarow_green & 0x0080) ? 0x61 : 0x60;
     p.value = (blm_scalar_master_leds_extrarow_green >> 0) & 0x7f;
@@ -974,7 +1119,7 @@ s32 BLM_SCALAR_MASTER_Periodic_mS(void)
     blm_scalar_master_leds_extrarow_green_sent = blm_scalar_master_leds_extrarow_green;
   }
 
-  if( force_update || blm_scalar_master_leds_extrarow_red != blm_scalar_master_leds_extrarow_red_sent ) {
+  if( blm_force_extra || blm_scalar_master_leds_extrarow_red != blm_scalar_master_leds_extrarow_red_sent ) {
     p.chn = Chn1;
     p.cc_number = (blm_scalar_master_leds_extrarow_red & 0x0080) ? 0x69 : 0x68;
     p.value = (blm_scalar_master_leds_extrarow_red >> 0) & 0x7f;
@@ -987,6 +1132,9 @@ s32 BLM_SCALAR_MASTER_Periodic_mS(void)
     blm_scalar_master_leds_extrarow_red_sent = blm_scalar_master_leds_extrarow_red;
   }
 
+  blm_force_extra = 0;
+  BLM_TxConsume(3*num_sent_packets);
+
   // send remaining packets
   if( num_packets )
     BLM_SendPackets(packets, num_packets);
@@ -1021,6 +1169,8 @@ static s32 BLM_SendPackets(mios32_midi_package_t *packets, u8 num_packets)
     for(i=0; i<num_packets; ++i)
       end_ptr = MIOS32_OSC_PutInt(end_ptr, packets[i].ALL);
 
+    // send collected OSC client messages before (if bundled)
+    OSC_CLIENT_Flush(blm_midi_port & 0x0f);
     OSC_SERVER_SendPacket(blm_midi_port & 0x0f, packet, (u32)(end_ptr-packet));
 #endif
   } else {
@@ -1034,4 +1184,120 @@ static s32 BLM_SendPackets(mios32_midi_package_t *packets, u8 num_packets)
   return 0; // no error
 }
 
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the number of bytes of a LED block SysEx for the given number of rows
+/////////////////////////////////////////////////////////////////////////////
+static u32 BLM_LedBlockSize(u8 num_rows)
+{
+  // 16 green + 16 red LEDs per row, packed into 7bit bytes
+  return BLM_LED_BLOCK_OVERHEAD + (32*num_rows + 6) / 7;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Help function to send a range of rows with a LED block SysEx:
+//! F0 00 00 7E 4E <device> 02 <flags> <first row> <number of rows> <data> F7
+//! The data is a bitstream which contains 16 green and 16 red LEDs for each row
+//! (LSB first), packed into 7bit bytes. The last byte is padded with zeroes.
+//! flags bit 0: rows are columns (rotated view)
+/////////////////////////////////////////////////////////////////////////////
+static s32 BLM_SendLedBlock(u8 first_row, u8 num_rows)
+{
+  u8 sysex_buffer[BLM_LED_BLOCK_OVERHEAD + (32*BLM_SCALAR_MASTER_NUM_ROWS + 6) / 7];
+  u8 *sysex_buffer_ptr = &sysex_buffer[0];
+  int i;
+
+  for(i=0; i<sizeof(blm_sysex_header); ++i)
+    *sysex_buffer_ptr++ = blm_sysex_header[i];
+
+  // device ID
+  *sysex_buffer_ptr++ = sysex_device_id;
+
+  // command and range
+  *sysex_buffer_ptr++ = SYSEX_BLM_CMD_LED_BLOCK;
+  *sysex_buffer_ptr++ = blm_leds_rotate_view ? SYSEX_BLM_LED_BLOCK_ROTATED : 0x00;
+  *sysex_buffer_ptr++ = first_row;
+  *sysex_buffer_ptr++ = num_rows;
+
+  // LED patterns
+  u32 bits = 0;
+  u8 num_bits = 0;
+  for(i=first_row; i<(first_row+num_rows); ++i) {
+    u8 led_row = i + blm_led_row_offset;
+    u16 pattern_green = blm_scalar_master_leds_green[led_row];
+    u16 pattern_red = blm_scalar_master_leds_red[led_row];
+
+    bits |= (u32)pattern_green << num_bits;
+    num_bits += 16;
+    while( num_bits >= 7 ) {
+      *sysex_buffer_ptr++ = bits & 0x7f;
+      bits >>= 7;
+      num_bits -= 7;
+    }
+
+    bits |= (u32)pattern_red << num_bits;
+    num_bits += 16;
+    while( num_bits >= 7 ) {
+      *sysex_buffer_ptr++ = bits & 0x7f;
+      bits >>= 7;
+      num_bits -= 7;
+    }
+
+    blm_scalar_master_leds_green_sent[led_row] = pattern_green;
+    blm_scalar_master_leds_red_sent[led_row] = pattern_red;
+    blm_force_rows &= ~(1U << i);
+  }
+
+  if( num_bits )
+    *sysex_buffer_ptr++ = bits & 0x7f;
+
+  // send footer
+  *sysex_buffer_ptr++ = 0xf7;
+
+  // finally send SysEx stream
+  BLM_SCALAR_MASTER_MUTEX_MIDIOUT_TAKE;
+  s32 status = MIOS32_MIDI_SendSysEx(blm_midi_port, (u8 *)sysex_buffer, (u32)sysex_buffer_ptr - ((u32)&sysex_buffer[0]));
+  BLM_SCALAR_MASTER_MUTEX_MIDIOUT_GIVE;
+
+  return status;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the bandwidth limit of the BLM port in bytes per second (0: unlimited)
+/////////////////////////////////////////////////////////////////////////////
+static u32 BLM_TxBandwidth(void)
+{
+  if( (blm_midi_port & 0xf0) == UART0 )
+    return BLM_SCALAR_MASTER_UART_BANDWIDTH;
+
+  return BLM_SCALAR_MASTER_BANDWIDTH;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns 1 if the given number of bytes can be sent without exceeding the
+//! bandwidth limit.\n
+//! Transfers which are larger than the burst size are allowed once the bucket
+//! is full, the bucket will be in debt afterwards.
+/////////////////////////////////////////////////////////////////////////////
+static u8 BLM_TxAvailable(u32 num_bytes)
+{
+  if( !BLM_TxBandwidth() )
+    return 1; // unlimited
+
+  return blm_tx_tokens >= (s32)(1000*num_bytes) || blm_tx_tokens >= (1000 * BLM_SCALAR_MASTER_BURST_SIZE);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Takes the given number of bytes from the token bucket
+/////////////////////////////////////////////////////////////////////////////
+static void BLM_TxConsume(u32 num_bytes)
+{
+  if( BLM_TxBandwidth() )
+    blm_tx_tokens -= 1000*num_bytes;
+}
+
 //! \}
@@ -43,6 +43,29 @@
 #endif
 
 
+// enable this switch to send a LED block SysEx (command 0x02) instead of CCs if the BLM
+// reported support during the layout request, and if the block is smaller than the CC stream
+#ifndef BLM_SCALAR_MASTER_SYSEX_BLOCKS
+#define BLM_SCALAR_MASTER_SYSEX_BLOCKS 0
+#endif
+
+// bandwidth limit in bytes per second for BLMs connected to a UART port (0: unlimited)
+// 31250 baud allow 3125 bytes/s, e.g. 2500 leaves some headroom for other messages
+#ifndef BLM_SCALAR_MASTER_UART_BANDWIDTH
+#define BLM_SCALAR_MASTER_UART_BANDWIDTH 0
+#endif
+
+// bandwidth limit in bytes per second for BLMs connected to other ports (0: unlimited)
+#ifndef BLM_SCALAR_MASTER_BANDWIDTH
+#define BLM_SCALAR_MASTER_BANDWIDTH 0
+#endif
+
+// maximum number of bytes which can be sent in a burst if bandwidth is limited
+#ifndef BLM_SCALAR_MASTER_BURST_SIZE
+#define BLM_SCALAR_MASTER_BURST_SIZE 96
+#endif
+
+
 // it's recommended to assign the MIDIOUT mutex used by the application in mios32_config.h
 #ifndef BLM_SCALAR_MASTER_MUTEX_MIDIOUT_TAKE
 #define BLM_SCALAR_MASTER_MUTEX_MIDIOUT_TAKE { }
@@ -103,10 +126,13 @@ extern s32 BLM_SCALAR_MASTER_RotateViewSet(u8 blm, u8 rotate_view);
 extern s32 BLM_SCALAR_MASTER_RotateViewGet(u8 blm);
 extern s32 BLM_SCALAR_MASTER_RowOffsetSet(u8 blm, u8 row_offset);
 extern s32 BLM_SCALAR_MASTER_RowOffsetGet(u8 blm);
+extern s32 BLM_SCALAR_MASTER_CursorRowSet(u8 blm, u8 row);
+extern s32 BLM_SCALAR_MASTER_CursorRowGet(u8 blm);
 
 extern s32 BLM_SCALAR_MASTER_NumColumnsGet(u8 blm);
 extern s32 BLM_SCALAR_MASTER_NumRowsGet(u8 blm);
 extern s32 BLM_SCALAR_MASTER_NumColoursGet(u8 blm);
+extern s32 BLM_SCALAR_MASTER_FeaturesGet(u8 blm);
 
 extern s32 BLM_SCALAR_MASTER_TimeoutCtrSet(u8 blm, u16 ctr);
 extern s32 BLM_SCALAR_MASTER_TimeoutCtrGet(u8 blm);
@@ -35,6 +35,29 @@
 // SysEx buffer for each input (exclusive Default)
 #define NUM_SYSEX_BUFFERS     (MIDI_PORT_NUM_IN_PORTS-1)
 
+// routing table: one list for USB0..7, UART0..7, IIC0..7, OSC0..7, and one for all other source ports
+#define NUM_ROUTE_LISTS       (32+1)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// local types
+/////////////////////////////////////////////////////////////////////////////
+
+// routing table entry, compiled from a midi_router_node_entry_t
+typedef struct {
+  u16 src_chn_mask; // bit 0..15: forward events of channel 1..16
+  u8  src_port;     // only checked for the list of the other source ports
+  u8  dst_port;
+  u8  dst_chn;      // 1..16: change channel, 17: keep channel
+} midi_router_route_t;
+
+// routing table, sorted by source ports (and node order)
+// the routes of list n are located at route[route_begin[n]..route_begin[n+1]-1]
+typedef struct {
+  midi_router_route_t route[MIDI_ROUTER_NUM_NODES];
+  u16 route_begin[NUM_ROUTE_LISTS+1];
+} midi_router_table_t;
+
 
 /////////////////////////////////////////////////////////////////////////////
 // global variables
@@ -69,6 +92,20 @@ u32 midi_router_mclk_out;
 static u8 sysex_buffer[NUM_SYSEX_BUFFERS][MIDI_ROUTER_SYSEX_BUFFER_SIZE];
 static u32 sysex_buffer_len[NUM_SYSEX_BUFFERS];
 
+// MIDI_ROUTER_NodesChanged() compiles the nodes into the inactive table and
+// switches to it afterwards, so that MIDI_ROUTER_Receive() (which can be called
+// from different tasks) always works on a complete table
+static midi_router_table_t route_table[2];
+static midi_router_table_t * volatile route_table_active = &route_table[0];
+
+
+/////////////////////////////////////////////////////////////////////////////
+// local prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+static void MIDI_ROUTER_Compile(midi_router_table_t *t);
+static void MIDI_ROUTER_ForwardChnEvent(mios32_midi_port_t port, mios32_midi_package_t midi_package, midi_router_route_t *r, midi_router_route_t *r_end, u8 check_src_port);
+
 
 /////////////////////////////////////////////////////////////////////////////
 // This function initializes the MIDI router
@@ -88,6 +125,26 @@ s32 MIDI_ROUTER_Init(u32 mode)
   for(i=0; i<NUM_SYSEX_BUFFERS; ++i)
     sysex_buffer_len[i] = 0;
 
+  // compile routing table
+  MIDI_ROUTER_NodesChanged();
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// This function has to be called whenever midi_router_node[] has been changed
+// The routing table is compiled immediately
+/////////////////////////////////////////////////////////////////////////////
+s32 MIDI_ROUTER_NodesChanged(void)
+{
+  // only one task can compile a table at a time (takes some uS)
+  MIOS32_IRQ_Disable();
+  midi_router_table_t *t = (route_table_active == &route_table[0]) ? &route_table[1] : &route_table[0];
+  MIDI_ROUTER_Compile(t);
+  route_table_active = t;
+  MIOS32_IRQ_Enable();
+
   return 0; // no error
 }
 
@@ -106,6 +163,91 @@ static inline u32 MIDI_ROUTER_PortMaskGet(mios32_midi_port_t port)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Returns the routing table list of the given source port
+/////////////////////////////////////////////////////////////////////////////
+static inline u32 MIDI_ROUTER_RouteListGet(mios32_midi_port_t port)
+{
+  u8 port_ix = port & 0xf;
+  if( port >= USB0 && port <= OSC7 && port_ix <= 7 ) {
+    return (((port-USB0) & 0x30) >> 1) | port_ix;
+  }
+
+  return NUM_ROUTE_LISTS-1; // other ports
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Compiles midi_router_node[] into the given routing table
+/////////////////////////////////////////////////////////////////////////////
+static void MIDI_ROUTER_Compile(midi_router_table_t *t)
+{
+  // count the routes of each list
+  u16 num_routes[NUM_ROUTE_LISTS];
+  int list;
+  for(list=0; list<NUM_ROUTE_LISTS; ++list)
+    num_routes[list] = 0;
+
+  int node;
+  midi_router_node_entry_t *n = (midi_router_node_entry_t *)&midi_router_node[0];
+  for(node=0; node<MIDI_ROUTER_NUM_NODES; ++node, ++n) {
+    // forwarding OSC to OSC will very likely result into a stack overflow (or feedback loop) -> avoid this!
+    if( n->src_chn && n->dst_chn &&
+	!(((n->src_port & 0xf0) == OSC0) && ((n->dst_port & 0xf0) == OSC0)) )
+      ++num_routes[MIDI_ROUTER_RouteListGet(n->src_port)];
+  }
+
+  // determine the begin of each list
+  u16 pos = 0;
+  for(list=0; list<NUM_ROUTE_LISTS; ++list) {
+    t->route_begin[list] = pos;
+    pos += num_routes[list];
+    num_routes[list] = t->route_begin[list]; // used as write position
+  }
+  t->route_begin[NUM_ROUTE_LISTS] = pos;
+
+  // fill the lists, the node order is kept
+  n = (midi_router_node_entry_t *)&midi_router_node[0];
+  for(node=0; node<MIDI_ROUTER_NUM_NODES; ++node, ++n) {
+    if( n->src_chn && n->dst_chn &&
+	!(((n->src_port & 0xf0) == OSC0) && ((n->dst_port & 0xf0) == OSC0)) ) {
+      midi_router_route_t *r = &t->route[num_routes[MIDI_ROUTER_RouteListGet(n->src_port)]++];
+      if( n->src_chn == 17 )
+	r->src_chn_mask = 0xffff; // all channels
+      else if( n->src_chn <= 16 )
+	r->src_chn_mask = 1 << (n->src_chn-1);
+      else
+	r->src_chn_mask = 0; // only realtime events
+      r->src_port = n->src_port;
+      r->dst_port = n->dst_port;
+      r->dst_chn = n->dst_chn;
+    }
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Forwards a MIDI package
+// if available, the package is queued in the output ring of the port,
+// otherwise it's sent directly
+// MIOS32_MIDI_SendPackage() forwards the queued packages of the port first,
+// so that the order is kept if the ring is full, and for SysEx streams which
+// are sent directly by MIDI_ROUTER_ReceiveSysEx()
+/////////////////////////////////////////////////////////////////////////////
+static inline void MIDI_ROUTER_SendPackage(mios32_midi_port_t port, mios32_midi_package_t package)
+{
+#if MIOS32_MIDI_OUT_RING_SIZE
+  // no mutex required
+  if( MIOS32_MIDI_SendPackage_Queued(port, package) >= 0 )
+    return;
+#endif
+
+  MUTEX_MIDIOUT_TAKE;
+  MIOS32_MIDI_SendPackage(port, package);
+  MUTEX_MIDIOUT_GIVE;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Receives a MIDI package from APP_NotifyReceivedEvent (-> app.c)
 /////////////////////////////////////////////////////////////////////////////
@@ -117,34 +259,24 @@ s32 MIDI_ROUTER_Receive(mios32_midi_port_t port, mios32_midi_package_t midi_pack
       (midi_package.cin >= 0x4 && midi_package.cin <= 0x7)) )
     return 0; // no error
 
-  u32 sysex_dst_fwd_done = 0;
-  int node;
-  midi_router_node_entry_t *n = (midi_router_node_entry_t *)&midi_router_node[0];
-  for(node=0; node<MIDI_ROUTER_NUM_NODES; ++node, ++n) {
-    if( n->src_chn && n->dst_chn && (n->src_port == port) ) {
-
-      // forwarding OSC to OSC will very likely result into a stack overflow (or feedback loop) -> avoid this!
-      if( ((port & 0xf0) == OSC0) && ((n->dst_port & 0xf0) == OSC0) )
-	continue;
+  // only the routes of the source port have to be checked
+  midi_router_table_t *t = route_table_active;
+  u32 list = MIDI_ROUTER_RouteListGet(port);
+  u8 check_src_port = list == (NUM_ROUTE_LISTS-1);
+  midi_router_route_t *r = &t->route[t->route_begin[list]];
+  midi_router_route_t *r_end = &t->route[t->route_begin[list+1]];
 
-      if( midi_package.event >= NoteOff && midi_package.event <= PitchBend ) {
-	if( n->src_chn == 17 || midi_package.chn == (n->src_chn-1) ) {
-	  mios32_midi_package_t fwd_package = midi_package;
-	  if( n->dst_chn <= 16 )
-	    fwd_package.chn = (n->dst_chn-1);
-	  mios32_midi_port_t port = n->dst_port;
-	  MUTEX_MIDIOUT_TAKE;
-	  MIOS32_MIDI_SendPackage(port, fwd_package);
-	  MUTEX_MIDIOUT_GIVE;
-	}
-      } else {
+  if( midi_package.event >= NoteOff && midi_package.event <= PitchBend ) {
+    MIDI_ROUTER_ForwardChnEvent(port, midi_package, r, r_end, check_src_port);
+  } else {
+    u32 sysex_dst_fwd_done = 0;
+    for(; r != r_end; ++r) {
+      if( !check_src_port || r->src_port == port ) {
 	// Realtime events: ensure that they are only forwarded once
-	u32 mask = MIDI_ROUTER_PortMaskGet(n->dst_port);
+	u32 mask = MIDI_ROUTER_PortMaskGet(r->dst_port);
 	if( !mask || !(sysex_dst_fwd_done & mask) ) {
 	  sysex_dst_fwd_done |= mask;
-	  MUTEX_MIDIOUT_TAKE;
-	  MIOS32_MIDI_SendPackage(n->dst_port, midi_package);
-	  MUTEX_MIDIOUT_GIVE;
+	  MIDI_ROUTER_SendPackage(r->dst_port, midi_package);
 	}
       }
     }
@@ -153,6 +285,50 @@ s32 MIDI_ROUTER_Receive(mios32_midi_port_t port, mios32_midi_package_t midi_pack
   return 0; // no error
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Receives a run of channel voice messages of the same port from a block
+// callback (-> app.c, installed via MIOS32_MIDI_BlockCallback_Init)
+// The routes of the source port are only searched once for the whole run
+/////////////////////////////////////////////////////////////////////////////
+s32 MIDI_ROUTER_ReceiveBlock(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 num)
+{
+  midi_router_table_t *t = route_table_active;
+  u32 list = MIDI_ROUTER_RouteListGet(port);
+  u8 check_src_port = list == (NUM_ROUTE_LISTS-1);
+  midi_router_route_t *r = &t->route[t->route_begin[list]];
+  midi_router_route_t *r_end = &t->route[t->route_begin[list+1]];
+
+  // no route for this port?
+  if( r == r_end )
+    return 0; // no error
+
+  for(; num; --num, ++packages) {
+    if( packages->event >= NoteOff && packages->event <= PitchBend )
+      MIDI_ROUTER_ForwardChnEvent(port, *packages, r, r_end, check_src_port);
+    else
+      MIDI_ROUTER_Receive(port, *packages);
+  }
+
+  return 0; // no error
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Forwards a channel voice message to all matching routes
+/////////////////////////////////////////////////////////////////////////////
+static void MIDI_ROUTER_ForwardChnEvent(mios32_midi_port_t port, mios32_midi_package_t midi_package, midi_router_route_t *r, midi_router_route_t *r_end, u8 check_src_port)
+{
+  u16 chn_mask = 1 << midi_package.chn;
+
+  for(; r != r_end; ++r) {
+    if( (r->src_chn_mask & chn_mask) && (!check_src_port || r->src_port == port) ) {
+      mios32_midi_package_t fwd_package = midi_package;
+      if( r->dst_chn <= 16 )
+	fwd_package.chn = (r->dst_chn-1);
+      MIDI_ROUTER_SendPackage(r->dst_port, fwd_package);
+    }
+  }
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // Receives a SysEx byte from APP_SYSEX_Parser (-> app.c)
 /////////////////////////////////////////////////////////////////////////////
@@ -545,6 +721,7 @@ s32 MIDI_ROUTER_TerminalParseLine(char *input, void *_output_function)
 	n->src_chn = src_chn;
 	n->dst_port = dst_port;
 	n->dst_chn = dst_chn;
+	MIDI_ROUTER_NodesChanged();
 
 	out("Changed Node %d to SRC:%s %s  DST:%s %s",
 	    node+1,
@@ -23,6 +23,8 @@ extern "C" {
 /////////////////////////////////////////////////////////////////////////////
 
 // can be overruled from mios32_config.h
+// midi_router_node[] is compiled into a routing table, so that the number
+// of nodes doesn't affect the forwarding time
 #ifndef MIDI_ROUTER_NUM_NODES
 #define MIDI_ROUTER_NUM_NODES  16
 #endif
@@ -57,8 +59,10 @@ typedef struct {
 /////////////////////////////////////////////////////////////////////////////
 
 extern s32 MIDI_ROUTER_Init(u32 mode);
+extern s32 MIDI_ROUTER_NodesChanged(void);
 
 extern s32 MIDI_ROUTER_Receive(mios32_midi_port_t port, mios32_midi_package_t midi_package);
+extern s32 MIDI_ROUTER_ReceiveBlock(mios32_midi_port_t port, mios32_midi_package_t *packages, u32 num);
 extern s32 MIDI_ROUTER_ReceiveSysEx(mios32_midi_port_t port, u8 midi_in);
 
 extern s32 MIDI_ROUTER_MIDIClockInGet(mios32_midi_port_t port);
@@ -18,9 +18,6 @@
 #include <mios32.h>
 #include <string.h>
 
-#include <FreeRTOS.h>
-//#include <portmacro.h>
-
 #include "mid_parser.h"
 
 
@@ -46,13 +43,60 @@ typedef struct {
   u8   running_status;
 } midi_track_t;
 
+#if MID_PARSER_TRACK_BUFFER_SIZE > 0
+typedef struct {
+  u32  file_pos; // file position of buffer[0]
+  u32  len;      // number of valid bytes in buffer
+  u8   buffer[MID_PARSER_TRACK_BUFFER_SIZE];
+} midi_track_buffer_t;
+#endif
+
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+// controllers which are chased after a seek
+static const u8 chase_cc_number[] = { 0, 32, 1, 7, 10, 11, 64 };
+#define CHASE_CC_NUM sizeof(chase_cc_number)
+
+typedef struct {
+  u8   track;         // track which sent the last event
+  u8   program;       // 0x80: not set
+  u8   cc[CHASE_CC_NUM]; // 0x80: not set
+  u8   pitchbend_lsb;
+  u8   pitchbend_msb; // 0x80: not set
+} midi_chase_chn_t;
+
+typedef struct {
+  midi_chase_chn_t chn[16];
+  u8   tempo[3];
+  u8   tempo_track;   // 0xff: tempo not set
+} midi_chase_t;
+
+typedef struct {
+  u32  file_pos;
+  u32  tick;
+  u8   running_status;
+} midi_track_pos_t;
+
+typedef struct {
+  u32  tick;
+  midi_chase_t chase;
+  midi_track_pos_t track[MID_PARSER_MAX_TRACKS];
+} midi_seek_checkpoint_t;
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Local prototypes
 /////////////////////////////////////////////////////////////////////////////
 
 static u32 MID_PARSER_ReadWord(u8 len);
-static u32 MID_PARSER_ReadVarLen(u32 *pos);
+static u32 MID_PARSER_ReadVarLen(midi_track_t *mt, u32 *pos);
+static u32 MID_PARSER_TrackRead(midi_track_t *mt, void *buffer, u32 len);
+static void MID_PARSER_InvalidateTrackBuffers(void);
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+static void MID_PARSER_ChaseReset(void);
+static void MID_PARSER_ChaseUpdate(u8 track, mios32_midi_package_t midi_package, u32 tick);
+static void MID_PARSER_SeekIndexUpdate(u32 tick);
+#endif
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -66,13 +110,29 @@ static u16 midifile_ppqn;
 
 static u8 midi_tracks_num;
 static midi_track_t midi_tracks[MID_PARSER_MAX_TRACKS];
+#if MID_PARSER_TRACK_BUFFER_SIZE > 0
+static midi_track_buffer_t midi_track_buffers[MID_PARSER_MAX_TRACKS];
+#endif
 
 static u8 meta_buffer[MID_PARSER_META_BUFFER_SIZE];
 
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+static midi_chase_t midi_chase;
+// tick of each chased value: since the tracks are fetched one after another,
+// an older value of a following track must not overwrite a newer one
+// not stored in the checkpoints, since all values are older than the following events
+static u32 midi_chase_tick[16][CHASE_CC_NUM+2];
+static u32 midi_chase_tempo_tick;
+static midi_seek_checkpoint_t seek_index[MID_PARSER_SEEK_INDEX_NUM];
+static u8 seek_index_num;
+static u32 seek_index_distance;
+#endif
+
 // callback functions
 static u32 (*mid_parser_read_callback)(void *buffer, u32 len);
 static s32 (*mid_parser_eof_callback)(void);
 static s32 (*mid_parser_seek_callback)(u32 pos);
+static u32 (*mid_parser_read_block_callback)(u32 pos, void *buffer, u32 len);
 static s32 (*mid_parser_playevent_callback)(u8 track, mios32_midi_package_t midi_package, u32 tick);
 static s32 (*mid_parser_playmeta_callback)(u8 track, u8 meta, u32 len, u8 *buffer, u32 tick);
 
@@ -90,9 +150,16 @@ s32 MID_PARSER_Init(u32 mode)
   mid_parser_read_callback = NULL;
   mid_parser_eof_callback = NULL;
   mid_parser_seek_callback = NULL;
+  mid_parser_read_block_callback = NULL;
   mid_parser_playevent_callback = NULL;
   mid_parser_playmeta_callback = NULL;
 
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+  MID_PARSER_ChaseReset();
+  seek_index_num = 0;
+  seek_index_distance = MID_PARSER_SEEK_INDEX_BARS * 4 * 384;
+#endif
+
   return 0; // no error
 }
 
@@ -105,6 +172,23 @@ s32 MID_PARSER_InstallFileCallbacks(void *mid_parser_read, void *mid_parser_eof,
   mid_parser_read_callback = mid_parser_read;
   mid_parser_eof_callback = mid_parser_eof;
   mid_parser_seek_callback = mid_parser_seek;
+  mid_parser_read_block_callback = NULL; // has to be installed again for the new file
+  MID_PARSER_InvalidateTrackBuffers();
+  return 0; // no error
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Optional: reads <len> bytes at file position <pos> into <buffer> and
+// returns the number of read bytes (less at the end of file, 0 on errors).
+// Used by MID_PARSER_FetchEvents() to refill the read-ahead windows of the
+// tracks if MID_PARSER_TRACK_BUFFER_SIZE > 0, so that the file is accessed
+// once per window instead of once per byte.
+// Has to be installed after MID_PARSER_InstallFileCallbacks()
+/////////////////////////////////////////////////////////////////////////////
+s32 MID_PARSER_InstallReadBlockCallback(void *mid_parser_read_block)
+{
+  mid_parser_read_block_callback = mid_parser_read_block;
+  MID_PARSER_InvalidateTrackBuffers();
   return 0; // no error
 }
 
@@ -150,6 +234,7 @@ s32 MID_PARSER_Read(void)
 
   midi_tracks_num = 0;
   u16 num_tracks = 0;
+  MID_PARSER_InvalidateTrackBuffers();
 
   // read chunks
   while( !mid_parser_eof_callback() ) {
@@ -190,7 +275,7 @@ s32 MID_PARSER_Read(void)
 #endif
       } else {
 	u32 num_bytes = 0;
-	u32 delta = (u32)MID_PARSER_ReadVarLen(&num_bytes);
+	u32 delta = (u32)MID_PARSER_ReadVarLen(NULL, &num_bytes);
 	file_pos += num_bytes;
 	chunk_len -= num_bytes;
 
@@ -240,6 +325,13 @@ s32 MID_PARSER_Read(void)
   if( num_tracks ); // avoid warning (unused variable...)
 #endif
 
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+  // new song: start with an empty seek index
+  MID_PARSER_ChaseReset();
+  seek_index_num = 0;
+  seek_index_distance = MID_PARSER_SEEK_INDEX_BARS * 4 * (midifile_ppqn ? midifile_ppqn : 384);
+#endif
+
   file_valid = 1;
 
   return 0; // no error
@@ -301,15 +393,18 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
       if( mt->tick >= (tick_offset + num_ticks) )
 	break;
 
-      // set file pos
-      mid_parser_seek_callback(mt->file_pos);
+      // set file pos (not required if the track is read via its read-ahead window)
+#if MID_PARSER_TRACK_BUFFER_SIZE > 0
+      if( mid_parser_read_block_callback == NULL )
+#endif
+	mid_parser_seek_callback(mt->file_pos);
 
       // get event
       u8 event;
-      mt->file_pos += mid_parser_read_callback(&event, 1);
+      mt->file_pos += MID_PARSER_TrackRead(mt, &event, 1);
 
       if( event == 0xf0 ) { // SysEx event
-	u32 length = (u32)MID_PARSER_ReadVarLen(&mt->file_pos);
+	u32 length = (u32)MID_PARSER_ReadVarLen(mt, &mt->file_pos);
 #if DEBUG_VERBOSE_LEVEL >= 3
 	DEBUG_MSG("[MID_PARSER:%d:%u] SysEx event with %u bytes\n\r", track, mt->tick, length);
 #endif
@@ -327,13 +422,13 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 	int i;
 	for(i=0; i<length; ++i) {
 	  u8 evnt0;
-	  mt->file_pos += mid_parser_read_callback(&evnt0, 1);
+	  mt->file_pos += MID_PARSER_TrackRead(mt, &evnt0, 1);
 	  midi_package.evnt0 = evnt0;
 	  if( mid_parser_playevent_callback != NULL )
 	    mid_parser_playevent_callback(track, midi_package, mt->tick);
 	}
       } else if( event == 0xf7 ) { // "Escaped" event (allows to send any MIDI data)
-	u32 length = (u32)MID_PARSER_ReadVarLen(&mt->file_pos);
+	u32 length = (u32)MID_PARSER_ReadVarLen(mt, &mt->file_pos);
 #if DEBUG_VERBOSE_LEVEL >= 3
 	DEBUG_MSG("[MID_PARSER:%d:%u] Escaped event with %u bytes\n\r", track, mt->tick, length);
 #endif
@@ -342,15 +437,15 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 	int i;
 	for(i=0; i<length; ++i) {
 	  u8 evnt0;
-	  mt->file_pos += mid_parser_read_callback(&evnt0, 1);
+	  mt->file_pos += MID_PARSER_TrackRead(mt, &evnt0, 1);
 	  midi_package.evnt0 = evnt0;
 	  if( mid_parser_playevent_callback != NULL )
 	    mid_parser_playevent_callback(track, midi_package, mt->tick);
 	}
       } else if( event == 0xff ) { // Meta Event
 	u8 meta;
-	mt->file_pos += mid_parser_read_callback(&meta, 1);
-	u32 length = (u32)MID_PARSER_ReadVarLen(&mt->file_pos);
+	mt->file_pos += MID_PARSER_TrackRead(mt, &meta, 1);
+	u32 length = (u32)MID_PARSER_ReadVarLen(mt, &mt->file_pos);
 
 	if( mid_parser_playmeta_callback != NULL ) {
 	  u32 buflen = length;
@@ -367,18 +462,26 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 
 	  if( buflen ) {
 	    // copy bytes into buffer
-	    mt->file_pos += mid_parser_read_callback(meta_buffer, buflen);
+	    mt->file_pos += MID_PARSER_TrackRead(mt, meta_buffer, buflen);
 
 	    if( length > buflen ) {
 	      // no free memory: dummy reads
 	      int i;
 	      u8 dummy;
 	      for(i=buflen; i<length; ++i)
-		mt->file_pos += mid_parser_read_callback(&dummy, 1);
+		mt->file_pos += MID_PARSER_TrackRead(mt, &dummy, 1);
 	    }
 	  }
 
 	  meta_buffer[buflen] = 0; // terminate with 0 for the case that a string has been transfered
+
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+	  if( meta == 0x51 && buflen == 3 && mt->tick >= midi_chase_tempo_tick ) { // Set Tempo
+	    midi_chase_tempo_tick = mt->tick;
+	    memcpy(midi_chase.tempo, meta_buffer, 3);
+	    midi_chase.tempo_track = track;
+	  }
+#endif
 	  
 	  // -> forward to callback function
 	  mid_parser_playmeta_callback(track, meta, buflen, meta_buffer, mt->tick);
@@ -390,7 +493,7 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 	  mt->running_status = event;
 	  midi_package.evnt0 = event;
 	  u8 evnt1;
-	  mt->file_pos += mid_parser_read_callback(&evnt1, 1);
+	  mt->file_pos += MID_PARSER_TrackRead(mt, &evnt1, 1);
 	  midi_package.evnt1 = evnt1;
 	} else {
 	  midi_package.evnt0 = mt->running_status;
@@ -406,8 +509,11 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 	  case PitchBend:
 	  {
 	    u8 evnt2;
-	    mt->file_pos += mid_parser_read_callback(&evnt2, 1);
+	    mt->file_pos += MID_PARSER_TrackRead(mt, &evnt2, 1);
 	    midi_package.evnt2 = evnt2;
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+	    MID_PARSER_ChaseUpdate(track, midi_package, mt->tick);
+#endif
 
 	    if( mid_parser_playevent_callback != NULL )
 	      mid_parser_playevent_callback(track, midi_package, mt->tick);
@@ -418,6 +524,9 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 	  break;
 	  case ProgramChange:
 	  case Aftertouch:
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+	    MID_PARSER_ChaseUpdate(track, midi_package, mt->tick);
+#endif
 	    if( mid_parser_playevent_callback != NULL )
 	      mid_parser_playevent_callback(track, midi_package, mt->tick);
 #if DEBUG_VERBOSE_LEVEL >= 3
@@ -434,12 +543,18 @@ s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks)
 
       // get delta length to next event if end of track hasn't been reached yet
       if( mt->file_pos < mt->chunk_end ) {
-	u32 delta = (u32)MID_PARSER_ReadVarLen(&mt->file_pos);
+	u32 delta = (u32)MID_PARSER_ReadVarLen(mt, &mt->file_pos);
 	mt->tick += delta;
       }
     }
   }
 
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+  // all tracks are located at tick_offset + num_ticks now
+  if( num_tracks_running )
+    MID_PARSER_SeekIndexUpdate(tick_offset + num_ticks);
+#endif
+
   return num_tracks_running;
 }
 
@@ -466,18 +581,19 @@ static u32 MID_PARSER_ReadWord(u8 len)
 /////////////////////////////////////////////////////////////////////////////
 // Help function: reads a variable-length number from the .mid file
 // based on code example in MIDI file spec
+// if <mt> is not NULL, the number is read from the current position of the track
 /////////////////////////////////////////////////////////////////////////////
-static u32 MID_PARSER_ReadVarLen(u32 *pos)
+static u32 MID_PARSER_ReadVarLen(midi_track_t *mt, u32 *pos)
 {
   u32 value;
   u8 c;
 
-  *pos += mid_parser_read_callback(&c, 1);
+  *pos += (mt != NULL) ? MID_PARSER_TrackRead(mt, &c, 1) : mid_parser_read_callback(&c, 1);
   if( (value = c) & 0x80 ) {
     value &= 0x7f;
 
     do {
-      *pos += mid_parser_read_callback(&c, 1);
+      *pos += (mt != NULL) ? MID_PARSER_TrackRead(mt, &c, 1) : mid_parser_read_callback(&c, 1);
       value = (value << 7) | (c & 0x7f);
     } while( c & 0x80 );
   }
@@ -486,6 +602,75 @@ static u32 MID_PARSER_ReadVarLen(u32 *pos)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Help function: reads <len> bytes from the current position of a track
+// Uses the read-ahead window of the track if a block read callback has been
+// installed, otherwise the file has to be at mt->file_pos already.
+// returns number of read bytes
+/////////////////////////////////////////////////////////////////////////////
+static u32 MID_PARSER_TrackRead(midi_track_t *mt, void *buffer, u32 len)
+{
+#if MID_PARSER_TRACK_BUFFER_SIZE > 0
+  if( mid_parser_read_block_callback != NULL ) {
+    midi_track_buffer_t *tb = &midi_track_buffers[mt - midi_tracks];
+    u8 *dst = (u8 *)buffer;
+    u32 pos = mt->file_pos;
+    u32 remaining = len;
+
+    if( pos > mt->chunk_end ) { // track has been stopped
+      memset(dst, 0, remaining);
+      return 0;
+    }
+
+    while( remaining ) {
+      if( pos < tb->file_pos || pos >= (tb->file_pos + tb->len) ) {
+	// refill window
+	tb->file_pos = pos - (pos % MID_PARSER_TRACK_BUFFER_SIZE);
+	tb->len = mid_parser_read_block_callback(tb->file_pos, tb->buffer, MID_PARSER_TRACK_BUFFER_SIZE);
+
+	if( pos >= (tb->file_pos + tb->len) ) {
+#if DEBUG_VERBOSE_LEVEL >= 1
+	  DEBUG_MSG("[MID_PARSER] read error at file position %u - stopping track %d\n\r", pos, mt - midi_tracks);
+#endif
+	  // read error or unexpected end of file: stop the track
+	  tb->len = 0;
+	  memset(dst, 0, remaining);
+	  mt->file_pos = mt->chunk_end + 1;
+	  return 0;
+	}
+      }
+
+      u32 offset = pos - tb->file_pos;
+      u32 num = tb->len - offset;
+      if( num > remaining )
+	num = remaining;
+      memcpy(dst, &tb->buffer[offset], num);
+      dst += num;
+      pos += num;
+      remaining -= num;
+    }
+
+    return len;
+  }
+#endif
+
+  return mid_parser_read_callback(buffer, len);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Help function: invalidates the read-ahead windows, e.g. on file changes
+/////////////////////////////////////////////////////////////////////////////
+static void MID_PARSER_InvalidateTrackBuffers(void)
+{
+#if MID_PARSER_TRACK_BUFFER_SIZE > 0
+  int track;
+  for(track=0; track<MID_PARSER_MAX_TRACKS; ++track)
+    midi_track_buffers[track].len = 0;
+#endif
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Restarts a song w/o reading the .mid file chunks again (saves time)
 /////////////////////////////////////////////////////////////////////////////
@@ -500,6 +685,219 @@ s32 MID_PARSER_RestartSong(void)
     mt->running_status = 0x80;
   }
 
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+  MID_PARSER_ChaseReset();
+#endif
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Moves the song position to the given tick: all events before this tick
+// are fetched (so that the caller should ignore them), events at and after
+// this tick will be returned by the next MID_PARSER_FetchEvents() call.
+// With MID_PARSER_SEEK_INDEX_NUM > 0 parsing continues at the nearest
+// checkpoint, and new checkpoints are stored on the way.
+// returns < 0 on errors
+// returns > 0 if tracks are still playing
+// returns 0 if song is finished
+/////////////////////////////////////////////////////////////////////////////
+s32 MID_PARSER_SeekTick(u32 tick)
+{
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+  int i;
+  for(i=seek_index_num-1; i>=0 && seek_index[i].tick > tick; --i);
+
+  if( i < 0 ) {
+    MID_PARSER_RestartSong();
+  } else {
+    // continue at checkpoint
+    midi_seek_checkpoint_t *cp = &seek_index[i];
+    u8 track = 0;
+    midi_track_t *mt = &midi_tracks[0];
+    for(track=0; track<midi_tracks_num; ++mt, ++track) {
+      mt->file_pos = cp->track[track].file_pos;
+      mt->tick = cp->track[track].tick;
+      mt->running_status = cp->track[track].running_status;
+    }
+    midi_chase = cp->chase;
+    memset(midi_chase_tick, 0, sizeof(midi_chase_tick));
+    midi_chase_tempo_tick = 0;
+  }
+
+  // fetch in steps, so that checkpoints can be stored
+  u32 pos = (i < 0) ? 0 : seek_index[i].tick;
+  s32 status = 1;
+  while( pos < tick && status > 0 ) {
+    u32 num_ticks = tick - pos;
+    if( num_ticks > seek_index_distance )
+      num_ticks = seek_index_distance;
+    status = MID_PARSER_FetchEvents(pos, num_ticks);
+    pos += num_ticks;
+  }
+
+  return status;
+#else
+  MID_PARSER_RestartSong();
+  return MID_PARSER_FetchEvents(0, tick);
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Forwards the last tempo, program changes, controllers and pitchbender
+// values before the current song position to the callback functions,
+// e.g. after MID_PARSER_SeekTick() has been called in silent mode.
+// Only available if MID_PARSER_SEEK_INDEX_NUM > 0
+/////////////////////////////////////////////////////////////////////////////
+s32 MID_PARSER_ChaseEvents(u32 tick)
+{
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+  if( midi_chase.tempo_track != 0xff && mid_parser_playmeta_callback != NULL ) {
+    memcpy(meta_buffer, midi_chase.tempo, 3);
+    meta_buffer[3] = 0;
+    mid_parser_playmeta_callback(midi_chase.tempo_track, 0x51, 3, meta_buffer, tick);
+  }
+
+  if( mid_parser_playevent_callback != NULL ) {
+    int chn;
+    midi_chase_chn_t *c = &midi_chase.chn[0];
+    for(chn=0; chn<16; ++chn, ++c) {
+      mios32_midi_package_t midi_package;
+      int i;
+
+      // controllers first, so that a bank select is sent before the program change
+      midi_package.ALL = 0;
+      midi_package.type = CC;
+      midi_package.evnt0 = 0xb0 | chn;
+      for(i=0; i<CHASE_CC_NUM; ++i) {
+	if( c->cc[i] < 0x80 ) {
+	  midi_package.evnt1 = chase_cc_number[i];
+	  midi_package.evnt2 = c->cc[i];
+	  mid_parser_playevent_callback(c->track, midi_package, tick);
+	}
+      }
+
+      if( c->program < 0x80 ) {
+	midi_package.ALL = 0;
+	midi_package.type = ProgramChange;
+	midi_package.evnt0 = 0xc0 | chn;
+	midi_package.evnt1 = c->program;
+	mid_parser_playevent_callback(c->track, midi_package, tick);
+      }
+
+      if( c->pitchbend_msb < 0x80 ) {
+	midi_package.ALL = 0;
+	midi_package.type = PitchBend;
+	midi_package.evnt0 = 0xe0 | chn;
+	midi_package.evnt1 = c->pitchbend_lsb;
+	midi_package.evnt2 = c->pitchbend_msb;
+	mid_parser_playevent_callback(c->track, midi_package, tick);
+      }
+    }
+  }
+#endif
+
   return 0; // no error
 }
 
+
+#if MID_PARSER_SEEK_INDEX_NUM > 0
+/////////////////////////////////////////////////////////////////////////////
+// Help function: clears the chase state (song start)
+/////////////////////////////////////////////////////////////////////////////
+static void MID_PARSER_ChaseReset(void)
+{
+  memset(&midi_chase, 0x80, sizeof(midi_chase));
+  midi_chase.tempo_track = 0xff;
+  memset(midi_chase_tick, 0, sizeof(midi_chase_tick));
+  midi_chase_tempo_tick = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Help function: stores the values of a fetched MIDI event for chasing
+/////////////////////////////////////////////////////////////////////////////
+static void MID_PARSER_ChaseUpdate(u8 track, mios32_midi_package_t midi_package, u32 tick)
+{
+  midi_chase_chn_t *c = &midi_chase.chn[midi_package.chn];
+  u32 *value_tick = midi_chase_tick[midi_package.chn];
+
+  switch( midi_package.event ) {
+  case CC: {
+    int i;
+    for(i=0; i<CHASE_CC_NUM; ++i) {
+      if( chase_cc_number[i] == midi_package.evnt1 ) {
+	if( tick >= value_tick[i] ) {
+	  value_tick[i] = tick;
+	  c->cc[i] = midi_package.evnt2 & 0x7f;
+	  c->track = track;
+	}
+	break;
+      }
+    }
+  } break;
+
+  case ProgramChange:
+    if( tick >= value_tick[CHASE_CC_NUM] ) {
+      value_tick[CHASE_CC_NUM] = tick;
+      c->program = midi_package.evnt1 & 0x7f;
+      c->track = track;
+    }
+    break;
+
+  case PitchBend:
+    if( tick >= value_tick[CHASE_CC_NUM+1] ) {
+      value_tick[CHASE_CC_NUM+1] = tick;
+      c->pitchbend_lsb = midi_package.evnt1 & 0x7f;
+      c->pitchbend_msb = midi_package.evnt2 & 0x7f;
+      c->track = track;
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Help function: stores a checkpoint if all tracks have been fetched up to
+// the given tick, and the distance to the previous checkpoint is reached
+/////////////////////////////////////////////////////////////////////////////
+static void MID_PARSER_SeekIndexUpdate(u32 tick)
+{
+  u32 next_tick = (seek_index_num ? seek_index[seek_index_num-1].tick : 0) + seek_index_distance;
+  if( tick < next_tick )
+    return; // too early, or position already covered by the index
+
+  if( seek_index_num >= MID_PARSER_SEEK_INDEX_NUM ) {
+    // index full: keep every second checkpoint, and double the distance
+    int i;
+    for(i=0; i<(MID_PARSER_SEEK_INDEX_NUM/2); ++i)
+      seek_index[i] = seek_index[2*i + 1];
+    seek_index_num = MID_PARSER_SEEK_INDEX_NUM/2;
+    seek_index_distance *= 2;
+
+    next_tick = (seek_index_num ? seek_index[seek_index_num-1].tick : 0) + seek_index_distance;
+    if( tick < next_tick )
+      return;
+  }
+
+  midi_seek_checkpoint_t *cp = &seek_index[seek_index_num++];
+  cp->tick = tick;
+  cp->chase = midi_chase;
+
+  u8 track = 0;
+  midi_track_t *mt = &midi_tracks[0];
+  for(track=0; track<midi_tracks_num; ++mt, ++track) {
+    cp->track[track].file_pos = mt->file_pos;
+    cp->track[track].tick = mt->tick;
+    cp->track[track].running_status = mt->running_status;
+  }
+
+#if DEBUG_VERBOSE_LEVEL >= 2
+  DEBUG_MSG("[MID_PARSER] stored checkpoint #%d at tick %u\n\r", seek_index_num-1, tick);
+#endif
+}
+#endif
+
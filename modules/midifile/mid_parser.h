@@ -14,6 +14,10 @@
 #ifndef _MID_PARSER_H
 #define _MID_PARSER_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 // Global definitions
 /////////////////////////////////////////////////////////////////////////////
@@ -27,6 +31,30 @@
 #define MID_PARSER_META_BUFFER_SIZE 80
 #endif
 
+// size of the read-ahead window of each track in bytes
+// If > 0 and a block read callback has been installed with MID_PARSER_InstallReadBlockCallback(),
+// MID_PARSER_FetchEvents() refills the windows in chunks of this size (aligned to the size)
+// instead of seeking and reading the file byte by byte.
+// 512 matches the sector size of SD cards, but costs MID_PARSER_MAX_TRACKS*512 bytes of RAM
+#ifndef MID_PARSER_TRACK_BUFFER_SIZE
+#define MID_PARSER_TRACK_BUFFER_SIZE 0
+#endif
+
+// max. number of checkpoints of the seek index (0 disables the index)
+// While the song is fetched, the parser stores the track positions, the tempo and
+// the program/controller/pitchbender state every MID_PARSER_SEEK_INDEX_BARS bars,
+// so that MID_PARSER_SeekTick() doesn't have to parse the song from the beginning.
+// If the index is full, every second checkpoint is dropped and the distance doubled.
+// Each checkpoint costs ca. 180 + 12*MID_PARSER_MAX_TRACKS bytes of RAM
+#ifndef MID_PARSER_SEEK_INDEX_NUM
+#define MID_PARSER_SEEK_INDEX_NUM 0
+#endif
+
+// initial distance between two checkpoints in 4/4 bars
+#ifndef MID_PARSER_SEEK_INDEX_BARS
+#define MID_PARSER_SEEK_INDEX_BARS 8
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Global Types
@@ -39,6 +67,7 @@
 extern s32 MID_PARSER_Init(u32 mode);
 
 extern s32 MID_PARSER_InstallFileCallbacks(void *mid_parser_read, void *mid_parser_eof, void *mid_parser_seek);
+extern s32 MID_PARSER_InstallReadBlockCallback(void *mid_parser_read_block);
 extern s32 MID_PARSER_InstallEventCallbacks(void *mid_parser_playevent, void *mid_parser_playmeta);
 
 extern s32 MID_PARSER_FileIsValid(void);
@@ -46,6 +75,8 @@ extern s32 MID_PARSER_FileIsValid(void);
 extern s32 MID_PARSER_Read(void);
 extern s32 MID_PARSER_FetchEvents(u32 tick_offset, u32 num_ticks);
 extern s32 MID_PARSER_RestartSong(void);
+extern s32 MID_PARSER_SeekTick(u32 tick);
+extern s32 MID_PARSER_ChaseEvents(u32 tick);
 
 extern s32 MIDI_PARSER_FormatGet(void);
 extern s32 MIDI_PARSER_PPQN_Get(void);
@@ -58,4 +89,8 @@ extern s32 MIDI_PARSER_TrackNumGet(void);
 // Export global variables
 /////////////////////////////////////////////////////////////////////////////
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* _MID_PARSER_H */
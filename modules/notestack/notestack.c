@@ -27,10 +27,89 @@
 #include "notestack.h"
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+#if NOTESTACK_BITMAP_ENABLED
+#define NOTESTACK_MAP_GET(map, note) ((map)[(note) >> 5] & (1U << ((note) & 31)))
+#define NOTESTACK_MAP_SET(map, note) { (map)[(note) >> 5] |= (1U << ((note) & 31)); }
+#define NOTESTACK_MAP_CLR(map, note) { (map)[(note) >> 5] &= ~(1U << ((note) & 31)); }
+#endif
+
+
+#if NOTESTACK_BITMAP_ENABLED
+/////////////////////////////////////////////////////////////////////////////
+// Returns the number of notes in the bitmap below the given note
+/////////////////////////////////////////////////////////////////////////////
+static s32 NOTESTACK_MapCountBelow(u32 *map, u8 note)
+{
+  int word;
+  int count = 0;
+
+  for(word=0; word < (note >> 5); ++word)
+    count += __builtin_popcount(map[word]);
+
+  if( note & 31 )
+    count += __builtin_popcount(map[note >> 5] & ((1U << (note & 31)) - 1));
+
+  return count;
+}
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the index of a note in the stack, or -1 if it isn't in the stack
+/////////////////////////////////////////////////////////////////////////////
+static s32 NOTESTACK_FindNote(notestack_t *n, u8 note)
+{
+  int i;
+
+#if NOTESTACK_BITMAP_ENABLED
+  if( !NOTESTACK_MAP_GET(n->note_map, note) )
+    return -1;
+
+  // sorted stack: the index is given by the number of lower notes
+  if( n->mode == NOTESTACK_MODE_SORT || n->mode == NOTESTACK_MODE_SORT_HOLD )
+    return NOTESTACK_MapCountBelow(n->note_map, note);
+#endif
+
+  for(i=0; i < n->len; ++i) {
+    if( n->note_items[i].note == note )
+      return i;
+  }
+
+  return -1;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Replaces the note of an existing item
+/////////////////////////////////////////////////////////////////////////////
+static void NOTESTACK_ReplaceItem(notestack_t *n, int ix, u8 new_note, u8 tag)
+{
+#if NOTESTACK_BITMAP_ENABLED
+  u8 old_note = n->note_items[ix].note;
+  NOTESTACK_MAP_CLR(n->note_map, old_note);
+  NOTESTACK_MAP_CLR(n->active_map, old_note);
+  NOTESTACK_MAP_SET(n->note_map, new_note);
+  NOTESTACK_MAP_SET(n->active_map, new_note);
+#endif
+
+  n->note_items[ix].note = new_note;
+  n->note_items[ix].depressed = 0;
+  n->note_items[ix].tag = tag;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //! Initializes a Notestack
 //!
 //! Has to be called before NOTESTACK_Push/Pop/Clear functions are used!
+//!
+//! With NOTESTACK_BITMAP_ENABLED the notes are additionally stored in bitmaps,
+//! which allows to check for existing notes and to find the insertion point of
+//! sorted stacks without scanning the items.
 //! \param[in] *n pointer to notestack structure
 //! \param[in] mode one of following modes:
 //! <UL>
@@ -71,6 +150,10 @@ s32 NOTESTACK_Push(notestack_t *n, u8 new_note, u8 tag)
 {
   int i;
 
+#if NOTESTACK_BITMAP_ENABLED
+  new_note &= 0x7f; // as stored in the note item
+#endif
+
   u8 hold_mode =
     n->mode == NOTESTACK_MODE_PUSH_TOP_HOLD ||
     n->mode == NOTESTACK_MODE_PUSH_BOTTOM_HOLD ||
@@ -78,12 +161,13 @@ s32 NOTESTACK_Push(notestack_t *n, u8 new_note, u8 tag)
 
   if( hold_mode ) {
     // check if note already in stack - in this case, replace it with the new tag and exit
-    for(i=0; i < n->len; ++i) {
-      if( n->note_items[i].note == new_note ) {
-	n->note_items[i].depressed = 0;
-	n->note_items[i].tag = tag;
-	return 0; // no error
-      }
+    if( (i=NOTESTACK_FindNote(n, new_note)) >= 0 ) {
+      n->note_items[i].depressed = 0;
+      n->note_items[i].tag = tag;
+#if NOTESTACK_BITMAP_ENABLED
+      NOTESTACK_MAP_SET(n->active_map, new_note);
+#endif
+      return 0; // no error
     }
   } else {
     // not in hold mode:
@@ -99,9 +183,7 @@ s32 NOTESTACK_Push(notestack_t *n, u8 new_note, u8 tag)
     } else {
       // corner case: stack is full, and new note is greater than all others:
       // replace last note by new one and exit
-      n->note_items[n->size-1].note = new_note;
-      n->note_items[n->size-1].depressed = 0;
-      n->note_items[n->size-1].tag = tag;
+      NOTESTACK_ReplaceItem(n, n->size-1, new_note, tag);
       return 0; // no error
     }
     insertion_point = n->len;
@@ -110,6 +192,12 @@ s32 NOTESTACK_Push(notestack_t *n, u8 new_note, u8 tag)
     // if sort flag set: search for insertion point
     int sort = n->mode == NOTESTACK_MODE_SORT || n->mode == NOTESTACK_MODE_SORT_HOLD;
     i = 0;
+#if NOTESTACK_BITMAP_ENABLED
+    if( sort ) {
+      // the insertion point is given by the number of lower notes
+      i = insertion_point = NOTESTACK_MapCountBelow(n->note_map, new_note);
+    }
+#else
     if( sort && n->len ) {
       for(i=0; i<n->len; ++i)
 	if( n->note_items[i].note > new_note ) {
@@ -117,14 +205,13 @@ s32 NOTESTACK_Push(notestack_t *n, u8 new_note, u8 tag)
 	  break;
 	}
     }
+#endif
 
     if( i == n->len ) {
       // corner case: stack is full, and new note is greater than all others:
       // replace last note by new one and exit
       if( n->len >= n->size ) {
-	n->note_items[n->size-1].note = new_note;
-	n->note_items[n->size-1].depressed = 0;
-	n->note_items[n->size-1].tag = tag;
+	NOTESTACK_ReplaceItem(n, n->size-1, new_note, tag);
 	return 0; // no error
       }
       insertion_point = n->len;
@@ -134,6 +221,14 @@ s32 NOTESTACK_Push(notestack_t *n, u8 new_note, u8 tag)
   // increment length so long it hasn't reached the notestack size
   if( n->len < n->size )
     ++n->len;
+#if NOTESTACK_BITMAP_ENABLED
+  else {
+    // the last note will be dropped
+    u8 dropped_note = n->note_items[n->len-1].note;
+    NOTESTACK_MAP_CLR(n->note_map, dropped_note);
+    NOTESTACK_MAP_CLR(n->active_map, dropped_note);
+  }
+#endif
   
   // add note at insertion point
   for(i=n->len-1; i > insertion_point; --i)
@@ -142,6 +237,11 @@ s32 NOTESTACK_Push(notestack_t *n, u8 new_note, u8 tag)
   n->note_items[insertion_point].depressed = 0;
   n->note_items[insertion_point].tag = tag;
 
+#if NOTESTACK_BITMAP_ENABLED
+  NOTESTACK_MAP_SET(n->note_map, new_note);
+  NOTESTACK_MAP_SET(n->active_map, new_note);
+#endif
+
   return 0; // no error
 }
 
@@ -158,38 +258,48 @@ s32 NOTESTACK_Pop(notestack_t *n, u8 old_note)
 {
   int i, j;
 
+#if NOTESTACK_BITMAP_ENABLED
+  old_note &= 0x7f; // as stored in the note item
+#endif
+
   u8 hold_mode =
     n->mode == NOTESTACK_MODE_PUSH_TOP_HOLD ||
     n->mode == NOTESTACK_MODE_PUSH_BOTTOM_HOLD ||
     n->mode == NOTESTACK_MODE_SORT_HOLD;
 
   // search for note with same value and remove it
-  // (SEQ_MIDI_IN_Notestack_Push ensures, that a note value only exists one time in stack)
-  for(i=0; i < n->len; ++i) {
-    if( n->note_items[i].note == old_note ) {
-      if( hold_mode ) {
-	n->note_items[i].depressed = 1;
-	
-	// check if any note is still pressed
-	u8 any_note_pressed = 0;
-	for(j=0; !any_note_pressed && j<n->len; ++j)
-	  if( !n->note_items[j].depressed )
-	    any_note_pressed = 1;
-
-	return any_note_pressed ? 1 : 2;
-      } else {
-	for(j=i; j < n->len-1; ++j)
-	  n->note_items[j] = n->note_items[j+1];
-	--n->len;
-	n->note_items[n->len].ALL = 0x00;
-
-	return 1; // note has been found and removed
-      }
-    }
+  // (NOTESTACK_Push ensures, that a note value only exists one time in stack)
+  if( (i=NOTESTACK_FindNote(n, old_note)) < 0 )
+    return 0; // note hasn't been found
+
+  if( hold_mode ) {
+    n->note_items[i].depressed = 1;
+
+    // check if any note is still pressed
+    u8 any_note_pressed = 0;
+#if NOTESTACK_BITMAP_ENABLED
+    NOTESTACK_MAP_CLR(n->active_map, old_note);
+    any_note_pressed = (n->active_map[0] | n->active_map[1] | n->active_map[2] | n->active_map[3]) != 0;
+#else
+    for(j=0; !any_note_pressed && j<n->len; ++j)
+      if( !n->note_items[j].depressed )
+	any_note_pressed = 1;
+#endif
+
+    return any_note_pressed ? 1 : 2;
   }
 
-  // note hasn't been found
-  return 0;
+  for(j=i; j < n->len-1; ++j)
+    n->note_items[j] = n->note_items[j+1];
+  --n->len;
+  n->note_items[n->len].ALL = 0x00;
+
+#if NOTESTACK_BITMAP_ENABLED
+  NOTESTACK_MAP_CLR(n->note_map, old_note);
+  NOTESTACK_MAP_CLR(n->active_map, old_note);
+#endif
+
+  return 1; // note has been found and removed
 }
 
 
@@ -205,9 +315,14 @@ s32 NOTESTACK_CountActiveNotes(notestack_t *n)
   int i;
   int count = 0;
 
+#if NOTESTACK_BITMAP_ENABLED
+  for(i=0; i<4; ++i)
+    count += __builtin_popcount(n->active_map[i]);
+#else
   for(i=0; i<n->len; ++i)
     if( !n->note_items[i].depressed )
       ++count;
+#endif
 
   return count;
 }
@@ -222,6 +337,24 @@ s32 NOTESTACK_RemoveNonActiveNotes(notestack_t *n)
 {
   int i, j;
 
+#if NOTESTACK_BITMAP_ENABLED
+  // any depressed note?
+  if( n->note_map[0] == n->active_map[0] && n->note_map[1] == n->active_map[1] &&
+      n->note_map[2] == n->active_map[2] && n->note_map[3] == n->active_map[3] )
+    return 0; // no error
+
+  // compact the stack in a single pass
+  for(i=0, j=0; i < n->len; ++i) {
+    if( !n->note_items[i].depressed )
+      n->note_items[j++] = n->note_items[i];
+  }
+  for(i=j; i < n->len; ++i)
+    n->note_items[i].ALL = 0x00;
+  n->len = j;
+
+  for(i=0; i<4; ++i)
+    n->note_map[i] = n->active_map[i];
+#else
   for(i=0; i < n->len; ++i) {
     if( n->note_items[i].depressed ) {
       for(j=i; j < n->len-1; ++j)
@@ -231,6 +364,7 @@ s32 NOTESTACK_RemoveNonActiveNotes(notestack_t *n)
       --i; // note at index "i" has been removed, ensure that next note will be checked
     }
   }
+#endif
 
   return 0; // no error
 }
@@ -250,10 +384,77 @@ s32 NOTESTACK_Clear(notestack_t *n)
   for(i=0; i<n->size; ++i)
     n->note_items[i].ALL = 0;
 
+#if NOTESTACK_BITMAP_ENABLED
+  for(i=0; i<4; ++i) {
+    n->note_map[i] = 0;
+    n->active_map[i] = 0;
+  }
+#endif
+
   return 0; // no error
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the highest note in the note stack (including depressed notes)
+//! \param[in] *n pointer to notestack structure
+//! \return < 0 if the note stack is empty
+//! \return >= 0: the note number
+/////////////////////////////////////////////////////////////////////////////
+s32 NOTESTACK_HighestNote(notestack_t *n)
+{
+#if NOTESTACK_BITMAP_ENABLED
+  int word;
+
+  for(word=3; word >= 0; --word) {
+    if( n->note_map[word] )
+      return 32*word + 31 - __builtin_clz(n->note_map[word]);
+  }
+
+  return -1; // stack empty
+#else
+  int i;
+  s32 note = -1;
+
+  for(i=0; i<n->len; ++i)
+    if( n->note_items[i].note > note )
+      note = n->note_items[i].note;
+
+  return note;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+//! Returns the lowest note in the note stack (including depressed notes)
+//! \param[in] *n pointer to notestack structure
+//! \return < 0 if the note stack is empty
+//! \return >= 0: the note number
+/////////////////////////////////////////////////////////////////////////////
+s32 NOTESTACK_LowestNote(notestack_t *n)
+{
+#if NOTESTACK_BITMAP_ENABLED
+  int word;
+
+  for(word=0; word < 4; ++word) {
+    if( n->note_map[word] )
+      return 32*word + __builtin_ctz(n->note_map[word]);
+  }
+
+  return -1; // stack empty
+#else
+  int i;
+  s32 note = -1;
+
+  for(i=0; i<n->len; ++i)
+    if( note < 0 || n->note_items[i].note < note )
+      note = n->note_items[i].note;
+
+  return note;
+#endif
+}
+
+
 
 /////////////////////////////////////////////////////////////////////////////
 //! Sends the content of the Notestack to the MIOS Terminal
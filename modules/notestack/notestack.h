@@ -22,6 +22,13 @@ extern "C" {
 // Global definitions
 /////////////////////////////////////////////////////////////////////////////
 
+// optional: the notes are additionally stored in bitmaps, so that Push/Pop
+// don't need to scan the stack for duplicates and insertion points
+// costs 32 bytes per notestack
+#ifndef NOTESTACK_BITMAP_ENABLED
+#define NOTESTACK_BITMAP_ENABLED 0
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 // Global Types
 /////////////////////////////////////////////////////////////////////////////
@@ -51,6 +58,10 @@ typedef struct {
   u8               size;
   u8               len;
   notestack_item_t *note_items;
+#if NOTESTACK_BITMAP_ENABLED
+  u32              note_map[4];   // notes which are in the stack
+  u32              active_map[4]; // notes which are not depressed
+#endif
 } notestack_t;
 
 
@@ -65,6 +76,8 @@ extern s32 NOTESTACK_Pop(notestack_t *n, u8 old_note);
 extern s32 NOTESTACK_CountActiveNotes(notestack_t *n);
 extern s32 NOTESTACK_RemoveNonActiveNotes(notestack_t *n);
 extern s32 NOTESTACK_Clear(notestack_t *n);
+extern s32 NOTESTACK_HighestNote(notestack_t *n);
+extern s32 NOTESTACK_LowestNote(notestack_t *n);
 
 
 extern s32 NOTESTACK_SendDebugMessage(notestack_t *n);
@@ -44,13 +44,18 @@ opl3_chip_t opl3_chip[OPL3_COUNT];
 // Local variables
 /////////////////////////////////////////////////////////////////////////////
 
-// Queues for what registers need to be updated
-static u16 opl3_op_queue[36*5*OPL3_COUNT];
-static u8 opl3_chan_queue[18*3*OPL3_COUNT];
-static u8 opl3_chip_queue[4*OPL3_COUNT];
-static u16 op_queue_idx;
-static u8 chan_queue_idx;
-static u8 chip_queue_idx;
+// Dirty flags for what registers need to be updated
+// One bit per register, and one bit per operator/channel with dirty registers
+// in the pending words, so OPL3_OnFrame() only visits what has changed
+static u8 opl3_op_dirty[36*OPL3_COUNT];    //Bit n: register n (0-4) of operator
+static u8 opl3_chan_dirty[18*OPL3_COUNT];  //Bit n: register n (0-2) of channel
+static u8 opl3_chip_dirty[OPL3_COUNT];     //Bit n: register n (0-3) of chip
+static u32 opl3_op_pending[OPL3_COUNT][2]; //Bit n: operator 32*word+n of chip
+static u32 opl3_chan_pending[OPL3_COUNT];  //Bit n: channel n of chip
+
+// Write statistics
+static u16 opl3_coalesced;
+static opl3_frame_stats_t opl3_frame_stats;
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -69,6 +74,11 @@ static const u8 OPL3ChanRegBegin[3] = {
   0xA0, 0xB0, 0xC0
 };
 
+//Order of channel register writes: 0xB0 (key on) last, so it uses the new settings
+static const u8 OPL3ChanRegOrder[3] = {
+  0, 2, 1
+};
+
 static const u8 OPL3ChipReg[4] = {
   0x05, 0x08, 0xBD, 0x04
 };
@@ -300,125 +310,140 @@ void OPL3_SendDemoPatch(){
 
 u8 toggle;
 s32 OPL3_OnFrame(){
-  u8 op, chan, chip, reg;
-  u16 val, q=0;
-  while(q < op_queue_idx){
-    if(q >= 36*5*OPL3_COUNT){
-      DEBUG_MSG("PANIC!! [opl3.c] Op queue overflow q==%d!", q);
+  u8 op, chan, chip, reg, word, dirty;
+  u32 pending;
+  u16 writes = 0;
+  //Chip by chip: operators, then channels, then chip registers (as they were
+  //queued before); no other ordering is needed since each write sends its address
+  //The pending words and dirty bytes are taken atomically, since the
+  //OPL3_Add*Queue() functions can be called from another task meanwhile
+  for(chip=0; chip<OPL3_COUNT; chip++){
+    for(word=0; word<2; word++){
+      MIOS32_IRQ_Disable();
+      pending = opl3_op_pending[chip][word];
+      opl3_op_pending[chip][word] = 0;
+      MIOS32_IRQ_Enable();
+      while(pending){
+        op = (36*chip) + (32*word) + __builtin_ctz(pending);
+        pending &= pending - 1;
+        MIOS32_IRQ_Disable();
+        dirty = opl3_op_dirty[op];
+        opl3_op_dirty[op] = 0;
+        MIOS32_IRQ_Enable();
+        for(reg=0; reg<5; reg++){
+          if(dirty & (1 << reg)){
+            OPL3_RefreshOperator(op, reg);
+            writes++;
+          }
+        }
+      }
     }
-    val = opl3_op_queue[q];
-    op = val / 5;
-    reg = val % 5;
-    OPL3_RefreshOperator(op, reg);
-    q++;
-  }
-  op_queue_idx = 0;
-  q = 0;
-  if(chan_queue_idx > 20){
-    DEBUG_MSG("chan_queue_idx=%d", chan_queue_idx);
-  }
-  while(q < chan_queue_idx){
-    if(q >= 18*3*OPL3_COUNT){
-      DEBUG_MSG("PANIC!! [opl3.c] Chan queue overflow q==%d!", q);
+    MIOS32_IRQ_Disable();
+    pending = opl3_chan_pending[chip];
+    opl3_chan_pending[chip] = 0;
+    MIOS32_IRQ_Enable();
+    while(pending){
+      chan = (18*chip) + __builtin_ctz(pending);
+      pending &= pending - 1;
+      MIOS32_IRQ_Disable();
+      dirty = opl3_chan_dirty[chan];
+      opl3_chan_dirty[chan] = 0;
+      MIOS32_IRQ_Enable();
+      for(word=0; word<3; word++){
+        reg = OPL3ChanRegOrder[word];
+        if(dirty & (1 << reg)){
+          OPL3_RefreshChannel(chan, reg);
+          writes++;
+        }
+      }
     }
-    val = opl3_chan_queue[q];
-    chan = val / 3;
-    reg = val % 3;
-    OPL3_RefreshChannel(chan, reg);
-    q++;
-  }
-  chan_queue_idx = 0;
-  q = 0;
-  while(q < chip_queue_idx){
-    if(q >= 4*OPL3_COUNT){
-      DEBUG_MSG("PANIC!! [opl3.c] Chip queue overflow q==%d!", q);
+    MIOS32_IRQ_Disable();
+    dirty = opl3_chip_dirty[chip];
+    opl3_chip_dirty[chip] = 0;
+    MIOS32_IRQ_Enable();
+    for(reg=0; reg<4; reg++){
+      if(dirty & (1 << reg)){
+        OPL3_RefreshChip(chip, reg);
+        writes++;
+      }
     }
-    val = opl3_chip_queue[q];
-    chip = val / 4;
-    reg = val % 4;
-    OPL3_RefreshChip(chip, reg);
-    q++;
   }
-  chip_queue_idx = 0;
+  //Statistics
+  opl3_frame_stats.writes = writes;
+  if(writes > opl3_frame_stats.writes_max){
+    opl3_frame_stats.writes_max = writes;
+  }
+  opl3_frame_stats.coalesced = opl3_coalesced;
+  opl3_coalesced = 0;
+  opl3_frame_stats.frames++;
+  return 0;
+}
+
+s32 OPL3_GetFrameStats(opl3_frame_stats_t *stats){
+  *stats = opl3_frame_stats;
+  return 0;
+}
+
+s32 OPL3_ResetFrameStats(){
+  opl3_frame_stats.writes = 0;
+  opl3_frame_stats.writes_max = 0;
+  opl3_frame_stats.coalesced = 0;
+  opl3_frame_stats.frames = 0;
   return 0;
 }
 
 
 s32 OPL3_AddOperQueue(u8 op, u8 reg){
   if(op >= 36*OPL3_COUNT){
-    DEBUG_MSG("PANIC!! [opl3.c] Invalid op %d passed to OPL3_AddOperQueue! op_queue_idx=%d", op, op_queue_idx);
+    DEBUG_MSG("PANIC!! [opl3.c] Invalid op %d passed to OPL3_AddOperQueue!", op);
     return -9001;
   }
   if(reg >= 5){
-    DEBUG_MSG("PANIC!! [opl3.c] Invalid reg %d passed to OPL3_AddOperQueue! op_queue_idx=%d", reg, op_queue_idx);
+    DEBUG_MSG("PANIC!! [opl3.c] Invalid reg %d passed to OPL3_AddOperQueue!", reg);
     return -9001;
   }
-  u16 val = (0x0005*((u16)op))+reg;
-  //See if it's on the queue
-  u16 q;
-  for(q=0; q<op_queue_idx; q++){
-    if(opl3_op_queue[q] == val){
-      return 0;
-    }
-  }
-  opl3_op_queue[op_queue_idx] = val;
-  op_queue_idx++;
-  if(op_queue_idx >= 36*5*OPL3_COUNT){
-    DEBUG_MSG("PANIC!! [opl3.c] Op queue overflow on write op_queue_idx==%d!", op_queue_idx);
-    op_queue_idx = (36*5*OPL3_COUNT)-1;
+  if(opl3_op_dirty[op] & (1 << reg)){
+    opl3_coalesced++;
+    return 0;
   }
+  opl3_op_dirty[op] |= (1 << reg);
+  u8 chipop = op % 36;
+  opl3_op_pending[op / 36][chipop >> 5] |= (1 << (chipop & 31));
   return 0;
 }
 
 s32 OPL3_AddChanQueue(u8 chan, u8 reg){
   if(chan >= 18*OPL3_COUNT){
-    DEBUG_MSG("PANIC!! [opl3.c] Invalid chan %d passed to OPL3_AddChanQueue! chan_queue_idx=%d", chan, chan_queue_idx);
+    DEBUG_MSG("PANIC!! [opl3.c] Invalid chan %d passed to OPL3_AddChanQueue!", chan);
     return -9001;
   }
   if(reg >= 3){
-    DEBUG_MSG("PANIC!! [opl3.c] Invalid reg %d passed to OPL3_AddChanQueue! chan_queue_idx=%d", reg, chan_queue_idx);
+    DEBUG_MSG("PANIC!! [opl3.c] Invalid reg %d passed to OPL3_AddChanQueue!", reg);
     return -9001;
   }
-  u8 val = (3*chan)+reg;
-  //See if it's on the queue
-  u8 q;
-  for(q=0; q<chan_queue_idx; q++){
-    if(opl3_chan_queue[q] == val){
-      return 0;
-    }
-  }
-  opl3_chan_queue[chan_queue_idx] = val;
-  chan_queue_idx++;
-  if(chan_queue_idx >= 18*3*OPL3_COUNT){
-    DEBUG_MSG("PANIC!! [opl3.c] Chan queue overflow on write chan_queue_idx==%d!", chan_queue_idx);
-    chan_queue_idx = (18*3*OPL3_COUNT)-1;
+  if(opl3_chan_dirty[chan] & (1 << reg)){
+    opl3_coalesced++;
+    return 0;
   }
+  opl3_chan_dirty[chan] |= (1 << reg);
+  opl3_chan_pending[chan / 18] |= (1 << (chan % 18));
   return 0;
 }
 
 s32 OPL3_AddChipQueue(u8 chip, u8 reg){
   if(chip >= OPL3_COUNT){
-    DEBUG_MSG("PANIC!! [opl3.c] Invalid chip %d passed to OPL3_AddChipQueue! chip_queue_idx=%d", chip, chip_queue_idx);
+    DEBUG_MSG("PANIC!! [opl3.c] Invalid chip %d passed to OPL3_AddChipQueue!", chip);
     return -9001;
   }
   if(reg >= 4){
-    DEBUG_MSG("PANIC!! [opl3.c] Invalid reg %d passed to OPL3_AddChipQueue! chip_queue_idx=%d", reg, chip_queue_idx);
+    DEBUG_MSG("PANIC!! [opl3.c] Invalid reg %d passed to OPL3_AddChipQueue!", reg);
     return -9001;
   }
-  u8 val = (4*chip)+reg;
-  //See if it's on the queue
-  u8 q;
-  for(q=0; q<chip_queue_idx; q++){
-    if(opl3_chip_queue[q] == val){
-      return 0;
-    }
-  }
-  opl3_chip_queue[chip_queue_idx] = val;
-  chip_queue_idx++;
-  if(chip_queue_idx >= 4*OPL3_COUNT){
-    DEBUG_MSG("PANIC!! [opl3.c] Chip queue overflow on write chip_queue_idx==%d!", chip_queue_idx);
-    chip_queue_idx = 4*OPL3_COUNT;
+  if(opl3_chip_dirty[chip] & (1 << reg)){
+    opl3_coalesced++;
+    return 0;
   }
+  opl3_chip_dirty[chip] |= (1 << reg);
   return 0;
 }
 
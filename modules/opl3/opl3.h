@@ -186,6 +186,13 @@ typedef union {
   };
 } opl3_chip_t;
 
+typedef struct {
+  u16 writes;     //Register writes done by the last OPL3_OnFrame()
+  u16 writes_max; //Most register writes done by one OPL3_OnFrame()
+  u16 coalesced;  //Changes in the last frame to registers which were already waiting to be written
+  u32 frames;     //Number of OPL3_OnFrame() calls
+} opl3_frame_stats_t;
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Export global variables
@@ -224,6 +231,11 @@ extern void OPL3_SendDemoPatch(void);
 // changed since last time.
 extern s32 OPL3_OnFrame(void);
 
+// Write statistics of OPL3_OnFrame(), e.g. to see how long a patch change takes.
+// The max. and frame counter are cleared by OPL3_ResetFrameStats().
+extern s32 OPL3_GetFrameStats(opl3_frame_stats_t *stats);
+extern s32 OPL3_ResetFrameStats(void);
+
 // Convenience functions for interacting with OPL3
 // You MUST use these functions to write data to OPL3 or the OPL3 will not be
 // refreshed with the data on the next frame!
@@ -42,13 +42,20 @@
 /////////////////////////////////////////////////////////////////////////////
 
 // an item of the MIDI output queue
+// note: next has to be the first member, so that a pointer to the next
+// member of the previous item can be converted into an item pointer
 typedef struct seq_midi_out_queue_item_t {
+  struct seq_midi_out_queue_item_t *next;
   u8                    port;
   u8                    event_type;
   u16                   len;
   mios32_midi_package_t package;
   u32                   timestamp;
-  struct seq_midi_out_queue_item_t *next;
+#if SEQ_MIDI_OUT_TAG_INDEX
+  struct seq_midi_out_queue_item_t **pprev;     // pointer which references this item in the queue
+  struct seq_midi_out_queue_item_t *tag_next;   // next item with the same tag
+  struct seq_midi_out_queue_item_t **tag_pprev; // pointer which references this item in the tag list
+#endif
 } seq_midi_out_queue_item_t;
 
 
@@ -59,6 +66,34 @@ typedef struct seq_midi_out_queue_item_t {
 static seq_midi_out_queue_item_t *SEQ_MIDI_OUT_SlotMalloc(void);
 static void SEQ_MIDI_OUT_SlotFree(seq_midi_out_queue_item_t *item);
 
+static void SEQ_MIDI_OUT_ItemLink(seq_midi_out_queue_item_t **pos, seq_midi_out_queue_item_t *item);
+static seq_midi_out_queue_item_t *SEQ_MIDI_OUT_ItemUnlink(seq_midi_out_queue_item_t **pos);
+static void SEQ_MIDI_OUT_ListInsert(seq_midi_out_queue_item_t **queue, seq_midi_out_queue_item_t *new_item);
+static void SEQ_MIDI_OUT_Play(seq_midi_out_queue_item_t *item);
+
+#if MIOS32_MIDI_OUT_RING_SIZE
+static s32 SEQ_MIDI_OUT_SendPackageQueued(mios32_midi_port_t port, mios32_midi_package_t midi_package);
+static void SEQ_MIDI_OUT_RingFlush(void);
+#endif
+
+#if SEQ_MIDI_OUT_TAG_INDEX || SEQ_MIDI_OUT_QUEUE_METHOD == 1
+static u8 SEQ_MIDI_OUT_ReScheduleMatch(seq_midi_out_queue_item_t *item, u8 tag, seq_midi_out_event_type_t event_type, u32 *reschedule_filter);
+static u32 SEQ_MIDI_OUT_DelayedTimestamp(seq_midi_out_queue_item_t *item, u32 timestamp);
+static seq_midi_out_queue_item_t *SEQ_MIDI_OUT_ReScheduleInsert(seq_midi_out_queue_item_t *resched_queue, seq_midi_out_queue_item_t *item, u8 before_equal);
+static void SEQ_MIDI_OUT_ReScheduleQueue(seq_midi_out_queue_item_t *resched_queue, u32 timestamp);
+#endif
+
+#if SEQ_MIDI_OUT_TAG_INDEX
+static void SEQ_MIDI_OUT_QueueRemove(seq_midi_out_queue_item_t *item);
+#endif
+
+#if SEQ_MIDI_OUT_QUEUE_METHOD == 1
+static void SEQ_MIDI_OUT_WheelInsert(seq_midi_out_queue_item_t *item);
+static void SEQ_MIDI_OUT_WheelPageEnter(void);
+static seq_midi_out_queue_item_t **SEQ_MIDI_OUT_WheelList(u32 n, seq_midi_out_queue_item_t ***tail);
+static seq_midi_out_queue_item_t *SEQ_MIDI_OUT_WheelUnlinkAll(void);
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Global variables
@@ -83,8 +118,37 @@ static s32 (*callback_bpm_is_running)(void);
 static u32 (*callback_bpm_tick_get)(void);
 static s32 (*callback_bpm_set)(float bpm);
 
+#if MIOS32_MIDI_OUT_RING_SIZE
+// set when a package has been queued by SEQ_MIDI_OUT_SendPackageQueued()
+static u8 ring_packages_queued;
+#endif
+
+// sorted list of all queued items
+// with SEQ_MIDI_OUT_QUEUE_METHOD 1 it only contains items which are scheduled beyond the timing wheel
 static seq_midi_out_queue_item_t *midi_queue;
 
+#if SEQ_MIDI_OUT_TAG_INDEX
+// one list for each tag (mios32_midi_package_t.cable), the most recently queued item first
+static seq_midi_out_queue_item_t *tag_queue[16];
+#endif
+
+#if SEQ_MIDI_OUT_QUEUE_METHOD == 1
+// number of lists which are iterated by SEQ_MIDI_OUT_WheelList()
+#define SEQ_MIDI_OUT_WHEEL_LISTS (SEQ_MIDI_OUT_WHEEL_TICKS + SEQ_MIDI_OUT_WHEEL_PAGES + 1)
+
+// one sorted list for each tick of the current page
+static seq_midi_out_queue_item_t *wheel_slot[SEQ_MIDI_OUT_WHEEL_TICKS];
+static u32 wheel_slot_items;
+
+// one unsorted list for each of the upcoming pages (items are stored in the order they have been queued)
+static seq_midi_out_queue_item_t *wheel_page[SEQ_MIDI_OUT_WHEEL_PAGES];
+static seq_midi_out_queue_item_t *wheel_page_tail[SEQ_MIDI_OUT_WHEEL_PAGES];
+static u32 wheel_page_items;
+
+// the next tick which will be handled by SEQ_MIDI_OUT_Handler()
+static u32 wheel_tick;
+#endif
+
 
 #if SEQ_MIDI_OUT_MALLOC_METHOD >= 0 && SEQ_MIDI_OUT_MALLOC_METHOD <= 3
 
@@ -177,14 +241,23 @@ s32 SEQ_MIDI_OUT_Init(u32 mode)
 //!   }
 //! \endcode
 //! If set to NULL, the default function MIOS32_MIDI_SendPackage function will
-//! be used. This allows you to restore the default setup properly.
+//! be used. This allows you to restore the default setup properly.<BR>
+//! If MIOS32_MIDI_OUT_RING_SIZE is enabled, the default function queues the
+//! packages in the output rings of MIOS32_MIDI instead, and SEQ_MIDI_OUT_Handler()
+//! forwards them in a single burst.
 //! \return < 0 on errors
 /////////////////////////////////////////////////////////////////////////////
 s32 SEQ_MIDI_OUT_Callback_MIDI_SendPackage_Set(void *_callback_midi_send_package)
 {
+#if MIOS32_MIDI_OUT_RING_SIZE
+  callback_midi_send_package = (_callback_midi_send_package == NULL)
+    ? SEQ_MIDI_OUT_SendPackageQueued
+    : _callback_midi_send_package;
+#else
   callback_midi_send_package = (_callback_midi_send_package == NULL)
     ? MIOS32_MIDI_SendPackage
     : _callback_midi_send_package;
+#endif
 
   return 0; // no error
 }
@@ -333,74 +406,27 @@ s32 SEQ_MIDI_OUT_Send(mios32_midi_port_t port, mios32_midi_package_t midi_packag
   DEBUG_MSG("[SEQ_MIDI_OUT_Send:%u] (tag %d) %02x %02x %02x len:%u @%u\n", timestamp, midi_package.cable, midi_package.evnt0, midi_package.evnt1, midi_package.evnt2, len, SEQ_BPM_TickGet());
 #endif
 
-  // search in queue for last item which has the same (or earlier) timestamp
-  seq_midi_out_queue_item_t *item;
-  if( (item=midi_queue) == NULL ) {
-    // no item in queue -- first element
-    midi_queue = new_item;
-  } else {
-    u8 insert_before_item = 0;
-    seq_midi_out_queue_item_t *last_item = NULL;
-    seq_midi_out_queue_item_t *next_item;
-    do {
-      // Clock and Tempo events are sorted before CC and Note events at a given timestamp
-      if( (event_type == SEQ_MIDI_OUT_ClkEvent || event_type == SEQ_MIDI_OUT_TempoEvent ) && 
-	  item->timestamp >= timestamp &&
-	  (item->event_type == SEQ_MIDI_OUT_OnEvent || 
-	   item->event_type == SEQ_MIDI_OUT_OffEvent || 
-	   item->event_type == SEQ_MIDI_OUT_OnOffEvent || 
-	   item->event_type == SEQ_MIDI_OUT_CCEvent) ) {
-	// found any event with same timestamp, insert clock before these events
-	// note that the Clock event order doesn't get lost if clock events 
-	// are queued at the same timestamp (e.g. MIDI start -> MIDI clock)
-	insert_before_item = 1;
-	break;
-      }
+#if SEQ_MIDI_OUT_QUEUE_METHOD == 1
+  // rebase the timing wheel if it doesn't contain any item
+  if( !wheel_slot_items && !wheel_page_items && midi_queue == NULL )
+    wheel_tick = callback_bpm_tick_get();
 
-      // CCs are sorted before notes at a given timestamp
-      // (new CC before On events at the same timestamp)
-      // CCs are still played after Off or Clock events
-      if( event_type == SEQ_MIDI_OUT_CCEvent && 
-	  item->timestamp == timestamp &&
-	  (item->event_type == SEQ_MIDI_OUT_OnEvent || item->event_type == SEQ_MIDI_OUT_OnOffEvent) ) {
-	// found On event with same timestamp, play CC before On event
-	insert_before_item = 1;
-	break;
-      }
-
-      if( item->timestamp > timestamp ) {
-	// found entry with later timestamp
-	insert_before_item = 1;
-	break;
-      }
-
-      if( (next_item=item->next) == NULL ) {
-	// end of queue reached, insert new item at the end
-	break;
-      }
-	
-      if( next_item->timestamp > timestamp ) {
-	// found entry with later timestamp
-	break;
-      }
-
-      // switch to next item
-      last_item = item;
-      item = next_item;
-    } while( 1 );
+  SEQ_MIDI_OUT_WheelInsert(new_item);
+#else
+  SEQ_MIDI_OUT_ListInsert(&midi_queue, new_item);
+#endif
 
-    // insert/add item into/to list
-    if( insert_before_item ) {
-      if( last_item == NULL )
-	midi_queue = new_item;
-      else
-	last_item->next = new_item;
-      new_item->next = item;
-    } else {
-      item->next = new_item;
-      new_item->next = next_item;
-    }
+#if SEQ_MIDI_OUT_TAG_INDEX
+  // add to tag list
+  {
+    seq_midi_out_queue_item_t **tag_list = &tag_queue[midi_package.cable];
+    new_item->tag_next = *tag_list;
+    if( new_item->tag_next != NULL )
+      new_item->tag_next->tag_pprev = &new_item->tag_next;
+    new_item->tag_pprev = tag_list;
+    *tag_list = new_item;
   }
+#endif
 
   // schedule off event now if length > 16bit (since it cannot be stored in event record)
   if( event_type == SEQ_MIDI_OUT_OnOffEvent && len > 0xffff ) {
@@ -408,9 +434,9 @@ s32 SEQ_MIDI_OUT_Send(mios32_midi_port_t port, mios32_midi_package_t midi_packag
   }
 
   // display queue
-#if DEBUG_VERBOSE_LEVEL >= 4
+#if DEBUG_VERBOSE_LEVEL >= 4 && SEQ_MIDI_OUT_QUEUE_METHOD == 0
   DEBUG_MSG("--- vvv ---\n");
-  item=midi_queue;
+  seq_midi_out_queue_item_t *item=midi_queue;
   while( item != NULL ) {
     DEBUG_MSG("[%u] (tag %d) %02x %02x %02x len:%u @%u\n", item->timestamp, item->package.cable, item->package.evnt0, item->package.evnt1, item->package.evnt2, item->len, SEQ_BPM_TickGet());
     item = item->next;
@@ -448,6 +474,109 @@ s32 SEQ_MIDI_OUT_Send(mios32_midi_port_t port, mios32_midi_package_t midi_packag
 /////////////////////////////////////////////////////////////////////////////
 s32 SEQ_MIDI_OUT_ReSchedule(u8 tag, seq_midi_out_event_type_t event_type, u32 timestamp, u32 *reschedule_filter)
 {
+#if SEQ_MIDI_OUT_TAG_INDEX
+  // only the items of the tag list have to be checked
+  // the list based queue stops searching at the first (earliest) item which is already due
+  // at the new timestamp (the port delay is considered) - determine this item
+  // matching items with the same timestamp are queued in the order they have been sent,
+  // and the tag list starts with the most recent item, so that the last due item
+  // with the earliest timestamp is taken
+  seq_midi_out_queue_item_t *due_item = NULL;
+  seq_midi_out_queue_item_t *item;
+  for(item=tag_queue[tag & 0xf]; item != NULL; item=item->tag_next) {
+    if( SEQ_MIDI_OUT_ReScheduleMatch(item, tag, event_type, reschedule_filter) &&
+	item->timestamp <= SEQ_MIDI_OUT_DelayedTimestamp(item, timestamp) &&
+	(due_item == NULL || item->timestamp <= due_item->timestamp) ) {
+      due_item = item;
+    }
+  }
+
+  // remove all matching items which are queued before this item
+  // (with the same timestamp: items which have been sent before, they follow in the tag list)
+  // they are collected in chronological order (note: tag list starts with the most recent item)
+  seq_midi_out_queue_item_t *resched_queue = NULL;
+  u8 due_item_passed = 0;
+  for(item=tag_queue[tag & 0xf]; item != NULL; item=item->tag_next) {
+    if( item == due_item ) {
+      due_item_passed = 1;
+    } else if( SEQ_MIDI_OUT_ReScheduleMatch(item, tag, event_type, reschedule_filter) &&
+	       (due_item == NULL || item->timestamp < due_item->timestamp ||
+		(item->timestamp == due_item->timestamp && due_item_passed)) ) {
+      SEQ_MIDI_OUT_QueueRemove(item);
+      resched_queue = SEQ_MIDI_OUT_ReScheduleInsert(resched_queue, item, 1);
+    }
+  }
+
+  // re-schedule collected items at new timestamp
+  SEQ_MIDI_OUT_ReScheduleQueue(resched_queue, timestamp);
+#elif SEQ_MIDI_OUT_QUEUE_METHOD == 1
+  // search in all lists of the timing wheel for items with the given tag
+  // the list based queue stops searching at the first (earliest) item which is already due
+  // at the new timestamp (the port delay is considered) - determine the timestamp of this item
+  u8 due_found = 0;
+  u32 due_timestamp = 0;
+  u32 n;
+  for(n=0; n<SEQ_MIDI_OUT_WHEEL_LISTS; ++n) {
+    seq_midi_out_queue_item_t **tail;
+    seq_midi_out_queue_item_t *item = *SEQ_MIDI_OUT_WheelList(n, &tail);
+    for(; item != NULL; item=item->next) {
+      if( SEQ_MIDI_OUT_ReScheduleMatch(item, tag, event_type, reschedule_filter) &&
+	  item->timestamp <= SEQ_MIDI_OUT_DelayedTimestamp(item, timestamp) &&
+	  (!due_found || item->timestamp < due_timestamp) ) {
+	due_found = 1;
+	due_timestamp = item->timestamp;
+      }
+    }
+  }
+
+  // remove all matching items which are scheduled before this item
+  // matching items with the same timestamp are stored in the same list in the order they
+  // have been sent: they are removed until the first due item has been found
+  // they are collected in chronological order
+  seq_midi_out_queue_item_t *resched_queue = NULL;
+  u8 due_item_passed = 0;
+  for(n=0; n<SEQ_MIDI_OUT_WHEEL_LISTS; ++n) {
+    seq_midi_out_queue_item_t **tail;
+    seq_midi_out_queue_item_t **list = SEQ_MIDI_OUT_WheelList(n, &tail);
+    seq_midi_out_queue_item_t *prev_item = NULL;
+    seq_midi_out_queue_item_t *item = *list;
+    while( item != NULL ) {
+      seq_midi_out_queue_item_t *next_item = item->next;
+      u8 resched = 0;
+      if( SEQ_MIDI_OUT_ReScheduleMatch(item, tag, event_type, reschedule_filter) ) {
+	if( !due_found || item->timestamp < due_timestamp ) {
+	  resched = 1;
+	} else if( item->timestamp == due_timestamp && !due_item_passed ) {
+	  if( item->timestamp <= SEQ_MIDI_OUT_DelayedTimestamp(item, timestamp) )
+	    due_item_passed = 1;
+	  else
+	    resched = 1;
+	}
+      }
+
+      if( resched ) {
+	// remove item from list
+	SEQ_MIDI_OUT_ItemUnlink((prev_item == NULL) ? list : &prev_item->next);
+	if( tail != NULL && *tail == item )
+	  *tail = prev_item;
+
+	if( n < SEQ_MIDI_OUT_WHEEL_TICKS )
+	  --wheel_slot_items;
+	else if( n < (SEQ_MIDI_OUT_WHEEL_TICKS + SEQ_MIDI_OUT_WHEEL_PAGES) )
+	  --wheel_page_items;
+
+	// add to re-schedule list (page slots are not sorted)
+	resched_queue = SEQ_MIDI_OUT_ReScheduleInsert(resched_queue, item, 0);
+      } else {
+	prev_item = item;
+      }
+      item = next_item;
+    }
+  }
+
+  // re-schedule collected items at new timestamp
+  SEQ_MIDI_OUT_ReScheduleQueue(resched_queue, timestamp);
+#else
   // search in queue for items with the given tag
 
   seq_midi_out_queue_item_t *prev_item = NULL;
@@ -536,6 +665,8 @@ s32 SEQ_MIDI_OUT_ReSchedule(u8 tag, seq_midi_out_event_type_t event_type, u32 ti
     }
   }
 
+#endif
+
   return 0; // no error
 }
 
@@ -546,6 +677,11 @@ s32 SEQ_MIDI_OUT_ReSchedule(u8 tag, seq_midi_out_event_type_t event_type, u32 ti
 /////////////////////////////////////////////////////////////////////////////
 s32 SEQ_MIDI_OUT_FlushQueue(void)
 {
+#if SEQ_MIDI_OUT_QUEUE_METHOD == 1
+  // collect all items of the timing wheel in a single list
+  midi_queue = SEQ_MIDI_OUT_WheelUnlinkAll();
+#endif
+
   seq_midi_out_queue_item_t *item;
   while( (item=midi_queue) != NULL ) {
     if( item->event_type == SEQ_MIDI_OUT_OffEvent || item->event_type == SEQ_MIDI_OUT_OnOffEvent ) {
@@ -557,6 +693,10 @@ s32 SEQ_MIDI_OUT_FlushQueue(void)
     SEQ_MIDI_OUT_SlotFree(item);
   }
 
+#if MIOS32_MIDI_OUT_RING_SIZE
+  SEQ_MIDI_OUT_RingFlush();
+#endif
+
   return 0; // no error
 }
 
@@ -567,6 +707,12 @@ s32 SEQ_MIDI_OUT_FlushQueue(void)
 /////////////////////////////////////////////////////////////////////////////
 s32 SEQ_MIDI_OUT_FreeHeap(void)
 {
+#if SEQ_MIDI_OUT_QUEUE_METHOD == 1
+  // collect all items of the timing wheel in a single list
+  midi_queue = SEQ_MIDI_OUT_WheelUnlinkAll();
+  wheel_tick = 0;
+#endif
+
   // ensure that all items are delocated
   seq_midi_out_queue_item_t *item;
   while( (item=midi_queue) != NULL ) {
@@ -609,70 +755,515 @@ s32 SEQ_MIDI_OUT_Handler(void)
   if( !callback_bpm_is_running() )
     return 0;
 
+#if SEQ_MIDI_OUT_QUEUE_METHOD == 1
+  // dispatch the slots of all ticks which have been passed since the last invocation
+  // empty slots and pages are skipped
+  u32 bpm_tick = callback_bpm_tick_get();
+  while( wheel_slot_items || wheel_page_items || midi_queue != NULL ) {
+    // play all items of the current slot which are due (this includes events which have been
+    // scheduled for an earlier timestamp after the slot has been selected)
+    seq_midi_out_queue_item_t *item;
+    while( (item=wheel_slot[wheel_tick % SEQ_MIDI_OUT_WHEEL_TICKS]) != NULL && item->timestamp <= bpm_tick ) {
+      SEQ_MIDI_OUT_ItemUnlink(&wheel_slot[wheel_tick % SEQ_MIDI_OUT_WHEEL_TICKS]);
+      --wheel_slot_items;
+      SEQ_MIDI_OUT_Play(item);
+    }
+
+    if( wheel_tick >= bpm_tick )
+      break;
+
+    // determine the next tick which has to be checked
+    u32 next_tick;
+    if( wheel_slot_items ) {
+      next_tick = wheel_tick + 1;
+    } else {
+      // no item in the current page: continue with the next page
+      next_tick = (wheel_tick / SEQ_MIDI_OUT_WHEEL_TICKS + 1) * SEQ_MIDI_OUT_WHEEL_TICKS;
+
+      // no item in the upcoming pages: continue with the page at which the first overflow item enters the wheel
+      if( !wheel_page_items && midi_queue != NULL ) {
+	u32 first_page = midi_queue->timestamp / SEQ_MIDI_OUT_WHEEL_TICKS;
+	if( first_page >= SEQ_MIDI_OUT_WHEEL_PAGES ) {
+	  u32 enter_tick = (first_page - (SEQ_MIDI_OUT_WHEEL_PAGES-1)) * SEQ_MIDI_OUT_WHEEL_TICKS;
+	  if( enter_tick > next_tick )
+	    next_tick = enter_tick;
+	}
+      }
+    }
+
+    if( next_tick > bpm_tick || next_tick <= wheel_tick ) // (second condition in case of an overrun)
+      next_tick = bpm_tick;
+
+    u8 page_changed = (next_tick / SEQ_MIDI_OUT_WHEEL_TICKS) != (wheel_tick / SEQ_MIDI_OUT_WHEEL_TICKS);
+    wheel_tick = next_tick;
+    if( page_changed )
+      SEQ_MIDI_OUT_WheelPageEnter();
+  }
+#else
   // search in queue for items which have to be played now (or have been missed earlier)
   // note that we are going through a sorted list, therefore we can exit once a timestamp
   // has been found which has to be played later than now
 
   seq_midi_out_queue_item_t *item;
   while( (item=midi_queue) != NULL && item->timestamp <= callback_bpm_tick_get() ) {
+    // remove item from queue
+    SEQ_MIDI_OUT_ItemUnlink(&midi_queue);
+
+    SEQ_MIDI_OUT_Play(item);
+  }
+#endif
+
+#if MIOS32_MIDI_OUT_RING_SIZE
+  SEQ_MIDI_OUT_RingFlush();
+#endif
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function to link an item into a queue at the given position
+// (pos points to the list head or to the next pointer of the previous item)
+/////////////////////////////////////////////////////////////////////////////
+static void SEQ_MIDI_OUT_ItemLink(seq_midi_out_queue_item_t **pos, seq_midi_out_queue_item_t *item)
+{
+  item->next = *pos;
+  *pos = item;
+#if SEQ_MIDI_OUT_TAG_INDEX
+  item->pprev = pos;
+  if( item->next != NULL )
+    item->next->pprev = &item->next;
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function to unlink the item which is referenced by pos
+// returns the unlinked item
+/////////////////////////////////////////////////////////////////////////////
+static seq_midi_out_queue_item_t *SEQ_MIDI_OUT_ItemUnlink(seq_midi_out_queue_item_t **pos)
+{
+  seq_midi_out_queue_item_t *item = *pos;
+  *pos = item->next;
+#if SEQ_MIDI_OUT_TAG_INDEX
+  if( item->next != NULL )
+    item->next->pprev = pos;
+#endif
+  return item;
+}
+
+
+#if SEQ_MIDI_OUT_TAG_INDEX
+/////////////////////////////////////////////////////////////////////////////
+// Local function to remove any item from the queue
+/////////////////////////////////////////////////////////////////////////////
+static void SEQ_MIDI_OUT_QueueRemove(seq_midi_out_queue_item_t *item)
+{
+#if SEQ_MIDI_OUT_QUEUE_METHOD == 1
+  // determine the timing wheel list which contains the item (see SEQ_MIDI_OUT_WheelInsert())
+  u32 timestamp = item->timestamp;
+  if( timestamp < wheel_tick )
+    timestamp = wheel_tick;
+
+  u32 page = timestamp / SEQ_MIDI_OUT_WHEEL_TICKS;
+  u32 page_offset = page - (wheel_tick / SEQ_MIDI_OUT_WHEEL_TICKS);
+
+  if( page_offset == 0 ) {
+    --wheel_slot_items;
+  } else if( page_offset < SEQ_MIDI_OUT_WHEEL_PAGES ) {
+    u32 ix = page % SEQ_MIDI_OUT_WHEEL_PAGES;
+    if( wheel_page_tail[ix] == item ) {
+      // the previous item is located at the pprev address, since next is the first member
+      wheel_page_tail[ix] = (item->pprev == &wheel_page[ix]) ? NULL : (seq_midi_out_queue_item_t *)item->pprev;
+    }
+    --wheel_page_items;
+  }
+#endif
+
+  SEQ_MIDI_OUT_ItemUnlink(item->pprev);
+}
+#endif
+
+
+#if SEQ_MIDI_OUT_TAG_INDEX || SEQ_MIDI_OUT_QUEUE_METHOD == 1
+/////////////////////////////////////////////////////////////////////////////
+// Local function which checks if an item should be re-scheduled
+// (see SEQ_MIDI_OUT_ReSchedule())
+/////////////////////////////////////////////////////////////////////////////
+static u8 SEQ_MIDI_OUT_ReScheduleMatch(seq_midi_out_queue_item_t *item, u8 tag, seq_midi_out_event_type_t event_type, u32 *reschedule_filter)
+{
+  u8 evnt1 = item->package.evnt1;
+  return (item->event_type == event_type) && (item->package.cable == tag) &&
+    (reschedule_filter == NULL ||
+     !(reschedule_filter[evnt1>>5] & (1 << (evnt1 & 0x1f))));
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function which returns the timestamp + delay of the item's port
+/////////////////////////////////////////////////////////////////////////////
+static u32 SEQ_MIDI_OUT_DelayedTimestamp(seq_midi_out_queue_item_t *item, u32 timestamp)
+{
+#if SEQ_MIDI_OUT_SUPPORT_DELAY
+  if( item->port < PPQN_DELAY_NUM ) {
+    s8 delay = ppqn_delay[item->port];
+    if( (delay < 0) && (timestamp < -delay) ) {
+      timestamp = 0;
+    } else {
+      timestamp += delay;
+    }
+  }
+#endif
+
+  return timestamp;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function which adds an item to the re-schedule list, sorted by timestamp
+// if before_equal is set, the item will be inserted before items with the same timestamp
+// returns the new list head
+/////////////////////////////////////////////////////////////////////////////
+static seq_midi_out_queue_item_t *SEQ_MIDI_OUT_ReScheduleInsert(seq_midi_out_queue_item_t *resched_queue, seq_midi_out_queue_item_t *item, u8 before_equal)
+{
+  seq_midi_out_queue_item_t **insert_ptr = &resched_queue;
+  while( *insert_ptr != NULL &&
+	 ((*insert_ptr)->timestamp < item->timestamp ||
+	  (!before_equal && (*insert_ptr)->timestamp == item->timestamp)) )
+    insert_ptr = &(*insert_ptr)->next;
+
+  item->next = *insert_ptr;
+  *insert_ptr = item;
+
+  return resched_queue;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function which queues the items of the re-schedule list at the new timestamp
+/////////////////////////////////////////////////////////////////////////////
+static void SEQ_MIDI_OUT_ReScheduleQueue(seq_midi_out_queue_item_t *resched_queue, u32 timestamp)
+{
+  seq_midi_out_queue_item_t *item;
+  while( (item=resched_queue) != NULL ) {
+    resched_queue = item->next;
+
+    // ensure that we get a free memory slot by releasing the current item before queuing the off item
+    seq_midi_out_queue_item_t copy;
+    copy.port = item->port;
+    copy.event_type = item->event_type;
+    copy.len = item->len;
+    copy.package.ALL = item->package.ALL;
+    SEQ_MIDI_OUT_SlotFree(item);
+
 #if DEBUG_VERBOSE_LEVEL >= 2
-#if DEBUG_VERBOSE_LEVEL == 2
-    if( item->event_type != SEQ_MIDI_OUT_ClkEvent )
+    DEBUG_MSG("[SEQ_MIDI_OUT_ReSchedule:%u] (tag %d) %02x %02x %02x @%u\n", timestamp, copy.package.cable, copy.package.evnt0, copy.package.evnt1, copy.package.evnt2, SEQ_BPM_TickGet());
 #endif
-    DEBUG_MSG("[SEQ_MIDI_OUT_Handler:%u] (tag %d) %02x %02x %02x @%u\n", item->timestamp, item->package.cable, item->package.evnt0, item->package.evnt1, item->package.evnt2, SEQ_BPM_TickGet());
+
+    SEQ_MIDI_OUT_Send(copy.port, copy.package, copy.event_type, timestamp, copy.len);
+  }
+}
 #endif
 
-    // if tempo event: change BPM stored in midi_package.ALL
-    if( item->event_type == SEQ_MIDI_OUT_TempoEvent ) {
-      callback_bpm_set(item->package.ALL);
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function to insert an item into a sorted queue
+/////////////////////////////////////////////////////////////////////////////
+static void SEQ_MIDI_OUT_ListInsert(seq_midi_out_queue_item_t **queue, seq_midi_out_queue_item_t *new_item)
+{
+  seq_midi_out_event_type_t event_type = new_item->event_type;
+  u32 timestamp = new_item->timestamp;
+
+  // search in queue for last item which has the same (or earlier) timestamp
+  seq_midi_out_queue_item_t *item;
+  if( (item=*queue) == NULL ) {
+    // no item in queue -- first element
+    SEQ_MIDI_OUT_ItemLink(queue, new_item);
+  } else {
+    u8 insert_before_item = 0;
+    seq_midi_out_queue_item_t *last_item = NULL;
+    seq_midi_out_queue_item_t *next_item;
+    do {
+      // Clock and Tempo events are sorted before CC and Note events at a given timestamp
+      if( (event_type == SEQ_MIDI_OUT_ClkEvent || event_type == SEQ_MIDI_OUT_TempoEvent ) && 
+	  item->timestamp >= timestamp &&
+	  (item->event_type == SEQ_MIDI_OUT_OnEvent || 
+	   item->event_type == SEQ_MIDI_OUT_OffEvent || 
+	   item->event_type == SEQ_MIDI_OUT_OnOffEvent || 
+	   item->event_type == SEQ_MIDI_OUT_CCEvent) ) {
+	// found any event with same timestamp, insert clock before these events
+	// note that the Clock event order doesn't get lost if clock events 
+	// are queued at the same timestamp (e.g. MIDI start -> MIDI clock)
+	insert_before_item = 1;
+	break;
+      }
+
+      // CCs are sorted before notes at a given timestamp
+      // (new CC before On events at the same timestamp)
+      // CCs are still played after Off or Clock events
+      if( event_type == SEQ_MIDI_OUT_CCEvent && 
+	  item->timestamp == timestamp &&
+	  (item->event_type == SEQ_MIDI_OUT_OnEvent || item->event_type == SEQ_MIDI_OUT_OnOffEvent) ) {
+	// found On event with same timestamp, play CC before On event
+	insert_before_item = 1;
+	break;
+      }
+
+      if( item->timestamp > timestamp ) {
+	// found entry with later timestamp
+	insert_before_item = 1;
+	break;
+      }
+
+      if( (next_item=item->next) == NULL ) {
+	// end of queue reached, insert new item at the end
+	break;
+      }
+	
+      if( next_item->timestamp > timestamp ) {
+	// found entry with later timestamp
+	break;
+      }
+
+      // switch to next item
+      last_item = item;
+      item = next_item;
+    } while( 1 );
+
+    // insert/add item into/to list
+    if( insert_before_item ) {
+      SEQ_MIDI_OUT_ItemLink((last_item == NULL) ? queue : &last_item->next, new_item);
     } else {
-      callback_midi_send_package(item->port, item->package);
+      SEQ_MIDI_OUT_ItemLink(&item->next, new_item);
     }
+  }
+}
 
-    // schedule Off event if requested
-    if( item->event_type == SEQ_MIDI_OUT_OnOffEvent && item->len ) {
-      // ensure that we get a free memory slot by releasing the current item before queuing the off item
+
+#if MIOS32_MIDI_OUT_RING_SIZE
+/////////////////////////////////////////////////////////////////////////////
+// Default function to send a package if the output rings of MIOS32_MIDI are enabled
+// the package is queued in the output ring of the port, and will be forwarded
+// by SEQ_MIDI_OUT_RingFlush()
+/////////////////////////////////////////////////////////////////////////////
+static s32 SEQ_MIDI_OUT_SendPackageQueued(mios32_midi_port_t port, mios32_midi_package_t midi_package)
+{
+  if( MIOS32_MIDI_SendPackage_Queued(port, midi_package) >= 0 ) {
+    ring_packages_queued = 1;
+    return 0; // no error
+  }
+
+  // no ring for this port or ring full: send directly
+  // (MIOS32_MIDI_SendPackage() forwards the queued packages of the port first)
+  return MIOS32_MIDI_SendPackage(port, midi_package);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Forwards the packages which have been queued by SEQ_MIDI_OUT_SendPackageQueued()
+// in a single burst
+/////////////////////////////////////////////////////////////////////////////
+static void SEQ_MIDI_OUT_RingFlush(void)
+{
+  if( ring_packages_queued ) {
+    ring_packages_queued = 0;
+    MIOS32_MIDI_OutRing_Handler();
+  }
+}
+#endif
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function to play an item which has been removed from the queue
+// the item will be released, Off events of OnOff items will be scheduled
+/////////////////////////////////////////////////////////////////////////////
+static void SEQ_MIDI_OUT_Play(seq_midi_out_queue_item_t *item)
+{
+#if DEBUG_VERBOSE_LEVEL >= 2
+#if DEBUG_VERBOSE_LEVEL == 2
+  if( item->event_type != SEQ_MIDI_OUT_ClkEvent )
+#endif
+  DEBUG_MSG("[SEQ_MIDI_OUT_Handler:%u] (tag %d) %02x %02x %02x @%u\n", item->timestamp, item->package.cable, item->package.evnt0, item->package.evnt1, item->package.evnt2, SEQ_BPM_TickGet());
+#endif
+
+  // if tempo event: change BPM stored in midi_package.ALL
+  if( item->event_type == SEQ_MIDI_OUT_TempoEvent ) {
+    callback_bpm_set(item->package.ALL);
+  } else {
+    callback_midi_send_package(item->port, item->package);
+  }
+
+  // schedule Off event if requested
+  if( item->event_type == SEQ_MIDI_OUT_OnOffEvent && item->len ) {
+    // ensure that we get a free memory slot by releasing the current item before queuing the off item
 #if 0
-      seq_midi_out_queue_item_t copy = *item;
+    seq_midi_out_queue_item_t copy = *item;
 #else
-      // ???
-      seq_midi_out_queue_item_t copy;
-      copy.port = item->port;
-      copy.event_type = item->event_type;
-      copy.len = item->len;
-      copy.package.ALL = item->package.ALL;
-      copy.timestamp = item->timestamp;
-      copy.next = item->next;
+    // ???
+    seq_midi_out_queue_item_t copy;
+    copy.port = item->port;
+    copy.event_type = item->event_type;
+    copy.len = item->len;
+    copy.package.ALL = item->package.ALL;
+    copy.timestamp = item->timestamp;
+    copy.next = item->next;
 #endif
-      copy.package.velocity = 0; // ensure that velocity is 0
+    copy.package.velocity = 0; // ensure that velocity is 0
 
-      // remove item from queue
-      midi_queue = item->next;
-      SEQ_MIDI_OUT_SlotFree(item);
+    SEQ_MIDI_OUT_SlotFree(item);
 
-      u32 delayed_timestamp = copy.len + copy.timestamp;
+    u32 delayed_timestamp = copy.len + copy.timestamp;
 #if SEQ_MIDI_OUT_SUPPORT_DELAY
-      // revert timestamp delay (will be added again by SEQ_MIDI_OUT_Send())
-      if( copy.port < PPQN_DELAY_NUM ) {
-	s8 delay = ppqn_delay[copy.port];
-	if( (delay > 0) && (delayed_timestamp < delay) ) {
-	  delayed_timestamp = 0;
-	} else {
-	  delayed_timestamp -= delay;
-	}
+    // revert timestamp delay (will be added again by SEQ_MIDI_OUT_Send())
+    if( copy.port < PPQN_DELAY_NUM ) {
+      s8 delay = ppqn_delay[copy.port];
+      if( (delay > 0) && (delayed_timestamp < delay) ) {
+	delayed_timestamp = 0;
+      } else {
+	delayed_timestamp -= delay;
       }
+    }
 #endif
 
-      SEQ_MIDI_OUT_Send(copy.port, copy.package, SEQ_MIDI_OUT_OffEvent, delayed_timestamp, 0);
-    } else {
-      // remove item from queue
-      midi_queue = item->next;
-      SEQ_MIDI_OUT_SlotFree(item);
+    SEQ_MIDI_OUT_Send(copy.port, copy.package, SEQ_MIDI_OUT_OffEvent, delayed_timestamp, 0);
+  } else {
+    SEQ_MIDI_OUT_SlotFree(item);
+  }
+}
+
+
+#if SEQ_MIDI_OUT_QUEUE_METHOD == 1
+/////////////////////////////////////////////////////////////////////////////
+// Local function to insert an item into the timing wheel
+// Items of the current page are sorted into the tick slots, items of the
+// upcoming pages are added to the page slots, all others to the overflow list.
+// Items with a timestamp before wheel_tick are added to the current slot.
+/////////////////////////////////////////////////////////////////////////////
+static void SEQ_MIDI_OUT_WheelInsert(seq_midi_out_queue_item_t *item)
+{
+  u32 timestamp = item->timestamp;
+  if( timestamp < wheel_tick )
+    timestamp = wheel_tick;
+
+  u32 page = timestamp / SEQ_MIDI_OUT_WHEEL_TICKS;
+  u32 page_offset = page - (wheel_tick / SEQ_MIDI_OUT_WHEEL_TICKS);
+
+  if( page_offset == 0 ) {
+    SEQ_MIDI_OUT_ListInsert(&wheel_slot[timestamp % SEQ_MIDI_OUT_WHEEL_TICKS], item);
+    ++wheel_slot_items;
+  } else if( page_offset < SEQ_MIDI_OUT_WHEEL_PAGES ) {
+    // the order will be considered once the page is entered
+    u32 ix = page % SEQ_MIDI_OUT_WHEEL_PAGES;
+    SEQ_MIDI_OUT_ItemLink((wheel_page_tail[ix] == NULL) ? &wheel_page[ix] : &wheel_page_tail[ix]->next, item);
+    wheel_page_tail[ix] = item;
+    ++wheel_page_items;
+  } else {
+    SEQ_MIDI_OUT_ListInsert(&midi_queue, item);
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function which is called whenever wheel_tick has entered a new page:
+// moves the items of the page slot into the tick slots, and takes over
+// overflow items which are in range of the wheel now
+/////////////////////////////////////////////////////////////////////////////
+static void SEQ_MIDI_OUT_WheelPageEnter(void)
+{
+  u32 page = wheel_tick / SEQ_MIDI_OUT_WHEEL_TICKS;
+  u32 ix = page % SEQ_MIDI_OUT_WHEEL_PAGES;
+
+  // items are inserted in the order they have been queued, so that the sort order is kept
+  seq_midi_out_queue_item_t *item = wheel_page[ix];
+  wheel_page[ix] = NULL;
+  wheel_page_tail[ix] = NULL;
+  while( item != NULL ) {
+    seq_midi_out_queue_item_t *next_item = item->next;
+    --wheel_page_items;
+    SEQ_MIDI_OUT_WheelInsert(item);
+    item = next_item;
+  }
+
+  while( (item=midi_queue) != NULL &&
+	 (item->timestamp <= wheel_tick ||
+	  ((item->timestamp / SEQ_MIDI_OUT_WHEEL_TICKS) - page) < SEQ_MIDI_OUT_WHEEL_PAGES) ) {
+    SEQ_MIDI_OUT_ItemUnlink(&midi_queue);
+    SEQ_MIDI_OUT_WheelInsert(item);
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function which returns the list with the given number
+// 0..SEQ_MIDI_OUT_WHEEL_LISTS-1 in chronological order (tick slots, page slots, overflow list)
+// *tail is set to the tail pointer of the list if available, otherwise NULL
+/////////////////////////////////////////////////////////////////////////////
+static seq_midi_out_queue_item_t **SEQ_MIDI_OUT_WheelList(u32 n, seq_midi_out_queue_item_t ***tail)
+{
+  *tail = NULL;
+
+  // note: tick slots before wheel_tick and the page slot of the current page are always empty
+  if( n < SEQ_MIDI_OUT_WHEEL_TICKS )
+    return &wheel_slot[(wheel_tick + n) % SEQ_MIDI_OUT_WHEEL_TICKS];
+  n -= SEQ_MIDI_OUT_WHEEL_TICKS;
+
+  if( n < SEQ_MIDI_OUT_WHEEL_PAGES ) {
+    u32 ix = (wheel_tick / SEQ_MIDI_OUT_WHEEL_TICKS + n) % SEQ_MIDI_OUT_WHEEL_PAGES;
+    *tail = &wheel_page_tail[ix];
+    return &wheel_page[ix];
+  }
+
+  return &midi_queue;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local function which removes all items from the timing wheel
+// returns a single list of these items in the same order like
+// SEQ_MIDI_OUT_QUEUE_METHOD 0 would keep them
+/////////////////////////////////////////////////////////////////////////////
+static seq_midi_out_queue_item_t *SEQ_MIDI_OUT_WheelUnlinkAll(void)
+{
+  seq_midi_out_queue_item_t *first_item = NULL;
+  seq_midi_out_queue_item_t *last_item = NULL;
+
+  u32 n;
+  for(n=0; n<SEQ_MIDI_OUT_WHEEL_LISTS; ++n) {
+    seq_midi_out_queue_item_t **tail;
+    seq_midi_out_queue_item_t **list = SEQ_MIDI_OUT_WheelList(n, &tail);
+    seq_midi_out_queue_item_t *item;
+
+    if( tail != NULL && *list != NULL ) {
+      // page slots are not sorted yet (see SEQ_MIDI_OUT_WheelInsert())
+      // items are inserted in the order they have been queued, so that the sort order is kept
+      seq_midi_out_queue_item_t *sorted_list = NULL;
+      while( *list != NULL )
+	SEQ_MIDI_OUT_ListInsert(&sorted_list, SEQ_MIDI_OUT_ItemUnlink(list));
+      *list = sorted_list;
+    }
+
+    if( (item=*list) != NULL ) {
+      if( last_item == NULL )
+	first_item = item;
+      else
+	last_item->next = item;
+
+      while( item->next != NULL )
+	item = item->next;
+      last_item = item;
+
+      *list = NULL;
+      if( tail != NULL )
+	*tail = NULL;
     }
   }
 
-  return 0; // no error
+  wheel_slot_items = 0;
+  wheel_page_items = 0;
+
+  return first_item;
 }
+#endif
 
 
 /////////////////////////////////////////////////////////////////////////////
@@ -816,6 +1407,13 @@ static seq_midi_out_queue_item_t *SEQ_MIDI_OUT_SlotMalloc(void)
 /////////////////////////////////////////////////////////////////////////////
 static void SEQ_MIDI_OUT_SlotFree(seq_midi_out_queue_item_t *item)
 {
+#if SEQ_MIDI_OUT_TAG_INDEX
+  // remove from tag list
+  *item->tag_pprev = item->tag_next;
+  if( item->tag_next != NULL )
+    item->tag_next->tag_pprev = item->tag_pprev;
+#endif
+
 #if SEQ_MIDI_OUT_MALLOC_METHOD == 4
   vPortFree(item);
   --seq_midi_out_allocated;
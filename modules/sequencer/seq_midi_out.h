@@ -51,6 +51,44 @@ extern "C" {
 #define SEQ_MIDI_OUT_SUPPORT_DELAY 0
 #endif
 
+// queue method:
+// 0: single linked list, sorted by timestamp (each new event walks through the queue)
+// 1: hierarchical timing wheel: one slot per tick for the current page,
+//    one slot per page for the upcoming pages, and a sorted overflow list
+//    for events which are scheduled beyond the wheel range (e.g. sustained notes)
+//    Each slot allocates 4 bytes (page slots 8 bytes)
+// Both methods send the events in the same order. Only exception: if OnOff events
+// are re-scheduled, a CC which has been sorted before them at the same timestamp can be
+// sent after Off events of this timestamp by method 1 (like a new CC)
+#ifndef SEQ_MIDI_OUT_QUEUE_METHOD
+#define SEQ_MIDI_OUT_QUEUE_METHOD 0
+#endif
+
+// number of ticks per timing wheel page (only relevant for SEQ_MIDI_OUT_QUEUE_METHOD 1)
+// must be a power of two! (e.g. 64, 128, 256, ...)
+#ifndef SEQ_MIDI_OUT_WHEEL_TICKS
+#define SEQ_MIDI_OUT_WHEEL_TICKS 256
+#endif
+
+// number of timing wheel pages (only relevant for SEQ_MIDI_OUT_QUEUE_METHOD 1)
+// must be a power of two! (e.g. 16, 32, 64, ...)
+#ifndef SEQ_MIDI_OUT_WHEEL_PAGES
+#define SEQ_MIDI_OUT_WHEEL_PAGES 64
+#endif
+
+// index for SEQ_MIDI_OUT_ReSchedule(): queued events are additionally linked
+// per tag (mios32_midi_package_t.cable), so that only the events of the given
+// tag have to be checked. Each event allocates 12 additional bytes
+// Enabled by default for the timing wheel, since without index SEQ_MIDI_OUT_ReSchedule()
+// has to scan all slots of the wheel
+#ifndef SEQ_MIDI_OUT_TAG_INDEX
+#if SEQ_MIDI_OUT_QUEUE_METHOD == 1
+#define SEQ_MIDI_OUT_TAG_INDEX 1
+#else
+#define SEQ_MIDI_OUT_TAG_INDEX 0
+#endif
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Global Types
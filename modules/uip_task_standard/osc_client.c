@@ -25,6 +25,14 @@
 #include "osc_server.h"
 #include "osc_client.h"
 
+#if !defined(MIOS32_FAMILY_EMULATION)
+#include "uip_task.h"
+#else
+// bundles are flushed by the uIP task which isn't available in the emulation
+# undef OSC_CLIENT_BUNDLE_ENABLED
+# define OSC_CLIENT_BUNDLE_ENABLED 0
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // for optional debugging messages via MIOS32_MIDI_SendDebug*
@@ -71,6 +79,19 @@ static u16 osc_transfer_mode[OSC_CLIENT_NUM_PORTS];
 static u8 sysex_buffer[OSC_CLIENT_NUM_PORTS][OSC_CLIENT_SYSEX_BUFFER_SIZE];
 static u8 sysex_buffer_len[OSC_CLIENT_NUM_PORTS];
 
+// prepared "/midi<port>" path (padded to 4 bytes) followed by the ",m" type tag
+#define OSC_CLIENT_MIDI_PATH_SIZE 8
+static u8 midi_path[OSC_CLIENT_NUM_PORTS][OSC_CLIENT_MIDI_PATH_SIZE + 4];
+
+#if OSC_CLIENT_BUNDLE_ENABLED
+// each bundle buffer starts with "#bundle" and the timetag, followed by <size><message> elements
+#define OSC_CLIENT_BUNDLE_HEADER_SIZE 16
+static u8 bundle_buffer[OSC_CLIENT_NUM_PORTS][OSC_CLIENT_BUNDLE_MAX_SIZE] __attribute__((aligned(4)));
+static u16 bundle_len[OSC_CLIENT_NUM_PORTS];
+static u8 bundle_num_messages[OSC_CLIENT_NUM_PORTS];
+static u16 bundle_age_ms[OSC_CLIENT_NUM_PORTS];
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 // Initialize the OSC client
@@ -82,9 +103,156 @@ s32 OSC_CLIENT_Init(u32 mode)
   for(i=0; i<OSC_CLIENT_NUM_PORTS; ++i) {
     osc_transfer_mode[i] = OSC_CLIENT_TRANSFER_MODE_MIDI;
     sysex_buffer_len[i] = 0;
+
+    u8 *end_ptr = MIOS32_OSC_PutString(midi_path[i], "/midiX");
+    midi_path[i][5] = '1' + i;
+    MIOS32_OSC_PutString(end_ptr, ",m");
+
+#if OSC_CLIENT_BUNDLE_ENABLED
+    // the header never changes: timetag 0.000000001 means "immediately"
+    mios32_osc_timetag_t timetag;
+    timetag.seconds = 0;
+    timetag.fraction = 1;
+    end_ptr = MIOS32_OSC_PutString(bundle_buffer[i], "#bundle");
+    end_ptr = MIOS32_OSC_PutTimetag(end_ptr, timetag);
+    bundle_len[i] = OSC_CLIENT_BUNDLE_HEADER_SIZE;
+    bundle_num_messages[i] = 0;
+    bundle_age_ms[i] = 0;
+#endif
+  }
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Should be called each mS by the uIP task (outside the UIP mutex)
+// Sends collected bundles once the coalescing window has expired
+/////////////////////////////////////////////////////////////////////////////
+s32 OSC_CLIENT_Periodic_mS(void)
+{
+#if OSC_CLIENT_BUNDLE_ENABLED
+  int i;
+
+  MUTEX_UIP_TAKE;
+  for(i=0; i<OSC_CLIENT_NUM_PORTS; ++i) {
+    if( bundle_num_messages[i] && ++bundle_age_ms[i] > OSC_CLIENT_BUNDLE_WINDOW_MS )
+      OSC_CLIENT_Flush(i);
+  }
+  MUTEX_UIP_GIVE;
+#endif
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Sends the collected messages of the given port immediately
+// A single message is sent without the bundle header
+/////////////////////////////////////////////////////////////////////////////
+s32 OSC_CLIENT_Flush(u8 osc_port)
+{
+  if( osc_port >= OSC_CLIENT_NUM_PORTS )
+    return -1; // invalid port
+
+#if OSC_CLIENT_BUNDLE_ENABLED
+  s32 status = 0;
+
+  MUTEX_UIP_TAKE;
+  if( bundle_num_messages[osc_port] == 1 ) {
+    u32 offset = OSC_CLIENT_BUNDLE_HEADER_SIZE + 4;
+    status = OSC_SERVER_SendPacket(osc_port, &bundle_buffer[osc_port][offset], bundle_len[osc_port] - offset);
+  } else if( bundle_num_messages[osc_port] > 1 ) {
+    status = OSC_SERVER_SendPacket(osc_port, bundle_buffer[osc_port], bundle_len[osc_port]);
+  }
+  bundle_len[osc_port] = OSC_CLIENT_BUNDLE_HEADER_SIZE;
+  bundle_num_messages[osc_port] = 0;
+  bundle_age_ms[osc_port] = 0;
+  MUTEX_UIP_GIVE;
+
+  return status;
+#else
+  return 0; // no error
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Adds a message to the bundle of the given port, or sends it directly
+// if bundling is disabled
+/////////////////////////////////////////////////////////////////////////////
+static s32 OSC_CLIENT_SendPacket(u8 osc_port, u8 *packet, u32 len)
+{
+#if OSC_CLIENT_BUNDLE_ENABLED
+  if( len == 0 )
+    return 0; // nothing to send
+
+  // too large for a bundle: send it directly after the collected messages
+  if( (OSC_CLIENT_BUNDLE_HEADER_SIZE + 4 + len) > OSC_CLIENT_BUNDLE_MAX_SIZE ) {
+    OSC_CLIENT_Flush(osc_port);
+    return OSC_SERVER_SendPacket(osc_port, packet, len);
   }
 
+  MUTEX_UIP_TAKE;
+
+  // bundle full?
+  if( (bundle_len[osc_port] + 4 + len) > OSC_CLIENT_BUNDLE_MAX_SIZE )
+    OSC_CLIENT_Flush(osc_port);
+
+  u8 *end_ptr = MIOS32_OSC_PutWord(&bundle_buffer[osc_port][bundle_len[osc_port]], len);
+  memcpy(end_ptr, packet, len);
+  bundle_len[osc_port] += 4 + len;
+  ++bundle_num_messages[osc_port];
+
+  MUTEX_UIP_GIVE;
+
   return 0; // no error
+#else
+  return OSC_SERVER_SendPacket(osc_port, packet, len);
+#endif
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Puts an OSC address into the buffer: <prefix><num1><infix><num2>
+// Negative numbers and a NULL infix are omitted.
+// The string is terminated and padded to 4 bytes like MIOS32_OSC_PutString()
+/////////////////////////////////////////////////////////////////////////////
+static u8 *OSC_CLIENT_PutPath(u8 *buffer, const char *prefix, s32 num1, const char *infix, s32 num2)
+{
+  u8 *ptr = buffer;
+  int pass;
+
+  while( *prefix )
+    *ptr++ = *prefix++;
+
+  for(pass=0; pass<2; ++pass) {
+    s32 num = pass ? num2 : num1;
+
+    if( num >= 0 ) {
+      char digits[10];
+      int num_digits = 0;
+      do {
+	digits[num_digits++] = '0' + (num % 10);
+	num /= 10;
+      } while( num );
+
+      while( num_digits )
+	*ptr++ = digits[--num_digits];
+    }
+
+    if( !pass && infix != NULL ) {
+      while( *infix )
+	*ptr++ = *infix++;
+    }
+  }
+
+  // terminate and pad to 4 bytes
+  do {
+    *ptr++ = 0;
+  } while( (ptr - buffer) & 3 );
+
+  return ptr;
 }
 
 
@@ -139,52 +307,45 @@ s32 OSC_CLIENT_SendMIDIEvent(u8 osc_port, mios32_midi_package_t package)
 #endif
 
   // create the OSC packet
-  u8 packet[128];
+  u8 packet[128] __attribute__((aligned(4)));
   u8 *end_ptr = packet;
 
   if( osc_transfer_mode[osc_port] == OSC_CLIENT_TRANSFER_MODE_MCMPP &&
       package.type >= NoteOff && package.type <= PitchBend ) {
-    char event_path[30];
     switch( package.type ) {
     case NoteOff:
       package.velocity = 0;
       // fall through
     case NoteOn:
-      sprintf(event_path, "/mcmpp/key/%d/%d", package.note, package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/mcmpp/key/", package.note, "/", package.chn+1);
       end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
       end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)package.velocity/127.0);
       break;
 
     case PolyPressure:
-      sprintf(event_path, "/mcmpp/polypressure/%d/%d", package.note, package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/mcmpp/polypressure/", package.note, "/", package.chn+1);
       end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
       end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)package.velocity/127.0);
       break;
 
     case CC:
-      sprintf(event_path, "/mcmpp/cc/%d/%d", package.cc_number, package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/mcmpp/cc/", package.cc_number, "/", package.chn+1);
       end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
       end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)package.value/127.0);
       break;
 
     case ProgramChange:
-      sprintf(event_path, "/mcmpp/programchange/%d/%d", package.program_change, package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/mcmpp/programchange/", package.program_change, "/", package.chn+1);
       break;
 
     case Aftertouch:
-      sprintf(event_path, "/mcmpp/aftertouch/%d", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/mcmpp/aftertouch/", package.chn+1, NULL, -1);
       end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
       end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)package.velocity/127.0);
       break;
 
     case PitchBend: {
-      sprintf(event_path, "/mcmpp/pitch/%d", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/mcmpp/pitch/", package.chn+1, NULL, -1);
       int value = ((package.evnt1 & 0x7f) | (int)((package.evnt2 & 0x7f) << 7)) - 8192;
       if( value >= 0 && value <= 127 )
 	value = 0;
@@ -193,53 +354,45 @@ s32 OSC_CLIENT_SendMIDIEvent(u8 osc_port, mios32_midi_package_t package)
     } break;
 
     default:
-      sprintf(event_path, "/mcmpp/invalid/%d", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/mcmpp/invalid/", package.chn+1, NULL, -1);
       break;
     }
   } else if( osc_transfer_mode[osc_port] == OSC_CLIENT_TRANSFER_MODE_TOSC &&
       package.type >= NoteOff && package.type <= PitchBend ) {
-    char event_path[30];
     switch( package.type ) {
     case NoteOff:
       package.velocity = 0;
       // fall through
     case NoteOn:
-      sprintf(event_path, "/%d/note_%d", package.chn+1, package.note);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/note_", package.note);
       end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
       end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)package.velocity/127.0);
       break;
 
     case PolyPressure:
-      sprintf(event_path, "/%d/polypressure_%d", package.chn+1, package.note);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/polypressure_", package.note);
       end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
       end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)package.velocity/127.0);
       break;
 
     case CC:
-      sprintf(event_path, "/%d/cc_%d", package.chn+1, package.cc_number);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/cc_", package.cc_number);
       end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
       end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)package.value/127.0);
       break;
 
     case ProgramChange:
-      sprintf(event_path, "/%d/programchange_%d", package.chn+1, package.program_change);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/programchange_", package.program_change);
       break;
 
     case Aftertouch:
-      sprintf(event_path, "/%d/aftertouch", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/aftertouch", -1);
       end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
       end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)package.velocity/127.0);
       break;
 
     case PitchBend: {
-      sprintf(event_path, "/%d/pitch", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/pitch", -1);
       int value = ((package.evnt1 & 0x7f) | (int)((package.evnt2 & 0x7f) << 7)) - 8192;
       if( value >= 0 && value <= 127 )
 	value = 0;
@@ -248,20 +401,17 @@ s32 OSC_CLIENT_SendMIDIEvent(u8 osc_port, mios32_midi_package_t package)
     } break;
 
     default:
-      sprintf(event_path, "/%d/invalid", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/invalid", -1);
       break;
     }
   } else if( osc_transfer_mode[osc_port] != OSC_CLIENT_TRANSFER_MODE_MIDI &&
       package.type >= NoteOff && package.type <= PitchBend ) {
-    char event_path[30];
     switch( package.type ) {
     case NoteOff:
       package.velocity = 0;
       // fall through
     case NoteOn:
-      sprintf(event_path, "/%d/note", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/note", -1);
       if( osc_transfer_mode[osc_port] == OSC_CLIENT_TRANSFER_MODE_FLOAT ) {
 	end_ptr = MIOS32_OSC_PutString(end_ptr, ",if");
 	end_ptr = MIOS32_OSC_PutInt(end_ptr, package.note);
@@ -274,8 +424,7 @@ s32 OSC_CLIENT_SendMIDIEvent(u8 osc_port, mios32_midi_package_t package)
       break;
 
     case PolyPressure:
-      sprintf(event_path, "/%d/polypressure", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/polypressure", -1);
       if( osc_transfer_mode[osc_port] == OSC_CLIENT_TRANSFER_MODE_FLOAT ) {
 	end_ptr = MIOS32_OSC_PutString(end_ptr, ",if");
 	end_ptr = MIOS32_OSC_PutInt(end_ptr, package.note);
@@ -288,8 +437,7 @@ s32 OSC_CLIENT_SendMIDIEvent(u8 osc_port, mios32_midi_package_t package)
       break;
 
     case CC:
-      sprintf(event_path, "/%d/cc", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/cc", -1);
       if( osc_transfer_mode[osc_port] == OSC_CLIENT_TRANSFER_MODE_FLOAT ) {
 	end_ptr = MIOS32_OSC_PutString(end_ptr, ",if");
 	end_ptr = MIOS32_OSC_PutInt(end_ptr, package.cc_number);
@@ -302,8 +450,7 @@ s32 OSC_CLIENT_SendMIDIEvent(u8 osc_port, mios32_midi_package_t package)
       break;
 
     case ProgramChange:
-      sprintf(event_path, "/%d/programchange", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/programchange", -1);
       if( osc_transfer_mode[osc_port] == OSC_CLIENT_TRANSFER_MODE_FLOAT ) {
 	end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
 	end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)package.program_change/127.0);
@@ -314,8 +461,7 @@ s32 OSC_CLIENT_SendMIDIEvent(u8 osc_port, mios32_midi_package_t package)
       break;
 
     case Aftertouch:
-      sprintf(event_path, "/%d/aftertouch", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/aftertouch", -1);
       if( osc_transfer_mode[osc_port] == OSC_CLIENT_TRANSFER_MODE_FLOAT ) {
 	end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
 	end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)package.velocity/127.0);
@@ -326,8 +472,7 @@ s32 OSC_CLIENT_SendMIDIEvent(u8 osc_port, mios32_midi_package_t package)
       break;
 
     case PitchBend: {
-      sprintf(event_path, "/%d/pitchbend", package.chn+1);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn+1, "/pitchbend", -1);
       int value = ((package.evnt1 & 0x7f) | (int)((package.evnt2 & 0x7f) << 7)) - 8192;
       if( value >= 0 && value <= 127 )
 	value = 0;
@@ -341,8 +486,7 @@ s32 OSC_CLIENT_SendMIDIEvent(u8 osc_port, mios32_midi_package_t package)
     } break;
 
     default:
-      sprintf(event_path, "/%d/invalid", package.chn);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+      end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", package.chn, "/invalid", -1);
       break;
     }
   } else {
@@ -379,10 +523,8 @@ s32 OSC_CLIENT_SendMIDIEvent(u8 osc_port, mios32_midi_package_t package)
 	*buffer_len += 1;
 
 	if( evnt == 0xf7 || *buffer_len >= OSC_CLIENT_SYSEX_BUFFER_SIZE ) {
-	  char midi_path[8];
-	  strcpy(midi_path, "/midiX");
-	  midi_path[5] = '1' + osc_port;
-	  end_ptr = MIOS32_OSC_PutString(end_ptr, midi_path);
+	  memcpy(end_ptr, midi_path[osc_port], OSC_CLIENT_MIDI_PATH_SIZE);
+	  end_ptr += OSC_CLIENT_MIDI_PATH_SIZE;
 	  end_ptr = MIOS32_OSC_PutString(end_ptr, ",b");
 	  end_ptr = MIOS32_OSC_PutBlob(end_ptr, buffer, *buffer_len);
 	  *buffer_len = 0;
@@ -393,17 +535,15 @@ s32 OSC_CLIENT_SendMIDIEvent(u8 osc_port, mios32_midi_package_t package)
       if( !send_sysex )
 	return 0; // wait until sysex stream is terminated (or buffer is full)
     } else {
-      char midi_path[8];
-      strcpy(midi_path, "/midiX");
-      midi_path[5] = '1' + osc_port;
-      end_ptr = MIOS32_OSC_PutString(end_ptr, midi_path);
-      end_ptr = MIOS32_OSC_PutString(end_ptr, ",m");
+      // path and type tag ",m" are taken from the prepared template
+      memcpy(end_ptr, midi_path[osc_port], OSC_CLIENT_MIDI_PATH_SIZE + 4);
+      end_ptr += OSC_CLIENT_MIDI_PATH_SIZE + 4;
       end_ptr = MIOS32_OSC_PutMIDI(end_ptr, package);
     }
   }
 
-  // send packet and exit
-  return OSC_SERVER_SendPacket(osc_port, packet, (u32)(end_ptr-packet));
+  // send packet (or add it to the bundle) and exit
+  return OSC_CLIENT_SendPacket(osc_port, packet, (u32)(end_ptr-packet));
 }
 
 
@@ -423,25 +563,19 @@ s32 OSC_CLIENT_SendNRPNEvent(u8 osc_port, u8 chn, u16 nrpn_number, u16 nrpn_valu
 #endif
 
   // create the OSC packet
-  u8 packet[128];
+  u8 packet[128] __attribute__((aligned(4)));
   u8 *end_ptr = packet;
 
   if( osc_transfer_mode[osc_port] == OSC_CLIENT_TRANSFER_MODE_MCMPP ) {
-    char event_path[30];
-    sprintf(event_path, "/mcmpp/nrpn/%d/%d", nrpn_number, chn+1);
-    end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+    end_ptr = OSC_CLIENT_PutPath(end_ptr, "/mcmpp/nrpn/", nrpn_number, "/", chn+1);
     end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
     end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)nrpn_value/16383.0);
   } else if( osc_transfer_mode[osc_port] == OSC_CLIENT_TRANSFER_MODE_TOSC ) {
-    char event_path[30];
-    sprintf(event_path, "/%d/nrpn_%d", chn+1, nrpn_number);
-    end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+    end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", chn+1, "/nrpn_", nrpn_number);
     end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
     end_ptr = MIOS32_OSC_PutFloat(end_ptr, (float)nrpn_value/16383.0);
   } else if( osc_transfer_mode[osc_port] != OSC_CLIENT_TRANSFER_MODE_MIDI ) {
-    char event_path[30];
-    sprintf(event_path, "/%d/nrpn", chn+1);
-    end_ptr = MIOS32_OSC_PutString(end_ptr, event_path);
+    end_ptr = OSC_CLIENT_PutPath(end_ptr, "/", chn+1, "/nrpn", -1);
     if( osc_transfer_mode[osc_port] == OSC_CLIENT_TRANSFER_MODE_FLOAT ) {
       end_ptr = MIOS32_OSC_PutString(end_ptr, ",if");
       end_ptr = MIOS32_OSC_PutInt(end_ptr, nrpn_number);
@@ -452,10 +586,8 @@ s32 OSC_CLIENT_SendNRPNEvent(u8 osc_port, u8 chn, u16 nrpn_number, u16 nrpn_valu
       end_ptr = MIOS32_OSC_PutInt(end_ptr, nrpn_value);
     }
   } else {
-    char midi_path[8];
-    strcpy(midi_path, "/midiX");
-    midi_path[5] = '1' + osc_port;
-    end_ptr = MIOS32_OSC_PutString(end_ptr, midi_path);
+    memcpy(end_ptr, midi_path[osc_port], OSC_CLIENT_MIDI_PATH_SIZE);
+    end_ptr += OSC_CLIENT_MIDI_PATH_SIZE;
     end_ptr = MIOS32_OSC_PutString(end_ptr, ",mmmm");
 
     mios32_midi_package_t p;
@@ -484,8 +616,8 @@ s32 OSC_CLIENT_SendNRPNEvent(u8 osc_port, u8 chn, u16 nrpn_number, u16 nrpn_valu
     end_ptr = MIOS32_OSC_PutMIDI(end_ptr, p);
   }
 
-  // send packet and exit
-  return OSC_SERVER_SendPacket(osc_port, packet, (u32)(end_ptr-packet));
+  // send packet (or add it to the bundle) and exit
+  return OSC_CLIENT_SendPacket(osc_port, packet, (u32)(end_ptr-packet));
 }
 
 
@@ -512,17 +644,15 @@ s32 OSC_CLIENT_SendSysEx(u8 osc_port, u8 *stream, u32 count)
     u32 bytes_to_send = ((send_offset + max_bytes) > count) ? (count-send_offset) : max_bytes;
 
     // create the OSC packet
-    u8 packet[128];
+    u8 packet[128] __attribute__((aligned(4)));
     u8 *end_ptr = packet;
 
-    char midi_path[8];
-    strcpy(midi_path, "/midiX");
-    midi_path[5] = '1' + osc_port;
-    end_ptr = MIOS32_OSC_PutString(end_ptr, midi_path);
+    memcpy(end_ptr, midi_path[osc_port], OSC_CLIENT_MIDI_PATH_SIZE);
+    end_ptr += OSC_CLIENT_MIDI_PATH_SIZE;
     end_ptr = MIOS32_OSC_PutString(end_ptr, ",b");
     end_ptr = MIOS32_OSC_PutBlob(end_ptr, (u8 *)&stream[send_offset], bytes_to_send);
 
-    OSC_SERVER_SendPacket(osc_port, packet, (u32)(end_ptr-packet));
+    OSC_CLIENT_SendPacket(osc_port, packet, (u32)(end_ptr-packet));
 
     send_offset += bytes_to_send;
   };
@@ -546,6 +676,11 @@ s32 OSC_CLIENT_SendMIDIEventBundled(u8 osc_port, mios32_midi_package_t *p, u8 nu
     return -2; 
 #endif
 
+#if OSC_CLIENT_BUNDLE_ENABLED
+  // send collected messages first to keep the order
+  OSC_CLIENT_Flush(osc_port);
+#endif
+
   // create the OSC packet
   u8 packet[256];
   u8 *end_ptr = packet;
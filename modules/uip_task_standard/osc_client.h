@@ -24,6 +24,29 @@ extern "C" {
 
 #define OSC_CLIENT_NUM_PORTS 4
 
+// if enabled in mios32_config.h, outgoing messages are collected per port
+// and sent as a single #bundle, otherwise one datagram is sent per message
+// The bundles are sent with the timetag "immediately" (0.000000001), since
+// the core doesn't know the time of the receiver: the messages are executed
+// on reception, the window below delays them by max. OSC_CLIENT_BUNDLE_WINDOW_MS+1 mS.
+// Use OSC_CLIENT_SendMIDIEventBundled() to send events with a dedicated timetag.
+// Packets which are sent with OSC_SERVER_SendPacket() by the application have
+// to be preceded by OSC_CLIENT_Flush() to keep the order
+#ifndef OSC_CLIENT_BUNDLE_ENABLED
+#define OSC_CLIENT_BUNDLE_ENABLED 0
+#endif
+
+// coalescing window in mS
+// 0: messages are collected until the next uIP task cycle (<1 mS)
+#ifndef OSC_CLIENT_BUNDLE_WINDOW_MS
+#define OSC_CLIENT_BUNDLE_WINDOW_MS 0
+#endif
+
+// max. size of a bundle datagram (per port), should be below the MTU
+#ifndef OSC_CLIENT_BUNDLE_MAX_SIZE
+#define OSC_CLIENT_BUNDLE_MAX_SIZE 512
+#endif
+
 
 // transfer modes
 // keep OSC_CLIENT_TransferModeFullNameGet() and OSC_CLIENT_TransferModeShortNameGet() aligned with the assignments!
@@ -46,6 +69,8 @@ extern "C" {
 /////////////////////////////////////////////////////////////////////////////
 
 extern s32 OSC_CLIENT_Init(u32 mode);
+extern s32 OSC_CLIENT_Periodic_mS(void);
+extern s32 OSC_CLIENT_Flush(u8 osc_port);
 
 extern s32 OSC_CLIENT_TransferModeSet(u8 osc_port, u8 mode);
 extern u8 OSC_CLIENT_TransferModeGet(u8 osc_port);
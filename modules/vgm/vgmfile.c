@@ -368,6 +368,8 @@ s32 VGM_File_LoadRAM(VgmSource* sourceram, VgmFileMetadata* md){
         vgmh2_free(vsr->cmds);
         vsr->cmds = NULL;
         vsr->numcmds = 0;
+        vsr->gapstart = 0;
+        vsr->gapsize = 0;
     }
     //Copy data from metadata to source/sourceram
     sourceram->psgclock = md->psgclock;
@@ -378,6 +380,9 @@ s32 VGM_File_LoadRAM(VgmSource* sourceram, VgmFileMetadata* md){
     sourceram->usage.all = md->usage.all;
     vsr->numcmds = md->numcmdsram;
     vsr->cmds = vgmh2_malloc(vsr->numcmds * sizeof(VgmChipWriteCmd));
+    //No gap, the commands can be written directly into cmds
+    vsr->gapstart = vsr->numcmds;
+    vsr->gapsize = 0;
     if(vsr->cmds == NULL){
         DBG("VGM_File_LoadRAM out of memory for main data!");
         return -50;
@@ -567,7 +572,7 @@ s32 VGM_File_SaveRAM(VgmSource* sourceram, char* filename){
     u8 type;
     VgmChipWriteCmd cmd;
     for(i=0; i<vsr->numcmds; ++i){
-        cmd.all = vsr->cmds[i].all;
+        cmd.all = VGM_SourceRAM_cmdPtr(vsr, i)->all;
         type = cmd.cmd;
         if(type == 0x50){
             //PSG write
@@ -664,7 +669,7 @@ s32 VGM_File_SaveRAM(VgmSource* sourceram, char* filename){
         FILE_WriteWord(blocklen);
         for(i=0; i<vsr->numcmds; ++i){
             //Write block data
-            cmd = vsr->cmds[i];
+            cmd = *VGM_SourceRAM_cmdPtr(vsr, i);
             type = cmd.cmd;
             if(type >= 0x80 && type <= 0x8F){
                 FILE_WriteByte(cmd.data);
@@ -678,7 +683,7 @@ s32 VGM_File_SaveRAM(VgmSource* sourceram, char* filename){
     DBG("--Writing VGM data");
     VgmChipWriteCmd cmd1, cmd2;
     for(i=0; i<vsr->numcmds; ++i){
-        cmd = vsr->cmds[i];
+        cmd = *VGM_SourceRAM_cmdPtr(vsr, i);
         type = cmd.cmd;
         if(VGM_Cmd_UnpackTwoByte(cmd, &cmd1, &cmd2)){
             if(type == 0x50){
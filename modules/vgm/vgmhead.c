@@ -18,6 +18,7 @@
 #include <genesis.h>
 #include "vgm_heap2.h"
 #include "vgmtuning.h"
+#include "vgmplayer.h"
 
 VgmHead* vgm_heads[VGM_HEAD_MAXNUM];
 u32 vgm_numheads;
@@ -30,6 +31,7 @@ VgmHead* VGM_Head_Create(VgmSource* source, u32 freqmult, u32 tempomult, u32 tlo
     if(source == NULL) return NULL;
     VgmHead* head = vgmh2_malloc(sizeof(VgmHead));
     head->playing = 0;
+    head->schedidx = 0xFF; //not scheduled
     head->source = source;
     head->ticks = 0; //will get changed at restart
     head->srcaddr = 0;
@@ -77,6 +79,7 @@ s32 VGM_Head_Delete(VgmHead* head){
     if(head == NULL) return -1;
     s32 ret = -1;
     MIOS32_IRQ_Disable();
+    VGM_Player_Remove(head);
     u8 i;
     for(i=0; i<vgm_numheads; ++i){
         if(vgm_heads[i] == head){
@@ -112,6 +115,7 @@ void VGM_Head_Restart(VgmHead* head, u32 vgm_time){
     }else if(head->source->type == VGM_SOURCE_TYPE_QUEUE){
         VGM_HeadQueue_Restart(head);
     }
+    VGM_Player_Schedule(head);
 }
 void VGM_Head_cmdNext(VgmHead* head, u32 vgm_time){
     if(head == NULL) return;
@@ -62,7 +62,8 @@ typedef union {
         u8 firstoftwo:1;
         u8 psgfreq0to1:1;
         u8 psglastchannel:2;
-        u32 dummy:24;
+        u32 schedidx:8; //Position in the player's schedule, see vgmplayer.c
+        u32 dummy:16;
     };
 } VgmHead;
 
@@ -27,6 +27,190 @@ u8 VGM_Player_docapture;
 static u8 nextchiptocapture;
 static u32 lasttimecaptured;
 
+/*
+Scheduling: each playing head is in one of these places (head->schedidx):
+- the deadline heap, ordered by head->ticks, if its current command is a wait
+  (or if it was just (re)started and hasn't been looked at yet)
+- the write queue of the chip its current command writes to
+- nowhere, if it's not playing or done; VGM_Player_Schedule() has to be called
+  when such a head is started again
+So each wakeup only touches the heads which are due and the chips which are
+ready, instead of scanning all heads.
+*/
+#define VGMP_SCHED_QUEUED 0xFE
+#define VGMP_SCHED_NONE   0xFF
+
+#define VGMP_QUEUE_PSG  0
+#define VGMP_QUEUE_OPN2 1
+
+typedef struct {
+    VgmHead* head[VGM_HEAD_MAXNUM];
+    u8 first;
+    u8 num;
+} vgmp_writequeue;
+
+static VgmHead* heap[VGM_HEAD_MAXNUM];
+static u8 heapsize;
+static vgmp_writequeue writequeues[GENESIS_COUNT][2];
+
+static inline u8 HeapBefore(VgmHead* a, VgmHead* b){
+    return (s32)(a->ticks - b->ticks) < 0;
+}
+static void HeapSet(u8 i, VgmHead* h){
+    heap[i] = h;
+    h->schedidx = i;
+}
+static void HeapUp(u8 i){
+    VgmHead* h = heap[i];
+    while(i > 0){
+        u8 p = (i-1) >> 1;
+        if(!HeapBefore(h, heap[p])) break;
+        HeapSet(i, heap[p]);
+        i = p;
+    }
+    HeapSet(i, h);
+}
+static void HeapDown(u8 i){
+    VgmHead* h = heap[i];
+    while(1){
+        u8 c = (i << 1) + 1;
+        if(c >= heapsize) break;
+        if(c+1 < heapsize && HeapBefore(heap[c+1], heap[c])) ++c;
+        if(!HeapBefore(heap[c], h)) break;
+        HeapSet(i, heap[c]);
+        i = c;
+    }
+    HeapSet(i, h);
+}
+static void HeapPush(VgmHead* h){
+    heap[heapsize] = h;
+    HeapUp(heapsize++);
+}
+static void HeapRemove(u8 i){
+    heap[i]->schedidx = VGMP_SCHED_NONE;
+    --heapsize;
+    if(i == heapsize) return;
+    heap[i] = heap[heapsize];
+    HeapDown(i);
+    HeapUp(heap[i]->schedidx);
+}
+
+static void QueuePush(vgmp_writequeue* q, VgmHead* h){
+    q->head[(q->first + q->num) % VGM_HEAD_MAXNUM] = h;
+    ++q->num;
+    h->schedidx = VGMP_SCHED_QUEUED;
+}
+static void QueuePop(vgmp_writequeue* q){
+    q->first = (q->first + 1) % VGM_HEAD_MAXNUM;
+    --q->num;
+}
+
+static void Unschedule(VgmHead* h){
+    if(h->schedidx < VGM_HEAD_MAXNUM){
+        HeapRemove(h->schedidx);
+    }else if(h->schedidx == VGMP_SCHED_QUEUED){
+        u8 chip, type, i, j;
+        for(chip=0; chip<GENESIS_COUNT; ++chip){
+            for(type=0; type<2; ++type){
+                vgmp_writequeue* q = &writequeues[chip][type];
+                for(i=0, j=0; i<q->num; ++i){
+                    VgmHead* qh = q->head[(q->first + i) % VGM_HEAD_MAXNUM];
+                    if(qh != h){
+                        q->head[(q->first + j) % VGM_HEAD_MAXNUM] = qh;
+                        ++j;
+                    }
+                }
+                q->num = j;
+            }
+        }
+        h->schedidx = VGMP_SCHED_NONE;
+    }
+}
+
+//Puts the head into the heap or the write queue, depending on its current command
+static void Enqueue(VgmHead* h, u32 vgm_time){
+    VgmChipWriteCmd cmd;
+    u8 chip, subcmd;
+    while(h->playing && !h->isdone){
+        if(VGM_Head_cmdIsChipWrite(h)){
+            cmd = h->writecmd;
+            chip = (cmd.cmd >> 4);
+            subcmd = (cmd.cmd & 0x0F);
+            if(chip >= GENESIS_COUNT || subcmd > 4 || subcmd == 1){
+                //Not a valid chip write, skip it
+                VGM_Head_cmdNext(h, vgm_time);
+                continue;
+            }
+            QueuePush(&writequeues[chip][(subcmd == 0) ? VGMP_QUEUE_PSG : VGMP_QUEUE_OPN2], h);
+        }else{
+            //Wait, or a command which does nothing: advance when head->ticks is reached
+            HeapPush(h);
+        }
+        return;
+    }
+    h->schedidx = VGMP_SCHED_NONE;
+}
+
+void VGM_Player_Schedule(VgmHead* head){
+    MIOS32_IRQ_Disable();
+    Unschedule(head);
+    if(head->playing && !head->isdone){
+        //Checked by the next wakeup, like a head whose wait is over
+        HeapPush(head);
+    }
+    MIOS32_IRQ_Enable();
+}
+
+void VGM_Player_Remove(VgmHead* head){
+    MIOS32_IRQ_Disable();
+    Unschedule(head);
+    MIOS32_IRQ_Enable();
+}
+
+//Writes the commands of the heads in the queue until the chip is busy
+//returns the remaining busy time if heads are waiting, else 0xFFFFFFFF
+static u32 ServiceQueue(u8 chip, u8 type, u32 vgm_time, u8* progress){
+    vgmp_writequeue* q = &writequeues[chip][type];
+    VgmHead* h;
+    VgmChipWriteCmd cmd;
+    u32 u;
+    while(q->num){
+        h = q->head[q->first];
+        if(!h->playing || h->isdone){
+            //Head has been stopped
+            QueuePop(q);
+            h->schedidx = VGMP_SCHED_NONE;
+            continue;
+        }
+        cmd = h->writecmd;
+        if(type == VGMP_QUEUE_PSG){
+            u = TIM2->CNT - chipdata[chip].psg_lastwritetime;
+            if(u < VGMP_PSGBUSYDELAY){
+                return VGMP_PSGBUSYDELAY - u;
+            }
+            Genesis_PSGWrite(chip, cmd.data);
+            chipdata[chip].psg_lastwritetime = TIM2->CNT;
+        }else{
+            u = TIM2->CNT - chipdata[chip].opn2_lastwritetime;
+            if(u < VGMP_OPN2BUSYDELAY){
+                return VGMP_OPN2BUSYDELAY - u;
+            }
+            Genesis_OPN2Write(chip, (cmd.cmd & 0x01), cmd.addr, cmd.data);
+            //Don't delay after 0x2x commands
+            if(cmd.addr >= 0x20 && cmd.addr < 0x2F && cmd.addr != 0x28){
+                chipdata[chip].opn2_lastwritetime = TIM2->CNT - VGMP_OPN2BUSYDELAY;
+            }else{
+                chipdata[chip].opn2_lastwritetime = TIM2->CNT;
+            }
+        }
+        QueuePop(q);
+        VGM_Head_cmdNext(h, vgm_time);
+        Enqueue(h, vgm_time);
+        *progress = 1;
+    }
+    return 0xFFFFFFFF;
+}
+
 u16 VgmPlayer_WorkCallback(){
     ////////////////////////////////////////////////////////////////////////
     // PLAY VGMS
@@ -34,89 +218,74 @@ u16 VgmPlayer_WorkCallback(){
     u8 leds = MIOS32_BOARD_LED_Get();
     MIOS32_BOARD_LED_Set(0b1111, 0b0010);
     VgmHead* h;
-    u32 minwait = 0xFFFFFFFF; s32 s; u32 u;
-    u32 vgm_time = TIM5->CNT;
-    VgmChipWriteCmd cmd;
-    u8 wrotetochip, chip, subcmd;
-    //Scan all VGMs for delays
-    u8 i;
-    for(i=0; i<vgm_numheads; ++i){
-        h = vgm_heads[i];
-        if(h != NULL && h->playing){
-            //Check for delay
-            if(VGM_Head_cmdIsWait(h)){
-                s = VGM_Head_cmdGetWaitRemaining(h, vgm_time);
-                if(s <= 0){
-                    //Advance to next command
+    u32 minwait, u, start;
+    s32 s;
+    u32 vgm_time;
+    u8 progress, chip, type;
+    //Heads which are still due after being advanced, see below
+    VgmHead* deferred[VGM_HEAD_MAXNUM];
+    u8 numdeferred = 0;
+    while(1){
+        vgm_time = TIM5->CNT;
+        minwait = 0xFFFFFFFF;
+        do{
+            progress = 0;
+            //Advance the heads whose wait is over
+            while(heapsize > 0){
+                h = heap[0];
+                if((s32)(h->ticks - vgm_time) > 0) break;
+                HeapRemove(0);
+                if(!h->playing || h->isdone){
+                    //Head has been stopped: drop it, like ServiceQueue()
+                    //(HeapRemove() has set schedidx to VGMP_SCHED_NONE)
+                    continue;
+                }
+                if(!VGM_Head_cmdIsChipWrite(h)){
                     VGM_Head_cmdNext(h, vgm_time);
-                }else{
-                    u = s * VGMP_HRTICKSPERSAMPLE;
-                    if(u < minwait){
-                        //Store it as the shortest remaining time
-                        minwait = u;
+                    if(h->playing && !h->isdone && !VGM_Head_cmdIsChipWrite(h)
+                            && (s32)(h->ticks - vgm_time) <= 0){
+                        //Its time didn't advance (queue head busy, stream waiting
+                        //for its buffer, or behind schedule): leave it for the next
+                        //wakeup, else we'd spin here and the task which unblocks it
+                        //never runs
+                        deferred[numdeferred++] = h;
+                        continue;
                     }
                 }
+                Enqueue(h, vgm_time);
+                progress = 1;
             }
-        }
-    }
-    //Scan all VGMs for pending chip write commands
-    wrotetochip = 1;
-    while(wrotetochip){
-        wrotetochip = 0;
-        for(i=0; i<vgm_numheads; ++i){
-            h = vgm_heads[i];
-            if(h != NULL && h->playing){
-                //Check for command
-                if(VGM_Head_cmdIsChipWrite(h)){
-                    cmd = h->writecmd;
-                    chip = (cmd.cmd >> 4);
-                    subcmd = (cmd.cmd & 0x0F);
-                    if(chip >= GENESIS_COUNT || subcmd > 4 || subcmd == 1){
-                        VGM_Head_cmdNext(h, vgm_time);
-                        wrotetochip = 1;
-                    }else if(subcmd == 0){
-                        //PSG write
-                        u = TIM2->CNT - chipdata[chip].psg_lastwritetime;
-                        if(u < VGMP_PSGBUSYDELAY){
-                            u = VGMP_PSGBUSYDELAY - u;
-                            if(u < minwait){
-                                minwait = u;
-                            }
-                        }else{
-                            Genesis_PSGWrite(chip, cmd.data);
-                            VGM_Head_cmdNext(h, vgm_time);
-                            chipdata[chip].psg_lastwritetime = TIM2->CNT;
-                            wrotetochip = 1;
-                        }
-                    }else{
-                        //OPN2 write
-                        u = TIM2->CNT - chipdata[chip].opn2_lastwritetime;
-                        if(u < VGMP_OPN2BUSYDELAY){
-                            u = VGMP_OPN2BUSYDELAY - u;
-                            if(u < minwait){
-                                minwait = u;
-                            }
-                        }else{
-                            Genesis_OPN2Write(chip, (cmd.cmd & 0x01), cmd.addr, cmd.data);
-                            VGM_Head_cmdNext(h, vgm_time);
-                            //Don't delay after 0x2x commands
-                            if(cmd.addr >= 0x20 && cmd.addr < 0x2F && cmd.addr != 0x28){
-                                chipdata[chip].opn2_lastwritetime = TIM2->CNT - VGMP_OPN2BUSYDELAY;
-                            }else{
-                                chipdata[chip].opn2_lastwritetime = TIM2->CNT;
-                            }
-                            wrotetochip = 1;
-                        }
-                    }
+            //Write to the chips which are ready
+            minwait = 0xFFFFFFFF;
+            for(chip=0; chip<GENESIS_COUNT; ++chip){
+                for(type=0; type<2; ++type){
+                    u = ServiceQueue(chip, type, vgm_time, &progress);
+                    if(u < minwait) minwait = u;
                 }
             }
+        }while(progress);
+        //Time until the next head is due
+        if(heapsize > 0){
+            s = (s32)(heap[0]->ticks - vgm_time);
+            u = (s > 0) ? (s * VGMP_HRTICKSPERSAMPLE) : 0;
+            if(u < minwait) minwait = u;
+        }
+        if(numdeferred){
+            //Deferred heads are due right away
+            while(numdeferred){
+                h = deferred[--numdeferred];
+                HeapPush(h);
+            }
+            minwait = VGMP_MINDELAY;
+            break;
         }
+        if(minwait >= VGMP_MINDELAY) break;
+        //Too short to re-time the work timer, wait here
+        start = TIM2->CNT;
+        while(TIM2->CNT - start < minwait);
     }
     //Set up next delay
-    if(minwait < 100){
-        //TODO loop instead of returning and re-timing
-        minwait = 100;
-    }else if(minwait > VGMP_MAXDELAY){
+    if(minwait > VGMP_MAXDELAY){
         if(VGM_Player_docapture 
                 && (TIM2->CNT - lasttimecaptured >= 30000)
                 && (TIM2->CNT - chipdata[nextchiptocapture].opn2_lastwritetime >= VGMP_OPN2BUSYDELAY)){
@@ -128,7 +297,6 @@ u16 VgmPlayer_WorkCallback(){
         }
         minwait = VGMP_MAXDELAY;
     }
-    //minwait = 1000;
     MIOS32_BOARD_LED_Set(0b1111, leds);
     return minwait;
 }
@@ -188,6 +356,15 @@ void VGM_Player_Init(){
     TIM_ITConfig(TIM3, TIM_IT_Update, ENABLE); //Enable interrupts
     MIOS32_IRQ_Install(TIM3_IRQn, MIOS32_IRQ_PRIO_INSANE); //highest priority!
     TIM_Cmd(TIM3, ENABLE); //Start counting!
+    //Init scheduler
+    heapsize = 0;
+    u8 chip, type;
+    for(chip=0; chip<GENESIS_COUNT; ++chip){
+        for(type=0; type<2; ++type){
+            writequeues[chip][type].first = 0;
+            writequeues[chip][type].num = 0;
+        }
+    }
     //Init capture
     VGM_Player_docapture = 0;
     nextchiptocapture = 0;
@@ -14,6 +14,7 @@
 #define _VGMPLAYER_H
 
 #include <mios32.h>
+#include "vgmhead.h"
 
 #define USE_GENESIS 3 //TODO
 
@@ -24,6 +25,8 @@
 //#define VGMP_CHIPBUSYDELAY 850
 #define VGMP_PSGBUSYDELAY 672
 #define VGMP_OPN2BUSYDELAY 2100 //1512 or 2016?
+// Shorter delays (in hr_ticks) are waited for in the work callback itself
+#define VGMP_MINDELAY 100
 
 
 static inline u32 VGM_Player_GetHRTime() { return TIM2->CNT; }
@@ -32,6 +35,12 @@ static inline u32 VGM_Player_GetVGMTime() { return TIM5->CNT; }
 // Call at startup
 extern void VGM_Player_Init();
 
+// Call after a head has been started (playing = 1), or its ticks have been
+// changed outside of the player. VGM_Head_Restart() does this already.
+extern void VGM_Player_Schedule(VgmHead* head);
+// Called by VGM_Head_Delete()
+extern void VGM_Player_Remove(VgmHead* head);
+
 extern u8 VGM_Player_docapture;
 
 
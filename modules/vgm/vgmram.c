@@ -18,6 +18,7 @@
 #include "vgmtuning.h"
 #include "vgm_heap2.h"
 #include <genesis.h>
+#include <string.h>
 
 VgmHeadRAM* VGM_HeadRAM_Create(VgmSource* source){
     //VgmSourceRAM* vsr = (VgmSourceRAM*)source->data;
@@ -31,7 +32,7 @@ void VGM_HeadRAM_Delete(void* headram){
 }
 
 void VGM_HeadRAM_InternalCmdNext(VgmHead* head, VgmSourceRAM* vsr, VgmHeadRAM* vhr){
-    VgmChipWriteCmd cmd = vsr->cmds[head->srcaddr];
+    VgmChipWriteCmd cmd = *VGM_SourceRAM_cmdPtr(vsr, head->srcaddr);
     VGM_Head_doTransformations(head, &cmd);
     head->firstoftwo = VGM_Cmd_UnpackTwoByte(cmd, &cmd, &(vhr->bufferedcmd));
     VGM_Head_setWritecmd(head, cmd);
@@ -94,6 +95,8 @@ VgmSource* VGM_SourceRAM_Create(){
     source->data = vsr;
     vsr->cmds = NULL;
     vsr->numcmds = 0;
+    vsr->gapstart = 0;
+    vsr->gapsize = 0;
     return source;
 }
 void VGM_SourceRAM_Delete(void* sourceram){
@@ -109,35 +112,97 @@ void VGM_SourceRAM_UpdateUsage(VgmSource* source){
     source->usage.all = 0;
     u32 a;
     for(a=0; a<vsr->numcmds; ++a){
-        VGM_Cmd_UpdateUsage(&source->usage, vsr->cmds[a]);
+        VGM_Cmd_UpdateUsage(&source->usage, *VGM_SourceRAM_cmdPtr(vsr, a));
     }
     VGM_Cmd_DebugPrintUsage(source->usage);
 }
 
-void VGM_SourceRAM_InsertCmd(VgmSource* source, u32 addr, VgmChipWriteCmd newcmd){
+static u32 VGM_SourceRAM_GapTarget(VgmSourceRAM* vsr){
+    u32 gap = vsr->numcmds >> 3;
+    return (gap < VGM_SOURCERAM_GAP_MIN) ? VGM_SOURCERAM_GAP_MIN : gap;
+}
+
+//Copies the commands [from, from+count) to dst
+static void VGM_SourceRAM_CopyOut(VgmSourceRAM* vsr, VgmChipWriteCmd* dst, u32 from, u32 count){
+    if(from < vsr->gapstart){
+        u32 n = vsr->gapstart - from;
+        if(n > count) n = count;
+        memcpy(dst, &vsr->cmds[from], n*sizeof(VgmChipWriteCmd));
+        dst += n;
+        from += n;
+        count -= n;
+    }
+    if(count){
+        memcpy(dst, &vsr->cmds[from + vsr->gapsize], count*sizeof(VgmChipWriteCmd));
+    }
+}
+
+//Moves the data into a new array with a gap of newgap commands at addr
+static s32 VGM_SourceRAM_Resize(VgmSourceRAM* vsr, u32 addr, u32 newgap){
+    VgmChipWriteCmd* oldcmds = vsr->cmds;
+    VgmChipWriteCmd* newcmds = vgmh2_malloc((vsr->numcmds + newgap)*sizeof(VgmChipWriteCmd));
+    if(newcmds == NULL) return -1;
+    //Playback continues with the old array while the data is copied
+    VGM_SourceRAM_CopyOut(vsr, newcmds, 0, addr);
+    VGM_SourceRAM_CopyOut(vsr, &newcmds[addr + newgap], addr, vsr->numcmds - addr);
     MIOS32_IRQ_Disable();
-    VgmSourceRAM* vsr = (VgmSourceRAM*)source->data;
-    if(addr > vsr->numcmds) addr = vsr->numcmds;
-    //Allocate additional memory
-    vsr->cmds = vgmh2_realloc(vsr->cmds, (vsr->numcmds+1)*sizeof(VgmChipWriteCmd));
-    if(vsr->cmds == NULL){
-        DBG("Out of memory trying to enlarge VgmSourceRAM! Crashing soon!");
-        vsr->numcmds = 0;
-        MIOS32_IRQ_Enable();
+    vsr->cmds = newcmds;
+    vsr->gapstart = addr;
+    vsr->gapsize = newgap;
+    MIOS32_IRQ_Enable();
+    if(oldcmds != NULL){
+        vgmh2_free(oldcmds);
+    }
+    return 0;
+}
+
+//Moves the gap to addr, in slices so that playback is only blocked shortly
+static void VGM_SourceRAM_MoveGap(VgmSourceRAM* vsr, u32 addr){
+    u32 n;
+    if(vsr->gapsize == 0){
+        vsr->gapstart = addr;
         return;
     }
-    //Move later data
-    u32 a;
-    for(a=vsr->numcmds; a>addr; --a){
-        vsr->cmds[a].all = vsr->cmds[a-1].all;
+    while(vsr->gapstart != addr){
+        MIOS32_IRQ_Disable();
+        if(addr < vsr->gapstart){
+            n = vsr->gapstart - addr;
+            if(n > VGM_SOURCERAM_MOVE_SLICE) n = VGM_SOURCERAM_MOVE_SLICE;
+            vsr->gapstart -= n;
+            memmove(&vsr->cmds[vsr->gapstart + vsr->gapsize], &vsr->cmds[vsr->gapstart], n*sizeof(VgmChipWriteCmd));
+        }else{
+            n = addr - vsr->gapstart;
+            if(n > VGM_SOURCERAM_MOVE_SLICE) n = VGM_SOURCERAM_MOVE_SLICE;
+            memmove(&vsr->cmds[vsr->gapstart], &vsr->cmds[vsr->gapstart + vsr->gapsize], n*sizeof(VgmChipWriteCmd));
+            vsr->gapstart += n;
+        }
+        MIOS32_IRQ_Enable();
+    }
+}
+
+void VGM_SourceRAM_InsertCmd(VgmSource* source, u32 addr, VgmChipWriteCmd newcmd){
+    VgmSourceRAM* vsr = (VgmSourceRAM*)source->data;
+    if(addr > vsr->numcmds) addr = vsr->numcmds;
+    //Get a gap at addr
+    if(vsr->gapsize == 0){
+        if(VGM_SourceRAM_Resize(vsr, addr, VGM_SourceRAM_GapTarget(vsr)) < 0){
+            DBG("Out of memory trying to enlarge VgmSourceRAM!");
+            return;
+        }
+    }else{
+        VGM_SourceRAM_MoveGap(vsr, addr);
     }
-    //Insert new data
+    MIOS32_IRQ_Disable();
+    //Insert new data at the beginning of the gap
     vsr->cmds[addr] = newcmd;
+    ++vsr->gapstart;
+    --vsr->gapsize;
     //Change length
     ++vsr->numcmds;
     if(source->markstart >= addr && addr > 0) source->markstart++;
     if(source->markend >= addr && source->markend < 0xFFFFFFFF) source->markend++;
     //Move any heads playing this forward by one command
+    u32 a;
     VgmHead* head;
     for(a=0; a<VGM_HEAD_MAXNUM; ++a){
         head = vgm_heads[a];
@@ -148,21 +213,19 @@ void VGM_SourceRAM_InsertCmd(VgmSource* source, u32 addr, VgmChipWriteCmd newcmd
     MIOS32_IRQ_Enable();
 }
 void VGM_SourceRAM_DeleteCmd(VgmSource* source, u32 addr){
-    MIOS32_IRQ_Disable();
     VgmSourceRAM* vsr = (VgmSourceRAM*)source->data;
     if(addr >= vsr->numcmds) return;
-    //Move later data
-    u32 a;
-    for(a=addr; a<vsr->numcmds-1; ++a){
-        vsr->cmds[a].all = vsr->cmds[a+1].all;
-    }
+    //Let the gap begin after the command, and then add the command to the gap
+    VGM_SourceRAM_MoveGap(vsr, addr+1);
+    MIOS32_IRQ_Disable();
+    --vsr->gapstart;
+    ++vsr->gapsize;
     //Change length
     --vsr->numcmds;
     if(source->markstart > addr) source->markstart--;
     if(source->markend > addr && source->markend < 0xFFFFFFFF) source->markend--;
-    //Deallocate extra memory
-    vsr->cmds = vgmh2_realloc(vsr->cmds, vsr->numcmds*sizeof(VgmChipWriteCmd));
     //Move any heads playing this backward by one command
+    u32 a;
     VgmHead* head;
     for(a=0; a<VGM_HEAD_MAXNUM; ++a){
         head = vgm_heads[a];
@@ -171,6 +234,11 @@ void VGM_SourceRAM_DeleteCmd(VgmSource* source, u32 addr){
         }
     }
     MIOS32_IRQ_Enable();
+    //Deallocate extra memory if the gap got much larger than needed
+    u32 gap = VGM_SourceRAM_GapTarget(vsr);
+    if(vsr->gapsize > 4*gap){
+        VGM_SourceRAM_Resize(vsr, vsr->gapstart, gap);
+    }
 }
 
 //Turn DAC and Wait command into regular OPN2 chip write to DAC
@@ -193,7 +261,7 @@ s32 VGM_HeadRAM_Forward1(VgmHead* head){
         return -1;
     }
     //Play the current command, which should be buffered in head->writecmd
-    PlayCommandNow(head, vsr, vhr, vsr->cmds[head->srcaddr]);
+    PlayCommandNow(head, vsr, vhr, *VGM_SourceRAM_cmdPtr(vsr, head->srcaddr));
     //Forward one command
     ++head->srcaddr;
     //If we would now be going off the end, don't loop back
@@ -218,14 +286,14 @@ s32 VGM_HeadRAM_Backward1(VgmHead* head){
     --head->srcaddr;
     head->isdone = 0;
     VgmChipWriteCmd curcmd;
-    curcmd.all = vsr->cmds[head->srcaddr].all;
+    curcmd.all = VGM_SourceRAM_cmdPtr(vsr, head->srcaddr)->all;
     //Find the most recent command before this one, which this one overwrote the state of
     s32 a; u8 flag = 0;
     VgmChipWriteCmd oldcmd;
     FixDACWrite(curcmd);
     if(curcmd.cmd == 0x50){
         for(a=(s32)head->srcaddr-1; a>=0; --a){
-            oldcmd = vsr->cmds[a];
+            oldcmd = *VGM_SourceRAM_cmdPtr(vsr, a);
             //Has to be PSG Write command
             if(oldcmd.cmd != 0x50) continue;
             //Has to be the same address
@@ -252,7 +320,7 @@ s32 VGM_HeadRAM_Backward1(VgmHead* head){
         }
     }else if((curcmd.cmd & 0xFE) == 0x52){
         for(a=(s32)head->srcaddr-1; a>=0; --a){
-            oldcmd = vsr->cmds[a];
+            oldcmd = *VGM_SourceRAM_cmdPtr(vsr, a);
             FixDACWrite(oldcmd);
             //Has to be OPN2 Write command with the same addrhi
             if(oldcmd.cmd != curcmd.cmd) continue;
@@ -315,7 +383,7 @@ s32 VGM_HeadRAM_ForwardState(VgmHead* head, u32 maxt, u32 maxdt, u8 allowstay){
     u32 totalt = 0, thist;
     u32 origsrcaddr = head->srcaddr;
     while(head->srcaddr < vsr->numcmds){
-        cmd = vsr->cmds[head->srcaddr];
+        cmd = *VGM_SourceRAM_cmdPtr(vsr, head->srcaddr);
         thist = VGM_Cmd_GetWaitValue(cmd);
         if(state == 0){
             if(thist == 0 || (cmd.cmd >= 0x80 && cmd.cmd <= 0x8F)){
@@ -350,7 +418,7 @@ s32 VGM_HeadRAM_BackwardState(VgmHead* head, u32 maxt, u32 maxdt){
     u32 totalt = 0, thist;
     u32 origsrcaddr = head->srcaddr;
     while(head->srcaddr > 0){
-        cmd = vsr->cmds[head->srcaddr-1];
+        cmd = *VGM_SourceRAM_cmdPtr(vsr, head->srcaddr-1);
         thist = VGM_Cmd_GetWaitValue(cmd);
         if(state == 0){
             totalt += thist;
@@ -15,6 +15,13 @@
  * PSG write (same for frequency command), sample+wait (0x80-0x8F, except the
  * actual command for the sample write is in addr and data), and all the timing
  * comamnds. All other commands are ignored.
+ *
+ * The commands are stored in a gap buffer: the unused space of the array is
+ * kept at the last edit point, so inserting or deleting commands near it only
+ * moves the commands between the old and the new edit point, and the array is
+ * only reallocated when the gap is used up. Heads and marks address commands
+ * by their index in the sequence (without gap), so they don't depend on the
+ * position of the gap; use VGM_SourceRAM_cmdPtr() to access a command.
  */
 
 #ifndef _VGMRAM_H
@@ -24,6 +31,19 @@
 #include "vgmsource.h"
 #include "vgmhead.h"
 
+// minimum size of the gap (in commands) which is allocated when the gap is
+// used up. The gap grows with 1/8 of the sequence length, so that inserts are
+// amortised O(1)
+#ifndef VGM_SOURCERAM_GAP_MIN
+#define VGM_SOURCERAM_GAP_MIN 32
+#endif
+
+// maximum number of commands which are moved with interrupts disabled while
+// the gap is moved to a new edit point
+#ifndef VGM_SOURCERAM_MOVE_SLICE
+#define VGM_SOURCERAM_MOVE_SLICE 16
+#endif
+
 typedef union {
     u8 ALL[4];
     struct{
@@ -43,13 +63,17 @@ extern s32 VGM_HeadRAM_ForwardState(VgmHead* head, u32 maxt, u32 maxdt, u8 allow
 extern s32 VGM_HeadRAM_BackwardState(VgmHead* head, u32 maxt, u32 maxdt);
 
 typedef union {
-    u8 ALL[8];
+    u8 ALL[16];
     struct{
         VgmChipWriteCmd* cmds;
-        u32 numcmds;
+        u32 numcmds;  //Number of commands, without gap
+        u32 gapstart; //Index in cmds where the gap begins
+        u32 gapsize;  //Number of unused entries at gapstart
     };
 } VgmSourceRAM;
 
+static inline VgmChipWriteCmd* VGM_SourceRAM_cmdPtr(VgmSourceRAM* vsr, u32 addr) { return &vsr->cmds[(addr < vsr->gapstart) ? addr : (addr + vsr->gapsize)]; }
+
 extern VgmSource* VGM_SourceRAM_Create();
 extern void VGM_SourceRAM_Delete(void* sourceram);
 
@@ -13,6 +13,7 @@
 #include "vgmtracker.h"
 
 #include "vgmhead.h"
+#include "vgmplayer.h"
 #include "vgmqueue.h"
 #include "vgmtuning.h"
 #include <genesis.h>
@@ -57,6 +58,7 @@ void VGM_Tracker_Init(){
     qsource->psgclock = genesis_clock_psg;
     qhead = VGM_Head_Create(qsource, 0x1000, 0x1000, 0);
     qhead->playing = 1;
+    VGM_Player_Schedule(qhead);
     u8 i;
     for(i=0; i<10*GENESIS_COUNT; ++i){
         trackervoicekeys[i] = -1;
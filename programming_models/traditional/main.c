@@ -259,6 +259,11 @@ static void TASK_MIDI_Hooks(void *pvParameters)
     // optional application specific hook
     // helps to save memory (re-use the TASK_Hooks for other purposes...)
     APP_MIDI_Tick();
+
+#if MIOS32_MIDI_OUT_RING_SIZE
+    // forward packages which have been queued with MIOS32_MIDI_SendPackage_Queued()
+    MIOS32_MIDI_OutRing_Handler();
+#endif
   }
 }
 #endif
@@ -252,6 +252,45 @@ void BlmClass::setLedPattern8_V(const int& col, const int& rowOffset, const int&
     }
 }
 
+// decodes the payload of a LED block SysEx (command 0x02):
+// <flags> <first row> <number of rows> followed by a bitstream which contains
+// 16 green and 16 red LEDs for each row (LSB first), packed into 7bit bytes
+void BlmClass::setLedBlock(const uint8 *data, int size)
+{
+    if( size < 3 )
+        return;
+
+    bool rotated = (data[0] & 0x01) != 0;
+    int firstRow = data[1];
+    int numRows = data[2];
+    const uint8 *ptr = &data[3];
+    const uint8 *endPtr = &data[size];
+
+    unsigned int bits = 0;
+    int numBits = 0;
+    for(int row=firstRow; row<(firstRow+numRows); ++row) {
+        for(int colourIx=0; colourIx<2; ++colourIx) {
+            while( numBits < 16 ) {
+                if( ptr >= endPtr )
+                    return; // incomplete block
+                bits |= (unsigned int)*ptr++ << numBits;
+                numBits += 7;
+            }
+
+            if( rotated ) {
+                setLedPattern8_V(row, 0, colourIx, bits & 0xff);
+                setLedPattern8_V(row, 8, colourIx, (bits >> 8) & 0xff);
+            } else {
+                setLedPattern8_H(0, row, colourIx, bits & 0xff);
+                setLedPattern8_H(8, row, colourIx, (bits >> 8) & 0xff);
+            }
+
+            bits >>= 16;
+            numBits -= 16;
+        }
+    }
+}
+
 
 //==============================================================================
 void BlmClass::handleIncomingMidiMessage(MidiInput *source, const MidiMessage &message)
@@ -376,6 +415,9 @@ void BlmClass::BLMIncomingMidiMessage(const MidiMessage &message, uint8 RunningS
             if( data[6] == 0x00 && data[7] == 0x00 ) {
                 // no error checking... just send layout (the hardware version will check better)
                 sendBLMLayout();
+            } else if( data[6] == 0x02 ) {
+                setLedBlock(&data[7], size-8); // without F7
+                midiDataReceived = true;
             } else if( data[6] == 0x0f && data[7] == 0xf7 ) {
                 sendAck();
             }
@@ -455,7 +497,7 @@ void BlmClass::setBLMLayout(const String& layout)
 
 void BlmClass::sendBLMLayout(void)
 {
-	unsigned char sysex[14];
+	unsigned char sysex[15];
 	sysex[0] = 0xf0;
 	sysex[1] = 0x00;
 	sysex[2] = 0x00;
@@ -469,8 +511,9 @@ void BlmClass::sendBLMLayout(void)
 	sysex[10] = 1; // number of extra rows
 	sysex[11] = 1; // number of extra columns
 	sysex[12] = 1; // number of extra buttons (e.g. shift)
-	sysex[13] = 0xf7;
-	MidiMessage message(sysex,14);
+	sysex[13] = 0x01; // supported features: LED block SysEx
+	sysex[14] = 0xf7;
+	MidiMessage message(sysex,15);
     mainComponent->sendMidiMessage(message);
 }
 
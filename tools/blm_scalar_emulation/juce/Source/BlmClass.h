@@ -58,6 +58,7 @@ public:
     void setLed(const int& col, const int& row, const int& colourIx, const int& enabled);
     void setLedPattern8_H(const int& colOffset, const int& row, const int& colourIx, const unsigned char& pattern);
     void setLedPattern8_V(const int& col, const int& rowOffset, const int& colourIx, const unsigned char& pattern);
+    void setLedBlock(const uint8 *data, int size);
 
 	void setBLMLayout(const String& layout);
 
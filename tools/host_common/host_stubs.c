@@ -0,0 +1,62 @@
+// $Id$
+/*
+ * Default implementations of the MIOS32 functions which are referenced by
+ * the modules and applications compiled into the host tools, but not
+ * available on the host.
+ *
+ * All functions are declared as weak, so that a tool (or a linked MIOS32
+ * source file) can overrule them with its own version, e.g. to count the
+ * sent packages or to print the debug messages.
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#include <mios32.h>
+
+
+/////////////////////////////////////////////////////////////////////////////
+// System
+/////////////////////////////////////////////////////////////////////////////
+
+__attribute__ ((weak)) s32 MIOS32_SYS_Reset(void) { return 0; }
+__attribute__ ((weak)) u32 MIOS32_SYS_ChipIDGet(void) { return 0; }
+__attribute__ ((weak)) u32 MIOS32_SYS_FlashSizeGet(void) { return 0; }
+__attribute__ ((weak)) u32 MIOS32_SYS_RAMSizeGet(void) { return 0; }
+__attribute__ ((weak)) s32 MIOS32_SYS_SerialNumberGet(char *str) { str[0] = 0; return 0; }
+
+__attribute__ ((weak)) mios32_sys_time_t MIOS32_SYS_TimeGet(void)
+{
+  mios32_sys_time_t t = { .seconds = 0, .fraction_ms = 0 };
+  return t;
+}
+
+// the tools run single threaded, there are no interrupts to disable
+__attribute__ ((weak)) s32 MIOS32_IRQ_Disable(void) { return 0; }
+__attribute__ ((weak)) s32 MIOS32_IRQ_Enable(void) { return 0; }
+
+__attribute__ ((weak)) s32 MIOS32_STOPWATCH_Reset(void) { return 0; }
+__attribute__ ((weak)) u32 MIOS32_STOPWATCH_ValueGet(void) { return 0; }
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Board and shift registers
+/////////////////////////////////////////////////////////////////////////////
+
+__attribute__ ((weak)) u32 MIOS32_BOARD_LED_Get(void) { return 0; }
+__attribute__ ((weak)) s32 MIOS32_BOARD_LED_Set(u32 leds, u32 value) { return 0; }
+__attribute__ ((weak)) s32 MIOS32_DOUT_PinSet(u32 pin, u32 value) { return 0; }
+
+
+/////////////////////////////////////////////////////////////////////////////
+// MIDI: no interfaces, packages and debug messages are dropped
+/////////////////////////////////////////////////////////////////////////////
+
+__attribute__ ((weak)) s32 MIOS32_MIDI_CheckAvailable(mios32_midi_port_t port) { return 0; }
+__attribute__ ((weak)) s32 MIOS32_MIDI_SendPackage(mios32_midi_port_t port, mios32_midi_package_t package) { return 0; }
+__attribute__ ((weak)) s32 MIOS32_MIDI_SendDebugMessage(const char *format, ...) { return 0; }
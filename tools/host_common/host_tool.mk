@@ -0,0 +1,53 @@
+# $Id$
+# Common part of the Makefiles of the host tools in $(MIOS32_PATH)/tools
+#
+# The Makefile of a tool sets following variables before including this file:
+#   PROGRAM      name of the executable
+#   OBJS         object files of the tool, the sources are searched in the
+#                tool directory and in the directories listed in SRC_PATHS
+#   SRC_PATHS    additional source directories (optional)
+#   TOOL_FLAGS   additional include paths and defines (optional)
+#   TOOL_LIBS    additional libraries (optional)
+#   LINK         $(CXX) if C++ sources are linked (optional)
+#
+# Rules for special objects (e.g. a source compiled twice with different
+# defines) can be added after the include statement.
+#
+# The tools are compiled with -Wall and are expected to be warning-clean:
+# fix the warning instead of disabling it.
+
+HOST_COMMON_PATH = $(MIOS32_PATH)/tools/host_common
+
+VFLAGS = -O2 -Wall
+
+# the tool directory comes first, so that its mios32_config.h is used
+MIOS32FLAGS = -I . $(TOOL_FLAGS) -I $(HOST_COMMON_PATH) -I $(MIOS32_PATH)/include/mios32 -D MIOS32_FAMILY_EMULATION
+
+CC  = gcc $(VFLAGS) $(MIOS32FLAGS)
+CXX = g++ $(VFLAGS) $(MIOS32FLAGS)
+LINK ?= $(CC)
+
+# default implementations of common MIOS32 functions, see host_stubs.c
+OBJS += host_stubs.o
+
+vpath %.c   . $(SRC_PATHS) $(HOST_COMMON_PATH)
+vpath %.cpp . $(SRC_PATHS)
+vpath %.cc  . $(SRC_PATHS)
+
+current: all
+
+all: Makefile $(OBJS)
+	$(LINK) $(OBJS) $(TOOL_LIBS) -o $(PROGRAM)
+
+%.o: %.c Makefile
+	$(CC) -c $< -o $@
+
+%.o: %.cpp Makefile
+	$(CXX) -c $< -o $@
+
+%.o: %.cc Makefile
+	$(CXX) -c $< -o $@
+
+clean:
+	rm -f *.o
+	rm -f $(PROGRAM)
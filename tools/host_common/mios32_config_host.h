@@ -0,0 +1,26 @@
+// $Id$
+/*
+ * Common MIOS32 configuration of the host tools
+ * Included at the end of the mios32_config.h file of a tool
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef _MIOS32_CONFIG_HOST_H
+#define _MIOS32_CONFIG_HOST_H
+
+// returned on a SysEx query
+#ifndef MIOS32_BOARD_STR
+#define MIOS32_BOARD_STR   "HOST"
+#endif
+#ifndef MIOS32_FAMILY_STR
+#define MIOS32_FAMILY_STR  "EMULATION"
+#endif
+
+#endif /* _MIOS32_CONFIG_HOST_H */
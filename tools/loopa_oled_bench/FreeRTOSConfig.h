@@ -0,0 +1,20 @@
+// Host replacement of the FreeRTOS configuration for the OLED benchmark
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#define configUSE_PREEMPTION          1
+#define configUSE_IDLE_HOOK           0
+#define configUSE_TICK_HOOK           0
+#define configCPU_CLOCK_HZ            1
+#define configTICK_RATE_HZ            1000
+#define configMAX_PRIORITIES          5
+#define configMINIMAL_STACK_SIZE      128
+#define configMAX_TASK_NAME_LEN       16
+#define configUSE_16_BIT_TICKS        0
+#define configIDLE_SHOULD_YIELD       1
+#define configUSE_MUTEXES             1
+#define configUSE_RECURSIVE_MUTEXES   1
+#define INCLUDE_vTaskDelay            1
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,237 @@
+// LoopA OLED benchmark
+// See README.txt for details
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <mios32.h>
+#include "commonIncludes.h"
+#include "app.h"
+#include "loopa.h"
+#include "screen.h"
+#include "setup.h"
+#include "ui.h"
+
+// -------------------------------------------------------------------------------------------
+
+#define FRAMES 1000      // frames rendered per page
+#define TICKS_PER_FRAME 8 // sequencer ticks per frame (384 ppqn at 120 bpm -> one frame every 10ms)
+
+typedef struct
+{
+   const char *name;
+   enum LoopAPage page;
+   u8 menu;
+   u8 screensaver;
+} BenchPage;
+
+static const BenchPage benchPages_[] =
+{
+   { "Mute (clips)",  PAGE_MUTE,        0, 0 },
+   { "Clip",          PAGE_CLIP,        0, 0 },
+   { "Notes",         PAGE_NOTES,       0, 0 },
+   { "Track",         PAGE_TRACK,       0, 0 },
+   { "Tempo",         PAGE_TEMPO,       0, 0 },
+   { "Router",        PAGE_ROUTER,      0, 0 },
+   { "Setup",         PAGE_SETUP,       0, 0 },
+   { "MIDI Monitor",  PAGE_MIDIMONITOR, 0, 0 },
+   { "Live FX",       PAGE_LIVEFX,      0, 0 },
+   { "Disk",          PAGE_DISK,        0, 0 },
+   { "Menu",          PAGE_MUTE,        1, 0 },
+   { "Screensaver",   PAGE_MUTE,        0, 1 },
+};
+
+// -------------------------------------------------------------------------------------------
+// Display transport: counts the bytes, and emulates the SSD1322 display RAM
+// (column/row address windows and the write RAM command), so that the content
+// can be compared with the frame that has been rendered
+
+extern u8 screenSent_[64][128];
+
+static u32 busBytes_;
+static u32 busBlocks_;
+
+static u8 ram_[64][128];
+static u8 cmd_;
+static u8 args_[2];
+static u8 argCount_;
+static u8 colStart_ = 0x1c, colEnd_ = 0x5b, rowStart_ = 0, rowEnd_ = 0x3f;
+static u8 col_, row_, colByte_;
+
+s32 APP_LCD_Cmd(u8 cmd)
+{
+   busBytes_++;
+
+   cmd_ = cmd;
+   argCount_ = 0;
+   if (cmd == 0x5c)
+   {
+      col_ = colStart_;
+      row_ = rowStart_;
+      colByte_ = 0;
+   }
+   return 0;
+}
+
+s32 APP_LCD_Data(u8 data)
+{
+   busBytes_++;
+
+   if (cmd_ == 0x5c)
+   {
+      if (col_ >= 0x1c && col_ <= 0x5b && row_ < 64)
+         ram_[row_][(col_ - 0x1c) * 2 + colByte_] = data;
+
+      if (++colByte_ == 2)
+      {
+         colByte_ = 0;
+         if (col_++ == colEnd_)
+         {
+            col_ = colStart_;
+            row_ = (row_ == rowEnd_) ? rowStart_ : row_ + 1;
+         }
+      }
+   }
+   else if (argCount_ < 2)
+   {
+      args_[argCount_++] = data;
+      if (argCount_ == 2)
+      {
+         if (cmd_ == 0x15)
+         {
+            colStart_ = args_[0];
+            colEnd_ = args_[1];
+         }
+         else if (cmd_ == 0x75)
+         {
+            rowStart_ = args_[0];
+            rowEnd_ = args_[1];
+         }
+      }
+   }
+   return 0;
+}
+
+s32 APP_LCD_DataBlock(u8 *data, u32 len)
+{
+   u32 i;
+
+   busBlocks_++;
+   for (i = 0; i < len; i++)
+      APP_LCD_Data(data[i]);
+   return 0;
+}
+// -------------------------------------------------------------------------------------------
+
+
+/**
+ * Fill all clips of the first scene with random notes
+ *
+ */
+static void setupClips()
+{
+   u8 t;
+   u16 n;
+
+   for (t = 0; t < TRACKS; t++)
+   {
+      clipSteps_[t][0] = 16 << (t % 3);
+      clipNotesSize_[t][0] = 8 + 8 * t;
+
+      for (n = 0; n < clipNotesSize_[t][0]; n++)
+      {
+         NoteData *note = &clipNotes_[t][0][n];
+         note->tick = rand() % (clipSteps_[t][0] * 96);
+         note->length = 48 + rand() % 192;
+         note->note = 36 + rand() % 48;
+         note->velocity = 40 + rand() % 88;
+      }
+
+      invalidateClipIndex(t);
+   }
+}
+// -------------------------------------------------------------------------------------------
+
+
+/**
+ * Render a page for FRAMES frames, and return the average number of bytes per frame
+ *
+ * fullRefresh: 1 to send every frame completely, like before the differential push
+ * errors: incremented for each frame where the display RAM doesn't match the rendered frame
+ *
+ */
+static u32 benchPage(const BenchPage *p, u8 fullRefresh, u32 *blocks, u32 *errors)
+{
+   u32 frame;
+
+   srand(1);
+   tick_ = 0;
+   inactivitySeconds_ = p->screensaver ? 3600 : 0;
+   screenShowMenu(p->menu);
+   setActivePage(p->page);
+
+   screenForceFullRefresh();
+   busBytes_ = 0;
+   busBlocks_ = 0;
+
+   for (frame = 0; frame < FRAMES; frame++)
+   {
+      tick_ += TICKS_PER_FRAME;
+
+      // MIDI monitor: a few events per frame
+      if (p->page == PAGE_MIDIMONITOR && (frame % 10) == 0)
+      {
+         mios32_midi_package_t package = { .type = NoteOn, .event = NoteOn, .chn = Chn1, .note = 36 + rand() % 48, .velocity = 100 };
+         MIDIMonitorAddLog(rand() % 2, UART0, package);
+      }
+
+      if (fullRefresh)
+         screenForceFullRefresh();
+
+      display();
+
+      if (memcmp(ram_, screenSent_, sizeof(ram_)) != 0)
+         (*errors)++;
+   }
+
+   *blocks = busBlocks_ / FRAMES;
+   return busBytes_ / FRAMES;
+}
+// -------------------------------------------------------------------------------------------
+
+
+int main(int argc, char *argv[])
+{
+   u8 i;
+
+   seqInit();
+   loopaStartup(); // initializes the voxel space
+   screenShowLoopaLogo(0);
+   setupClips();
+
+   printf("Bytes sent to the SSD1322 per frame (%d frames per page, %d ticks per frame):\n\n", FRAMES, TICKS_PER_FRAME);
+   printf("  %-14s %10s %12s %8s %12s\n", "Page", "full push", "differential", "ratio", "data blocks");
+
+   u32 totalFull = 0, totalDiff = 0, errors = 0;
+   for (i = 0; i < sizeof(benchPages_) / sizeof(benchPages_[0]); i++)
+   {
+      u32 blocks;
+      u32 full = benchPage(&benchPages_[i], 1, &blocks, &errors);
+      u32 diff = benchPage(&benchPages_[i], 0, &blocks, &errors);
+
+      printf("  %-14s %10lu %12lu %7.1f%% %12lu\n", benchPages_[i].name, full, diff, 100.0 * diff / full, blocks);
+      totalFull += full;
+      totalDiff += diff;
+   }
+
+   printf("\n  %-14s %10lu %12lu %7.1f%%\n", "Average", totalFull / i, totalDiff / i, 100.0 * totalDiff / totalFull);
+
+   if (errors)
+      printf("\nERROR: display RAM didn't match the rendered frame in %lu frames\n", errors);
+   else
+      printf("\nDisplay RAM matched the rendered frame after every frame\n");
+
+   return errors ? 1 : 0;
+}
+// -------------------------------------------------------------------------------------------
@@ -0,0 +1,34 @@
+// Host replacement of the FreeRTOS port header, only the types and macros
+// needed to compile the LoopA sources for the OLED benchmark
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#define portCHAR        char
+#define portFLOAT       float
+#define portDOUBLE      double
+#define portLONG        long
+#define portSHORT       short
+#define portSTACK_TYPE  unsigned long
+#define portBASE_TYPE   long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef unsigned long TickType_t;
+typedef unsigned long portTickType;
+
+#define portMAX_DELAY        0xffffffff
+#define portBYTE_ALIGNMENT   8
+#define portSTACK_GROWTH     -1
+#define portTICK_PERIOD_MS   1
+#define portTICK_RATE_MS     portTICK_PERIOD_MS
+
+#define portYIELD()
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portNOP()
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters) void vFunction(void *pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters) void vFunction(void *pvParameters)
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,92 @@
+// LoopA OLED benchmark: host stubs for the modules used by the LoopA sources
+// (the MIOS32 functions are provided by tools/host_common/host_stubs.c)
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <mios32.h>
+#include "commonIncludes.h"
+#include "app.h"
+
+// -------------------------------------------------------------------------------------------
+// Application globals (app.c isn't linked)
+
+enum HardwareMode hw_enabled = HARDWARE_LOOPA_OPERATIONAL;
+
+// -------------------------------------------------------------------------------------------
+// FreeRTOS and tasks
+
+void vPortEnterCritical(void) {}
+void vPortExitCritical(void) {}
+void *pvPortMalloc(size_t size) { return malloc(size); }
+void vPortFree(void *pv) { free(pv); }
+
+void TASKS_SDCardSemaphoreTake(void) {}
+void TASKS_SDCardSemaphoreGive(void) {}
+void TASKS_DigitalOutSemaphoreTake(void) {}
+void TASKS_DigitalOutSemaphoreGive(void) {}
+
+// -------------------------------------------------------------------------------------------
+// Sequencer BPM generator: always running, ticks are advanced by the benchmark
+
+static float bpm = 120.0;
+static u16 ppqn = 384;
+
+s32 SEQ_BPM_Init(u32 mode) { return 0; }
+float SEQ_BPM_Get(void) { return bpm; }
+s32 SEQ_BPM_Set(float _bpm) { bpm = _bpm; return 0; }
+s32 SEQ_BPM_PPQN_Get(void) { return ppqn; }
+s32 SEQ_BPM_PPQN_Set(u16 _ppqn) { ppqn = _ppqn; return 0; }
+s32 SEQ_BPM_IsRunning(void) { return 1; }
+s32 SEQ_BPM_IsMaster(void) { return 1; }
+s32 SEQ_BPM_CheckAutoMaster(void) { return 0; }
+s32 SEQ_BPM_Start(void) { return 0; }
+s32 SEQ_BPM_Stop(void) { return 0; }
+u32 SEQ_BPM_TickGet(void) { return 0; }
+s32 SEQ_BPM_TickSet(u32 tick) { return 0; }
+s32 SEQ_BPM_ChkReqClk(u32 *bpm_tick_ptr) { return 0; }
+s32 SEQ_BPM_ChkReqCont(void) { return 0; }
+s32 SEQ_BPM_ChkReqSongPos(u16 *song_pos) { return 0; }
+s32 SEQ_BPM_ChkReqStart(void) { return 0; }
+s32 SEQ_BPM_ChkReqStop(void) { return 0; }
+
+// -------------------------------------------------------------------------------------------
+// MIDI ports and router: four UART ports
+
+midi_router_node_entry_t midi_router_node[MIDI_ROUTER_NUM_NODES];
+u32 midi_router_mclk_in;
+u32 midi_router_mclk_out;
+
+s32 MIDI_PORT_InNumGet(void) { return 4; }
+s32 MIDI_PORT_OutNumGet(void) { return 4; }
+mios32_midi_port_t MIDI_PORT_InPortGet(u8 port_ix) { return UART0 + port_ix; }
+mios32_midi_port_t MIDI_PORT_OutPortGet(u8 port_ix) { return UART0 + port_ix; }
+u8 MIDI_PORT_InIxGet(mios32_midi_port_t port) { return port - UART0; }
+u8 MIDI_PORT_OutIxGet(mios32_midi_port_t port) { return port - UART0; }
+
+static char portName[8];
+char *MIDI_PORT_InNameGet(u8 port_ix) { sprintf(portName, "IN%d ", port_ix + 1); return portName; }
+char *MIDI_PORT_OutNameGet(u8 port_ix) { sprintf(portName, "OUT%d", port_ix + 1); return portName; }
+
+mios32_midi_package_t MIDI_PORT_InPackageGet(mios32_midi_port_t port) { mios32_midi_package_t p = { .ALL = 0 }; return p; }
+mios32_midi_package_t MIDI_PORT_OutPackageGet(mios32_midi_port_t port) { mios32_midi_package_t p = { .ALL = 0 }; return p; }
+
+s32 MIDI_ROUTER_MIDIClockInGet(mios32_midi_port_t port) { return 1; }
+s32 MIDI_ROUTER_MIDIClockInSet(mios32_midi_port_t port, u8 enable) { return 0; }
+s32 MIDI_ROUTER_MIDIClockOutGet(mios32_midi_port_t port) { return 1; }
+s32 MIDI_ROUTER_MIDIClockOutSet(mios32_midi_port_t port, u8 enable) { return 0; }
+s32 MIDI_ROUTER_NodesChanged(void) { return 0; }
+s32 MIDI_ROUTER_SendMIDIClockEvent(u8 evnt0, u32 bpm_tick) { return 0; }
+
+// -------------------------------------------------------------------------------------------
+// SD card: not available
+
+s32 FILE_FileExists(char *filepath) { return 0; }
+s32 FILE_ReadOpen(file_t* file, char *filepath) { return -1; }
+s32 FILE_ReadClose(file_t *file) { return 0; }
+s32 FILE_ReadBuffer(u8 *buffer, u32 len) { return -1; }
+s32 FILE_ReadLine(u8 *buffer, u32 max_len) { return 0; }
+s32 FILE_WriteOpen(char *filepath, u8 create) { return -1; }
+s32 FILE_WriteClose(void) { return 0; }
+s32 FILE_WriteBuffer(u8 *buffer, u32 len) { return -1; }
+s32 FILE_WriteByte(u8 byte) { return -1; }
@@ -0,0 +1,269 @@
+/*
+ * MIDIbox Quad Genesis: Voice allocation test
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+#include <mios32.h>
+#include "syeng.h"
+#include "stubs.h"
+
+#define NUM_STREAMS   50     //Random note streams
+#define STREAM_LENGTH 20000  //Events per stream
+#define NUM_PROGRAMS  16     //One per MIDI channel
+#define NUM_SATURATED 200000 //Note ons with all voices and proginstances in use
+
+static u8 verbose;
+
+int Harness_DebugMessage(const char *format, ...){
+    if(!verbose) return 0;
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Programs with all kinds of usage, so every path in AllocatePI gets exercised
+////////////////////////////////////////////////////////////////////////////////
+
+static VgmUsageBits RandomUsage(){
+    VgmUsageBits u = {.all = 0};
+    switch(rand() % 14){
+        case 0: u.fm1 = 1; break;
+        case 1: u.fm1 = 1; u.fm2 = 1; break;
+        case 2: u.fm1 = 1; u.fm2 = 1; u.fm3 = 1; u.fm4 = 1; break;
+        case 3: u.fm1 = 1; u.fm1_lfo = 1; u.lfomode = 1; u.lfofixedspeed = 1 + rand() % 7; break;
+        case 4: u.fm1 = 1; u.fm2 = 1; u.fm1_lfo = 1; u.fm2_lfo = 1; u.lfomode = 2; break;
+        case 5: u.fm6 = 1; u.dac = 1; break;
+        case 6: u.fm6 = 1; u.dac = 1; u.fm6_lfo = 1; u.lfomode = 2; break;
+        case 7: u.fm3 = 1; u.fm3_special = 1; break;
+        case 8: u.opn2_globals = 1; u.all |= 0x3F; break;
+        case 9: u.sq1 = 1; break;
+        case 10: u.sq1 = 1; u.sq2 = 1; break;
+        case 11: u.noise = 1; break;
+        case 12: u.sq3 = 1; u.noise = 1; u.noisefreqsq3 = 1; break;
+        default: u.fm1 = 1; u.sq1 = 1; u.noise = 1; break;
+    }
+    return u;
+}
+
+static synprogram_t programs[NUM_PROGRAMS];
+static VgmSource* source;
+
+static void SetupPrograms(){
+    u8 c;
+    for(c=0; c<NUM_PROGRAMS; ++c){
+        synprogram_t* prog = &programs[c];
+        memset(prog, 0, sizeof(synprogram_t));
+        prog->usage = RandomUsage();
+        prog->initsource = (rand() & 1) ? source : NULL;
+        prog->noteonsource = source;
+        prog->noteoffsource = (rand() & 1) ? source : NULL;
+        prog->rootnote = 60;
+        channels[c].program = prog;
+        channels[c].trackermode = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Checks that the free voice bitmaps match the voice use
+////////////////////////////////////////////////////////////////////////////////
+
+static s32 CheckFreeVoices(){
+    u8 g, v;
+    for(g=0; g<GENESIS_COUNT; ++g){
+        for(v=0; v<12; ++v){
+            if(((syngenesis[g].freevoices >> v) & 1) != (syngenesis[g].channels[v].use == 0)){
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Random events, with the same probabilities for every stream
+////////////////////////////////////////////////////////////////////////////////
+
+static u32 RunStream(u32 stream){
+    u8 held[16][128];
+    u8 staticpis[8];
+    u8 numstatic = 0;
+    u32 i, r, errors = 0;
+    u8 chn, note, g, v;
+    memset(held, 0, sizeof(held));
+    SetupPrograms();
+    for(i=0; i<STREAM_LENGTH; ++i){
+        mios32_midi_package_t pkg = {.ALL = 0};
+        r = rand() % 1000;
+        chn = rand() % NUM_PROGRAMS;
+        note = 36 + rand() % 48;
+        pkg.chn = chn;
+        pkg.note = note;
+        pkg.velocity = 1 + rand() % 127;
+        if(r < 450){
+            SyEng_Note_On(pkg);
+            held[chn][note] = 1;
+        }else if(r < 850){
+            //Release a held note if there is one on this channel
+            for(note=0; note<128; ++note) if(held[chn][note]) break;
+            if(note < 128){
+                pkg.note = note;
+                SyEng_Note_Off(pkg);
+                held[chn][note] = 0;
+            }
+        }else if(r < 950){
+            //Let some VGMs finish, and the engine react to it
+            u32 h;
+            for(h=0; h<harness_numheads; ++h){
+                if(rand() & 1) harness_heads[h]->isdone = 1;
+            }
+            SyEng_Tick();
+        }else if(r < 970){
+            if(numstatic < 8 && (rand() & 1)){
+                u8 pi = SyEng_GetStaticPI(RandomUsage());
+                if(pi != 0xFF){
+                    if(!proginstances[pi].isstatic){
+                        //When all voices are taken, AllocatePI may steal a
+                        //voice from the PI it is allocating for, which clears
+                        //that PI. Drop it, as Mode_Vgm would never see it.
+                        proginstances[pi].isstatic = 1;
+                        SyEng_ReleaseStaticPI(pi);
+                    }else{
+                        staticpis[numstatic++] = pi;
+                    }
+                }
+            }else if(numstatic > 0){
+                SyEng_ReleaseStaticPI(staticpis[--numstatic]);
+            }
+        }else if(r < 985){
+            //Take a voice for the tracker or give it back, like mode_chan.c
+            g = rand() % GENESIS_COUNT;
+            v = rand() % 12;
+            if(syngenesis[g].channels[v].use == 3){
+                syngenesis[g].channels[v].use = 0;
+                SyEng_VoiceUseChanged(g, v);
+            }else{
+                SyEng_ClearVoice(g, v);
+                syngenesis[g].channels[v].use = 3;
+                SyEng_VoiceUseChanged(g, v);
+            }
+        }else if(r < 990){
+            //Program change
+            programs[chn].usage = RandomUsage();
+            SyEng_HardFlushProgram(&programs[chn]);
+        }
+        harness_tim5.CNT += rand() % 2000;
+        if(CheckFreeVoices() < 0){
+            if(++errors <= 5) printf("ERROR: free voice bitmap mismatch in stream %lu event %lu\n", stream, i);
+            break;
+        }
+    }
+    //Return all voices, so the next stream starts from scratch
+    while(numstatic > 0) SyEng_ReleaseStaticPI(staticpis[--numstatic]);
+    for(chn=0; chn<NUM_PROGRAMS; ++chn) SyEng_HardFlushProgram(&programs[chn]);
+    for(g=0; g<GENESIS_COUNT; ++g){
+        for(v=0; v<12; ++v){
+            if(syngenesis[g].channels[v].use == 3){
+                syngenesis[g].channels[v].use = 0;
+                SyEng_VoiceUseChanged(g, v);
+            }
+            SyEng_ClearVoice(g, v);
+        }
+    }
+    for(i=0; i<harness_numheads; ++i) harness_heads[i]->isdone = 1;
+    SyEng_Tick();
+    //Heads still around now have been lost track of by syeng.c, drop them
+    //so they don't slow down the next stream
+    while(harness_numheads > 0) VGM_Head_Delete(harness_heads[0]);
+    return errors;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Worst case of the voice allocation: notes are never released, and the
+// tracker holds a quarter of the voices, so every note on has to replace a
+// proginstance, and most voices have to be found by rating all candidates.
+// The full scans have a fixed length (GENESIS_COUNT * 12 voices resp.
+// MBQG_NUM_PROGINSTANCES), this measures how often they run and how long
+// a note on takes.
+////////////////////////////////////////////////////////////////////////////////
+
+static void MeasureSaturated(){
+    u32 i, maxvoices = 0, maxpis = 0, totalvoices = 0, scans = 0;
+    u8 g, v;
+    clock_t start;
+    double elapsed;
+    SetupPrograms();
+    for(g=0; g<GENESIS_COUNT; ++g){
+        for(v=0; v<12; v+=4){
+            SyEng_ClearVoice(g, v);
+            syngenesis[g].channels[v].use = 3;
+            SyEng_VoiceUseChanged(g, v);
+        }
+    }
+    syeng_voice_index_check = 0;
+    start = clock();
+    for(i=0; i<NUM_SATURATED; ++i){
+        mios32_midi_package_t pkg = {.ALL = 0};
+        pkg.chn = rand() % NUM_PROGRAMS;
+        pkg.note = 36 + rand() % 48;
+        pkg.velocity = 1 + rand() % 127;
+        syeng_rated_voices = 0;
+        syeng_rated_pis = 0;
+        SyEng_Note_On(pkg);
+        if(syeng_rated_voices){
+            ++scans;
+            totalvoices += syeng_rated_voices;
+        }
+        if(syeng_rated_voices > maxvoices) maxvoices = syeng_rated_voices;
+        if(syeng_rated_pis > maxpis) maxpis = syeng_rated_pis;
+        harness_tim5.CNT += rand() % 2000;
+    }
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    syeng_voice_index_check = 1;
+    printf("Saturated: %d note ons, %.2f uS each, %lu with a voice scan (avg. %.1f voices rated)\n",
+            NUM_SATURATED, elapsed * 1e6 / NUM_SATURATED, scans, scans ? (double)totalvoices / scans : 0.0);
+    printf("Max. per note on: %lu voices (%d per full scan), %lu proginstances rated\n",
+            maxvoices, GENESIS_COUNT * 12, maxpis);
+    for(i=0; i<harness_numheads; ++i) harness_heads[i]->isdone = 1;
+    SyEng_Tick();
+    while(harness_numheads > 0) VGM_Head_Delete(harness_heads[0]);
+}
+
+int main(int argc, char* argv[]){
+    u32 stream, errors = 0;
+    clock_t start;
+    verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+    srand(1);
+    SyEng_Init();
+    source = VGM_SourceRAM_Create();
+    printf("Replaying %d random note streams on %d chips...\n", NUM_STREAMS, GENESIS_COUNT);
+    fflush(stdout);
+    start = clock();
+    for(stream=0; stream<NUM_STREAMS; ++stream){
+        errors += RunStream(stream);
+    }
+    printf("Done in %.2f s\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+    MeasureSaturated();
+    printf("Free voice bitmap mismatches: %lu\n", errors);
+    printf("Voices chosen differently than by full scan: %lu\n", syeng_voice_index_errors);
+    errors += syeng_voice_index_errors;
+    printf("%s\n", errors ? "FAILED" : "passed");
+    return errors ? 1 : 0;
+}
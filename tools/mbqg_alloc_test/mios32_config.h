@@ -0,0 +1,25 @@
+/*
+ * MIOS32 configuration file for the Quad Genesis voice allocation test
+ */
+
+#ifndef _MIOS32_CONFIG_H
+#define _MIOS32_CONFIG_H
+
+#define DBG Harness_DebugMessage
+extern int Harness_DebugMessage(const char *format, ...);
+
+// MBHP_Genesis
+#define GENESIS_COUNT 4
+
+// Compare each voice found via the free voice bitmaps with a full scan
+#define SYENG_CHECK_VOICE_INDEX 1
+
+// The VGM player reads its time from TIM2 and TIM5, which are advanced by the test
+typedef struct { volatile unsigned int CNT; } harness_tim_t;
+extern harness_tim_t harness_tim2, harness_tim5;
+#define TIM2 (&harness_tim2)
+#define TIM5 (&harness_tim5)
+
+#include <mios32_config_host.h>
+
+#endif /* _MIOS32_CONFIG_H */
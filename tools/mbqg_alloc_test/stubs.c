@@ -0,0 +1,115 @@
+/*
+ * MIDIbox Quad Genesis: Voice allocation test, stubs
+ * Replaces the VGM player, file and front panel functions used by syeng.c
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <mios32.h>
+#include <file.h>
+#include <vgmsdtask.h>
+#include "syeng.h"
+#include "stubs.h"
+
+harness_tim_t harness_tim2, harness_tim5;
+VgmSource* selvgm;
+xSemaphoreHandle xSDCardSemaphore;
+
+VgmHead** harness_heads;
+u32 harness_numheads;
+static u32 maxheads;
+
+////////////////////////////////////////////////////////////////////////////////
+// VGM heads: only kept in a list, so the test can finish them at random
+////////////////////////////////////////////////////////////////////////////////
+
+VgmHead* VGM_Head_Create(VgmSource* source, u32 freqmult, u32 tempomult, u32 tloffs){
+    VgmHead* head = calloc(1, sizeof(VgmHead));
+    head->source = source;
+    head->schedidx = 0xFF;
+    if(harness_numheads == maxheads){
+        maxheads = maxheads ? (maxheads << 1) : 64;
+        harness_heads = realloc(harness_heads, maxheads * sizeof(VgmHead*));
+    }
+    harness_heads[harness_numheads++] = head;
+    return head;
+}
+s32 VGM_Head_Delete(VgmHead* head){
+    u32 i;
+    for(i=0; i<harness_numheads; ++i){
+        if(harness_heads[i] == head){
+            harness_heads[i] = harness_heads[--harness_numheads];
+            break;
+        }
+    }
+    free(head);
+    return 0;
+}
+void VGM_Head_Restart(VgmHead* head, u32 vgm_time){
+    head->isdone = 0;
+    head->ticks = vgm_time;
+}
+void VGM_Player_Schedule(VgmHead* head){}
+
+VgmSource* VGM_SourceRAM_Create(){
+    VgmSource* source = calloc(1, sizeof(VgmSource));
+    source->type = VGM_SOURCE_TYPE_RAM;
+    source->data = calloc(1, sizeof(VgmSourceRAM));
+    return source;
+}
+s32 VGM_Source_Delete(VgmSource* source){
+    free(source->data);
+    free(source);
+    return 0;
+}
+void VGM_Source_UpdateUsage(VgmSource* source){}
+
+void VGM_ResetChipVoiceAsync(u8 g, u8 v){}
+void VGM_PartialResetChipVoiceAsync(u8 g, u8 v){}
+void VGM_Tracker_Enqueue(VgmChipWriteCmd cmd, u8 fixfreq){}
+u32 VGM_getFreqMultiplier(s8 deltanote){ return 0x1000; }
+void VGM_Cmd_DebugPrintUsage(VgmUsageBits usage){}
+s32 VGM_File_Load(char* filename, VgmSource** ss, char* resultMsg){ return -1; }
+s32 VGM_File_SaveRAM(VgmSource* sourceram, char* filename){ return -1; }
+
+void* vgmh2_malloc(size_t size){ return malloc(size); }
+void vgmh2_free(void* ptr){ free(ptr); }
+
+////////////////////////////////////////////////////////////////////////////////
+// Application and system functions
+////////////////////////////////////////////////////////////////////////////////
+
+void DemoPrograms_Init(){}
+void Mode_Vgm_InvalidatePI(synproginstance_t* maybestaticpi){}
+void Mode_Vgm_InvalidateVgm(VgmSource* maybeselvgm){}
+void Mode_Vgm_SelectVgm(VgmSource* newselvgm){}
+
+s32 FILE_DirExists(char *path){ return 0; }
+s32 FILE_FileExists(char *filepath){ return 0; }
+s32 FILE_MakeDir(char *path){ return -1; }
+s32 FILE_ReadBuffer(u8 *buffer, u32 len){ return -1; }
+s32 FILE_ReadByte(u8 *byte){ return -1; }
+s32 FILE_ReadClose(file_t* file){ return 0; }
+s32 FILE_ReadOpen(file_t* file, char *filepath){ return -1; }
+s32 FILE_ReadReOpen(file_t* file){ return -1; }
+s32 FILE_ReadSeek(u32 offset){ return -1; }
+s32 FILE_ReadWord(u32 *word){ return -1; }
+s32 FILE_Remove(char *path){ return -1; }
+s32 FILE_WriteBuffer(u8 *buffer, u32 len){ return -1; }
+s32 FILE_WriteByte(u8 byte){ return -1; }
+s32 FILE_WriteClose(void){ return 0; }
+s32 FILE_WriteOpen(char *filepath, u8 create){ return -1; }
+s32 FILE_WriteWord(u32 word){ return -1; }
+
+long xSemaphoreTakeRecursive(xSemaphoreHandle sem, portTickType ticks){ return pdTRUE; }
+long xSemaphoreGiveRecursive(xSemaphoreHandle sem){ return pdTRUE; }
+void vTaskDelay(portTickType ticks){}
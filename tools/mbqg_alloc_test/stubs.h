@@ -0,0 +1,22 @@
+/*
+ * MIDIbox Quad Genesis: Voice allocation test, stubs header
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ * 
+ * ==========================================================================
+ */
+
+#ifndef _STUBS_H
+#define _STUBS_H
+
+#include <vgm.h>
+
+//All heads created and not yet deleted by syeng.c
+extern VgmHead** harness_heads;
+extern u32 harness_numheads;
+
+#endif /* _STUBS_H */
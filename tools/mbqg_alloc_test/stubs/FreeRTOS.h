@@ -0,0 +1,10 @@
+// Just enough of FreeRTOS to compile the VGM module headers on the host
+
+#ifndef _FREERTOS_H
+#define _FREERTOS_H
+
+typedef void* xSemaphoreHandle;
+typedef unsigned int portTickType;
+#define pdTRUE 1
+
+#endif /* _FREERTOS_H */
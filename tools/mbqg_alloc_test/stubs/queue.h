@@ -0,0 +1 @@
+// Intentionally empty, only included by the VGM module headers
@@ -0,0 +1,9 @@
+// Just enough of FreeRTOS to compile the VGM module headers on the host
+
+#ifndef _SEMPHR_H
+#define _SEMPHR_H
+
+extern long xSemaphoreTakeRecursive(xSemaphoreHandle sem, portTickType ticks);
+extern long xSemaphoreGiveRecursive(xSemaphoreHandle sem);
+
+#endif /* _SEMPHR_H */
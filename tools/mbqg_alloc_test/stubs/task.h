@@ -0,0 +1,8 @@
+// Just enough of FreeRTOS to compile the VGM module headers on the host
+
+#ifndef _TASK_H
+#define _TASK_H
+
+extern void vTaskDelay(portTickType ticks);
+
+#endif /* _TASK_H */
@@ -0,0 +1,443 @@
+/* -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*- */
+// $Id$
+/*
+ * MIDIbox SID Offline Renderer
+ * Plays a .mid file through MbSidEnvironment and reSID, and writes a .wav file
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+#include <mios32.h>
+#include <sid.h>
+#include <mid_parser.h>
+
+#include "MbSidEnvironment.h"
+#include "resid.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// update frequency of MBSID (same as in the JUCE plugin)
+#define MBSID_UPDATE_FRQ 1000
+
+// sampling method
+#define RESID_SAMPLING_METHOD SAMPLE_INTERPOLATE
+
+// SID frequency
+#define RESID_FREQUENCY 1000000
+
+// selected Model
+#define RESID_MODEL MOS8580
+
+// number of samples rendered per clock() call
+#define RENDER_BUFFER_SIZE 256
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+// these global variables are used by ReSID
+double mixer_value1;
+double mixer_value2;
+double mixer_value3;
+
+static MbSidEnvironment *mbSidEnvironment;
+
+static SID *reSID[SID_NUM];
+static sid_regs_t sidRegsShadow[SID_NUM];
+
+// .mid file in memory
+static u8 *midiFile;
+static u32 midiFileLen;
+static u32 midiFilePos;
+
+// tempo of the .mid file
+static double midiBpm = 120.0;
+
+// measured CPU time in nS
+static double engineTime[SID_SE_NUM];
+static double reSidTime[SID_NUM];
+static double midiTime;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// MIOS32 functions used by MbSidEnvironment which are not available in
+// midibox_sid_v3/juce/Source/mios32_wrapper_code.c
+/////////////////////////////////////////////////////////////////////////////
+extern "C" s32 MIOS32_MIDI_SendSysEx(mios32_midi_port_t port, u8 *stream, u32 count)
+{
+    return 0; // SysEx responses are ignored
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Time measurement
+/////////////////////////////////////////////////////////////////////////////
+static inline double timeNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// File callbacks of MID_PARSER
+/////////////////////////////////////////////////////////////////////////////
+static u32 midiFileRead(void *buffer, u32 len)
+{
+    if( midiFilePos + len > midiFileLen )
+        len = (midiFilePos < midiFileLen) ? (midiFileLen - midiFilePos) : 0;
+
+    memcpy(buffer, &midiFile[midiFilePos], len);
+    midiFilePos += len;
+
+    return len;
+}
+
+static s32 midiFileEof(void)
+{
+    return midiFilePos >= midiFileLen;
+}
+
+static s32 midiFileSeek(u32 pos)
+{
+    midiFilePos = pos;
+    return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Event callbacks of MID_PARSER
+/////////////////////////////////////////////////////////////////////////////
+static s32 midiPlayEvent(u8 track, mios32_midi_package_t midi_package, u32 tick)
+{
+    if( midi_package.type == 0xf ) {
+        // SysEx stream is forwarded byte by byte
+        mbSidEnvironment->midiReceiveSysEx(DEFAULT, midi_package.evnt0);
+    } else {
+        mbSidEnvironment->midiReceive(DEFAULT, midi_package);
+    }
+
+    return 0; // no error
+}
+
+static s32 midiPlayMeta(u8 track, u8 meta, u32 len, u8 *buffer, u32 tick)
+{
+    if( meta == 0x51 && len == 3 ) { // Set Tempo
+        u32 tempo_us = ((u32)buffer[0] << 16) | ((u32)buffer[1] << 8) | (u32)buffer[2];
+        if( tempo_us ) {
+            midiBpm = 60000000.0 / (double)tempo_us;
+            mbSidEnvironment->bpmSet((float)midiBpm);
+        }
+    }
+
+    return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Sound engine update cycle
+// Same as MbSidEnvironment::tick(), but measures the time of each engine
+/////////////////////////////////////////////////////////////////////////////
+static void mbSidTick(void)
+{
+    mbSidEnvironment->mbSidClock.tick();
+
+    MbSid *s = mbSidEnvironment->mbSid.first();
+    for(int sid=0; sid < mbSidEnvironment->mbSid.size; ++sid, ++s) {
+        double t = timeNs();
+        s->tick(mbSidEnvironment->updateSpeedFactor);
+        engineTime[sid] += timeNs() - t;
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Transfers changed SID registers to reSID
+// the update order is the same like in the JUCE plugin (osc control registers at the end)
+/////////////////////////////////////////////////////////////////////////////
+static const u8 update_order[] = {
+   0,  1,  2,  3,  5,  6, // voice 1 w/o osc control register
+   7,  8,  9, 10, 12, 13, // voice 2 w/o osc control register
+  14, 15, 16, 17, 19, 20, // voice 3 w/o osc control register
+   4, 11, 18,             // voice 1/2/3 control registers
+  21, 22, 23, 24,         // remaining SID registers
+};
+
+static void reSidUpdate(void)
+{
+    for(unsigned i=0; i<sizeof(update_order); ++i) {
+        u8 reg = update_order[i];
+        for(int sid=0; sid<SID_NUM; ++sid) {
+            u8 data;
+            if( (data=sid_regs[sid].ALL[reg]) != sidRegsShadow[sid].ALL[reg] ) {
+                sidRegsShadow[sid].ALL[reg] = data;
+                reSID[sid]->write(reg, data);
+            }
+        }
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Renders the given number of samples of a SID
+/////////////////////////////////////////////////////////////////////////////
+static void reSidRender(int sid, short *buffer, int numSamples, double sampleRate)
+{
+    double t = timeNs();
+
+    int renderedSamples = 0;
+    while( renderedSamples < numSamples ) {
+        // clock() returns once the requested number of samples is available and the
+        // remaining cycles cover the next sample - the unused cycles are discarded
+        cycle_count delta_t = (cycle_count)((numSamples - renderedSamples + 2) * (RESID_FREQUENCY / sampleRate)) + 2;
+        renderedSamples += reSID[sid]->clock(delta_t, &buffer[renderedSamples], numSamples - renderedSamples);
+    }
+
+    reSidTime[sid] += timeNs() - t;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// WAV file output (16bit stereo PCM)
+/////////////////////////////////////////////////////////////////////////////
+static void wavWriteWord(FILE *f, u32 value, int len)
+{
+    for(int i=0; i<len; ++i, value >>= 8)
+        fputc(value & 0xff, f);
+}
+
+static void wavWriteHeader(FILE *f, u32 sampleRate, u32 numFrames)
+{
+    u32 dataLen = numFrames * 4;
+
+    fwrite("RIFF", 1, 4, f);
+    wavWriteWord(f, 36 + dataLen, 4);
+    fwrite("WAVE", 1, 4, f);
+    fwrite("fmt ", 1, 4, f);
+    wavWriteWord(f, 16, 4);             // chunk size
+    wavWriteWord(f, 1, 2);              // PCM
+    wavWriteWord(f, 2, 2);              // channels
+    wavWriteWord(f, sampleRate, 4);
+    wavWriteWord(f, sampleRate * 4, 4); // bytes per second
+    wavWriteWord(f, 4, 2);              // block align
+    wavWriteWord(f, 16, 2);             // bits per sample
+    fwrite("data", 1, 4, f);
+    wavWriteWord(f, dataLen, 4);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Help
+/////////////////////////////////////////////////////////////////////////////
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [options] <file.mid> <file.wav>\n", prog);
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  -r <rate>   sample rate in Hz (default: 44100)\n");
+    fprintf(stderr, "  -p <patch>  loads patch A<patch> (0..127) into all engines before playback\n");
+    fprintf(stderr, "  -t <secs>   release time rendered after the end of the song (default: 2)\n");
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Main
+/////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    double sampleRate = 44100.0;
+    int patch = -1;
+    double releaseTime = 2.0;
+
+    int opt = 1;
+    for(; opt < argc && argv[opt][0] == '-'; ++opt) {
+        if( opt+1 >= argc ) {
+            usage(argv[0]);
+            return 1;
+        }
+
+        if( strcmp(argv[opt], "-r") == 0 ) {
+            sampleRate = atof(argv[++opt]);
+        } else if( strcmp(argv[opt], "-p") == 0 ) {
+            patch = atoi(argv[++opt]);
+        } else if( strcmp(argv[opt], "-t") == 0 ) {
+            releaseTime = atof(argv[++opt]);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if( argc - opt != 2 || sampleRate < 8000.0 || patch > 127 ) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const char *midiFileName = argv[opt];
+    const char *wavFileName = argv[opt+1];
+
+    // read .mid file into memory
+    FILE *f = fopen(midiFileName, "rb");
+    if( f == NULL ) {
+        fprintf(stderr, "ERROR: can't open %s\n", midiFileName);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    midiFileLen = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    midiFile = (u8 *)malloc(midiFileLen ? midiFileLen : 1);
+    if( fread(midiFile, 1, midiFileLen, f) != midiFileLen ) {
+        fprintf(stderr, "ERROR: can't read %s\n", midiFileName);
+        return 1;
+    }
+    fclose(f);
+
+    MID_PARSER_Init(0);
+    MID_PARSER_InstallFileCallbacks((void *)&midiFileRead, (void *)&midiFileEof, (void *)&midiFileSeek);
+    MID_PARSER_InstallEventCallbacks((void *)&midiPlayEvent, (void *)&midiPlayMeta);
+    if( MID_PARSER_Read() < 0 || !MID_PARSER_FileIsValid() || MIDI_PARSER_PPQN_Get() == 0 ) {
+        fprintf(stderr, "ERROR: %s is not a valid .mid file\n", midiFileName);
+        return 1;
+    }
+
+    // initialize reSID
+    mixer_value1 = 1.0f;
+    mixer_value2 = 1.0f;
+    mixer_value3 = 1.0f;
+    for(int sid=0; sid<SID_NUM; ++sid) {
+        reSID[sid] = new SID;
+        reSID[sid]->set_chip_model(RESID_MODEL);
+        reSID[sid]->reset();
+        if( !reSID[sid]->set_sampling_parameters(RESID_FREQUENCY, RESID_SAMPLING_METHOD, sampleRate) ) {
+            fprintf(stderr, "ERROR: initialisation of reSID[%d] failed at sample rate %7.2f Hz!\n", sid, sampleRate);
+            return 1;
+        }
+    }
+
+    // initialize sound engines
+    mbSidEnvironment = new MbSidEnvironment();
+    mbSidEnvironment->bpmSet((float)midiBpm);
+    if( patch >= 0 ) {
+        for(int sid=0; sid<SID_SE_NUM; ++sid)
+            mbSidEnvironment->bankLoad(sid, 0, patch);
+    }
+
+    FILE *wav = fopen(wavFileName, "wb");
+    if( wav == NULL ) {
+        fprintf(stderr, "ERROR: can't create %s\n", wavFileName);
+        return 1;
+    }
+    wavWriteHeader(wav, (u32)sampleRate, 0); // will be updated at the end
+
+    printf("Rendering %s (%d tracks, %d ppqn) with %d sound engines at %d Hz...\n",
+           midiFileName, (int)MIDI_PARSER_TrackNumGet(), (int)MIDI_PARSER_PPQN_Get(), SID_SE_NUM, (int)sampleRate);
+
+    // render loop: each iteration handles one update cycle of the sound engines
+    static short sidBuffer[SID_NUM][RENDER_BUFFER_SIZE];
+    static short wavBuffer[2*RENDER_BUFFER_SIZE];
+    double ppqn = (double)MIDI_PARSER_PPQN_Get();
+    double midiTick = 0.0;
+    u32 fetchedTicks = 0;
+    double sampleCounter = 0.0;
+    u32 numFrames = 0;
+    u32 numUpdateCycles = 0;
+    u32 releaseCycles = (u32)(releaseTime * MBSID_UPDATE_FRQ);
+    bool songRunning = true;
+    double startTime = timeNs();
+
+    while( songRunning || releaseCycles ) {
+        // play MIDI events of this cycle
+        if( songRunning ) {
+            double t = timeNs();
+            midiTick += ppqn * midiBpm / (60.0 * MBSID_UPDATE_FRQ);
+            u32 nextTick = (u32)midiTick;
+            if( nextTick > fetchedTicks ) {
+                songRunning = MID_PARSER_FetchEvents(fetchedTicks, nextTick - fetchedTicks) > 0;
+                fetchedTicks = nextTick;
+            }
+            midiTime += timeNs() - t;
+        } else {
+            --releaseCycles;
+        }
+
+        // update sound engines
+        mbSidTick();
+        reSidUpdate();
+        ++numUpdateCycles;
+
+        // render the samples until the next update cycle
+        sampleCounter += sampleRate / MBSID_UPDATE_FRQ;
+        int numSamples = (int)sampleCounter;
+        sampleCounter -= numSamples;
+
+        while( numSamples > 0 ) {
+            int n = (numSamples > RENDER_BUFFER_SIZE) ? RENDER_BUFFER_SIZE : numSamples;
+
+            for(int sid=0; sid<SID_NUM; ++sid)
+                reSidRender(sid, sidBuffer[sid], n, sampleRate);
+
+            // mix left SIDs (even numbers) and right SIDs (odd numbers) of all engines
+            for(int i=0; i<n; ++i) {
+                s32 l = 0, r = 0;
+                for(int sid=0; sid<SID_NUM; sid+=2) {
+                    l += sidBuffer[sid+0][i];
+                    r += sidBuffer[sid+1][i];
+                }
+                wavBuffer[2*i+0] = (short)(l / SID_SE_NUM);
+                wavBuffer[2*i+1] = (short)(r / SID_SE_NUM);
+            }
+
+            for(int i=0; i<2*n; ++i)
+                wavWriteWord(wav, (u16)wavBuffer[i], 2);
+
+            numFrames += n;
+            numSamples -= n;
+        }
+    }
+
+    double totalTime = timeNs() - startTime;
+
+    // update header with the final length
+    fseek(wav, 0, SEEK_SET);
+    wavWriteHeader(wav, (u32)sampleRate, numFrames);
+    fclose(wav);
+
+    // statistics
+    double audioTime = (double)numFrames / sampleRate;
+    printf("Rendered %.2f seconds (%lu update cycles) in %.3f seconds (%.1fx realtime)\n",
+           audioTime, numUpdateCycles, totalTime / 1e9, (audioTime * 1e9) / totalTime);
+
+    printf("CPU time per update cycle:\n");
+    printf("  MIDI file:   %8.2f uS\n", midiTime / numUpdateCycles / 1e3);
+    for(int sid=0; sid<SID_SE_NUM; ++sid) {
+        char patchName[21];
+        mbSidEnvironment->mbSid[sid].mbSidPatch.nameGet(patchName);
+        printf("  Engine %d:    %8.2f uS   (%s)\n", sid, engineTime[sid] / numUpdateCycles / 1e3, patchName);
+    }
+    for(int sid=0; sid<SID_NUM; ++sid)
+        printf("  reSID %d:     %8.2f uS\n", sid, reSidTime[sid] / numUpdateCycles / 1e3);
+
+    for(int sid=0; sid<SID_NUM; ++sid)
+        delete reSID[sid];
+    delete mbSidEnvironment;
+    free(midiFile);
+
+    return 0;
+}
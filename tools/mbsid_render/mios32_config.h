@@ -0,0 +1,29 @@
+// $Id$
+/*
+ * Local MIOS32 configuration file
+ *
+ * this file allows to disable (or re-configure) default functions of MIOS32
+ * available switches are listed in $MIOS32_PATH/modules/mios32/MIOS32_CONFIG.txt
+ *
+ */
+
+#ifndef _MIOS32_CONFIG_H
+#define _MIOS32_CONFIG_H
+
+#define MIOS32_FAMILY_EMULATION 1
+#define MIOS32_BOARD_STR   "RENDER"
+#define MIOS32_FAMILY_STR  "EMULATION"
+
+// function used to output debug messages (must be printf compatible!)
+#define DEBUG_MSG MIOS32_MIDI_SendDebugMessage
+
+// number of physical SIDs, each sound engine controls a stereo pair
+// -> 8 SIDs = 4 sound engines, as on a fully stuffed MIDIbox SID
+#define SID_NUM 8
+
+// no SID hardware
+#define SIDPHYS_DISABLED
+
+#include <mios32_config_host.h>
+
+#endif /* _MIOS32_CONFIG_H */
@@ -0,0 +1,174 @@
+// $Id$
+/*
+ * MIDI Receive Benchmark (host variant)
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <time.h>
+
+#include <mios32.h>
+
+#include "benchmark.h"
+#include "usb_midi.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+#define MIN_MEASURE_TIME  1.0 // seconds per test
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Previous MIOS32_MIDI_Receive_Handler() for USB: each package is taken
+// from the receive buffer and processed by MIOS32_MIDI_ReceivePackage
+/////////////////////////////////////////////////////////////////////////////
+static s32 USB_ReceiveHandler_Single(void *_callback_package)
+{
+  mios32_midi_package_t package;
+
+  while( MIOS32_USB_MIDI_PackageReceive(&package) >= 0 )
+    MIOS32_MIDI_ReceivePackage(USB0 + package.cable, package, _callback_package);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Receives the package pattern via the USB receive buffer: USB transfers are
+// put into the buffer until it is full, thereafter the receive handler is
+// called like by the MIDI task
+/////////////////////////////////////////////////////////////////////////////
+static s32 USB_Receive(s32 (*receive_handler)(void *_callback_package))
+{
+  const mios32_midi_package_t *p = BENCHMARK_PatternGet();
+  u32 num = BENCHMARK_NUM_PACKAGES;
+
+  while( num ) {
+    u32 transfer;
+    do {
+      transfer = (num > USB_MIDI_TRANSFER_SIZE) ? USB_MIDI_TRANSFER_SIZE : num;
+      if( USB_MIDI_RxBufferPut(p, transfer) < 0 )
+	break;
+      p += transfer;
+      num -= transfer;
+    } while( num );
+
+    receive_handler(BENCHMARK_NotifyPackage);
+  }
+
+  return 0; // no error
+}
+
+static s32 Benchmark_Start_USB_Single(u32 par)
+{
+  return USB_Receive(USB_ReceiveHandler_Single);
+}
+
+static s32 Benchmark_Start_USB_Span(u32 par)
+{
+  return USB_Receive(MIOS32_MIDI_Receive_Handler);
+}
+
+static s32 Benchmark_Start_USB_SpanBlockCallback(u32 par)
+{
+  s32 status;
+
+  MIOS32_MIDI_BlockCallback_Init(BENCHMARK_NotifyBlock);
+  status = USB_Receive(MIOS32_MIDI_Receive_Handler);
+  MIOS32_MIDI_BlockCallback_Init(NULL);
+
+  return status;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Processes the package pattern repeatedly and prints the time per burst
+// returns the checksum over all forwarded packages of the first loop
+/////////////////////////////////////////////////////////////////////////////
+static u32 Benchmark_Run(const char *name, s32 (*benchmark_start)(u32 par), u32 par, u32 *num_received)
+{
+  u32 checksum = 0;
+  u32 loops = 0;
+  double elapsed;
+  clock_t start = clock();
+
+  BENCHMARK_Reset(par);
+
+  do {
+    benchmark_start(par);
+
+    if( !loops ) {
+      checksum = BENCHMARK_ChecksumGet();
+      *num_received = BENCHMARK_NumReceivedGet();
+    }
+    ++loops;
+
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+  } while( elapsed < MIN_MEASURE_TIME );
+
+  printf("  %-40s %8.2f uS for %d packages (%lu forwarded per loop, checksum %08x)\n",
+	 name, elapsed * 1e6 / loops, BENCHMARK_NUM_PACKAGES, *num_received, (unsigned)checksum);
+
+  return checksum;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Main
+/////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+  static const char *pattern_names[] = {
+    "Notes/CCs on a single cable",
+    "MIDI Clock after each 8th package",
+    "cable changed after each 4th package",
+  };
+  static const struct {
+    const char *name;
+    s32 (*benchmark_start)(u32 par);
+  } methods[] = {
+    { "MIOS32_MIDI_ReceivePackage", BENCHMARK_Start_Single },
+    { "MIOS32_MIDI_ReceivePackageBlock", BENCHMARK_Start_Block },
+    { "...Block() with block callback", BENCHMARK_Start_BlockCallback },
+    { "USB: PackageReceive + ReceivePackage", Benchmark_Start_USB_Single },
+    { "USB: Receive_Handler (Span/Release)", Benchmark_Start_USB_Span },
+    { "USB: ...Handler() with block callback", Benchmark_Start_USB_SpanBlockCallback },
+  };
+  int num_methods = sizeof(methods) / sizeof(methods[0]);
+  int status = 0;
+  u32 par;
+
+  MIOS32_USB_MIDI_ChangeConnectionState(1);
+
+  for(par=0; par<3; ++par) {
+    u32 num_received[num_methods];
+    u32 checksum[num_methods];
+    int method;
+
+    printf("Pattern %lu: %s\n", par, pattern_names[par]);
+    for(method=0; method<num_methods; ++method) {
+      checksum[method] = Benchmark_Run(methods[method].name, methods[method].benchmark_start, par, &num_received[method]);
+
+      if( num_received[method] != num_received[0] || checksum[method] != checksum[0] ) {
+	printf("ERROR: different packages forwarded!\n");
+	status = 1;
+      }
+    }
+  }
+
+  return status;
+}
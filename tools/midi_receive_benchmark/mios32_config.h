@@ -0,0 +1,21 @@
+// $Id$
+/*
+ * Local MIOS32 configuration file
+ *
+ * this file allows to disable (or re-configure) default functions of MIOS32
+ * available switches are listed in $MIOS32_PATH/modules/mios32/MIOS32_CONFIG.txt
+ *
+ */
+
+#ifndef _MIOS32_CONFIG_H
+#define _MIOS32_CONFIG_H
+
+// only the MIDI receive path of MIOS32_MIDI is used, the packages are received
+// via the USB MIDI layer of the emulation, the other interfaces are not available on the host
+#define MIOS32_DONT_USE_UART_MIDI
+#define MIOS32_DONT_USE_IIC_MIDI
+#define MIOS32_DONT_USE_SPI_MIDI
+
+#include <mios32_config_host.h>
+
+#endif /* _MIOS32_CONFIG_H */
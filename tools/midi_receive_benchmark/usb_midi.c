@@ -0,0 +1,48 @@
+// $Id$
+/*
+ * MIDI Receive Benchmark (host variant)
+ * USB MIDI layer of the emulation, with a function which fills the receive
+ * buffer like the USB OUT endpoint of a MIDIbox core
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+// the receive buffer variables are static, therefore the driver is included
+#include "mios32_usb_midi.c"
+
+#include "usb_midi.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Puts a USB transfer into the receive buffer
+// Like the USB driver, the transfer is only taken if it completely fits
+// into the buffer.
+// returns -1 if the buffer is full, the transfer has to be repeated
+/////////////////////////////////////////////////////////////////////////////
+s32 USB_MIDI_RxBufferPut(const mios32_midi_package_t *packages, u32 num)
+{
+  if( num >= (MIOS32_USB_MIDI_RX_BUFFER_SIZE-rx_buffer_size) )
+    return -1;
+
+  MIOS32_IRQ_Disable();
+  for(; num; --num, ++packages) {
+    rx_buffer[rx_buffer_head] = packages->ALL;
+
+    if( ++rx_buffer_head >= MIOS32_USB_MIDI_RX_BUFFER_SIZE )
+      rx_buffer_head = 0;
+    ++rx_buffer_size;
+  }
+  MIOS32_IRQ_Enable();
+
+  return 0; // no error
+}
@@ -0,0 +1,32 @@
+// $Id$
+/*
+ * MIDI Receive Benchmark (host variant)
+ * USB MIDI receive buffer access
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef _USB_MIDI_H
+#define _USB_MIDI_H
+
+/////////////////////////////////////////////////////////////////////////////
+// Global definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// number of packages per USB transfer
+#define USB_MIDI_TRANSFER_SIZE (MIOS32_USB_MIDI_DATA_OUT_SIZE/4)
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Prototypes
+/////////////////////////////////////////////////////////////////////////////
+
+extern s32 USB_MIDI_RxBufferPut(const mios32_midi_package_t *packages, u32 num);
+
+#endif /* _USB_MIDI_H */
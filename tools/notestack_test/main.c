@@ -0,0 +1,237 @@
+// $Id$
+/*
+ * Notestack Test
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+#include <mios32.h>
+#include <notestack.h>
+#include "notestack_impl.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+#define NUM_STREAMS       200   // random note streams per mode and size
+#define STREAM_LENGTH     2000  // events per stream
+#define BENCHMARK_EVENTS  2000000
+
+static const char *mode_names[] = {
+  "PUSH_TOP", "PUSH_BOTTOM", "PUSH_TOP_HOLD", "PUSH_BOTTOM_HOLD", "SORT", "SORT_HOLD"
+};
+
+static const u8 stack_sizes[] = { 1, 2, 4, 8, 10, 16, 32, 128 };
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Used by NOTESTACK_SendDebugMessage()
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_SendDebugMessage(const char *format, ...)
+{
+  va_list args;
+
+  va_start(args, format);
+  vprintf(format, args);
+  va_end(args);
+
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Random note events: mostly push/pop within a limited note range,
+// so that notes are pushed/popped multiple times
+/////////////////////////////////////////////////////////////////////////////
+typedef enum {
+  EVENT_PUSH,
+  EVENT_POP,
+  EVENT_REMOVE_NON_ACTIVE,
+  EVENT_CLEAR
+} event_t;
+
+static event_t Event_Random(u8 *note, u8 *tag, int note_range)
+{
+  int r = rand() % 1000;
+
+  *note = (rand() % note_range) + ((note_range < 128) ? (rand() % (128 - note_range)) / 16 * 16 : 0);
+  *tag = rand() & 0xff;
+
+  if( r < 2 )
+    return EVENT_CLEAR;
+  if( r < 30 )
+    return EVENT_REMOVE_NON_ACTIVE;
+  if( r < 530 )
+    return EVENT_PUSH;
+  return EVENT_POP;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Compares the content of both implementations
+// returns 0 if identical
+/////////////////////////////////////////////////////////////////////////////
+static int Compare(u8 size)
+{
+  notestack_item_t *array_items;
+  notestack_item_t *bitmap_items;
+  u8 array_len = ARRAY_Items(&array_items);
+  u8 bitmap_len = BITMAP_Items(&bitmap_items);
+  int i;
+
+  if( array_len != bitmap_len )
+    return -1;
+
+  for(i=0; i<size; ++i) {
+    if( array_items[i].ALL != bitmap_items[i].ALL )
+      return -2;
+  }
+
+  if( ARRAY_CountActiveNotes() != BITMAP_CountActiveNotes() )
+    return -3;
+
+  if( ARRAY_HighestNote() != BITMAP_HighestNote() ||
+      ARRAY_LowestNote() != BITMAP_LowestNote() )
+    return -4;
+
+  return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Runs random note streams on both implementations
+// returns the number of mismatches
+/////////////////////////////////////////////////////////////////////////////
+static int Test_Mode(notestack_mode_t mode, u8 size, int note_range)
+{
+  int errors = 0;
+  int stream;
+
+  for(stream=0; stream<NUM_STREAMS; ++stream) {
+    int event_ix;
+
+    ARRAY_Init(mode, size);
+    BITMAP_Init(mode, size);
+
+    for(event_ix=0; event_ix<STREAM_LENGTH; ++event_ix) {
+      u8 note, tag;
+      s32 array_status = 0, bitmap_status = 0;
+      event_t event = Event_Random(&note, &tag, note_range);
+
+      switch( event ) {
+      case EVENT_PUSH:
+	array_status = ARRAY_Push(note, tag);
+	bitmap_status = BITMAP_Push(note, tag);
+	break;
+      case EVENT_POP:
+	array_status = ARRAY_Pop(note);
+	bitmap_status = BITMAP_Pop(note);
+	break;
+      case EVENT_REMOVE_NON_ACTIVE:
+	array_status = ARRAY_RemoveNonActiveNotes();
+	bitmap_status = BITMAP_RemoveNonActiveNotes();
+	break;
+      case EVENT_CLEAR:
+	array_status = ARRAY_Clear();
+	bitmap_status = BITMAP_Clear();
+	break;
+      }
+
+      int status = (array_status != bitmap_status) ? -5 : Compare(size);
+      if( status < 0 ) {
+	if( ++errors <= 5 )
+	  printf("ERROR %d: mode %s, size %d, stream %d, event %d (type %d, note %d)\n",
+		 status, mode_names[mode], size, stream, event_ix, event, note);
+	break; // continue with next stream
+      }
+    }
+  }
+
+  return errors;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Measures the time for Push/Pop events
+/////////////////////////////////////////////////////////////////////////////
+static void Benchmark_Mode(notestack_mode_t mode, u8 size)
+{
+  static u8 notes[BENCHMARK_EVENTS];
+  static u8 is_push[BENCHMARK_EVENTS];
+  int impl;
+  int i;
+
+  srand(mode);
+  for(i=0; i<BENCHMARK_EVENTS; ++i) {
+    notes[i] = 36 + rand() % 48;
+    is_push[i] = (rand() % 2) == 0;
+  }
+
+  printf("  %-16s size %3d:", mode_names[mode], size);
+  for(impl=0; impl<2; ++impl) {
+    clock_t start = clock();
+
+    if( impl == 0 ) {
+      ARRAY_Init(mode, size);
+      for(i=0; i<BENCHMARK_EVENTS; ++i)
+	is_push[i] ? ARRAY_Push(notes[i], 0) : ARRAY_Pop(notes[i]);
+    } else {
+      BITMAP_Init(mode, size);
+      for(i=0; i<BENCHMARK_EVENTS; ++i)
+	is_push[i] ? BITMAP_Push(notes[i], 0) : BITMAP_Pop(notes[i]);
+    }
+
+    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("  %s %6.1f ns/event", impl ? "bitmap" : "array", 1e9 * elapsed / BENCHMARK_EVENTS);
+  }
+  printf("\n");
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Main
+/////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+  int errors = 0;
+  int mode, size_ix;
+
+  srand(1);
+
+  printf("Comparing NOTESTACK_BITMAP_ENABLED 0 and 1 on random note streams...\n");
+  for(mode=NOTESTACK_MODE_PUSH_TOP; mode<=NOTESTACK_MODE_SORT_HOLD; ++mode) {
+    int mode_errors = 0;
+    for(size_ix=0; size_ix<sizeof(stack_sizes); ++size_ix) {
+      mode_errors += Test_Mode(mode, stack_sizes[size_ix], 12);
+      mode_errors += Test_Mode(mode, stack_sizes[size_ix], 128);
+    }
+    printf("  %-16s %s\n", mode_names[mode], mode_errors ? "FAILED" : "passed");
+    errors += mode_errors;
+  }
+
+  printf("Push/Pop timing:\n");
+  for(mode=NOTESTACK_MODE_PUSH_TOP; mode<=NOTESTACK_MODE_SORT_HOLD; ++mode) {
+    Benchmark_Mode(mode, 10);
+    Benchmark_Mode(mode, 64);
+  }
+
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,16 @@
+// $Id$
+/*
+ * Local MIOS32 configuration file
+ *
+ * this file allows to disable (or re-configure) default functions of MIOS32
+ * available switches are listed in $MIOS32_PATH/modules/mios32/MIOS32_CONFIG.txt
+ *
+ */
+
+#ifndef _MIOS32_CONFIG_H
+#define _MIOS32_CONFIG_H
+
+// nothing else to configure: notestack.c only needs the MIOS32 types
+#include <mios32_config_host.h>
+
+#endif /* _MIOS32_CONFIG_H */
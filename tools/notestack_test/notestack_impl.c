@@ -0,0 +1,58 @@
+// $Id$
+/*
+ * Wraps one notestack implementation for the comparison
+ * Compiled twice: with NOTESTACK_BITMAP_ENABLED 0 and 1
+ * IMPL selects the prefix of the wrapper functions
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#include <mios32.h>
+
+// rename the notestack functions, so that both implementations can be linked together
+#define IMPL_CONCAT2(a, b) a##_##b
+#define IMPL_CONCAT(a, b) IMPL_CONCAT2(a, b)
+
+#define NOTESTACK_Init                 IMPL_CONCAT(IMPL, NOTESTACK_Init)
+#define NOTESTACK_Push                 IMPL_CONCAT(IMPL, NOTESTACK_Push)
+#define NOTESTACK_Pop                  IMPL_CONCAT(IMPL, NOTESTACK_Pop)
+#define NOTESTACK_CountActiveNotes     IMPL_CONCAT(IMPL, NOTESTACK_CountActiveNotes)
+#define NOTESTACK_RemoveNonActiveNotes IMPL_CONCAT(IMPL, NOTESTACK_RemoveNonActiveNotes)
+#define NOTESTACK_Clear                IMPL_CONCAT(IMPL, NOTESTACK_Clear)
+#define NOTESTACK_HighestNote          IMPL_CONCAT(IMPL, NOTESTACK_HighestNote)
+#define NOTESTACK_LowestNote           IMPL_CONCAT(IMPL, NOTESTACK_LowestNote)
+#define NOTESTACK_SendDebugMessage     IMPL_CONCAT(IMPL, NOTESTACK_SendDebugMessage)
+
+#include "notestack.c"
+
+#include "notestack_impl.h"
+
+
+static notestack_t notestack;
+static notestack_item_t note_items[NOTESTACK_IMPL_MAX_SIZE];
+
+
+s32 IMPL_CONCAT(IMPL, Init)(notestack_mode_t mode, u8 size)
+{
+  return NOTESTACK_Init(&notestack, mode, note_items, size);
+}
+
+s32 IMPL_CONCAT(IMPL, Push)(u8 note, u8 tag)         { return NOTESTACK_Push(&notestack, note, tag); }
+s32 IMPL_CONCAT(IMPL, Pop)(u8 note)                  { return NOTESTACK_Pop(&notestack, note); }
+s32 IMPL_CONCAT(IMPL, CountActiveNotes)(void)        { return NOTESTACK_CountActiveNotes(&notestack); }
+s32 IMPL_CONCAT(IMPL, RemoveNonActiveNotes)(void)    { return NOTESTACK_RemoveNonActiveNotes(&notestack); }
+s32 IMPL_CONCAT(IMPL, Clear)(void)                   { return NOTESTACK_Clear(&notestack); }
+s32 IMPL_CONCAT(IMPL, HighestNote)(void)             { return NOTESTACK_HighestNote(&notestack); }
+s32 IMPL_CONCAT(IMPL, LowestNote)(void)              { return NOTESTACK_LowestNote(&notestack); }
+
+u8 IMPL_CONCAT(IMPL, Items)(notestack_item_t **items)
+{
+  *items = note_items;
+  return notestack.len;
+}
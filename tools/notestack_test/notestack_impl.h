@@ -0,0 +1,34 @@
+// $Id$
+/*
+ * Header file for the wrapped notestack implementations
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef _NOTESTACK_IMPL_H
+#define _NOTESTACK_IMPL_H
+
+#define NOTESTACK_IMPL_MAX_SIZE 128
+
+// ARRAY: NOTESTACK_BITMAP_ENABLED 0, BITMAP: NOTESTACK_BITMAP_ENABLED 1
+#define NOTESTACK_IMPL_PROTOTYPES(prefix) \
+  extern s32 prefix##_Init(notestack_mode_t mode, u8 size); \
+  extern s32 prefix##_Push(u8 note, u8 tag); \
+  extern s32 prefix##_Pop(u8 note); \
+  extern s32 prefix##_CountActiveNotes(void); \
+  extern s32 prefix##_RemoveNonActiveNotes(void); \
+  extern s32 prefix##_Clear(void); \
+  extern s32 prefix##_HighestNote(void); \
+  extern s32 prefix##_LowestNote(void); \
+  extern u8 prefix##_Items(notestack_item_t **items);
+
+NOTESTACK_IMPL_PROTOTYPES(ARRAY)
+NOTESTACK_IMPL_PROTOTYPES(BITMAP)
+
+#endif /* _NOTESTACK_IMPL_H */
@@ -0,0 +1,364 @@
+// $Id$
+/*
+ * OSC Dispatch Benchmark
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <mios32.h>
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+#define NUM_PACKETS       4096
+#define PACKET_SIZE       64
+#define MIN_MEASURE_TIME  1.0 // seconds per test
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+// checksum over all method calls, must be identical for both parsers
+static u32 method_checksum;
+static u32 method_calls;
+
+static u8 packet[NUM_PACKETS][PACKET_SIZE];
+static u32 packet_len[NUM_PACKETS];
+
+static u8 dispatch_buffer[65536];
+
+
+/////////////////////////////////////////////////////////////////////////////
+// OSC methods: only the calls are recorded
+/////////////////////////////////////////////////////////////////////////////
+static s32 Method_Record(mios32_osc_args_t *osc_args, u32 method_arg, u32 method_id)
+{
+  int i;
+
+  method_checksum = method_checksum * 31 + method_id;
+  method_checksum = method_checksum * 31 + method_arg;
+  method_checksum = method_checksum * 31 + osc_args->num_args;
+  for(i=0; i<osc_args->num_path_parts; ++i)
+    method_checksum = method_checksum * 31 + (u32)(size_t)osc_args->path_part[i];
+  ++method_calls;
+
+  return 0; // no error
+}
+
+static s32 Method_MIDI(mios32_osc_args_t *osc_args, u32 method_arg)      { return Method_Record(osc_args, method_arg, 1); }
+static s32 Method_MCMPP(mios32_osc_args_t *osc_args, u32 method_arg)     { return Method_Record(osc_args, method_arg, 2); }
+static s32 Method_Event(mios32_osc_args_t *osc_args, u32 method_arg)     { return Method_Record(osc_args, method_arg, 3); }
+static s32 Method_EventTOSC(mios32_osc_args_t *osc_args, u32 method_arg) { return Method_Record(osc_args, method_arg, 4); }
+static s32 Method_EventNRPN(mios32_osc_args_t *osc_args, u32 method_arg) { return Method_Record(osc_args, method_arg, 5); }
+static s32 Method_EventPB(mios32_osc_args_t *osc_args, u32 method_arg)   { return Method_Record(osc_args, method_arg, 6); }
+static s32 Method_Control(mios32_osc_args_t *osc_args, u32 method_arg)   { return Method_Record(osc_args, method_arg, 7); }
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Search tree of $MIOS32_PATH/modules/uip_task_standard/osc_server.c
+/////////////////////////////////////////////////////////////////////////////
+const static mios32_osc_search_tree_t parse_mcmpp_value[] = {
+  { "*", NULL, &Method_MCMPP, 0x00000000 },
+
+  { NULL, NULL, NULL, 0 } // terminator
+};
+
+const static mios32_osc_search_tree_t parse_mcmpp[] = {
+  { "key",           parse_mcmpp_value, NULL, 0x00000090 },
+  { "polypressure",  parse_mcmpp_value, NULL, 0x000000a0 },
+  { "cc",            parse_mcmpp_value, NULL, 0x000000b0 },
+  { "programchange", parse_mcmpp_value, NULL, 0x000000c0 },
+  { "aftertouch",    parse_mcmpp_value, NULL, 0x000000d0 },
+  { "pitch",         parse_mcmpp_value, NULL, 0x000000e0 },
+
+  { NULL, NULL, NULL, 0 } // terminator
+};
+
+const static mios32_osc_search_tree_t parse_event[] = {
+  { "note_*",        NULL, &Method_EventTOSC, 0x00000090 },
+  { "polypressure_*",NULL, &Method_EventTOSC, 0x000000a0 },
+  { "cc_*",          NULL, &Method_EventTOSC, 0x000000b0 },
+  { "programchange_*", NULL, &Method_EventTOSC, 0x000000c0 },
+
+  { "note",          NULL, &Method_Event,     0x00000090 },
+  { "polypressure",  NULL, &Method_Event,     0x000000a0 },
+  { "cc",            NULL, &Method_Event,     0x000000b0 },
+  { "nrpn",          NULL, &Method_EventNRPN, 0x000000b0 },
+  { "programchange", NULL, &Method_Event,     0x000000c0 },
+  { "aftertouch",    NULL, &Method_Event,     0x000000b0 },
+  { "pitchbend",     NULL, &Method_EventPB,   0x000000e0 },
+
+  { NULL, NULL, NULL, 0 } // terminator
+};
+
+const static mios32_osc_search_tree_t parse_root[] = {
+  { "midi",  NULL, &Method_MIDI, 0x00000000 },
+  { "midi1", NULL, &Method_MIDI, 0x00000000 },
+  { "midi2", NULL, &Method_MIDI, 0x00000001 },
+  { "midi3", NULL, &Method_MIDI, 0x00000002 },
+  { "midi4", NULL, &Method_MIDI, 0x00000003 },
+
+  { "mcmpp", parse_mcmpp, NULL, 0x00000000},
+
+  { "1",  parse_event, NULL, 0x00000000},
+  { "2",  parse_event, NULL, 0x00000001},
+  { "3",  parse_event, NULL, 0x00000002},
+  { "4",  parse_event, NULL, 0x00000003},
+  { "5",  parse_event, NULL, 0x00000004},
+  { "6",  parse_event, NULL, 0x00000005},
+  { "7",  parse_event, NULL, 0x00000006},
+  { "8",  parse_event, NULL, 0x00000007},
+  { "9",  parse_event, NULL, 0x00000008},
+  { "10", parse_event, NULL, 0x00000009},
+  { "11", parse_event, NULL, 0x0000000a},
+  { "12", parse_event, NULL, 0x0000000b},
+  { "13", parse_event, NULL, 0x0000000c},
+  { "14", parse_event, NULL, 0x0000000d},
+  { "15", parse_event, NULL, 0x0000000e},
+  { "16", parse_event, NULL, 0x0000000f},
+
+  { NULL, NULL, NULL, 0 } // terminator
+};
+
+
+/////////////////////////////////////////////////////////////////////////////
+// TouchOSC like layout, created during runtime:
+// /<page>/fader<n>, /<page>/rotary<n>, /<page>/push<n>, /<page>/toggle<n>
+// and /<page>/multifader<n>/<m>
+/////////////////////////////////////////////////////////////////////////////
+#define LAYOUT_PAGES        4
+#define LAYOUT_FADERS      32
+#define LAYOUT_ROTARIES    32
+#define LAYOUT_PUSHES      64
+#define LAYOUT_TOGGLES     64
+#define LAYOUT_MULTIFADERS  4
+#define LAYOUT_MULTIFADER_SIZE 16
+
+static mios32_osc_search_tree_t *layout_root;
+
+static const char *Layout_Name(const char *prefix, int num)
+{
+  char *str = malloc(32);
+  sprintf(str, "%s%d", prefix, num);
+  return str;
+}
+
+static mios32_osc_search_tree_t *Layout_Create(void)
+{
+  int page, i;
+
+  mios32_osc_search_tree_t *multifader = calloc(LAYOUT_MULTIFADER_SIZE+1, sizeof(mios32_osc_search_tree_t));
+  for(i=0; i<LAYOUT_MULTIFADER_SIZE; ++i) {
+    multifader[i].address = Layout_Name("", i+1);
+    multifader[i].osc_method = &Method_Control;
+    multifader[i].method_arg = i;
+  }
+
+  mios32_osc_search_tree_t *root = calloc(LAYOUT_PAGES+1, sizeof(mios32_osc_search_tree_t));
+  for(page=0; page<LAYOUT_PAGES; ++page) {
+    int num_nodes = LAYOUT_FADERS + LAYOUT_ROTARIES + LAYOUT_PUSHES + LAYOUT_TOGGLES + LAYOUT_MULTIFADERS;
+    mios32_osc_search_tree_t *nodes = calloc(num_nodes+1, sizeof(mios32_osc_search_tree_t));
+    mios32_osc_search_tree_t *node = nodes;
+
+    for(i=0; i<LAYOUT_FADERS; ++i, ++node) {
+      node->address = Layout_Name("fader", i+1);
+      node->osc_method = &Method_Control;
+      node->method_arg = 0x1000 | (i << 4);
+    }
+    for(i=0; i<LAYOUT_ROTARIES; ++i, ++node) {
+      node->address = Layout_Name("rotary", i+1);
+      node->osc_method = &Method_Control;
+      node->method_arg = 0x2000 | (i << 4);
+    }
+    for(i=0; i<LAYOUT_PUSHES; ++i, ++node) {
+      node->address = Layout_Name("push", i+1);
+      node->osc_method = &Method_Control;
+      node->method_arg = 0x3000 | (i << 4);
+    }
+    for(i=0; i<LAYOUT_TOGGLES; ++i, ++node) {
+      node->address = Layout_Name("toggle", i+1);
+      node->osc_method = &Method_Control;
+      node->method_arg = 0x4000 | (i << 4);
+    }
+    for(i=0; i<LAYOUT_MULTIFADERS; ++i, ++node) {
+      node->address = Layout_Name("multifader", i+1);
+      node->next = multifader;
+      node->method_arg = 0x5000 | (i << 8);
+    }
+
+    root[page].address = Layout_Name("", page+1);
+    root[page].next = nodes;
+    root[page].method_arg = page << 16;
+  }
+
+  return root;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Creates a packet with a single float argument
+/////////////////////////////////////////////////////////////////////////////
+static void Packet_Create(int ix, const char *path)
+{
+  u8 *end_ptr = packet[ix];
+  end_ptr = MIOS32_OSC_PutString(end_ptr, (char *)path);
+  end_ptr = MIOS32_OSC_PutString(end_ptr, ",f");
+  end_ptr = MIOS32_OSC_PutFloat(end_ptr, 0.5);
+  packet_len[ix] = end_ptr - packet[ix];
+}
+
+static void Packets_OscServer(void)
+{
+  static const char *event_names[] = { "note", "cc", "pitchbend", "nrpn", "note_", "cc_", "programchange_" };
+  char path[PACKET_SIZE];
+  int ix;
+
+  for(ix=0; ix<NUM_PACKETS; ++ix) {
+    int r = rand() % 10;
+    if( r == 0 ) {
+      sprintf(path, "/midi%d", 1 + rand() % 4);
+    } else if( r == 1 ) {
+      sprintf(path, "/mcmpp/key/%d/%d", rand() % 128, 1 + rand() % 16);
+    } else {
+      int event = rand() % 7;
+      if( event >= 4 )
+	sprintf(path, "/%d/%s%d", 1 + rand() % 16, event_names[event], rand() % 128);
+      else
+	sprintf(path, "/%d/%s", 1 + rand() % 16, event_names[event]);
+    }
+    Packet_Create(ix, path);
+  }
+}
+
+static void Packets_Layout(int with_wildcards)
+{
+  static const char *control_names[] = { "fader", "rotary", "push", "toggle" };
+  char path[PACKET_SIZE];
+  int ix;
+
+  for(ix=0; ix<NUM_PACKETS; ++ix) {
+    int page = 1 + rand() % LAYOUT_PAGES;
+    int r = rand() % 8;
+    if( with_wildcards && (ix % 64) == 0 ) {
+      sprintf(path, "/%d/fader*", page);
+    } else if( with_wildcards && (ix % 64) == 1 ) {
+      sprintf(path, "/?/push1%d", rand() % 10);
+    } else if( r == 0 ) {
+      sprintf(path, "/%d/multifader%d/%d", page, 1 + rand() % LAYOUT_MULTIFADERS, 1 + rand() % LAYOUT_MULTIFADER_SIZE);
+    } else {
+      int control = rand() % 4;
+      int num = 1 + rand() % ((control < 2) ? LAYOUT_FADERS : LAYOUT_PUSHES);
+      sprintf(path, "/%d/%s%d", page, control_names[control], num);
+    }
+    Packet_Create(ix, path);
+  }
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Parses all packets repeatedly and prints the number of messages per second
+// returns the checksum over all method calls of the first loop
+/////////////////////////////////////////////////////////////////////////////
+static u32 Benchmark_Run(const char *name, const mios32_osc_search_tree_t *search_tree, const mios32_osc_compiled_tree_t *compiled_tree)
+{
+  u32 checksum = 0;
+  u32 loops = 0;
+  u32 calls = 0;
+  double elapsed;
+  clock_t start = clock();
+
+  do {
+    int ix;
+
+    method_checksum = 0;
+    method_calls = 0;
+
+    for(ix=0; ix<NUM_PACKETS; ++ix) {
+      if( compiled_tree )
+	MIOS32_OSC_ParsePacketCompiled(packet[ix], packet_len[ix], compiled_tree);
+      else
+	MIOS32_OSC_ParsePacket(packet[ix], packet_len[ix], search_tree);
+    }
+
+    if( !loops ) {
+      checksum = method_checksum;
+      calls = method_calls;
+    }
+    ++loops;
+
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+  } while( elapsed < MIN_MEASURE_TIME );
+
+  printf("  %-28s %10.0f messages/sec (%u method calls, checksum %08x)\n",
+	 name, (double)loops * NUM_PACKETS / elapsed, (unsigned)calls, (unsigned)checksum);
+
+  return checksum;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Compares MIOS32_OSC_ParsePacket() with MIOS32_OSC_ParsePacketCompiled()
+/////////////////////////////////////////////////////////////////////////////
+static int Benchmark_Tree(const char *name, const mios32_osc_search_tree_t *search_tree)
+{
+  mios32_osc_compiled_tree_t compiled_tree;
+  s32 size = MIOS32_OSC_CompileSearchTree(&compiled_tree, search_tree, dispatch_buffer, sizeof(dispatch_buffer));
+
+  printf("%s (dispatch tables: %d bytes)\n", name, (int)size);
+  if( size < 0 ) {
+    printf("ERROR: compile buffer too small!\n");
+    return -1;
+  }
+
+  u32 checksum = Benchmark_Run("MIOS32_OSC_ParsePacket", search_tree, NULL);
+  u32 checksum_compiled = Benchmark_Run("MIOS32_OSC_ParsePacketCompiled", search_tree, &compiled_tree);
+
+  if( checksum != checksum_compiled ) {
+    printf("ERROR: different method calls!\n");
+    return -1;
+  }
+
+  return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Main
+/////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+  int status = 0;
+
+  srand(1);
+  layout_root = Layout_Create();
+
+  Packets_OscServer();
+  status |= Benchmark_Tree("osc_server.c search tree", parse_root);
+
+  Packets_Layout(0);
+  status |= Benchmark_Tree("TouchOSC layout (exact addresses)", layout_root);
+
+  Packets_Layout(1);
+  status |= Benchmark_Tree("TouchOSC layout (with wildcards)", layout_root);
+
+  return status ? 1 : 0;
+}
@@ -0,0 +1,368 @@
+// $Id$
+/*
+ * SEQ_CORE_Seek Test
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+// the static functions of seq_core.c and seq_lfo.c are tested directly
+#include "seq_core.c"
+#include "seq_lfo.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+// number of random track configurations, and seeks per configuration
+#define NUM_CONFIGS 3000
+#define NUM_SEEKS   10
+
+// max. number of MIDI clocks which are received between two SEQ_CORE_Handler() calls
+#define MAX_CLOCKS_PER_CALL 3
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local types
+/////////////////////////////////////////////////////////////////////////////
+
+// sequencer state which is compared after a seek
+typedef struct {
+  seq_core_trk_t trk[SEQ_CORE_NUM_TRACKS];
+  seq_lfo_t lfo[SEQ_CORE_NUM_TRACKS];
+  seq_core_state_t state;
+  u16 muted;
+  seq_core_slaveclk_mute_t slaveclk_mute;
+} snapshot_t;
+
+// state which is restored before each seek
+typedef struct {
+  seq_core_state_t state;
+  u16 muted;
+  u16 synched_mute;
+  u16 synched_unmute;
+  seq_core_slaveclk_mute_t slaveclk_mute;
+} setup_t;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Takes a snapshot of the sequencer state
+/////////////////////////////////////////////////////////////////////////////
+static void SnapshotTake(snapshot_t *s)
+{
+  memcpy(s->trk, seq_core_trk, sizeof(s->trk));
+  memcpy(s->lfo, seq_lfo, sizeof(s->lfo));
+  s->state = seq_core_state;
+  s->muted = seq_core_trk_muted;
+  s->slaveclk_mute = seq_core_slaveclk_mute;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Saves/restores the state which is changed by a seek
+/////////////////////////////////////////////////////////////////////////////
+static void SetupSave(setup_t *s)
+{
+  s->state = seq_core_state;
+  s->muted = seq_core_trk_muted;
+  s->synched_mute = seq_core_trk_synched_mute;
+  s->synched_unmute = seq_core_trk_synched_unmute;
+  s->slaveclk_mute = seq_core_slaveclk_mute;
+}
+
+static void SetupRestore(setup_t *s)
+{
+  SEQ_RANDOM_Gen(12345);
+  seq_core_state = s->state;
+  seq_core_trk_muted = s->muted;
+  seq_core_trk_synched_mute = s->synched_mute;
+  seq_core_trk_synched_unmute = s->synched_unmute;
+  seq_core_slaveclk_mute = s->slaveclk_mute;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Reference: plays all ticks before the target tick with muted tracks
+/////////////////////////////////////////////////////////////////////////////
+static void ReferenceSeek(u32 target)
+{
+  u32 tick;
+
+  SEQ_SONG_Reset(0);
+  SEQ_CORE_Reset(0);
+  for(tick=0; tick<target; ++tick) {
+    SEQ_BPM_TickSet(tick);
+    SEQ_CORE_Tick(tick, -1, 1);
+    SEQ_CORE_PatternSwitchCheck(tick);
+  }
+  SEQ_BPM_TickSet(target);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Complete seek like SEQ_CORE_Seek() + the following SEQ_CORE_Handler() calls
+// (without incoming clocks)
+/////////////////////////////////////////////////////////////////////////////
+static void CompleteSeek(u32 target)
+{
+  SEQ_CORE_Seek(target);
+  while( seek_replay_active )
+    SEQ_CORE_SeekReplay();
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Seek with MIDI clocks which are received while the replay is spread over
+// several SEQ_CORE_Handler() calls, handled like in SEQ_CORE_Handler().
+// Once the replay has caught up, the clocks are played (muted, so that the
+// state can be compared with the reference).
+// Returns the next tick which will be played
+/////////////////////////////////////////////////////////////////////////////
+static u32 SeekWithClocks(u32 target, u32 *handler_calls)
+{
+  u32 tick = target;
+  int clocks_after_replay = 0;
+
+  *handler_calls = 1;
+  SEQ_CORE_Seek(target);
+
+  while( seek_replay_active || clocks_after_replay < 100 ) {
+    int clocks = rand() % (MAX_CLOCKS_PER_CALL+1);
+
+    for(; clocks; --clocks, ++tick) {
+      if( seek_replay_active ) {
+	seek_replay_target = tick + 1;
+      } else {
+	SEQ_BPM_TickSet(tick);
+	SEQ_CORE_Tick(tick, -1, 1);
+	SEQ_CORE_PatternSwitchCheck(tick);
+	++clocks_after_replay;
+      }
+    }
+
+    ++*handler_calls;
+    if( seek_replay_active )
+      SEQ_CORE_SeekReplay();
+  }
+
+  return tick;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Compares two snapshots, returns the number of differences
+/////////////////////////////////////////////////////////////////////////////
+#define COMPARE(field) \
+  if( x->field != y->field && errors++ < 10 ) \
+    printf("  target %u track %d " #field ": ref %d seek %d\n", (unsigned)target, track, (int)x->field, (int)y->field);
+
+static int SnapshotCompare(snapshot_t *a, snapshot_t *b, u32 target)
+{
+  int errors = 0;
+  int track;
+
+  for(track=0; track<SEQ_CORE_NUM_TRACKS; ++track) {
+    seq_core_trk_t *x = &a->trk[track];
+    seq_core_trk_t *y = &b->trk[track];
+
+    COMPARE(step);
+    COMPARE(bar);
+    COMPARE(state.ALL);
+    COMPARE(step_saved);
+    COMPARE(step_fwd_ctr);
+    COMPARE(step_interval_ctr);
+    COMPARE(step_replay_ctr);
+    COMPARE(step_repeat_ctr);
+    COMPARE(step_skip_ctr);
+    COMPARE(timestamp_next_step);
+    COMPARE(timestamp_next_step_ref);
+    COMPARE(step_length);
+    COMPARE(arp_pos);
+
+    if( memcmp(x, y, sizeof(*x)) != 0 && errors++ < 10 )
+      printf("  target %u track %d: track state differs\n", (unsigned)target, track);
+
+    if( (a->lfo[track].step_ctr != b->lfo[track].step_ctr || a->lfo[track].pos != b->lfo[track].pos) && errors++ < 10 )
+      printf("  target %u track %d: LFO ref %d/%d seek %d/%d\n", (unsigned)target, track,
+	     a->lfo[track].step_ctr, a->lfo[track].pos, b->lfo[track].step_ctr, b->lfo[track].pos);
+  }
+
+  if( (a->state.ALL != b->state.ALL ||
+       a->state.ref_step != b->state.ref_step ||
+       a->state.ref_step_pattern != b->state.ref_step_pattern ||
+       a->state.ref_step_song != b->state.ref_step_song) && errors++ < 10 )
+    printf("  target %u: core state differs\n", (unsigned)target);
+
+  if( (a->muted != b->muted || a->slaveclk_mute != b->slaveclk_mute) && errors++ < 10 )
+    printf("  target %u: mutes differ\n", (unsigned)target);
+
+  return errors;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Random track configuration
+// random directions aren't used: the reference would consume the random
+// numbers at different ticks
+/////////////////////////////////////////////////////////////////////////////
+static void RandomSetup(int analytic_only)
+{
+  int track;
+
+  seq_core_steps_per_measure = (rand() % 4) ? 15 : (rand() % 64);
+  seq_core_steps_per_pattern = (rand() % 4) ? 15 : (rand() % 64);
+
+  for(track=0; track<SEQ_CORE_NUM_TRACKS; ++track) {
+    seq_cc_trk_t *tcc = &seq_cc_trk[track];
+
+    tcc->length = (rand() % 3) ? 15 : (rand() % 64);
+    tcc->loop = (rand() % 2) ? 0 : (rand() % (tcc->length+1));
+    tcc->dir_mode = rand() % 4;
+    tcc->clkdiv.value = (rand() % 2) ? 15 : (rand() % 32);
+    tcc->clkdiv.TRIPLETS = (rand() % 4) == 0;
+    tcc->clkdiv.SYNCH_TO_MEASURE = (rand() % 3) == 0;
+    tcc->steps_forward = (rand() % 2) ? 0 : (rand() % 8);
+    tcc->steps_rs_interval = rand() % 8;
+    tcc->steps_jump_back = (analytic_only || rand() % 4) ? 0 : (rand() % 4);
+    tcc->steps_replay = (analytic_only || rand() % 4) ? 0 : (rand() % 4);
+    tcc->steps_repeat = (analytic_only || rand() % 4) ? 0 : (rand() % 4);
+    tcc->steps_skip = (analytic_only || rand() % 4) ? 0 : (rand() % 4);
+    tcc->lfo_steps = rand() % 64;
+    tcc->lfo_steps_rst = rand() % 64;
+    tcc->lfo_phase = rand() % 100;
+    tcc->lfo_enable_flags.ONE_SHOT = (rand() % 4) == 0;
+    seq_core_trk[track].play_section = (rand() % 8) == 0;
+  }
+
+  seq_core_state.reset_trkpos_req = rand() & 0xffff;
+  seq_core_trk_synched_mute = rand() & 0xffff;
+  seq_core_trk_synched_unmute = rand() & 0xffff;
+  seq_core_trk_muted = rand() & 0xffff;
+  seq_core_slaveclk_mute = rand() % 3;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Measures the seek to the given bar with the default track configuration
+/////////////////////////////////////////////////////////////////////////////
+static void Benchmark(u32 bar)
+{
+  u32 target = bar * 16 * 96;
+  int i, loops = 20;
+  clock_t start;
+
+  // analytic seek
+  start = clock();
+  for(i=0; i<loops; ++i)
+    SEQ_CORE_Seek(target);
+  double t_analytic = (double)(clock() - start) / CLOCKS_PER_SEC / loops;
+
+  // replay, and the longest SEQ_CORE_SeekReplay() call
+  double t_replay = 0.0;
+  double t_call_max = 0.0;
+  u32 calls = 0;
+  for(i=0; i<loops; ++i) {
+    SEQ_SONG_Reset(0);
+    SEQ_CORE_Reset(0);
+    seek_replay_active = 1;
+    seek_replay_tick = 0;
+    seek_replay_target = target;
+    calls = 0;
+    while( seek_replay_active ) {
+      start = clock();
+      SEQ_CORE_SeekReplay();
+      double t = (double)(clock() - start) / CLOCKS_PER_SEC;
+      t_replay += t;
+      if( t > t_call_max )
+	t_call_max = t;
+      ++calls;
+    }
+  }
+  t_replay /= loops;
+
+  printf("bar %3u: analytic %6.1f uS, replay %8.1f uS in %4u calls (max. %5.1f uS per call)\n",
+	 (unsigned)bar, t_analytic*1e6, t_replay*1e6, (unsigned)calls, t_call_max*1e6);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Main Program
+/////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+  static snapshot_t ref, seek;
+  setup_t setup;
+  int errors = 0;
+  int analytic = 0, replay = 0, with_clocks = 0;
+  u32 handler_calls_max = 0;
+  int cfg, n;
+
+  SEQ_CORE_Init(0);
+  srand(argc > 1 ? atoi(argv[1]) : 1);
+
+  for(cfg=0; cfg<NUM_CONFIGS; ++cfg) {
+    RandomSetup((cfg % 3) != 0);
+    SetupSave(&setup);
+
+    for(n=0; n<NUM_SEEKS; ++n) {
+      u32 target = (n == 0) ? (rand() % 200) : (rand() % (40*16*96));
+
+      SetupRestore(&setup);
+      ReferenceSeek(target);
+      SnapshotTake(&ref);
+
+      SetupRestore(&setup);
+      if( target && SEQ_CORE_SeekAnalyticPossible() )
+	++analytic;
+      else
+	++replay;
+      CompleteSeek(target);
+      SnapshotTake(&seek);
+      errors += SnapshotCompare(&ref, &seek, target) ? 1 : 0;
+
+      // replays with incoming clocks: compare with the reference at the next tick
+      if( !target || !SEQ_CORE_SeekAnalyticPossible() ) {
+	u32 handler_calls;
+	u32 next_tick;
+
+	++with_clocks;
+	SetupRestore(&setup);
+	next_tick = SeekWithClocks(target, &handler_calls);
+	SnapshotTake(&seek);
+	if( handler_calls > handler_calls_max )
+	  handler_calls_max = handler_calls;
+
+	SetupRestore(&setup);
+	ReferenceSeek(next_tick);
+	SnapshotTake(&ref);
+	errors += SnapshotCompare(&ref, &seek, next_tick) ? 1 : 0;
+      }
+    }
+  }
+
+  printf("%d seeks (%d analytic, %d replay, %d replays with clocks, max. %u handler calls): %d mismatches\n",
+	 analytic+replay+with_clocks, analytic, replay, with_clocks, (unsigned)handler_calls_max, errors);
+
+  // timing with the default track configuration
+  SEQ_CORE_Init(0);
+  u32 bar;
+  for(bar=1; bar<=256; bar*=4)
+    Benchmark(bar);
+
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,120 @@
+// $Id$
+/*
+ * Stubs for the functions and variables of the MBSEQ modules which aren't
+ * linked to the SEQ_CORE_Seek test. Only the symbol names matter, the
+ * return values of the stubbed functions aren't used by the seek.
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Variables
+/////////////////////////////////////////////////////////////////////////////
+
+char seq_cv_clkout_divider[256];
+char seq_file_session_name[256];
+char seq_live_arp_pattern[4096];
+char seq_live_pattern_slot[4096];
+char seq_record_options[64];
+char seq_record_played_notes[64];
+char seq_record_state[64];
+char seq_ui_button_state[64];
+char seq_ui_display_update_req[4];
+char ui_page[4];
+char ui_selected_step_view[4];
+char ui_seq_pause[4];
+char ui_song_edit_pos[4];
+
+
+/////////////////////////////////////////////////////////////////////////////
+// BPM generator: the test sets the ticks directly
+/////////////////////////////////////////////////////////////////////////////
+
+static unsigned long bpm_tick;
+int SEQ_BPM_TickSet(unsigned long tick) { bpm_tick = tick; return 0; }
+unsigned long SEQ_BPM_TickGet(void) { return bpm_tick; }
+int SEQ_BPM_TicksFor_mS(int ms) { return ms * 768 / 1000; } // 120 BPM
+int SEQ_BPM_PPQN_Get(void) { return 384; }
+int SEQ_BPM_IsMaster(void) { return 0; }
+int SEQ_BPM_IsRunning(void) { return 1; }
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Functions
+/////////////////////////////////////////////////////////////////////////////
+
+int APP_SendDebugMessage() { return 0; }
+int BLM_SCALAR_MASTER_MIDI_PortGet() { return 0; }
+int MIOS32_MIDI_SendCC() { return 0; }
+int MIOS32_MIDI_SendProgramChange() { return 0; }
+int OSC_CLIENT_SendMIDIEvent() { return 0; }
+int SEQ_BPM_ChkReqClk() { return 0; }
+int SEQ_BPM_ChkReqCont() { return 0; }
+int SEQ_BPM_ChkReqSongPos() { return 0; }
+int SEQ_BPM_ChkReqStart() { return 0; }
+int SEQ_BPM_ChkReqStop() { return 0; }
+int SEQ_BPM_Cont() { return 0; }
+int SEQ_BPM_Get() { return 0; }
+int SEQ_BPM_Init() { return 0; }
+int SEQ_BPM_PPQN_Set() { return 0; }
+int SEQ_BPM_Set() { return 0; }
+int SEQ_BPM_Stop() { return 0; }
+int SEQ_CV_Clk_Trigger() { return 0; }
+int SEQ_CV_IfGet() { return 0; }
+int SEQ_CV_SendPackage() { return 0; }
+int SEQ_FILE_B_NumPatterns() { return 0; }
+int SEQ_FILE_B_PatternPeekName() { return 0; }
+int SEQ_FILE_B_PatternRead() { return 0; }
+int SEQ_FILE_B_PatternWrite() { return 0; }
+int SEQ_FILE_S_SongRead() { return 0; }
+int SEQ_FILE_S_SongWrite() { return 0; }
+int SEQ_LIVE_Init() { return 0; }
+int SEQ_LIVE_NewStep() { return 0; }
+int SEQ_MIDEXP_Init() { return 0; }
+int SEQ_MIDIMP_Init() { return 0; }
+int SEQ_MIDI_IN_ArpNoteGet() { return 0; }
+int SEQ_MIDI_IN_BusReceive() { return 0; }
+int SEQ_MIDI_IN_ExtCtrlSend() { return 0; }
+int SEQ_MIDI_IN_ResetSingleTransArpStacks() { return 0; }
+int SEQ_MIDI_IN_TransposerNoteGet() { return 0; }
+int SEQ_MIDI_OUT_DelaySet() { return 0; }
+int SEQ_MIDI_OUT_FlushQueue() { return 0; }
+int SEQ_MIDI_OUT_ReSchedule() { return 0; }
+int SEQ_MIDI_OUT_Send() { return 0; }
+int SEQ_MIDI_ROUTER_SendMIDIClockEvent() { return 0; }
+int SEQ_MIDPLY_Init() { return 0; }
+int SEQ_MIDPLY_ModeGet() { return 0; }
+int SEQ_MIDPLY_PlayOffEvents() { return 0; }
+int SEQ_MIDPLY_Reset() { return 0; }
+int SEQ_MIDPLY_RunModeGet() { return 0; }
+int SEQ_MIDPLY_SongPos() { return 0; }
+int SEQ_MIDPLY_Tick() { return 0; }
+int SEQ_MIXER_Load() { return 0; }
+int SEQ_MIXER_NumSet() { return 0; }
+int SEQ_MIXER_SendAll() { return 0; }
+int SEQ_MIXER_SendAllByChannel() { return 0; }
+int SEQ_RECORD_Init() { return 0; }
+int SEQ_RECORD_NewStep() { return 0; }
+int SEQ_RECORD_Reset() { return 0; }
+int SEQ_ROBOTIZE_Event() { return 0; }
+int SEQ_ROBOTIZE_Init() { return 0; }
+int SEQ_STATISTICS_StopwatchCapture() { return 0; }
+int SEQ_STATISTICS_StopwatchInit() { return 0; }
+int SEQ_STATISTICS_StopwatchReset() { return 0; }
+int SEQ_UI_IsSelectedTrack() { return 0; }
+int SEQ_UI_SDCardErrMsg() { return 0; }
+int SEQ_UI_SONG_EditPosSet() { return 0; }
+int SEQ_UI_VisibleTrackGet() { return 0; }
+int TASKS_MIDIOUTSemaphoreGive() { return 0; }
+int TASKS_MIDIOUTSemaphoreTake() { return 0; }
+int TASKS_SDCardSemaphoreGive() { return 0; }
+int TASKS_SDCardSemaphoreTake() { return 0; }
+void portENTER_CRITICAL(void) {}
+void portEXIT_CRITICAL(void) {}
@@ -0,0 +1,10 @@
+// $Id$
+/*
+ * seq_midi_out.c allocates its heap with the FreeRTOS functions
+ * They are mapped to the C library, no other FreeRTOS function is used
+ */
+
+#include <stdlib.h>
+
+#define pvPortMalloc malloc
+#define vPortFree    free
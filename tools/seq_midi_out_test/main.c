@@ -0,0 +1,455 @@
+// $Id$
+/*
+ * SEQ_MIDI_OUT Test
+ * See README.txt for details
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+/////////////////////////////////////////////////////////////////////////////
+// Include files
+/////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+#include <mios32.h>
+#include <seq_midi_out.h>
+#include "seq_midi_out_impl.h"
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local definitions
+/////////////////////////////////////////////////////////////////////////////
+
+#define NUM_STREAMS       1000   // random event streams per timestamp range
+#define STREAM_LENGTH     3000   // operations per stream
+#define MAX_LOG_ENTRIES   (4*STREAM_LENGTH)
+
+#define NUM_PORTS         8      // each port gets a random delay of -5..5 ticks
+#define NUM_TAGS          4
+
+// queue benchmark: like apps/benchmarks/seq_scheduler
+#define QUEUE_TICKS_PER_EVENT 4   // range of ticks over which the events are distributed (multiplied with the number of events)
+#define MIN_MEASURE_TIME      0.2 // seconds per queue size and implementation
+
+// re-schedule benchmark: like the per-step re-scheduling of MBSEQ
+#define RESCHEDULE_TAGS       16  // tracks
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local types
+/////////////////////////////////////////////////////////////////////////////
+
+// two implementations which have to send the same output
+typedef struct {
+  const seq_midi_out_impl_t *impl_a;
+  const seq_midi_out_impl_t *impl_b;
+  u8 reschedule_onoff; // re-schedule OnOff events as well (changes the CC order of the timing wheel, see seq_midi_out.h)
+} impl_pair_t;
+
+// a sent MIDI package or tempo change
+typedef struct {
+  u32 tick;
+  u32 port;
+  u32 value;
+} log_entry_t;
+
+typedef struct {
+  log_entry_t entry[MAX_LOG_ENTRIES];
+  u32 num_entries;
+  u32 overflow;
+} log_t;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Local variables
+/////////////////////////////////////////////////////////////////////////////
+
+// the timing wheel is compared with the sorted list, and each implementation
+// with tag index with the same queue method without index
+static const impl_pair_t impl_pairs[] = {
+  { &LIST_impl,  &WHEEL_impl,     0 },
+  { &LIST_impl,  &LIST_TAG_impl,  1 },
+  { &WHEEL_impl, &WHEEL_TAG_impl, 1 },
+};
+
+static u32 tick;
+static log_t *current_log;
+
+static log_t log_a;
+static log_t log_b;
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Used by SEQ_MIDI_OUT_Init() as default callbacks, and for debug messages
+/////////////////////////////////////////////////////////////////////////////
+s32 MIOS32_MIDI_SendDebugMessage(const char *format, ...)
+{
+  va_list args;
+
+  va_start(args, format);
+  vprintf(format, args);
+  va_end(args);
+
+  return 0; // no error
+}
+
+static void Log_Add(u32 port, u32 value)
+{
+  if( current_log == NULL ) {
+    // queue benchmark
+  } else if( current_log->num_entries >= MAX_LOG_ENTRIES ) {
+    ++current_log->overflow;
+  } else {
+    log_entry_t *e = &current_log->entry[current_log->num_entries++];
+    e->tick = tick;
+    e->port = port;
+    e->value = value;
+  }
+}
+
+s32 MIOS32_MIDI_SendPackage(mios32_midi_port_t port, mios32_midi_package_t package)
+{
+  Log_Add(port, package.ALL);
+  return 0; // no error
+}
+
+s32 SEQ_BPM_IsRunning(void)
+{
+  return 1;
+}
+
+u32 SEQ_BPM_TickGet(void)
+{
+  return tick;
+}
+
+s32 SEQ_BPM_Set(float bpm)
+{
+  Log_Add(0xff, (u32)bpm);
+  return 0; // no error
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Random generator which doesn't depend on the C library
+/////////////////////////////////////////////////////////////////////////////
+static u32 random_state;
+
+static u32 Random(void)
+{
+  random_state = random_state * 1664525 + 1013904223;
+  return random_state >> 8;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Plays a random event stream with one implementation
+// narrow: events are scheduled within 8 ticks, so that many events share
+// the same timestamp
+/////////////////////////////////////////////////////////////////////////////
+static void Stream_Play(const seq_midi_out_impl_t *impl, u32 seed, u8 narrow, u8 reschedule_onoff, log_t *log)
+{
+  int op;
+
+  random_state = seed;
+  tick = 0;
+  current_log = log;
+  log->num_entries = 0;
+  log->overflow = 0;
+
+  impl->Init(0);
+  impl->Callback_MIDI_SendPackage_Set(MIOS32_MIDI_SendPackage);
+  impl->Callback_BPM_IsRunning_Set(SEQ_BPM_IsRunning);
+  impl->Callback_BPM_TickGet_Set(SEQ_BPM_TickGet);
+  impl->Callback_BPM_Set_Set(SEQ_BPM_Set);
+
+  {
+    int port;
+    for(port=0; port<NUM_PORTS; ++port)
+      impl->DelaySet(port, (s8)(Random() % 11) - 5);
+  }
+
+  for(op=0; op<STREAM_LENGTH; ++op) {
+    u32 r = Random() % 1000;
+
+    if( r < 600 ) {
+      // queue an event
+      mios32_midi_package_t p;
+      p.ALL = Random();
+      p.cable = Random() % NUM_TAGS;
+      p.evnt1 &= 0x7f; // valid MIDI data bytes (evnt1 is used as index of the reschedule filter)
+      p.evnt2 &= 0x7f;
+      seq_midi_out_event_type_t event_type = Random() % 6;
+      if( event_type == SEQ_MIDI_OUT_TempoEvent )
+	p.ALL = 60 + Random() % 140;
+
+      u32 timestamp;
+      u32 q = Random() % 100;
+      if( q < 5 )
+	timestamp = (tick > 50) ? (tick - Random() % 50) : 0; // already due
+      else if( q < 15 )
+	timestamp = tick + Random() % 40000; // far future
+      else
+	timestamp = tick + Random() % (narrow ? 8 : 300);
+
+      u32 len = (q % 3 == 0) ? (Random() % 70000) : (Random() % 500);
+      impl->Send(Random() % NUM_PORTS, p, event_type, timestamp, len);
+    } else if( r < 950 ) {
+      // play events
+      u32 q = Random() % 100;
+      if( q < 90 )
+	tick += 1;
+      else if( q < 98 )
+	tick += Random() % 600;
+      else
+	tick += Random() % 50000;
+      impl->Handler();
+    } else if( r < 995 ) {
+      // re-schedule Off events (like SEQ_CORE on sustained notes)
+      u32 filter[4] = { Random(), Random(), 0, Random() };
+      u8 tag = Random() % NUM_TAGS;
+      seq_midi_out_event_type_t event_type = ((Random() % 2) && reschedule_onoff) ? SEQ_MIDI_OUT_OnOffEvent : SEQ_MIDI_OUT_OffEvent;
+      u32 timestamp = tick + Random() % (narrow ? 6 : 20);
+      impl->ReSchedule(tag, event_type, timestamp, (Random() % 2) ? filter : NULL);
+    } else {
+      // stop
+      impl->FlushQueue();
+    }
+  }
+
+  // play remaining events
+  impl->FlushQueue();
+  Log_Add(0xfe, *impl->allocated);
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Compares the output of two implementations
+// returns the index of the first different entry, or -1 if identical
+/////////////////////////////////////////////////////////////////////////////
+static int Log_Compare(log_t *a, log_t *b)
+{
+  u32 i;
+  u32 num = (a->num_entries < b->num_entries) ? a->num_entries : b->num_entries;
+
+  for(i=0; i<num; ++i) {
+    if( memcmp(&a->entry[i], &b->entry[i], sizeof(log_entry_t)) != 0 )
+      return i;
+  }
+
+  if( a->num_entries != b->num_entries || a->overflow != b->overflow )
+    return num;
+
+  return -1;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Queue benchmark: inserts the given number of randomly distributed events
+// (same mix like BENCHMARK_QueueFill() of apps/benchmarks/seq_scheduler),
+// and plays them again tick by tick.
+// The average insert and drain times are returned in uS
+/////////////////////////////////////////////////////////////////////////////
+static void Queue_Benchmark(const seq_midi_out_impl_t *impl, u32 num_events, double *insert_us, double *drain_us)
+{
+  clock_t insert_clocks = 0;
+  clock_t drain_clocks = 0;
+  u32 loops = 0;
+
+  current_log = NULL;
+
+  impl->Init(0);
+  impl->Callback_MIDI_SendPackage_Set(MIOS32_MIDI_SendPackage);
+  impl->Callback_BPM_IsRunning_Set(SEQ_BPM_IsRunning);
+  impl->Callback_BPM_TickGet_Set(SEQ_BPM_TickGet);
+  impl->Callback_BPM_Set_Set(SEQ_BPM_Set);
+
+  do {
+    u32 tick_range = num_events * QUEUE_TICKS_PER_EVENT;
+    mios32_midi_package_t midi_package;
+    clock_t start;
+    int i;
+
+    midi_package.ALL = 0;
+    midi_package.type = NoteOn;
+    midi_package.event = NoteOn;
+    midi_package.velocity = 100;
+
+    random_state = 0x12345678;
+    tick = 0;
+
+    start = clock();
+    for(i=0; i<num_events; ++i) {
+      u32 timestamp = 1 + Random() % tick_range;
+
+      seq_midi_out_event_type_t event_type;
+      switch( i % 4 ) {
+      case 0: event_type = SEQ_MIDI_OUT_OnEvent; break;
+      case 1: event_type = SEQ_MIDI_OUT_CCEvent; break;
+      case 2: event_type = (i % 16 == 2) ? SEQ_MIDI_OUT_ClkEvent : SEQ_MIDI_OUT_OffEvent; break;
+      default: event_type = SEQ_MIDI_OUT_OffEvent;
+      }
+
+      midi_package.cable = i % 16; // tag
+      midi_package.note = i % 128;
+      impl->Send(0, midi_package, event_type, timestamp, 0);
+    }
+    insert_clocks += clock() - start;
+
+    start = clock();
+    while( *impl->allocated ) {
+      ++tick;
+      impl->Handler();
+    }
+    drain_clocks += clock() - start;
+
+    ++loops;
+  } while( (double)(insert_clocks + drain_clocks) / CLOCKS_PER_SEC < MIN_MEASURE_TIME );
+
+  *insert_us = 1e6 * insert_clocks / CLOCKS_PER_SEC / loops;
+  *drain_us = 1e6 * drain_clocks / CLOCKS_PER_SEC / loops;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Re-schedule benchmark: queues the given number of events for 16 tags
+// (tracks), and re-schedules the Off events of each tag to the current tick
+// like SEQ_CORE does for each step.
+// The average time of a SEQ_MIDI_OUT_ReSchedule() call is returned in uS
+/////////////////////////////////////////////////////////////////////////////
+static double ReSchedule_Benchmark(const seq_midi_out_impl_t *impl, u32 num_events)
+{
+  clock_t reschedule_clocks = 0;
+  u32 calls = 0;
+
+  current_log = NULL;
+
+  impl->Init(0);
+  impl->Callback_MIDI_SendPackage_Set(MIOS32_MIDI_SendPackage);
+  impl->Callback_BPM_IsRunning_Set(SEQ_BPM_IsRunning);
+  impl->Callback_BPM_TickGet_Set(SEQ_BPM_TickGet);
+  impl->Callback_BPM_Set_Set(SEQ_BPM_Set);
+
+  do {
+    u32 tick_range = num_events * QUEUE_TICKS_PER_EVENT;
+    mios32_midi_package_t midi_package;
+    clock_t start;
+    int i;
+
+    midi_package.ALL = 0;
+    midi_package.type = NoteOn;
+    midi_package.event = NoteOn;
+    midi_package.velocity = 100;
+
+    random_state = 0x12345678;
+    tick = 0;
+
+    // same mix like the queue benchmark
+    for(i=0; i<num_events; ++i) {
+      u32 timestamp = 1 + Random() % tick_range;
+
+      seq_midi_out_event_type_t event_type;
+      switch( i % 4 ) {
+      case 0: event_type = SEQ_MIDI_OUT_OnEvent; break;
+      case 1: event_type = SEQ_MIDI_OUT_CCEvent; break;
+      default: event_type = SEQ_MIDI_OUT_OffEvent;
+      }
+
+      midi_package.cable = i % RESCHEDULE_TAGS; // tag
+      midi_package.note = i % 128;
+      impl->Send(0, midi_package, event_type, timestamp, 0);
+    }
+
+    start = clock();
+    for(i=0; i<RESCHEDULE_TAGS; ++i)
+      impl->ReSchedule(i, SEQ_MIDI_OUT_OffEvent, tick, NULL);
+    reschedule_clocks += clock() - start;
+    calls += RESCHEDULE_TAGS;
+
+    impl->FlushQueue();
+  } while( (double)reschedule_clocks / CLOCKS_PER_SEC < MIN_MEASURE_TIME );
+
+  return 1e6 * reschedule_clocks / CLOCKS_PER_SEC / calls;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Main
+/////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+  int errors = 0;
+  int pair;
+
+  printf("Comparing SEQ_MIDI_OUT queue methods and tag index (%d streams, %d ops, port delays -5..5)\n",
+	 2*NUM_STREAMS, STREAM_LENGTH);
+
+  for(pair=0; pair<sizeof(impl_pairs)/sizeof(impl_pairs[0]); ++pair) {
+    const seq_midi_out_impl_t *impl_a = impl_pairs[pair].impl_a;
+    const seq_midi_out_impl_t *impl_b = impl_pairs[pair].impl_b;
+    u8 reschedule_onoff = impl_pairs[pair].reschedule_onoff;
+    int pair_errors = 0;
+    u32 num_events = 0;
+    u8 narrow;
+
+    for(narrow=0; narrow<2; ++narrow) {
+      u32 seed;
+      for(seed=1; seed<=NUM_STREAMS; ++seed) {
+	Stream_Play(impl_a, seed, narrow, reschedule_onoff, &log_a);
+	Stream_Play(impl_b, seed, narrow, reschedule_onoff, &log_b);
+	num_events += log_a.num_entries;
+
+	int pos = Log_Compare(&log_a, &log_b);
+	if( pos >= 0 ) {
+	  if( ++pair_errors <= 5 )
+	    printf("ERROR: %s/%s seed %lu%s: output differs at entry %d (tick %lu)\n",
+		   impl_a->name, impl_b->name, seed, narrow ? " (narrow)" : "", pos,
+		   (pos < log_a.num_entries) ? log_a.entry[pos].tick : 0);
+	}
+      }
+    }
+
+    printf("%-5s vs. %-9s: %lu packages, %d different streams\n", impl_a->name, impl_b->name, num_events, pair_errors);
+    errors += pair_errors;
+  }
+
+  printf("\nQueue benchmark (insert/drain of randomly distributed events):\n");
+  {
+    u32 num_events;
+    for(num_events=128; num_events<=SEQ_MIDI_OUT_MAX_EVENTS; num_events *= 2) {
+      double list_insert_us, list_drain_us;
+      double wheel_insert_us, wheel_drain_us;
+
+      Queue_Benchmark(&LIST_impl, num_events, &list_insert_us, &list_drain_us);
+      Queue_Benchmark(&WHEEL_impl, num_events, &wheel_insert_us, &wheel_drain_us);
+
+      printf("Queue %4lu events: LIST insert %8.1f uS, drain %8.1f uS | WHEEL insert %8.1f uS, drain %8.1f uS\n",
+	     num_events, list_insert_us, list_drain_us, wheel_insert_us, wheel_drain_us);
+    }
+  }
+
+  printf("\nReSchedule benchmark (Off events of one of %d tags, average per call):\n", RESCHEDULE_TAGS);
+  {
+    const seq_midi_out_impl_t *impls[4] = { &LIST_impl, &LIST_TAG_impl, &WHEEL_impl, &WHEEL_TAG_impl };
+    u32 num_events;
+    for(num_events=64; num_events<=SEQ_MIDI_OUT_MAX_EVENTS; num_events *= 4) {
+      int i;
+      printf("Queue %4lu events:", num_events);
+      for(i=0; i<4; ++i)
+	printf(" %s %7.2f uS%s", impls[i]->name, ReSchedule_Benchmark(impls[i], num_events), (i < 3) ? " |" : "\n");
+    }
+  }
+
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,21 @@
+// $Id$
+/*
+ * Local MIOS32 configuration file
+ *
+ * this file allows to disable (or re-configure) default functions of MIOS32
+ * available switches are listed in $MIOS32_PATH/modules/mios32/MIOS32_CONFIG.txt
+ *
+ */
+
+#ifndef _MIOS32_CONFIG_H
+#define _MIOS32_CONFIG_H
+
+// the test sets random delays for all ports
+#define SEQ_MIDI_OUT_SUPPORT_DELAY 1
+
+// enough events for sustained notes, and the max. queue size of the queue benchmark
+#define SEQ_MIDI_OUT_MAX_EVENTS 8192
+
+#include <mios32_config_host.h>
+
+#endif /* _MIOS32_CONFIG_H */
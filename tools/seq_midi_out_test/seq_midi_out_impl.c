@@ -0,0 +1,58 @@
+// $Id$
+/*
+ * Wraps one SEQ_MIDI_OUT implementation for the comparison
+ * Compiled four times: with SEQ_MIDI_OUT_QUEUE_METHOD 0/1 and SEQ_MIDI_OUT_TAG_INDEX 0/1
+ * IMPL selects the prefix of the renamed functions
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#include <mios32.h>
+
+// rename the global functions and variables, so that all implementations can be linked together
+#define IMPL_CONCAT2(a, b) a##_##b
+#define IMPL_CONCAT(a, b) IMPL_CONCAT2(a, b)
+#define IMPL_STR2(a) #a
+#define IMPL_STR(a) IMPL_STR2(a)
+
+#define SEQ_MIDI_OUT_Init                          IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_Init)
+#define SEQ_MIDI_OUT_Callback_MIDI_SendPackage_Set IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_Callback_MIDI_SendPackage_Set)
+#define SEQ_MIDI_OUT_Callback_BPM_IsRunning_Set    IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_Callback_BPM_IsRunning_Set)
+#define SEQ_MIDI_OUT_Callback_BPM_TickGet_Set      IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_Callback_BPM_TickGet_Set)
+#define SEQ_MIDI_OUT_Callback_BPM_Set_Set          IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_Callback_BPM_Set_Set)
+#define SEQ_MIDI_OUT_Send                          IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_Send)
+#define SEQ_MIDI_OUT_ReSchedule                    IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_ReSchedule)
+#define SEQ_MIDI_OUT_FlushQueue                    IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_FlushQueue)
+#define SEQ_MIDI_OUT_FreeHeap                      IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_FreeHeap)
+#define SEQ_MIDI_OUT_Handler                       IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_Handler)
+#define SEQ_MIDI_OUT_DelaySet                      IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_DelaySet)
+#define SEQ_MIDI_OUT_DelayGet                      IMPL_CONCAT(IMPL, SEQ_MIDI_OUT_DelayGet)
+#define seq_midi_out_allocated                     IMPL_CONCAT(IMPL, seq_midi_out_allocated)
+#define seq_midi_out_max_allocated                 IMPL_CONCAT(IMPL, seq_midi_out_max_allocated)
+#define seq_midi_out_dropouts                      IMPL_CONCAT(IMPL, seq_midi_out_dropouts)
+
+#include "seq_midi_out.c"
+
+#include "seq_midi_out_impl.h"
+
+
+const seq_midi_out_impl_t IMPL_CONCAT(IMPL, impl) = {
+  IMPL_STR(IMPL),
+  SEQ_MIDI_OUT_Init,
+  SEQ_MIDI_OUT_Callback_MIDI_SendPackage_Set,
+  SEQ_MIDI_OUT_Callback_BPM_IsRunning_Set,
+  SEQ_MIDI_OUT_Callback_BPM_TickGet_Set,
+  SEQ_MIDI_OUT_Callback_BPM_Set_Set,
+  SEQ_MIDI_OUT_Send,
+  SEQ_MIDI_OUT_ReSchedule,
+  SEQ_MIDI_OUT_FlushQueue,
+  SEQ_MIDI_OUT_Handler,
+  SEQ_MIDI_OUT_DelaySet,
+  &seq_midi_out_allocated
+};
@@ -0,0 +1,42 @@
+// $Id$
+/*
+ * Header file for the wrapped SEQ_MIDI_OUT implementations
+ *
+ * ==========================================================================
+ *
+ *  Copyright (C) 2026 The MIOS32 contributors
+ *  Licensed for personal non-commercial use only.
+ *  All other rights reserved.
+ *
+ * ==========================================================================
+ */
+
+#ifndef _SEQ_MIDI_OUT_IMPL_H
+#define _SEQ_MIDI_OUT_IMPL_H
+
+// the functions of one implementation
+typedef struct {
+  const char *name;
+  s32 (*Init)(u32 mode);
+  s32 (*Callback_MIDI_SendPackage_Set)(void *_callback_midi_send_package);
+  s32 (*Callback_BPM_IsRunning_Set)(void *_callback_bpm_is_running);
+  s32 (*Callback_BPM_TickGet_Set)(void *_callback_bpm_tick_get);
+  s32 (*Callback_BPM_Set_Set)(void *_callback_bpm_set);
+  s32 (*Send)(mios32_midi_port_t port, mios32_midi_package_t midi_package, seq_midi_out_event_type_t event_type, u32 timestamp, u32 len);
+  s32 (*ReSchedule)(u8 tag, seq_midi_out_event_type_t event_type, u32 timestamp, u32 *reschedule_filter);
+  s32 (*FlushQueue)(void);
+  s32 (*Handler)(void);
+  s32 (*DelaySet)(mios32_midi_port_t port, s8 delay);
+  u32 *allocated;
+} seq_midi_out_impl_t;
+
+// LIST:      SEQ_MIDI_OUT_QUEUE_METHOD 0, SEQ_MIDI_OUT_TAG_INDEX 0
+// LIST_TAG:  SEQ_MIDI_OUT_QUEUE_METHOD 0, SEQ_MIDI_OUT_TAG_INDEX 1
+// WHEEL:     SEQ_MIDI_OUT_QUEUE_METHOD 1, SEQ_MIDI_OUT_TAG_INDEX 0
+// WHEEL_TAG: SEQ_MIDI_OUT_QUEUE_METHOD 1, SEQ_MIDI_OUT_TAG_INDEX 1
+extern const seq_midi_out_impl_t LIST_impl;
+extern const seq_midi_out_impl_t LIST_TAG_impl;
+extern const seq_midi_out_impl_t WHEEL_impl;
+extern const seq_midi_out_impl_t WHEEL_TAG_impl;
+
+#endif /* _SEQ_MIDI_OUT_IMPL_H */